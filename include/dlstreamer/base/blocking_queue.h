@@ -1,51 +1,156 @@
 /*******************************************************************************
- * Copyright (C) 2022 Intel Corporation
+ * Copyright (C) 2022-2024 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  ******************************************************************************/
 
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
+#include <optional>
+#include <vector>
 
 namespace dlstreamer {
 
+/**
+ * @brief Multi-producer multi-consumer FIFO queue protected by mutex, unbounded or limited to 'capacity' elements.
+ * After close(), push fails and pop returns remaining elements and then default-constructed T (or std::nullopt) instead
+ * of blocking. All methods are thread-safe.
+ */
 template <typename T>
 class BlockingQueue {
   public:
-    void push(T const &value, size_t queue_limit = 0) {
+    using clock = std::chrono::steady_clock;
+
+    explicit BlockingQueue(size_t capacity = 0) : _capacity(capacity) {
+    }
+
+    /**
+     * @brief Waits while queue has 'queue_limit' (or 'capacity' if zero) elements. Returns false if queue is closed.
+     */
+    bool push(T value, size_t queue_limit = 0) {
         std::unique_lock<std::mutex> lock(_mutex);
-        if (queue_limit > 0) {
-            while (_queue.size() >= queue_limit) {
-                _pop_condition.wait(lock);
-            }
-        }
-        _queue.push_front(value);
+        const size_t limit = queue_limit ? queue_limit : _capacity;
+        if (limit > 0)
+            _pop_condition.wait(lock, [&] { return _queue.size() < limit || _closed; });
+        if (_closed)
+            return false;
+        _queue.push_back(std::move(value));
+        lock.unlock();
+        _push_condition.notify_one();
+        return true;
+    }
+
+    bool try_push(T &&value) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_closed || (_capacity > 0 && _queue.size() >= _capacity))
+            return false;
+        _queue.push_back(std::move(value));
+        lock.unlock();
         _push_condition.notify_one();
+        return true;
     }
 
+    /**
+     * @brief Waits for element, returns default-constructed T if queue is closed and empty.
+     */
     T pop() {
         std::unique_lock<std::mutex> lock(_mutex);
-        _push_condition.wait(lock, [=] { return !_queue.empty(); });
-        T value(std::move(_queue.back()));
-        _queue.pop_back();
-        _pop_condition.notify_one();
-        return value;
+        _push_condition.wait(lock, [this] { return !_queue.empty() || _closed; });
+        if (_queue.empty())
+            return T();
+        return pop_front(lock);
+    }
+
+    /**
+     * @brief Waits for element until deadline, returns std::nullopt on timeout or if queue is closed and empty.
+     */
+    std::optional<T> pop(clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_push_condition.wait_until(lock, deadline, [this] { return !_queue.empty() || _closed; }) ||
+            _queue.empty())
+            return std::nullopt;
+        return pop_front(lock);
+    }
+
+    std::optional<T> try_pop() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_queue.empty())
+            return std::nullopt;
+        return pop_front(lock);
+    }
+
+    /**
+     * @brief Takes up to 'max_items' elements, waiting for more until deadline. Returns fewer elements on timeout or if
+     * queue is closed.
+     */
+    std::vector<T> pop_batch(size_t max_items, clock::time_point deadline) {
+        std::vector<T> batch;
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (batch.size() < max_items) {
+            if (_queue.empty() &&
+                !_push_condition.wait_until(lock, deadline, [this] { return !_queue.empty() || _closed; }))
+                break;
+            if (_queue.empty())
+                break; // closed
+            while (!_queue.empty() && batch.size() < max_items) {
+                batch.push_back(std::move(_queue.front()));
+                _queue.pop_front();
+            }
+            _pop_condition.notify_all();
+        }
+        return batch;
+    }
+
+    /**
+     * @brief Wakes all waiting threads. Further push calls fail, pop calls return remaining elements.
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _closed = true;
+        }
+        _push_condition.notify_all();
+        _pop_condition.notify_all();
+    }
+
+    bool closed() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _closed;
     }
 
     void clear() {
-        _queue.clear();
-        _pop_condition.notify_one();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.clear();
+        }
+        _pop_condition.notify_all();
     }
 
     size_t size() {
+        std::lock_guard<std::mutex> lock(_mutex);
         return _queue.size();
     }
 
+    bool empty() {
+        return size() == 0;
+    }
+
   private:
+    T pop_front(std::unique_lock<std::mutex> &lock) {
+        T value(std::move(_queue.front()));
+        _queue.pop_front();
+        lock.unlock();
+        _pop_condition.notify_one();
+        return value;
+    }
+
+    const size_t _capacity;
     std::deque<T> _queue;
+    bool _closed = false;
     std::mutex _mutex;
     std::condition_variable _push_condition;
     std::condition_variable _pop_condition;
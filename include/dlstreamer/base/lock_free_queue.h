@@ -0,0 +1,365 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace dlstreamer {
+
+namespace detail {
+
+static constexpr size_t cache_line_size = 64;
+
+// Threads waiting for a queue state change. Notifying side takes the mutex only if some thread is waiting.
+class WaitList {
+  public:
+    template <typename Ready>
+    bool wait(Ready ready, const std::chrono::steady_clock::time_point *deadline) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _waiters.fetch_add(1); // synchronizes with notify_one(), so 'ready' sees preceding queue updates
+        bool result = true;
+        if (deadline)
+            result = _condition.wait_until(lock, *deadline, ready);
+        else
+            _condition.wait(lock, ready);
+        _waiters.fetch_sub(1);
+        return result;
+    }
+
+    void notify_one() {
+        // Read-modify-write instead of load: either this sees the waiter or the waiter sees the queue update
+        if (_waiters.fetch_add(0) == 0)
+            return;
+        { std::lock_guard<std::mutex> lock(_mutex); }
+        _condition.notify_one();
+    }
+
+    void notify_all() {
+        { std::lock_guard<std::mutex> lock(_mutex); }
+        _condition.notify_all();
+    }
+
+  private:
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::atomic<int> _waiters{0};
+};
+
+/**
+ * Non-blocking and blocking operations on top of Derived::enqueue/dequeue. Blocking calls retry Derived::spin_count
+ * times, yielding in between, before they sleep. Waiting threads are notified outside of the other wait list's mutex,
+ * so producers and consumers never hold both.
+ */
+template <typename Derived, typename T>
+class LockFreeQueueBase {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    // Moves value only on success
+    bool try_push(T &&value) {
+        if (closed() || !derived().enqueue(std::move(value)))
+            return false;
+        _not_empty.notify_one();
+        return true;
+    }
+
+    std::optional<T> try_pop() {
+        std::optional<T> value = derived().dequeue();
+        if (value)
+            _not_full.notify_one();
+        return value;
+    }
+
+    /**
+     * @brief Waits while queue is full. Returns false if queue is closed.
+     */
+    bool push(T value) {
+        if (try_push(std::move(value)))
+            return true;
+        for (int i = 0; i < Derived::spin_count && !closed(); i++) {
+            std::this_thread::yield();
+            if (try_push(std::move(value)))
+                return true;
+        }
+        bool pushed = false;
+        _not_full.wait(
+            [&] {
+                pushed = !closed() && derived().enqueue(std::move(value));
+                return pushed || closed();
+            },
+            nullptr);
+        if (pushed)
+            _not_empty.notify_one();
+        return pushed;
+    }
+
+    /**
+     * @brief Waits for element, returns default-constructed T if queue is closed and empty.
+     */
+    T pop() {
+        std::optional<T> value = wait_pop(nullptr);
+        return value ? std::move(*value) : T();
+    }
+
+    /**
+     * @brief Waits for element until deadline, returns std::nullopt on timeout or if queue is closed and empty.
+     */
+    std::optional<T> pop(clock::time_point deadline) {
+        return wait_pop(&deadline);
+    }
+
+    /**
+     * @brief Takes up to 'max_items' elements, waiting for more until deadline. Returns fewer elements on timeout or if
+     * queue is closed.
+     */
+    std::vector<T> pop_batch(size_t max_items, clock::time_point deadline) {
+        std::vector<T> batch;
+        while (batch.size() < max_items) {
+            std::optional<T> value = try_pop();
+            if (!value && !closed())
+                value = wait_pop(&deadline);
+            if (!value)
+                break;
+            batch.push_back(std::move(*value));
+        }
+        return batch;
+    }
+
+    /**
+     * @brief Wakes all waiting threads. Further push calls fail, pop calls return remaining elements.
+     */
+    void close() {
+        _closed.store(true);
+        _not_empty.notify_all();
+        _not_full.notify_all();
+    }
+
+    bool closed() const {
+        return _closed.load(std::memory_order_acquire);
+    }
+
+    bool empty() const {
+        return static_cast<const Derived *>(this)->size() == 0;
+    }
+
+  protected:
+    Derived &derived() {
+        return *static_cast<Derived *>(this);
+    }
+
+    std::optional<T> wait_pop(const clock::time_point *deadline) {
+        std::optional<T> value = derived().dequeue();
+        for (int i = 0; !value && i < Derived::spin_count && !closed(); i++) {
+            std::this_thread::yield();
+            value = derived().dequeue();
+        }
+        if (!value) {
+            _not_empty.wait(
+                [&] {
+                    value = derived().dequeue();
+                    return value.has_value() || closed();
+                },
+                deadline);
+            if (!value && closed())
+                value = derived().dequeue(); // element pushed right before close()
+        }
+        if (value)
+            _not_full.notify_one();
+        return value;
+    }
+
+    std::atomic<bool> _closed{false};
+    WaitList _not_empty;
+    WaitList _not_full;
+};
+
+} // namespace detail
+
+/**
+ * @brief Bounded single-producer single-consumer ring buffer. try_push/try_pop are wait-free, blocking calls wait on
+ * condition variable only when queue is full or empty. push methods must be called from one thread and pop/front
+ * methods from one (other) thread at a time.
+ */
+template <typename T>
+class SpscQueue : public detail::LockFreeQueueBase<SpscQueue<T>, T> {
+  public:
+    explicit SpscQueue(size_t capacity) : _capacity(capacity), _slots(capacity) {
+        if (!capacity)
+            throw std::invalid_argument("SpscQueue capacity must be non-zero");
+    }
+
+    /**
+     * @brief Returns pointer to the oldest element or nullptr if queue is empty. Must be called from consumer thread.
+     */
+    T *front() {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail_cache) {
+            _tail_cache = _tail.load(std::memory_order_acquire);
+            if (head == _tail_cache)
+                return nullptr;
+        }
+        return &_slots[head % _capacity];
+    }
+
+    size_t size() const {
+        const size_t head = _head.load(std::memory_order_acquire);
+        return _tail.load(std::memory_order_acquire) - head;
+    }
+
+    size_t capacity() const {
+        return _capacity;
+    }
+
+  private:
+    friend class detail::LockFreeQueueBase<SpscQueue<T>, T>;
+
+    static constexpr int spin_count = 0;
+
+    // Moves value only on success
+    bool enqueue(T &&value) {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head_cache == _capacity) {
+            _head_cache = _head.load(std::memory_order_acquire);
+            if (tail - _head_cache == _capacity)
+                return false;
+        }
+        _slots[tail % _capacity] = std::move(value);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> dequeue() {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail_cache) {
+            _tail_cache = _tail.load(std::memory_order_acquire);
+            if (head == _tail_cache)
+                return std::nullopt;
+        }
+        T &slot = _slots[head % _capacity];
+        std::optional<T> value(std::move(slot));
+        slot = T(); // release resources held by the element
+        _head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    const size_t _capacity;
+    std::vector<T> _slots;
+
+    alignas(detail::cache_line_size) std::atomic<size_t> _head{0}; // written by consumer
+    size_t _tail_cache = 0;                                         // consumer's copy of _tail
+    alignas(detail::cache_line_size) std::atomic<size_t> _tail{0}; // written by producer
+    size_t _head_cache = 0;                                         // producer's copy of _head
+};
+
+/**
+ * @brief Bounded multi-producer multi-consumer queue (array of cells with sequence numbers, D. Vyukov's algorithm).
+ * try_push/try_pop are lock-free. Blocking calls spin shortly and then wait on condition variable, the mutex is only
+ * touched when some thread actually waits, so uncontended hand-off never takes a lock. Capacity is rounded up to
+ * power of two.
+ */
+template <typename T>
+class MpmcQueue : public detail::LockFreeQueueBase<MpmcQueue<T>, T> {
+  public:
+    explicit MpmcQueue(size_t capacity) : _capacity(round_up_pow2(capacity)), _cells(new Cell[_capacity]) {
+        if (!capacity)
+            throw std::invalid_argument("MpmcQueue capacity must be non-zero");
+        for (size_t i = 0; i < _capacity; i++)
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+    // Approximate if other threads push or pop concurrently
+    size_t size() const {
+        const size_t dequeue_pos = _dequeue_pos.load(std::memory_order_acquire);
+        const size_t enqueue_pos = _enqueue_pos.load(std::memory_order_acquire);
+        return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+    }
+
+    size_t capacity() const {
+        return _capacity;
+    }
+
+  private:
+    friend class detail::LockFreeQueueBase<MpmcQueue<T>, T>;
+
+    static constexpr int spin_count = 16;
+
+    static size_t round_up_pow2(size_t value) {
+        size_t result = 1;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    // Moves value only on success
+    bool enqueue(T &&value) {
+        Cell *cell;
+        size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &_cells[pos & (_capacity - 1)];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = _enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> dequeue() {
+        Cell *cell;
+        size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &_cells[pos & (_capacity - 1)];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return std::nullopt; // empty
+            } else {
+                pos = _dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        std::optional<T> value(std::move(cell->value));
+        cell->value = T(); // release resources held by the element
+        cell->sequence.store(pos + _capacity, std::memory_order_release);
+        return value;
+    }
+
+    struct alignas(detail::cache_line_size) Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    const size_t _capacity;
+    std::unique_ptr<Cell[]> _cells;
+
+    alignas(detail::cache_line_size) std::atomic<size_t> _enqueue_pos{0};
+    alignas(detail::cache_line_size) std::atomic<size_t> _dequeue_pos{0};
+};
+
+} // namespace dlstreamer
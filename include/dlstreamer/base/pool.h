@@ -7,51 +7,176 @@
 #pragma once
 
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
-#include <thread>
+#include <optional>
 #include <vector>
 
 namespace dlstreamer {
 
+/**
+ * @brief Pool of objects held by std::shared_ptr (T is std::shared_ptr<...>). get_or_create() returns a handle
+ * to a pooled object, the object goes back to the pool's free-list when the last copy of the handle is released.
+ * If 'is_available' callback is specified, it is checked on release, objects still referenced through other
+ * pointers (for example, tensors of a frame) stay pending and are re-checked when the free-list is empty.
+ * When the pool reached 'max_pool_size' objects, get_or_create() waits until an object is released or notify() is
+ * called. Holders of such other pointers should keep the handle alive instead (for example, with aliasing
+ * std::shared_ptr constructed from the handle), or call notify() after dropping them.
+ */
 template <typename T>
 class Pool {
   public:
+    using element_type = typename T::element_type;
+
+    struct Stats {
+        uint64_t hits = 0;        // objects taken from free-list
+        uint64_t allocations = 0; // objects created by allocator
+        uint64_t waits = 0;       // calls that waited for an object to be released
+        std::chrono::nanoseconds wait_time{0};
+    };
+
     Pool(std::function<T()> allocator, std::function<bool(T &)> is_available, size_t max_pool_size = 0)
-        : _allocator(allocator), _is_available(is_available), _max_pool_size(max_pool_size) {
+        : _allocator(allocator), _state(std::make_shared<State>()) {
+        _state->is_available = is_available;
+        _state->max_pool_size = max_pool_size;
     }
 
     T get_or_create() {
+        return acquire(std::nullopt);
+    }
 
-        for (;;) {
+    /**
+     * @brief Same as get_or_create() but waits at most 'timeout' for an object, returns empty pointer on timeout
+     */
+    T get_or_create(std::chrono::milliseconds timeout) {
+        return acquire(std::chrono::steady_clock::now() + timeout);
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        return _state->slots.size();
+    }
+
+    Stats stats() {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        return _state->stats;
+    }
+
+    /**
+     * @brief Wakes a waiting get_or_create() to re-check pending objects
+     */
+    void notify() {
+        // waiter either re-checks pending objects after the lock or is already waiting
+        {
+            std::lock_guard<std::mutex> lock(_state->mutex);
+        }
+        _state->released.notify_one();
+    }
+
+  private:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    struct Slot {
+        T object;
+        size_t next_free;
+    };
+
+    // Shared with handles, so objects can be released after the pool is destroyed
+    struct State {
+        std::mutex mutex;
+        std::condition_variable released;
+        std::vector<Slot> slots;
+        size_t free_head = npos;
+        std::vector<size_t> pending;
+        std::function<bool(T &)> is_available;
+        size_t max_pool_size = 0;
+        Stats stats;
+
+        bool available(size_t index) {
+            return !is_available || is_available(slots[index].object);
+        }
+
+        void push_free(size_t index) {
+            slots[index].next_free = free_head;
+            free_head = index;
+        }
+
+        void release(size_t index) {
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                for (T &object : _pool) {
-                    if (_is_available(object))
-                        return object;
-                }
-                if (!_max_pool_size || _pool.size() < _max_pool_size) { // allocate new object
-                    T object = _allocator();
-                    _pool.push_back(object);
-                    return object;
+                std::lock_guard<std::mutex> lock(mutex);
+                if (available(index))
+                    push_free(index);
+                else
+                    pending.push_back(index);
+            }
+            released.notify_one();
+        }
+
+        bool reclaim_pending() {
+            bool reclaimed = false;
+            for (size_t i = 0; i < pending.size();) {
+                if (available(pending[i])) {
+                    push_free(pending[i]);
+                    pending[i] = pending.back();
+                    pending.pop_back();
+                    reclaimed = true;
+                } else {
+                    i++;
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(1)); // TODO optimize
+            return reclaimed;
         }
-    }
+    };
 
-    size_t size() {
-        std::lock_guard<std::mutex> lock(_mutex);
-        return _pool.size();
+    T acquire(std::optional<std::chrono::steady_clock::time_point> deadline) {
+        State &state = *_state;
+        std::unique_lock<std::mutex> lock(state.mutex);
+        std::optional<std::chrono::steady_clock::time_point> wait_start;
+        size_t index = npos;
+
+        for (;;) {
+            if (state.free_head != npos || state.reclaim_pending()) {
+                index = state.free_head;
+                state.free_head = state.slots[index].next_free;
+                state.stats.hits++;
+                break;
+            }
+            if (!state.max_pool_size || state.slots.size() < state.max_pool_size) { // allocate new object
+                state.slots.push_back({_allocator(), npos});
+                index = state.slots.size() - 1;
+                state.stats.allocations++;
+                break;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (!wait_start) {
+                wait_start = now;
+                state.stats.waits++;
+            }
+            if (deadline && now >= *deadline) {
+                state.stats.wait_time += now - *wait_start;
+                return T();
+            }
+            if (deadline) {
+                state.released.wait_until(lock, *deadline);
+            } else {
+                state.released.wait(lock);
+            }
+        }
+
+        if (wait_start)
+            state.stats.wait_time += std::chrono::steady_clock::now() - *wait_start;
+
+        std::shared_ptr<State> state_ref = _state;
+        return T(state.slots[index].object.get(), [state_ref, index](element_type *) { state_ref->release(index); });
     }
 
-  private:
     std::function<T()> _allocator;
-    std::function<bool(T &)> _is_available;
-    std::vector<T> _pool;
-    std::mutex _mutex;
-    size_t _max_pool_size = 0;
+    std::shared_ptr<State> _state;
 };
 
 } // namespace dlstreamer
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dlstreamer {
+
+/**
+ * @brief Persistent worker threads for data-parallel loops. parallel_for() hands out indices to the workers and the
+ * calling thread and returns when all indices are processed, rethrowing the first exception thrown by the body.
+ * Loops started concurrently from several threads share the workers: every caller processes its own loop, idle workers
+ * join the loop with the fewest workers. Nested calls from inside the body run serially.
+ */
+class ThreadPool {
+  public:
+    // The calling thread takes part in every loop, so by default one worker less than hardware threads is created
+    explicit ThreadPool(size_t num_workers = std::max(std::thread::hardware_concurrency(), 1u) - 1) {
+        for (size_t i = 0; i < num_workers; i++)
+            _workers.emplace_back(&ThreadPool::worker, this);
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (auto &worker : _workers)
+            worker.join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void parallel_for(size_t count, const std::function<void(size_t)> &body) {
+        if (_workers.empty() || count < 2 || inside_loop()) {
+            for (size_t i = 0; i < count; i++)
+                body(i);
+            return;
+        }
+
+        Loop loop(body, count);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _loops.push_back(&loop);
+        }
+        _wake.notify_all();
+
+        run(loop);
+
+        {
+            // Workers join loops under _mutex, so none can see this one after it's removed here
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [&] { return loop.active_workers == 0; });
+            _loops.erase(std::find(_loops.begin(), _loops.end(), &loop));
+        }
+        if (loop.error)
+            std::rethrow_exception(loop.error);
+    }
+
+    size_t num_workers() const {
+        return _workers.size();
+    }
+
+  private:
+    struct Loop {
+        Loop(const std::function<void(size_t)> &body, size_t count) : body(body), count(count) {
+        }
+        bool has_work() const {
+            return next.load(std::memory_order_relaxed) < count;
+        }
+        const std::function<void(size_t)> &body;
+        const size_t count;
+        std::atomic<size_t> next{0};
+        size_t active_workers = 0; // protected by ThreadPool::_mutex
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    static bool &inside_loop() {
+        static thread_local bool inside = false;
+        return inside;
+    }
+
+    static void run(Loop &loop) {
+        inside_loop() = true;
+        for (size_t i = loop.next.fetch_add(1); i < loop.count; i = loop.next.fetch_add(1)) {
+            try {
+                loop.body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(loop.error_mutex);
+                if (!loop.error)
+                    loop.error = std::current_exception();
+                loop.next = loop.count; // skip remaining indices
+            }
+        }
+        inside_loop() = false;
+    }
+
+    // Loop with remaining indices and the fewest workers, nullptr if all loops are fully handed out
+    Loop *pick_loop() const {
+        Loop *picked = nullptr;
+        for (Loop *loop : _loops) {
+            if (loop->has_work() && (!picked || loop->active_workers < picked->active_workers))
+                picked = loop;
+        }
+        return picked;
+    }
+
+    void worker() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (;;) {
+            Loop *loop = nullptr;
+            _wake.wait(lock, [&] { return _stop || (loop = pick_loop()) != nullptr; });
+            if (_stop)
+                return;
+            loop->active_workers++;
+            lock.unlock();
+            run(*loop);
+            lock.lock();
+            if (--loop->active_workers == 0)
+                _done.notify_all();
+        }
+    }
+
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done; // shared by all callers, each waits for its own loop
+    std::vector<Loop *> _loops;
+    bool _stop = false;
+};
+
+} // namespace dlstreamer
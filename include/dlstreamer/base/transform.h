@@ -66,6 +66,10 @@ class BaseTransform : public BaseElement<Transform> {
         return _pool ? _pool->size() : 0;
     }
 
+    Pool<FramePtr>::Stats pool_stats() {
+        return _pool ? _pool->stats() : Pool<FramePtr>::Stats();
+    }
+
   protected:
     ContextPtr _app_context;
     FrameInfo _input_info;
@@ -94,11 +98,12 @@ class BaseTransform : public BaseElement<Transform> {
         return out;
     }
 
+    // Called by pool when the last handle to frame is released
     static bool is_frame_available(FramePtr &frame) {
         // check ref-count of FramePtr, use_count() is std::shared_ptr function
         if (frame.use_count() > 1)
             return false;
-        // check ref-count of each TensorPtr
+        // check ref-count of each TensorPtr, tensors may outlive the frame
         for (const TensorPtr &tensor : frame) {
             if (tensor.use_count() > 1)
                 return false;
@@ -80,6 +80,7 @@ using ParamDescVector = std::vector<ParamDesc>;
 enum ElementFlags {
     ELEMENT_FLAG_EXTERNAL_MEMORY = (1 << 0), // internal allocation not supported
     ELEMENT_FLAG_SHARABLE = (1 << 1),
+    ELEMENT_FLAG_CONCURRENT = (1 << 2), // shared instance supports concurrent process() calls from several streams
 };
 
 static constexpr int32_t ElementDescMagic = 0x34495239;
@@ -79,9 +79,11 @@ class MemoryMapperAnyToGST : public BaseMemoryMapper {
             FramePtr *src_ptr = new FramePtr(src);
             gst_mini_object_set_qdata(mini_object, g_quark_from_string(_quark_name), src_ptr, NULL);
         } else {
+            // Memories reference tensors through aliasing pointers owning the frame, so the frame (and the pool
+            // handle, if the frame is pooled) is released only after the last memory, when tensors are free to reuse
             TensorVector tensors;
             for (auto &tensor : src)
-                tensors.push_back(map(tensor, mode));
+                tensors.push_back(map(TensorPtr(src, tensor.get()), mode));
             dst = std::make_shared<GSTFrame>(src->media_type(), src->format(), tensors, false);
             // capture FramePtr in qdata and set destroy function for qdata
             GstMiniObject *mini_object = &dst->gst_buffer()->mini_object;
@@ -0,0 +1,206 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+/**
+ * @file gva_detection_meta.h
+ * @brief Metadata containing detection results as plain structures
+ */
+
+#ifndef __GVA_DETECTION_META_H__
+#define __GVA_DETECTION_META_H__
+
+#include <gst/gst.h>
+#include <gst/video/gstvideometa.h>
+
+#define GVA_DETECTION_META_API_NAME "GstGVADetectionMetaAPI"
+#define GVA_DETECTION_META_IMPL_NAME "GstGVADetectionMeta"
+
+G_BEGIN_DECLS
+
+/**
+ * @brief This struct represents single detection result. All fields have fixed offsets, so it can be read without
+ * any lookup by field name
+ */
+typedef struct _GVADetection {
+    gdouble x_min;      /**< left border normalized to frame width, in range [0,1] */
+    gdouble y_min;      /**< top border normalized to frame height, in range [0,1] */
+    gdouble x_max;      /**< right border normalized to frame width, in range [0,1] */
+    gdouble y_max;      /**< bottom border normalized to frame height, in range [0,1] */
+    gdouble confidence; /**< detection confidence */
+    gdouble rotation;   /**< bounding box rotation */
+    gint label_id;      /**< label id */
+    GQuark label;       /**< label, 0 if not set */
+    gint roi_id;        /**< id of GstVideoRegionOfInterestMeta attached for this detection */
+} GVADetection;
+
+typedef struct _GstGVADetectionMeta GstGVADetectionMeta;
+
+/**
+ * @brief This struct represents detection metadata attached to buffer by gvadetect element. All detections produced
+ * by one element for one buffer are stored in a single array, so attaching them costs one allocation per buffer
+ * instead of several allocations per detection. "detection" GstStructure of GstVideoRegionOfInterestMeta params is
+ * built from it, see gva_detection_meta_new_structure
+ */
+struct _GstGVADetectionMeta {
+    GstMeta meta;              /**< parent meta object */
+    GQuark element_id;         /**< id of GStreamer pipeline element produced detections (model-instance-id) */
+    GstStructure *params;      /**< fields common to all detections: model name, layer name, converter, etc. */
+    GVADetection *detections;  /**< array of detections */
+    guint size;                /**< number of detections in array */
+    guint capacity;            /**< number of detections array can hold without reallocation */
+    GstStructure **structures; /**< GstStructure representations created on request, see
+                                  gva_detection_meta_get_structure */
+    gboolean roi_params;       /**< TRUE if "detection" structures are added to GstVideoRegionOfInterestMeta params */
+};
+
+/**
+ * @brief This function registers, if needed, and returns GstMetaInfo for _GstGVADetectionMeta
+ * @return GstMetaInfo* for registered type
+ */
+const GstMetaInfo *gst_gva_detection_meta_get_info(void);
+
+/**
+ * @brief This function registers, if needed, and returns a GType for api "GstGVADetectionMetaAPI"
+ * @return GType type
+ */
+GType gst_gva_detection_meta_api_get_type(void);
+
+/**
+ * @def GST_GVA_DETECTION_META_INFO
+ * @brief This macro calls gst_gva_detection_meta_get_info
+ * @return const GstMetaInfo* for registered type
+ */
+#define GST_GVA_DETECTION_META_INFO (gst_gva_detection_meta_get_info())
+
+/**
+ * @def GST_GVA_DETECTION_META_GET
+ * @brief This macro retrieves ptr to _GstGVADetectionMeta instance for passed buf
+ * @param buf GstBuffer* of which metadata is retrieved
+ * @return _GstGVADetectionMeta* instance attached to buf
+ */
+#define GST_GVA_DETECTION_META_GET(buf)                                                                                \
+    ((GstGVADetectionMeta *)gst_buffer_get_meta(buf, gst_gva_detection_meta_api_get_type()))
+
+/**
+ * @def GST_GVA_DETECTION_META_ITERATE
+ * @brief This macro iterates through _GstGVADetectionMeta instances for passed buf, retrieving the next
+ * _GstGVADetectionMeta. If state points to NULL, the first _GstGVADetectionMeta is returned
+ * @param buf GstBuffer* of which metadata is iterated and retrieved
+ * @param state gpointer* that updates with opaque pointer after macro call.
+ * @return _GstGVADetectionMeta* instance attached to buf
+ */
+#define GST_GVA_DETECTION_META_ITERATE(buf, state)                                                                     \
+    ((GstGVADetectionMeta *)gst_buffer_iterate_meta_filtered(buf, state, gst_gva_detection_meta_api_get_type()))
+
+/**
+ * @def GST_GVA_DETECTION_META_ADD
+ * @brief This macro attaches new _GstGVADetectionMeta instance to passed buf
+ * @param buf GstBuffer* to which metadata will be attached
+ * @return _GstGVADetectionMeta* of the newly added instance attached to buf
+ */
+#define GST_GVA_DETECTION_META_ADD(buf)                                                                                \
+    ((GstGVADetectionMeta *)gst_buffer_add_meta(buf, gst_gva_detection_meta_get_info(), NULL))
+
+/**
+ * @brief This function makes sure meta can hold passed number of detections without reallocation
+ * @param meta GstGVADetectionMeta* to reserve memory in
+ * @param capacity total number of detections
+ */
+void gva_detection_meta_reserve(GstGVADetectionMeta *meta, guint capacity);
+
+/**
+ * @brief This function appends zero-initialized detection to meta. Pointers to detections previously obtained from
+ * meta may be invalidated
+ * @param meta GstGVADetectionMeta* to append detection to
+ * @return GVADetection* to fill
+ */
+GVADetection *gva_detection_meta_append(GstGVADetectionMeta *meta);
+
+/**
+ * @brief This function searches for detection attached together with GstVideoRegionOfInterestMeta
+ * @param meta GstGVADetectionMeta* that is searched for detection
+ * @param roi_id id of GstVideoRegionOfInterestMeta
+ * @return const GVADetection* for found detection or NULL if none is found
+ */
+const GVADetection *gva_detection_meta_find(const GstGVADetectionMeta *meta, gint roi_id);
+
+/**
+ * @brief This function returns detection in the form of "detection" GstStructure, the same as one gvadetect adds to
+ * GstVideoRegionOfInterestMeta params. The structure is created on first request only and is owned by meta
+ * @param meta GstGVADetectionMeta* to get detection from
+ * @param index index of detection
+ * @return GstStructure* representation of detection, NULL if index is out of range
+ */
+GstStructure *gva_detection_meta_get_structure(GstGVADetectionMeta *meta, guint index);
+
+/**
+ * @brief This function searches for first _GstGVADetectionMeta instance produced by passed element
+ * @param buffer GstBuffer* that is searched for metadata
+ * @param element_id model-instance-id of element produced metadata, NULL to return first instance
+ * @return GstGVADetectionMeta* for found instance or NULL if none are found
+ */
+GstGVADetectionMeta *find_detection_meta(GstBuffer *buffer, const char *element_id);
+
+/**
+ * @brief This function creates "detection" GstStructure for detection, the same as one gvadetect adds to
+ * GstVideoRegionOfInterestMeta params. It does not need dlstreamer_gst_meta library, so header-only API can use it
+ * @param meta GstGVADetectionMeta* to get detection from
+ * @param index index of detection, must be less than meta->size
+ * @return GstStructure* owned by caller
+ */
+static inline GstStructure *gva_detection_meta_new_structure(const GstGVADetectionMeta *meta, guint index) {
+    const GVADetection *detection = &meta->detections[index];
+    GstStructure *s = meta->params ? gst_structure_copy(meta->params) : gst_structure_new_empty("detection");
+    gst_structure_set_name(s, "detection");
+    gst_structure_set(s, "label_id", G_TYPE_INT, detection->label_id, "confidence", G_TYPE_DOUBLE,
+                      detection->confidence, "x_min", G_TYPE_DOUBLE, detection->x_min, "x_max", G_TYPE_DOUBLE,
+                      detection->x_max, "y_min", G_TYPE_DOUBLE, detection->y_min, "y_max", G_TYPE_DOUBLE,
+                      detection->y_max, "rotation", G_TYPE_DOUBLE, detection->rotation, NULL);
+    return s;
+}
+
+/**
+ * @brief This function adds "detection" GstStructure to params of every GstVideoRegionOfInterestMeta of buffer that
+ * has detection in GstGVADetectionMeta with roi_params not set, as gvadetect attaches them with
+ * roi-detection-params=false. It does not need dlstreamer_gst_meta library, so header-only API can use it
+ * @param buffer GstBuffer* with metadata
+ */
+static inline void gva_detection_meta_add_roi_params(GstBuffer *buffer) {
+    const GType api_type = g_type_from_name(GVA_DETECTION_META_API_NAME);
+    if (!api_type)
+        return;
+
+    gpointer state = NULL;
+    GstMeta *meta = NULL;
+    while ((meta = gst_buffer_iterate_meta_filtered(buffer, &state, api_type))) {
+        GstGVADetectionMeta *detection_meta = (GstGVADetectionMeta *)meta;
+        if (detection_meta->roi_params)
+            continue;
+
+        /* ROI metas follow in the order of detections, so search for the next one starts after the previous */
+        guint next = 0;
+        gpointer roi_state = NULL;
+        GstVideoRegionOfInterestMeta *roi_meta = NULL;
+        while ((roi_meta = GST_VIDEO_REGION_OF_INTEREST_META_ITERATE(buffer, &roi_state))) {
+            for (guint i = 0; i < detection_meta->size; i++) {
+                const guint index = (next + i) % detection_meta->size;
+                if (detection_meta->detections[index].roi_id != roi_meta->id)
+                    continue;
+                if (!gst_video_region_of_interest_meta_get_param(roi_meta, "detection")) {
+                    GstStructure *detection = gva_detection_meta_new_structure(detection_meta, index);
+                    gst_video_region_of_interest_meta_add_param(roi_meta, detection);
+                }
+                next = index + 1;
+                break;
+            }
+        }
+        detection_meta->roi_params = TRUE;
+    }
+}
+
+G_END_DECLS
+
+#endif /* __GVA_DETECTION_META_H__ */
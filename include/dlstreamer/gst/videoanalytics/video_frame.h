@@ -14,6 +14,7 @@
 
 #include "region_of_interest.h"
 
+#include "../metadata/gva_detection_meta.h"
 #include "../metadata/gva_json_meta.h"
 #include "../metadata/gva_tensor_meta.h"
 
@@ -315,6 +316,9 @@ class VideoFrame {
         GstMeta *meta = NULL;
         gpointer state = NULL;
 
+        // gvadetect with roi-detection-params=false keeps detections in GstGVADetectionMeta only
+        gva_detection_meta_add_roi_params(buffer);
+        regions.reserve(gst_buffer_get_n_meta(buffer, GST_VIDEO_REGION_OF_INTEREST_META_API_TYPE));
         while ((meta = gst_buffer_iterate_meta_filtered(buffer, &state, GST_VIDEO_REGION_OF_INTEREST_META_API_TYPE)))
             regions.emplace_back((GstVideoRegionOfInterestMeta *)meta);
         return regions;
@@ -0,0 +1,326 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <openvino/openvino.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dlstreamer {
+
+// Process-wide registry of OpenVINO™ models shared by inference elements.
+// Every model file is read once, callers get either the shared read-only model or its private copy. Compiled models
+// are shared by callers that request the same model with the same device and configuration, identical requests
+// issued concurrently wait for a single compilation while distinct models are compiled in parallel.
+// Registry holds weak references only: a model is released with its last user, and a model file replaced on disk
+// (.xml or .bin) is read and compiled again.
+// If environment variable GVA_MODEL_CACHE_DIR is set, compiled models are also exported to that directory and imported
+// on the next start instead of compiling them again.
+class OpenVINOModelCache {
+  public:
+    static constexpr auto cache_dir_env = "GVA_MODEL_CACHE_DIR";
+
+    enum class Source {
+        Compiled, // cold start: model was compiled
+        Imported, // warm start: compiled blob was imported from cache directory
+        Shared    // warm start: compiled model was shared with another caller
+    };
+
+    struct CompileResult {
+        ov::CompiledModel compiled_model;
+        // keeps compiled_model shared with other callers, it is released by the registry with the last reference
+        std::shared_ptr<const void> reference;
+        Source source = Source::Compiled;
+        std::chrono::milliseconds duration{0};
+        // reason why cache directory could not be used, empty if blob was imported or exported successfully
+        std::string blob_error;
+    };
+
+    static OpenVINOModelCache &instance() {
+        static OpenVINOModelCache cache;
+        return cache;
+    }
+
+    ov::Core &core() {
+        return _core;
+    }
+
+    // Returns model shared by all callers. It must not be modified, use clone_model() instead.
+    std::shared_ptr<const ov::Model> read_model(const std::string &path) {
+        bool created = false;
+        return get_or_create(_models, path + file_stamp(path), created,
+                             [&]() -> std::shared_ptr<const ov::Model> { return _core.read_model(path); });
+    }
+
+    // Returns private copy of model, which caller may modify (add pre-processing, reshape, set batch). The copy keeps
+    // the shared model, so other callers cloning the same file don't read it again.
+    std::shared_ptr<ov::Model> clone_model(const std::string &path) {
+        auto model = read_model(path);
+        std::shared_ptr<ov::Model> clone;
+        {
+            std::lock_guard<std::mutex> lock(_clone_mutex);
+            clone = model->clone();
+        }
+        auto owner = std::make_shared<std::pair<std::shared_ptr<const ov::Model>, std::shared_ptr<ov::Model>>>(
+            std::move(model), clone);
+        return std::shared_ptr<ov::Model>(owner, clone.get());
+    }
+
+    // Compiles model read from model_path on device. Model may be modified after reading, model_variant must describe
+    // all such modifications: models with equal path, variant, device and config are considered identical.
+    CompileResult compile_model(const std::shared_ptr<const ov::Model> &model, const std::string &model_path,
+                                const std::string &model_variant, const std::string &device,
+                                const ov::AnyMap &config) {
+        const auto start = std::chrono::steady_clock::now();
+        const std::string key = make_key(model_path, model_variant, device, config);
+
+        CompileResult result;
+        bool compiled = false;
+        std::shared_ptr<const ov::CompiledModel> shared =
+            get_or_create(_compiled_models, key, compiled, [&]() -> std::shared_ptr<const ov::CompiledModel> {
+                result = load(key, [&]() { return _core.compile_model(model, device, config); },
+                              [&](std::istream &stream) { return _core.import_model(stream, device, config); });
+                return std::make_shared<const ov::CompiledModel>(result.compiled_model);
+            });
+        if (!compiled) {
+            result.compiled_model = *shared;
+            result.source = Source::Shared;
+        }
+        result.reference = shared;
+        result.duration = elapsed(start);
+        return result;
+    }
+
+    // Compiles model for remote context. Such compiled models are bound to context and are not shared between
+    // callers, only cache directory is used.
+    CompileResult compile_model(const std::shared_ptr<const ov::Model> &model, const std::string &model_path,
+                                const std::string &model_variant, const ov::RemoteContext &context,
+                                const ov::AnyMap &config) {
+        const auto start = std::chrono::steady_clock::now();
+        const std::string key = make_key(model_path, model_variant, context.get_device_name(), config);
+        CompileResult result = load(key, [&]() { return _core.compile_model(model, context, config); },
+                                    [&](std::istream &stream) { return _core.import_model(stream, context, config); });
+        result.duration = elapsed(start);
+        return result;
+    }
+
+    static const char *source_name(Source source) {
+        switch (source) {
+        case Source::Compiled:
+            return "compiled";
+        case Source::Imported:
+            return "imported from cache directory";
+        case Source::Shared:
+            return "shared with another element";
+        }
+        return "";
+    }
+
+    // Forgets all models, already returned models stay valid
+    void clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _models.clear();
+        _compiled_models.clear();
+    }
+
+  private:
+    // Entry is a weak reference to the object, set once the object is created
+    template <typename T>
+    using Entries = std::map<std::string, std::shared_future<std::weak_ptr<T>>>;
+
+    ov::Core _core;
+    std::mutex _mutex;
+    std::mutex _clone_mutex; // ov::Model::clone() is not guaranteed to be thread-safe
+    Entries<const ov::Model> _models;
+    Entries<const ov::CompiledModel> _compiled_models;
+
+    OpenVINOModelCache() = default;
+    OpenVINOModelCache(const OpenVINOModelCache &) = delete;
+    OpenVINOModelCache &operator=(const OpenVINOModelCache &) = delete;
+
+    // Returns object registered with key if some caller still uses it, otherwise creates it. Concurrent callers with
+    // same key wait for a single creation. If creation throws, the entry is removed, so next caller tries again.
+    template <typename T, typename CreateFunc>
+    std::shared_ptr<T> get_or_create(Entries<T> &entries, const std::string &key, bool &created, CreateFunc create) {
+        for (;;) {
+            std::shared_future<std::weak_ptr<T>> future;
+            std::promise<std::weak_ptr<T>> promise;
+            bool owner = false;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (auto it = entries.begin(); it != entries.end();)
+                    it = released(it->second) ? entries.erase(it) : std::next(it);
+                auto it = entries.find(key);
+                if (it == entries.end()) {
+                    future = promise.get_future().share();
+                    entries.emplace(key, future);
+                    owner = true;
+                } else {
+                    future = it->second;
+                }
+            }
+
+            if (!owner) {
+                if (std::shared_ptr<T> object = future.get().lock()) {
+                    created = false;
+                    return object;
+                }
+                continue; // released by its last user before this caller got it
+            }
+
+            try {
+                std::shared_ptr<T> object = create();
+                promise.set_value(object);
+                created = true;
+                return object;
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    entries.erase(key);
+                }
+                promise.set_exception(std::current_exception());
+                throw;
+            }
+        }
+    }
+
+    template <typename T>
+    static bool released(const std::shared_future<std::weak_ptr<T>> &future) {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready && future.get().expired();
+    }
+
+    static std::chrono::milliseconds elapsed(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    }
+
+    static std::string any_to_string(const ov::Any &value) {
+        try {
+            return value.as<std::string>();
+        } catch (...) {
+            return value.type_info().name();
+        }
+    }
+
+    // Size and modification time of model file and of its weights file, which OpenVINO™ reads next to .xml
+    static std::string file_stamp(const std::string &model_path) {
+        std::string stamp;
+        std::filesystem::path path(model_path);
+        std::vector<std::filesystem::path> files = {path};
+        if (path.extension() == ".xml")
+            files.push_back(std::filesystem::path(path).replace_extension(".bin"));
+        for (const auto &file : files) {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(file, ec);
+            if (!ec)
+                stamp += ";" + file.extension().string() + ":size=" + std::to_string(size);
+            const auto time = std::filesystem::last_write_time(file, ec);
+            if (!ec)
+                stamp += ";" + file.extension().string() + ":mtime=" + std::to_string(time.time_since_epoch().count());
+        }
+        return stamp;
+    }
+
+    // Key changes whenever model or weights file, caller's modifications, device, configuration or OpenVINO™ version
+    // change
+    static std::string make_key(const std::string &model_path, const std::string &model_variant,
+                                const std::string &device, const ov::AnyMap &config) {
+        std::string key = model_path + file_stamp(model_path);
+        key += ";variant=" + model_variant + ";device=" + device;
+        for (const auto &item : config)
+            key += ";" + item.first + "=" + any_to_string(item.second);
+        key += ";openvino=" + std::string(ov::get_openvino_version().buildNumber);
+        return key;
+    }
+
+    // 64-bit FNV-1a, stable between runs unlike std::hash
+    static std::string blob_name(const std::string &key) {
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : key) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.blob", static_cast<unsigned long long>(hash));
+        return name;
+    }
+
+    template <typename CompileFunc, typename ImportFunc>
+    CompileResult load(const std::string &key, CompileFunc compile, ImportFunc import) {
+        CompileResult result;
+        const char *dir = std::getenv(cache_dir_env);
+        if (!dir || !*dir) {
+            result.compiled_model = compile();
+            return result;
+        }
+
+        const std::filesystem::path blob_path = std::filesystem::path(dir) / blob_name(key);
+        std::ifstream blob(blob_path, std::ios::binary);
+        if (blob) {
+            try {
+                result.compiled_model = import(blob);
+                result.source = Source::Imported;
+                return result;
+            } catch (const std::exception &e) {
+                // stale or corrupted blob, it is overwritten below
+                result.blob_error = "couldn't import " + blob_path.string() + ": " + e.what();
+            }
+        }
+
+        result.compiled_model = compile();
+        result.source = Source::Compiled;
+        std::string error = export_blob(result.compiled_model, blob_path);
+        if (!error.empty())
+            result.blob_error = error;
+        return result;
+    }
+
+    static std::string export_blob(ov::CompiledModel &compiled_model, const std::filesystem::path &blob_path) {
+        try {
+            std::error_code ec;
+            std::filesystem::create_directories(blob_path.parent_path(), ec);
+            if (ec)
+                return "couldn't create " + blob_path.parent_path().string() + ": " + ec.message();
+
+            // write to temporary file and rename it, so concurrent processes never read partially written blob
+            const std::filesystem::path tmp_path =
+                blob_path.string() + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) +
+                std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+            {
+                std::ofstream stream(tmp_path, std::ios::binary);
+                if (!stream)
+                    return "couldn't open " + tmp_path.string() + " for writing";
+                compiled_model.export_model(stream);
+                if (!stream.flush())
+                    return "couldn't write " + tmp_path.string();
+            }
+            std::filesystem::rename(tmp_path, blob_path, ec);
+            if (ec) {
+                std::filesystem::remove(tmp_path, ec);
+                return "couldn't write " + blob_path.string();
+            }
+        } catch (const std::exception &e) {
+            // some devices don't support export
+            return "couldn't export compiled model to " + blob_path.string() + ": " + e.what();
+        }
+        return {};
+    }
+};
+
+} // namespace dlstreamer
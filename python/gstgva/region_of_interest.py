@@ -15,6 +15,7 @@ from collections import namedtuple
 from .tensor import Tensor
 from .util import VideoRegionOfInterestMeta
 from .util import libgst, libgobject, libgstvideo, GLIST_POINTER
+from .util import _native
 
 import gi
 gi.require_version('GstVideo', '1.0')
@@ -61,6 +62,9 @@ class RegionOfInterest(object):
     ## @brief Get object id
     # @return object id as an int, None if failed to get
     def object_id(self) -> int:
+        if _native:
+            structure = _native.roi_find_tensor(ctypes.addressof(self.__roi_meta), "object_id")
+            return Tensor(structure)['id'] if structure else None
         param = self.meta()._params
         object_id_tensor = None
         while param:
@@ -95,6 +99,10 @@ class RegionOfInterest(object):
     ## @brief Get all Tensor instances added to this RegionOfInterest
     # @return list of Tensor instances added to this RegionOfInterest
     def tensors(self):
+        if _native:
+            for structure in _native.roi_tensors(ctypes.addressof(self.__roi_meta)):
+                yield Tensor(structure)
+            return
         param = self.meta()._params
         while param:
             tensor_structure = param.contents.data
@@ -149,6 +157,11 @@ class RegionOfInterest(object):
     # @return generator for VideoRegionOfInterestMeta instances attached to buffer
     @classmethod
     def _iterate(self, buffer: Gst.Buffer):
+        if _native:
+            for address in _native.buffer_metas(hash(buffer), "GstVideoRegionOfInterestMetaAPI"):
+                yield RegionOfInterest(VideoRegionOfInterestMeta.from_address(address))
+            return
+
         try:
             meta_api = hash(GObject.GType.from_name("GstVideoRegionOfInterestMetaAPI"))
         except:
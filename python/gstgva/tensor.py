@@ -19,6 +19,7 @@ from enum import Enum
 from gi.repository import GObject, Gst
 from .util import libgst, libgobject, G_VALUE_ARRAY_POINTER, GValueArray, GValue, G_VALUE_POINTER
 from .util import GVATensorMeta
+from .util import _native
 
 ## @brief This class represents tensor - map-like storage for inference result information, such as output blob
 # description (output layer dims, layout, rank, precision, etc.), inference result in a raw and interpreted forms.
@@ -124,6 +125,11 @@ class Tensor:
     def data(self) -> numpy.ndarray:
         precision = self.__precision_numpy_dtype[self.precision()]
 
+        if _native:
+            # memoryview keeps tensor data alive, no copy is made
+            view = _native.tensor_data(self.__structure)
+            return numpy.frombuffer(view, dtype=precision) if view is not None else None
+
         gvalue = libgst.gst_structure_get_value(
             self.__structure, 'data_buffer'.encode('utf-8'))
 
@@ -137,9 +143,27 @@ class Tensor:
 
         return None
 
+    ## @brief Get segmentation mask at model resolution. Unpacks "segmentation_bitmask" tensors (one bit per pixel,
+    # rows padded to whole bytes) and thresholds "segmentation_mask" tensors at 0.5
+    #  @return numpy.ndarray of bool with shape [height, width], None if tensor has no segmentation mask
+    def mask(self) -> numpy.ndarray:
+        mask_format = self.format()
+        if mask_format not in ("segmentation_bitmask", "segmentation_mask"):
+            return None
+        data = self.data()
+        if data is None:
+            return None
+        height, width = self.dims()
+        if mask_format == "segmentation_mask":
+            return data[:height * width].reshape(height, width) > 0.5
+        rows = data.view(numpy.uint8)[:height * ((width + 7) // 8)].reshape(height, -1)
+        return numpy.unpackbits(rows, axis=1, count=width, bitorder="little").astype(bool)
+
     ## @brief Get name as a string
     #  @return Tensor instance's name
     def name(self) -> str:
+        if _native:
+            return _native.structure_name(self.__structure)
         name = libgst.gst_structure_get_name(self.__structure)
         if name:
             return name.decode('utf-8')
@@ -182,12 +206,16 @@ class Tensor:
     ## @brief Get list of fields contained in Tensor instance
     #  @return List of fields contained in Tensor instance
     def fields(self) -> List[str]:
+        if _native:
+            return _native.structure_fields(self.__structure)
         return [libgst.gst_structure_nth_field_name(self.__structure, i).decode("utf-8") for i in range(self.__len__())]
 
     ## @brief Get item by the field name
     #  @param key Field name
     #  @return Item, None if failed to get
     def __getitem__(self, key):
+        if _native:
+            return _native.structure_get(self.__structure, key)
         key = key.encode('utf-8')
         gtype = libgst.gst_structure_get_field_type(self.__structure, key)
         if gtype == hash(GObject.TYPE_INVALID):  # key is not found
@@ -238,6 +266,8 @@ class Tensor:
     ## @brief Get number of fields contained in Tensor instance
     #  @return Number of fields contained in Tensor instance
     def __len__(self) -> int:
+        if _native:
+            return _native.structure_n_fields(self.__structure)
         return libgst.gst_structure_n_fields(self.__structure)
 
     ## @brief Iterable by all Tensor fields
@@ -249,6 +279,8 @@ class Tensor:
     ## @brief Return string represenation of the Tensor instance
     #  @return String of field names and values
     def __repr__(self) -> str:
+        if _native:
+            return repr(_native.structure_to_dict(self.__structure))
         return repr(dict(self))
 
     ## @brief Remove item by the field name
@@ -346,6 +378,11 @@ class Tensor:
 
     @classmethod
     def _iterate(cls, buffer):
+        if _native:
+            for structure in _native.buffer_tensors(hash(buffer)):
+                yield Tensor(structure)
+            return
+
         try:
             meta_api = hash(GObject.GType.from_name("GstGVATensorMetaAPI"))
         except:
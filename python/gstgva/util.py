@@ -16,6 +16,12 @@ from gi.repository import GstVideo, GstAudio, GLib, GObject, Gst
 # libgstreamer
 libgst = ctypes.CDLL("libgstreamer-1.0.so.0")
 
+# Compiled metadata accessors (python/native), per-call ctypes functions below are used if it's not built
+try:
+    from . import _native
+except ImportError:
+    _native = None
+
 GST_PADDING = 4
 GST_VAAPI_VIDEO_MEMORY_NAME = "GstVaapiVideoMemory"
 
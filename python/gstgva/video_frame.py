@@ -27,6 +27,25 @@ from .util import GVAJSONMetaStr
 from .region_of_interest import RegionOfInterest
 from .tensor import Tensor
 from .util import libgst, gst_buffer_data, VideoInfoFromCaps
+from .util import _native
+
+## @brief numpy dtype of VideoFrame.detections() records, one per RegionOfInterest. label_id and confidence come from
+# detection Tensor (-1 and NaN if there is none), object_id from tracking (-1 if not tracked), roi_type is GQuark of
+# label (use GLib.quark_to_string to get label)
+DETECTION_DTYPE = numpy.dtype([('region_id', numpy.int32),
+                               ('parent_id', numpy.int32),
+                               ('roi_type', numpy.uint32),
+                               ('x', numpy.int32),
+                               ('y', numpy.int32),
+                               ('w', numpy.int32),
+                               ('h', numpy.int32),
+                               ('label_id', numpy.int32),
+                               ('object_id', numpy.int32),
+                               ('confidence', numpy.float64)], align=True)
+
+# _native built from other sources than this file, detections() falls back to per-call ctypes functions
+if _native and _native.detection_record_size != DETECTION_DTYPE.itemsize:
+    _native = None
 
 
 ## @brief This class represents video frame - object for working with RegionOfInterest and Tensor objects which
@@ -72,6 +91,26 @@ class VideoFrame:
     def regions(self):
         return RegionOfInterest._iterate(self.__buffer)
 
+    ## @brief Get all RegionOfInterest objects attached to VideoFrame in one call, without creating
+    # RegionOfInterest and Tensor objects
+    #  @return numpy structured array of DETECTION_DTYPE records, in the same order as regions()
+    def detections(self) -> numpy.ndarray:
+        if _native:
+            return numpy.frombuffer(_native.frame_detections(hash(self.__buffer)), dtype=DETECTION_DTYPE)
+
+        records = []
+        for roi in self.regions():
+            meta = roi.meta()
+            detection = next((tensor for tensor in roi.tensors() if tensor.is_detection()), None)
+            label_id = detection['label_id'] if detection is not None else None
+            confidence = detection['confidence'] if detection is not None else None
+            object_id = roi.object_id()
+            records.append((meta.id, meta.parent_id, meta.roi_type, meta.x, meta.y, meta.w, meta.h,
+                            -1 if label_id is None else label_id,
+                            -1 if object_id is None else object_id,
+                            numpy.nan if confidence is None else confidence))
+        return numpy.array(records, dtype=DETECTION_DTYPE)
+
     ## @brief Get Tensor objects attached to VideoFrame
     #  @return iterator of Tensor objects attached to VideoFrame
     def tensors(self):
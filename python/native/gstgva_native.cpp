@@ -0,0 +1,390 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// gstgva._native: compiled accessors for metadata attached by DL Streamer elements. gstgva modules use it instead of
+// per-field ctypes calls when the module is available. Objects are passed by address: hash() of Gst.Buffer, addresses
+// of GstStructure and GstVideoRegionOfInterestMeta kept by gstgva classes.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <gst/gst.h>
+#include <gst/video/gstvideometa.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if PY_VERSION_HEX < 0x030900A4
+#define Py_SET_REFCNT(obj, refcnt) ((Py_REFCNT(obj) = (refcnt)), (void)0)
+#endif
+
+namespace {
+
+// Same layout as GstGVATensorMeta in gva_tensor_meta.h
+struct GVATensorMeta {
+    GstMeta meta;
+    GstStructure *data;
+};
+
+// Record of frame_detections() output, mirrored by gstgva.video_frame.DETECTION_DTYPE (numpy aligned dtype)
+struct DetectionRecord {
+    int32_t region_id;
+    int32_t parent_id;
+    uint32_t roi_type; // GQuark of label
+    int32_t x;
+    int32_t y;
+    int32_t w;
+    int32_t h;
+    int32_t label_id;  // -1 if ROI has no detection tensor
+    int32_t object_id; // -1 if ROI has no object_id tensor
+    double confidence; // NaN if ROI has no detection tensor
+};
+
+template <typename T>
+T *from_address(PyObject *address) {
+    void *pointer = PyLong_AsVoidPtr(address);
+    if (!pointer && !PyErr_Occurred())
+        PyErr_SetString(PyExc_ValueError, "nullptr passed");
+    return static_cast<T *>(pointer);
+}
+
+PyObject *string_or_none(const gchar *string) {
+    if (!string)
+        Py_RETURN_NONE;
+    return PyUnicode_FromString(string);
+}
+
+PyObject *array_item_to_python(const GValue *value) {
+    if (G_VALUE_TYPE(value) == G_TYPE_FLOAT)
+        return PyFloat_FromDouble(g_value_get_float(value));
+    if (G_VALUE_TYPE(value) == G_TYPE_UINT)
+        return PyLong_FromUnsignedLong(g_value_get_uint(value));
+    PyErr_SetString(PyExc_TypeError, "Unsupported value type for GValue array");
+    return nullptr;
+}
+
+template <typename GetSize, typename GetItem>
+PyObject *array_to_list(GetSize get_size, GetItem get_item) {
+    const guint size = get_size();
+    PyObject *list = PyList_New(size);
+    if (!list)
+        return nullptr;
+    for (guint i = 0; i < size; i++) {
+        PyObject *item = array_item_to_python(get_item(i));
+        if (!item) {
+            Py_DECREF(list);
+            return nullptr;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    return list;
+}
+
+// Conversions of Tensor.__getitem__: other field types are returned as GValue address, like the ctypes version does
+PyObject *field_to_python(const GstStructure *structure, const char *key) {
+    const GValue *value = gst_structure_get_value(structure, key);
+    if (!value)
+        Py_RETURN_NONE;
+    const GType type = G_VALUE_TYPE(value);
+    if (type == G_TYPE_STRING)
+        return string_or_none(g_value_get_string(value));
+    if (type == G_TYPE_INT)
+        return PyLong_FromLong(g_value_get_int(value));
+    if (type == G_TYPE_DOUBLE)
+        return PyFloat_FromDouble(g_value_get_double(value));
+    if (type == GST_TYPE_ARRAY)
+        return array_to_list([value] { return gst_value_array_get_size(value); },
+                             [value](guint i) { return gst_value_array_get_value(value, i); });
+    if (type == G_TYPE_VALUE_ARRAY) {
+        const GValueArray *array = static_cast<const GValueArray *>(g_value_get_boxed(value));
+        if (array)
+            return array_to_list([array] { return array->n_values; },
+                                 [array](guint i) { return &array->values[i]; });
+    }
+    return PyLong_FromVoidPtr(const_cast<GValue *>(value));
+}
+
+/* TensorData: keeps GVariant of tensor's data_buffer field alive while its memory is exported */
+
+struct TensorData {
+    PyObject_HEAD GVariant *variant;
+    void *data;
+    gsize size;
+};
+
+int tensor_data_get_buffer(PyObject *self, Py_buffer *view, int flags) {
+    TensorData *tensor_data = reinterpret_cast<TensorData *>(self);
+    return PyBuffer_FillInfo(view, self, tensor_data->data, tensor_data->size, 0 /*readonly*/, flags);
+}
+
+void tensor_data_dealloc(PyObject *self) {
+    g_variant_unref(reinterpret_cast<TensorData *>(self)->variant);
+    Py_TYPE(self)->tp_free(self);
+}
+
+PyBufferProcs tensor_data_buffer_procs = {tensor_data_get_buffer, nullptr};
+
+PyTypeObject tensor_data_type = [] {
+    PyTypeObject type{};
+    Py_SET_REFCNT(reinterpret_cast<PyObject *>(&type), 1);
+    type.tp_name = "gstgva._native.TensorData";
+    type.tp_basicsize = sizeof(TensorData);
+    type.tp_dealloc = tensor_data_dealloc;
+    type.tp_as_buffer = &tensor_data_buffer_procs;
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+    type.tp_doc = "Memory of tensor's data_buffer field";
+    return type;
+}();
+
+/* Module functions */
+
+PyObject *structure_get(PyObject *, PyObject *args) {
+    PyObject *address;
+    const char *key;
+    if (!PyArg_ParseTuple(args, "Os", &address, &key))
+        return nullptr;
+    GstStructure *structure = from_address<GstStructure>(address);
+    if (!structure)
+        return nullptr;
+    return field_to_python(structure, key);
+}
+
+PyObject *structure_name(PyObject *, PyObject *address) {
+    GstStructure *structure = from_address<GstStructure>(address);
+    if (!structure)
+        return nullptr;
+    return string_or_none(gst_structure_get_name(structure));
+}
+
+PyObject *structure_n_fields(PyObject *, PyObject *address) {
+    GstStructure *structure = from_address<GstStructure>(address);
+    if (!structure)
+        return nullptr;
+    return PyLong_FromLong(gst_structure_n_fields(structure));
+}
+
+PyObject *structure_fields(PyObject *, PyObject *address) {
+    GstStructure *structure = from_address<GstStructure>(address);
+    if (!structure)
+        return nullptr;
+    const gint n_fields = gst_structure_n_fields(structure);
+    PyObject *list = PyList_New(n_fields);
+    if (!list)
+        return nullptr;
+    for (gint i = 0; i < n_fields; i++) {
+        PyObject *name = string_or_none(gst_structure_nth_field_name(structure, i));
+        if (!name) {
+            Py_DECREF(list);
+            return nullptr;
+        }
+        PyList_SET_ITEM(list, i, name);
+    }
+    return list;
+}
+
+PyObject *structure_to_dict(PyObject *, PyObject *address) {
+    GstStructure *structure = from_address<GstStructure>(address);
+    if (!structure)
+        return nullptr;
+    PyObject *dict = PyDict_New();
+    if (!dict)
+        return nullptr;
+    const gint n_fields = gst_structure_n_fields(structure);
+    for (gint i = 0; i < n_fields; i++) {
+        const gchar *key = gst_structure_nth_field_name(structure, i);
+        PyObject *value = field_to_python(structure, key);
+        if (!value || PyDict_SetItemString(dict, key, value) < 0) {
+            Py_XDECREF(value);
+            Py_DECREF(dict);
+            return nullptr;
+        }
+        Py_DECREF(value);
+    }
+    return dict;
+}
+
+// Zero-copy view of tensor's data_buffer, None if tensor has no data
+PyObject *tensor_data(PyObject *, PyObject *address) {
+    GstStructure *structure = from_address<GstStructure>(address);
+    if (!structure)
+        return nullptr;
+    const GValue *value = gst_structure_get_value(structure, "data_buffer");
+    if (!value || !G_VALUE_HOLDS_VARIANT(value) || !g_value_get_variant(value))
+        Py_RETURN_NONE;
+
+    GVariant *variant = g_value_get_variant(value);
+    gsize size = 0;
+    const void *data = g_variant_get_fixed_array(variant, &size, 1);
+
+    TensorData *owner = PyObject_New(TensorData, &tensor_data_type);
+    if (!owner)
+        return nullptr;
+    owner->variant = g_variant_ref(variant);
+    owner->data = const_cast<void *>(data);
+    owner->size = size;
+    PyObject *view = PyMemoryView_FromObject(reinterpret_cast<PyObject *>(owner));
+    Py_DECREF(owner);
+    return view;
+}
+
+// Addresses of metas with specified API type attached to buffer, in buffer order
+PyObject *buffer_metas(PyObject *, PyObject *args) {
+    PyObject *address;
+    const char *api_name;
+    if (!PyArg_ParseTuple(args, "Os", &address, &api_name))
+        return nullptr;
+    GstBuffer *buffer = from_address<GstBuffer>(address);
+    if (!buffer)
+        return nullptr;
+    const GType api = g_type_from_name(api_name);
+    PyObject *list = PyList_New(0);
+    if (!list || !api)
+        return list;
+    gpointer state = nullptr;
+    while (GstMeta *meta = gst_buffer_iterate_meta_filtered(buffer, &state, api)) {
+        PyObject *meta_address = PyLong_FromVoidPtr(meta);
+        if (!meta_address || PyList_Append(list, meta_address) < 0) {
+            Py_XDECREF(meta_address);
+            Py_DECREF(list);
+            return nullptr;
+        }
+        Py_DECREF(meta_address);
+    }
+    return list;
+}
+
+// Addresses of data structures of GstGVATensorMeta attached to buffer
+PyObject *buffer_tensors(PyObject *, PyObject *address) {
+    GstBuffer *buffer = from_address<GstBuffer>(address);
+    if (!buffer)
+        return nullptr;
+    const GType api = g_type_from_name("GstGVATensorMetaAPI");
+    PyObject *list = PyList_New(0);
+    if (!list || !api)
+        return list;
+    gpointer state = nullptr;
+    while (GstMeta *meta = gst_buffer_iterate_meta_filtered(buffer, &state, api)) {
+        PyObject *structure_address = PyLong_FromVoidPtr(reinterpret_cast<GVATensorMeta *>(meta)->data);
+        if (!structure_address || PyList_Append(list, structure_address) < 0) {
+            Py_XDECREF(structure_address);
+            Py_DECREF(list);
+            return nullptr;
+        }
+        Py_DECREF(structure_address);
+    }
+    return list;
+}
+
+// Addresses of ROI's tensor structures, except the "object_id" one holding tracking id
+PyObject *roi_tensors(PyObject *, PyObject *address) {
+    GstVideoRegionOfInterestMeta *roi = from_address<GstVideoRegionOfInterestMeta>(address);
+    if (!roi)
+        return nullptr;
+    const GQuark object_id_quark = g_quark_from_static_string("object_id");
+    PyObject *list = PyList_New(0);
+    if (!list)
+        return nullptr;
+    for (GList *param = roi->params; param; param = param->next) {
+        GstStructure *structure = static_cast<GstStructure *>(param->data);
+        if (gst_structure_get_name_id(structure) == object_id_quark)
+            continue;
+        PyObject *structure_address = PyLong_FromVoidPtr(structure);
+        if (!structure_address || PyList_Append(list, structure_address) < 0) {
+            Py_XDECREF(structure_address);
+            Py_DECREF(list);
+            return nullptr;
+        }
+        Py_DECREF(structure_address);
+    }
+    return list;
+}
+
+// Address of the first ROI's tensor structure with specified name, None if not found
+PyObject *roi_find_tensor(PyObject *, PyObject *args) {
+    PyObject *address;
+    const char *name;
+    if (!PyArg_ParseTuple(args, "Os", &address, &name))
+        return nullptr;
+    GstVideoRegionOfInterestMeta *roi = from_address<GstVideoRegionOfInterestMeta>(address);
+    if (!roi)
+        return nullptr;
+    const GQuark name_quark = g_quark_try_string(name);
+    for (GList *param = roi->params; param && name_quark; param = param->next) {
+        if (gst_structure_get_name_id(static_cast<GstStructure *>(param->data)) == name_quark)
+            return PyLong_FromVoidPtr(param->data);
+    }
+    Py_RETURN_NONE;
+}
+
+// All ROIs of the frame packed into DetectionRecord array, returned as bytearray
+PyObject *frame_detections(PyObject *, PyObject *address) {
+    GstBuffer *buffer = from_address<GstBuffer>(address);
+    if (!buffer)
+        return nullptr;
+    const GQuark detection_quark = g_quark_from_static_string("detection");
+    const GQuark object_id_quark = g_quark_from_static_string("object_id");
+    const GType api = GST_VIDEO_REGION_OF_INTEREST_META_API_TYPE;
+
+    std::vector<DetectionRecord> records;
+    gpointer state = nullptr;
+    while (GstMeta *meta = gst_buffer_iterate_meta_filtered(buffer, &state, api)) {
+        const GstVideoRegionOfInterestMeta *roi = reinterpret_cast<GstVideoRegionOfInterestMeta *>(meta);
+        DetectionRecord record = {roi->id, roi->parent_id, roi->roi_type, static_cast<int32_t>(roi->x),
+                                  static_cast<int32_t>(roi->y), static_cast<int32_t>(roi->w),
+                                  static_cast<int32_t>(roi->h), -1, -1, std::nan("")};
+        bool has_detection = false;
+        bool has_object_id = false;
+        for (GList *param = roi->params; param; param = param->next) {
+            const GstStructure *structure = static_cast<GstStructure *>(param->data);
+            const GQuark name = gst_structure_get_name_id(structure);
+            if (name == detection_quark && !has_detection) { // the first one, as RegionOfInterest.detection()
+                gst_structure_get_int(structure, "label_id", &record.label_id);
+                gst_structure_get_double(structure, "confidence", &record.confidence);
+                has_detection = true;
+            } else if (name == object_id_quark && !has_object_id) {
+                gst_structure_get_int(structure, "id", &record.object_id);
+                has_object_id = true;
+            }
+        }
+        records.push_back(record);
+    }
+    return PyByteArray_FromStringAndSize(reinterpret_cast<const char *>(records.data()),
+                                         records.size() * sizeof(DetectionRecord));
+}
+
+PyMethodDef native_methods[] = {
+    {"structure_get", structure_get, METH_VARARGS, "Value of structure field, None if field is not found"},
+    {"structure_name", structure_name, METH_O, "Name of structure"},
+    {"structure_n_fields", structure_n_fields, METH_O, "Number of structure fields"},
+    {"structure_fields", structure_fields, METH_O, "List of structure field names"},
+    {"structure_to_dict", structure_to_dict, METH_O, "Dictionary of all structure fields"},
+    {"tensor_data", tensor_data, METH_O, "memoryview of tensor data_buffer field without copy"},
+    {"buffer_metas", buffer_metas, METH_VARARGS, "Addresses of buffer metas with specified API type name"},
+    {"buffer_tensors", buffer_tensors, METH_O, "Addresses of tensor structures attached to buffer"},
+    {"roi_tensors", roi_tensors, METH_O, "Addresses of ROI tensor structures, except object_id"},
+    {"roi_find_tensor", roi_find_tensor, METH_VARARGS, "Address of ROI tensor structure with specified name"},
+    {"frame_detections", frame_detections, METH_O, "bytearray of detection records of all buffer ROIs"},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyModuleDef native_module = {
+    PyModuleDef_HEAD_INIT, "_native", "Native metadata accessors for gstgva", -1, native_methods, nullptr, nullptr,
+    nullptr,               nullptr};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit__native(void) {
+    if (PyType_Ready(&tensor_data_type) < 0)
+        return nullptr;
+    PyObject *module = PyModule_Create(&native_module);
+    if (!module)
+        return nullptr;
+    if (PyModule_AddIntConstant(module, "detection_record_size", sizeof(DetectionRecord)) < 0) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
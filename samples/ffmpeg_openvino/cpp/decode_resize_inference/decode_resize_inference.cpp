@@ -130,7 +130,7 @@ int main(int argc, char *argv[]) {
                 auto res = busy_requests.pop();
                 auto batched_frames = res.first;
                 auto infer_request = res.second;
-                if (!infer_request)
+                if (!infer_request) // queue closed
                     break;
                 infer_request.wait();
                 print_tensor(batched_frames, infer_request.get_output_tensor(0));
@@ -174,7 +174,7 @@ int main(int argc, char *argv[]) {
         }
 
         // wait for all inference requests in queue
-        busy_requests.push({});
+        busy_requests.close();
         thread.join();
     } catch (const std::runtime_error &e) {
         std::cerr << "Runtime error: " << e.what() << std::endl;
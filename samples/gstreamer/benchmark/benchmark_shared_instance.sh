@@ -0,0 +1,50 @@
+#!/bin/bash
+# ==============================================================================
+# Copyright (C) 2024 Intel Corporation
+#
+# SPDX-License-Identifier: MIT
+# ==============================================================================
+
+set -e
+
+if [ -z "${MODELS_PATH:-}" ]; then
+  echo "Error: MODELS_PATH is not set." >&2
+  exit 1
+else
+  echo "MODELS_PATH: $MODELS_PATH"
+fi
+
+VIDEO_FILE_NAME=${1}
+MODEL_PATH=${2:-"${MODELS_PATH}/intel/face-detection-adas-0001/FP16-INT8/face-detection-adas-0001.xml"}
+INFERENCE_DEVICE=${3:-CPU}  # Supported values: "CPU", "GPU", "AUTO", "MULTI:GPU,CPU"
+NUMBER_BRANCHES=${4:-16}
+MODEL_INSTANCE_ID=${5-inf0} # empty string disables sharing, every branch loads its own model
+SINK_ELEMENT=${6:-"fakesink async=false"}
+
+if [ -z "${1}" ]; then
+  echo "ERROR set path to video"
+  echo "Usage : ./benchmark_shared_instance.sh VIDEO_FILE [MODEL_PATH] [INFERENCE_DEVICE] [NUMBER_BRANCHES] [MODEL_INSTANCE_ID] [SINK_ELEMENT]"
+  exit
+fi
+
+# check if model exists in local directory
+if [ ! -f $MODEL_PATH ]; then
+  echo "Model not found: ${MODEL_PATH}"
+  exit
+fi
+
+INSTANCE_PARAMS=''
+if [ -n "$MODEL_INSTANCE_ID" ]; then
+  INSTANCE_PARAMS="model-instance-id=${MODEL_INSTANCE_ID}"
+fi
+
+# Pipeline for single branch. All branches run in one process, so elements with same model-instance-id use one
+# openvino_tensor_inference instance (one compiled model and pool of infer requests) concurrently.
+PIPELINE=" filesrc location=${VIDEO_FILE_NAME} ! \
+decodebin force-sw-decoders=true ! video/x-raw ! \
+object_detect model=${MODEL_PATH} device=${INFERENCE_DEVICE} ${INSTANCE_PARAMS} ! queue ! \
+gvafpscounter ! ${SINK_ELEMENT}"
+
+echo -e "$PIPELINE"
+
+"$(dirname "$0")"/gst-launch-multi.sh "$PIPELINE" "$NUMBER_BRANCHES" 1
@@ -8,14 +8,11 @@
 
 #include "openvino.hpp"
 
+#include "dlstreamer/base/lock_free_queue.h"
+#include "dlstreamer/element.h"
 #include "dlstreamer/openvino/context.h"
 #include "dlstreamer/openvino/tensor.h"
 #include "dlstreamer/openvino/utils.h"
-#include "infer_requests_queue.hpp"
-
-#include <queue>
-
-#include "dlstreamer/element.h"
 
 namespace dlstreamer {
 
@@ -53,12 +50,10 @@ class OpenVinoInference {
         if (!complete_cb)
             throw std::invalid_argument("complete_cb cannot be empty");
 
-        std::unique_lock<std::mutex> lk(_requests_mutex);
-        ++_requests_processing;
-
         auto tensors = map_frames_to_tensors(frames);
         size_t idx = 0;
         for (auto frame_tensors : tensors) { // TODO: need to understand which frame maps to which tensors
+            ++_requests_processing;
             auto batch_request = get_free_infer_request();
             set_input(frame_tensors, batch_request->infer_request);
             // Not accurate
@@ -80,7 +75,6 @@ class OpenVinoInference {
 
     void flush() {
         auto task = itt::Task("openvino:OpenVinoInference:flush");
-        std::unique_lock<std::mutex> requests_lk(_requests_mutex);
         std::unique_lock<std::mutex> flush_lk(_flush_mutex);
         _request_processed.wait_for(flush_lk, std::chrono::seconds(1), [this] { return _requests_processing == 0; });
     }
@@ -104,19 +98,19 @@ class OpenVinoInference {
         // std::vector<InferenceBackend::Allocator::AllocContext *> alloc_context; // TODO Openvino context for shared
         // mem
     };
-    SafeQueue<std::shared_ptr<BatchRequest>> _free_requests; // TODO Should it be safe queue?
+    // Lock-free ring of idle requests, shared by submitting thread and OpenVINO callback threads
+    std::unique_ptr<MpmcQueue<std::shared_ptr<BatchRequest>>> _free_requests;
     int _nireq;
 
     std::shared_ptr<spdlog::logger> _logger;
 
-    std::mutex _requests_mutex;
     std::atomic<unsigned int> _requests_processing;
     std::condition_variable _request_processed;
     std::mutex _flush_mutex;
 
     std::shared_ptr<BatchRequest> get_free_infer_request() {
         auto task = itt::Task("openvino:OpenVinoInference:get_free_infer_request");
-        return _free_requests.pop();
+        return _free_requests->pop();
     }
 
     bool is_preprocessing_required() const {
@@ -183,6 +177,7 @@ class OpenVinoInference {
 
     void allocate_infer_requests() {
         auto task = itt::Task("openvino:OpenVinoInference:allocate_infer_requests");
+        _free_requests = std::make_unique<MpmcQueue<std::shared_ptr<BatchRequest>>>(_nireq);
         for (int i = 0; i < _nireq; i++) {
             std::shared_ptr<BatchRequest> batch_request = std::make_shared<BatchRequest>();
             batch_request->infer_request = _compiled_model.create_infer_request();
@@ -190,13 +185,13 @@ class OpenVinoInference {
             // if (allocator) {
             //     SetBlobsToInferenceRequest(layers, batch_request, allocator);
             // }
-            _free_requests.push(batch_request);
+            _free_requests->push(batch_request);
         }
     }
 
     void free_request(std::shared_ptr<BatchRequest> batch_request) {
         auto task = itt::Task("openvino:OpenVinoInference:free_request");
-        _free_requests.push(batch_request);
+        _free_requests->push(batch_request);
         _requests_processing -= 1;
         _request_processed.notify_all();
     }
@@ -12,6 +12,7 @@
 #include "dlstreamer/utils.h"
 #include "dlstreamer_logger.h"
 #include "load_labels_file.h"
+#include "nms.h"
 
 #include <algorithm>
 #include <iostream>
@@ -41,12 +42,15 @@ static constexpr auto cells_number_y = "cells-number-y";
 static constexpr auto bbox_number_on_cell = "bbox-number-on-cell";
 static constexpr auto classes = "classes";
 static constexpr auto nms = "nms";
+static constexpr auto nms_method = "nms-method";
+static constexpr auto nms_top_k = "nms-top-k";
 
 static constexpr auto default_threshold = 0.5;
 static constexpr auto default_iou_threshold = 0.5;
 static constexpr auto default_softmax_enabled = true;
 static constexpr auto default_sigmoid_activation = true;
 static constexpr auto default_nms = true;
+static constexpr auto default_nms_method = "greedy";
 }; // namespace param
 
 static ParamDescVector params_desc = {
@@ -68,7 +72,12 @@ static ParamDescVector params_desc = {
     {param::bbox_number_on_cell, "Number of bounding boxes that can be predicted per cell (0 = autodetection)", 0, 0,
      INT32_MAX},
     {param::classes, "Number of classes", 0, 0, INT32_MAX},
-    {param::nms, "Apply Non-Maximum Suppression (NMS) filter to bounding boxes", param::default_nms}};
+    {param::nms, "Apply Non-Maximum Suppression (NMS) filter to bounding boxes", param::default_nms},
+    {param::nms_method,
+     "NMS method: 'greedy' suppresses overlapping boxes of any class, 'class-aware' only boxes of the same class",
+     std::string(param::default_nms_method)},
+    {param::nms_top_k, "Maximum number of boxes with highest confidence passed to NMS (0 = no limit)", 0, 0,
+     INT32_MAX}};
 
 class YoloParserBuilder final {
   public:
@@ -376,7 +385,11 @@ class PostProcYolo : public BaseTransformInplace {
         if (!labels_file.empty())
             _labels = load_labels_file(labels_file);
         _apply_nms = params->get<bool>(param::nms, param::default_nms);
-        _iou_threshold = params->get<double>(param::iou_threshold, param::default_iou_threshold);
+        _nms_options.iou_threshold =
+            static_cast<float>(params->get<double>(param::iou_threshold, param::default_iou_threshold));
+        _nms_options.method =
+            nms::methodFromString(params->get<std::string>(param::nms_method, param::default_nms_method));
+        _nms_options.top_k = params->get<int>(param::nms_top_k, 0);
         // other params passed to builder
         _builder.set_logger(_logger);
         _builder.set_params(params, _labels.size());
@@ -422,7 +435,7 @@ class PostProcYolo : public BaseTransformInplace {
     std::vector<std::string> _labels;
     YoloParserBuilder _builder;
     std::unique_ptr<YoloParser> _parser;
-    double _iou_threshold = param::default_iou_threshold;
+    nms::Options _nms_options;
     bool _apply_nms = param::default_nms;
 
     const std::string &get_label_by_id(size_t label_id) const noexcept {
@@ -455,41 +468,16 @@ class PostProcYolo : public BaseTransformInplace {
     }
 
     void perform_nms(std::vector<DetectionMetadata> &candidates) {
-        std::sort(candidates.rbegin(), candidates.rend(),
-                  [](const DetectionMetadata &l, const DetectionMetadata &r) -> bool {
-                      return l.confidence() < r.confidence();
-                  });
-
-        for (auto p_first_candidate = candidates.begin(); p_first_candidate != candidates.end(); ++p_first_candidate) {
-            const auto &first_candidate = *p_first_candidate;
-            double first_candidate_area = (first_candidate.x_max() - first_candidate.x_min()) *
-                                          (first_candidate.y_max() - first_candidate.y_min());
-
-            for (auto p_candidate = p_first_candidate + 1; p_candidate != candidates.end();) {
-                const auto &candidate = *p_candidate;
-
-                const double inter_width = std::min(first_candidate.x_max(), candidate.x_max()) -
-                                           std::max(first_candidate.x_min(), candidate.x_min());
-                const double inter_height = std::min(first_candidate.y_max(), candidate.y_max()) -
-                                            std::max(first_candidate.y_min(), candidate.y_min());
-                if (inter_width <= 0.0 || inter_height <= 0.0) {
-                    ++p_candidate;
-                    continue;
-                }
-
-                const double inter_area = inter_width * inter_height;
-                const double candidate_area =
-                    (candidate.x_max() - candidate.x_min()) * (candidate.y_max() - candidate.y_min());
-                const double union_area = candidate_area + first_candidate_area - inter_area;
-
-                assert(union_area != 0 && "union_area is null. Both of the boxes have zero areas.");
-                const double overlap = inter_area / union_area;
-                if (overlap > _iou_threshold)
-                    p_candidate = candidates.erase(p_candidate);
-                else
-                    ++p_candidate;
-            }
-        }
+        nms::Boxes boxes;
+        boxes.reserve(candidates.size());
+        for (const auto &candidate : candidates)
+            boxes.add(candidate.x_min(), candidate.y_min(), candidate.x_max(), candidate.y_max(),
+                      candidate.confidence(), candidate.label_id());
+
+        std::vector<DetectionMetadata> result;
+        for (size_t index : nms::run(boxes, _nms_options))
+            result.push_back(std::move(candidates[index]));
+        candidates = std::move(result);
     }
 };
 
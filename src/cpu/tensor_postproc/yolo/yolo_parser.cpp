@@ -8,6 +8,8 @@
 
 #include "yolo_parser.h"
 
+#include "yolo_decode.h"
+
 namespace dlstreamer {
 
 const TensorInfo &YoloParser::get_min_tensor_shape(const TensorInfoVector &infos_vec) {
@@ -91,11 +93,17 @@ std::vector<DetectionMetadata> YoloParser::parse_blob(const float *blob, const T
 
     std::vector<DetectionMetadata> objects;
 
-    for (size_t i = 0; i < side_square; ++i) {
-
-        const size_t row = i / side_w;
-        const size_t col = i % side_w;
-        for (size_t bbox_cell_num = 0; bbox_cell_num < _num_bbox_on_cell; ++bbox_cell_num) {
+    // Cells are prefiltered by raw objectness, see yolo::rawThreshold
+    const float objectness_threshold = yolo::rawThreshold(_confidence_threshold, _output_sigmoid_activation);
+    std::vector<size_t> cells;
+    for (size_t bbox_cell_num = 0; bbox_cell_num < _num_bbox_on_cell; ++bbox_cell_num) {
+        cells.clear();
+        yolo::selectAtLeast(blob + entry_index(side_square, bbox_cell_num * side_square, NUM_COORDS), side_square,
+                            objectness_threshold, cells);
+
+        for (size_t i : cells) {
+            const size_t row = i / side_w;
+            const size_t col = i % side_w;
             const size_t common_offset = bbox_cell_num * side_square + i;
             const size_t bbox_conf_index = entry_index(side_square, common_offset, NUM_COORDS);
             const size_t bbox_index = entry_index(side_square, common_offset, 0);
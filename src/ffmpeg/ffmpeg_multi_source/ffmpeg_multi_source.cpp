@@ -4,7 +4,7 @@
  * SPDX-License-Identifier: MIT
  ******************************************************************************/
 
-#include "dlstreamer/base/blocking_queue.h"
+#include "dlstreamer/base/lock_free_queue.h"
 #include "dlstreamer/base/source.h"
 #include "dlstreamer/base/transform.h"
 #include "dlstreamer/ffmpeg/context.h"
@@ -13,6 +13,13 @@
 #include "dlstreamer/source.h"
 #include "dlstreamer/vaapi/context.h"
 #include "dlstreamer/vaapi/elements/vaapi_batch_proc.h"
+#include "dlstreamer_logger.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <optional>
 #include <thread>
 
 extern "C" {
@@ -23,25 +30,99 @@ extern "C" {
 #include <libswscale/swscale.h>
 }
 
-#define MAX_QUEUE_SIZE 16
-
 namespace dlstreamer {
 
+namespace param {
+static constexpr auto inputs = "inputs";
+static constexpr auto queue_size = "queue-size";
+static constexpr auto scheduling = "scheduling";
+static constexpr auto decoder_threads = "decoder-threads";
+static constexpr auto decoder_thread_type = "decoder-thread-type";
+static constexpr auto stats_interval = "stats-interval";
+}; // namespace param
+
+static ParamDescVector params_desc = {
+    {param::inputs, "Array of input URLs or file paths, each decoded on its own thread", std::vector<std::string>()},
+    {param::queue_size, "Maximum number of decoded frames queued per input", 16, 1, std::numeric_limits<int>::max()},
+    {param::scheduling,
+     "Order in which read() takes frames from inputs: 'round-robin' takes one frame from each input in turn, "
+     "'latency' takes the frame that has been queued for the longest time",
+     "round-robin",
+     {"round-robin", "latency"}},
+    {param::decoder_threads, "Number of threads of each software decoder (0 = selected by FFmpeg)", 0, 0, 1024},
+    {param::decoder_thread_type, "Threading method of software decoders", "auto", {"auto", "frame", "slice"}},
+    {param::stats_interval, "Interval in seconds between per-input decode FPS log messages (0 = only at the end)", 0,
+     0, std::numeric_limits<int>::max()},
+};
+
+// Free-list of AVFrame objects. Frames released by consumers are unreferenced (returning decoder surfaces/buffers)
+// and reused by the decoding thread instead of allocating a new AVFrame per decoded picture.
+class AVFramePool {
+  public:
+    ~AVFramePool() {
+        for (AVFrame *frame : _free)
+            av_frame_free(&frame);
+    }
+
+    AVFrame *get() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_free.empty()) {
+                AVFrame *frame = _free.back();
+                _free.pop_back();
+                return frame;
+            }
+        }
+        AVFrame *frame = av_frame_alloc();
+        DLS_CHECK(frame);
+        return frame;
+    }
+
+    void release(AVFrame *frame) {
+        av_frame_unref(frame);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _free.push_back(frame);
+    }
+
+  private:
+    std::mutex _mutex;
+    std::vector<AVFrame *> _free;
+};
+
 class MultiSourceFFMPEG : public BaseSource {
   public:
-    MultiSourceFFMPEG(DictionaryCPtr params, const ContextPtr &app_context) : BaseSource(app_context) {
+    enum class Scheduling { RoundRobin, Latency };
+
+    MultiSourceFFMPEG(DictionaryCPtr params, const ContextPtr &app_context)
+        : BaseSource(app_context), _logger(log::get_or_nullsink(params->get(param::logger_name, std::string()))) {
         _ffmpeg_ctx = ptr_cast<FFmpegContext>(app_context);
+        _queue_size = params->get<int>(param::queue_size, 16);
+        DLS_CHECK(_queue_size > 0);
+        auto scheduling = params->get<std::string>(param::scheduling, "round-robin");
+        if (scheduling == "latency")
+            _scheduling = Scheduling::Latency;
+        else if (scheduling != "round-robin")
+            throw std::runtime_error("Unknown scheduling: " + scheduling);
+        _decoder_threads = params->get<int>(param::decoder_threads, 0);
+        auto thread_type = params->get<std::string>(param::decoder_thread_type, "auto");
+        if (thread_type == "frame")
+            _decoder_thread_type = FF_THREAD_FRAME;
+        else if (thread_type == "slice")
+            _decoder_thread_type = FF_THREAD_SLICE;
+        else if (thread_type != "auto")
+            throw std::runtime_error("Unknown decoder-thread-type: " + thread_type);
+        _stats_interval = std::chrono::seconds(params->get<int>(param::stats_interval, 0));
 
-        auto inputs = params->get<std::vector<std::string>>("inputs");
+        auto inputs = params->get<std::vector<std::string>>(param::inputs);
         for (auto &input : inputs)
             add_input(input);
     }
 
     ~MultiSourceFFMPEG() {
-        for (auto &stream : _streams) {
-            stream.active = false;
-            stream.thread.join();
-        }
+        for (auto &stream : _streams)
+            stream->queue.close(); // wakes decoding thread waiting for space in queue
+        for (auto &stream : _streams)
+            stream->thread.join();
     }
 
     void add_input(std::string_view url) {
@@ -61,65 +142,84 @@ class MultiSourceFFMPEG : public BaseSource {
         AVCodecContext *decoder_ctx = NULL;
         DLS_CHECK(decoder_ctx = avcodec_alloc_context3(codec));
         DLS_CHECK_GE0(avcodec_parameters_to_context(decoder_ctx, codecpar));
-        decoder_ctx->hw_device_ctx = av_buffer_ref(_ffmpeg_ctx->hw_device_context_ref());
-        decoder_ctx->get_format = [](AVCodecContext * /*ctx*/, const enum AVPixelFormat * /*pix_fmts*/) {
-            return AV_PIX_FMT_VAAPI; // request VAAPI frame format
-        };
+        if (_ffmpeg_ctx->hw_device_type() == AV_HWDEVICE_TYPE_VAAPI) {
+            decoder_ctx->hw_device_ctx = av_buffer_ref(_ffmpeg_ctx->hw_device_context_ref());
+            decoder_ctx->get_format = [](AVCodecContext * /*ctx*/, const enum AVPixelFormat * /*pix_fmts*/) {
+                return AV_PIX_FMT_VAAPI; // request VAAPI frame format
+            };
+        } else {
+            // Software decoding, let the decoder use several cores per stream
+            decoder_ctx->thread_count = _decoder_threads;
+            decoder_ctx->thread_type = _decoder_thread_type;
+        }
         DLS_CHECK_GE0(avcodec_open2(decoder_ctx, codec, NULL));
 
         // TODO fill _output_info
 
         // Create thread with frame reading loop
-        size_t stream_id = _streams.size();
-        _streams.push_back({});
-        _streams.back().thread = std::thread([=] {
+        std::lock_guard<std::mutex> lock(_read_mutex);
+        _streams.push_back(std::make_unique<Stream>(_queue_size));
+        Stream *stream = _streams.back().get();
+        stream->id = _streams.size() - 1;
+        stream->url = url;
+        stream->thread = std::thread([=] {
             int64_t timestamp = 0;
-            _streams[stream_id].active = true;
-            while (_streams[stream_id].active) {
+            auto frame_pool = stream->frame_pool;
+            AVPacket *avpacket = av_packet_alloc();
+            DLS_CHECK(avpacket);
+            AVFrame *dec_frame = frame_pool->get();
+            stream->started = stream->last_stats = std::chrono::steady_clock::now();
+            while (!stream->queue.closed()) {
                 // Read packet with compressed video frame
-                AVPacket *avpacket = av_packet_alloc();
-                if (av_read_frame(input_ctx, avpacket) < 0) {
-                    av_packet_free(&avpacket); // EOF or error. Send NULL to avcodec_send_packet once to flush decoder
-                } else if (avpacket->stream_index != video_stream) {
-                    av_packet_free(&avpacket); // Non-video (ex, audio) packet
+                bool end_of_stream = av_read_frame(input_ctx, avpacket) < 0;
+                if (!end_of_stream && avpacket->stream_index != video_stream) {
+                    av_packet_unref(avpacket); // Non-video (ex, audio) packet
                     continue;
                 }
 
-                // Send packet to decoder
-                DLS_CHECK_GE0(avcodec_send_packet(decoder_ctx, avpacket));
+                // Send packet to decoder, NULL packet on EOF or error flushes decoder
+                DLS_CHECK_GE0(avcodec_send_packet(decoder_ctx, end_of_stream ? nullptr : avpacket));
+                av_packet_unref(avpacket);
 
                 for (;;) {
                     // Receive frame from decoder
-                    auto dec_frame = av_frame_alloc();
                     int decode_err = avcodec_receive_frame(decoder_ctx, dec_frame);
                     if (decode_err == AVERROR(EAGAIN) || decode_err == AVERROR_EOF) {
                         break;
                     }
                     DLS_CHECK_GE0(decode_err);
 
-                    FramePtr frame = std::make_shared<FFmpegFrame>(dec_frame, true, _ffmpeg_ctx);
+                    FramePtr frame(new FFmpegFrame(dec_frame, false, _ffmpeg_ctx), [frame_pool](FFmpegFrame *f) {
+                        AVFrame *av_frame = f->avframe();
+                        delete f;
+                        frame_pool->release(av_frame);
+                    });
+                    auto pts = (dec_frame->pts == AV_NOPTS_VALUE) ? timestamp + time_delta : dec_frame->pts;
+                    dec_frame = frame_pool->get();
 
                     if (_postproc)
                         frame = _postproc->process(frame);
 
                     timestamp += time_delta;
                     SourceIdentifierMetadata meta(frame->metadata().add(SourceIdentifierMetadata::name));
-                    auto pts = (dec_frame->pts == AV_NOPTS_VALUE) ? timestamp : dec_frame->pts;
-                    meta.init(0, pts, stream_id, 0);
+                    meta.init(0, pts, stream->id, 0);
 
-                    _queue.push(frame, MAX_QUEUE_SIZE);
+                    stream->decoded++;
+                    update_stats(*stream);
+                    push(*stream, std::move(frame));
                 }
 
-                if (avpacket)
-                    av_packet_free(&avpacket);
-                else
-                    break; // End of stream on av_read_frame() call
+                if (end_of_stream)
+                    break;
             }
 
-            FramePtr null_frame(nullptr);
-            _queue.push(null_frame);
-            _streams[stream_id].active = false;
+            log_stats(*stream);
+            close_stream(*stream);
 
+            frame_pool->release(dec_frame);
+            av_packet_free(&avpacket);
+            AVCodecContext *dec_ctx = decoder_ctx;
+            avcodec_free_context(&dec_ctx);
             AVFormatContext *in_ctx = input_ctx;
             avformat_close_input(&in_ctx);
         });
@@ -134,36 +234,154 @@ class MultiSourceFFMPEG : public BaseSource {
     }
 
     void set_output_info(const FrameInfo &info) override {
-        TransformPtr vaapi_preproc;
-        // if (hw_device_type() == AV_HWDEVICE_TYPE_VAAPI)
+        if (_ffmpeg_ctx->hw_device_type() != AV_HWDEVICE_TYPE_VAAPI)
+            throw std::runtime_error("Output resize and color conversion require VAAPI decoding");
         _vaapi_ctx = VAAPIContext::create(_ffmpeg_ctx);
         _postproc = create_transform(vaapi_batch_proc, {}, _vaapi_ctx);
         _postproc->set_output_info(info);
         _output_info = info;
     }
 
+    // Returns next decoded frame from one of inputs, or nullptr once per input that reached End-Of-Stream
     FramePtr read() override {
-        return _queue.pop();
+        std::lock_guard<std::mutex> read_lock(_read_mutex);
+        {
+            std::unique_lock<std::mutex> lock(_ready_mutex);
+            _ready_condition.wait(lock, [this] { return _ready > 0; });
+            _ready--;
+        }
+
+        // Only this thread pops, so a stream found non-empty stays non-empty until popped. Every ready event is
+        // either a queued frame or a closed queue with End-Of-Stream not reported yet.
+        Stream *selected = nullptr;
+        const size_t num_streams = _streams.size();
+        if (_scheduling == Scheduling::RoundRobin) {
+            for (size_t i = 0; i < num_streams && !selected; i++) {
+                Stream *stream = _streams[(_next_stream + i) % num_streams].get();
+                if (stream->queue.front() || pending_end_of_stream(*stream))
+                    selected = stream;
+            }
+            _next_stream = (selected->id + 1) % num_streams;
+        } else {
+            std::chrono::steady_clock::time_point oldest = std::chrono::steady_clock::time_point::max();
+            for (auto &stream : _streams) {
+                QueuedFrame *head = stream->queue.front();
+                if (head && head->queued_at < oldest) {
+                    oldest = head->queued_at;
+                    selected = stream.get();
+                }
+            }
+            for (size_t i = 0; i < num_streams && !selected; i++) {
+                if (pending_end_of_stream(*_streams[i]))
+                    selected = _streams[i].get();
+            }
+        }
+
+        std::optional<QueuedFrame> queued = selected->queue.try_pop();
+        if (!queued) {
+            selected->end_of_stream_reported = true;
+            return nullptr;
+        }
+        return std::move(queued->frame);
     }
 
   private:
+    struct QueuedFrame {
+        FramePtr frame;
+        std::chrono::steady_clock::time_point queued_at;
+    };
+
+    struct Stream {
+        explicit Stream(size_t queue_size) : queue(queue_size) {
+        }
+
+        size_t id = 0;
+        std::string url;
+        std::thread thread;
+        std::shared_ptr<AVFramePool> frame_pool = std::make_shared<AVFramePool>();
+
+        // Decoding thread is the only producer, read() the only consumer. Queue is closed on End-Of-Stream
+        SpscQueue<QueuedFrame> queue;
+        bool end_of_stream_reported = false; // accessed by read() only
+
+        // Statistics, accessed by decoding thread only
+        uint64_t decoded = 0;
+        uint64_t decoded_at_last_stats = 0;
+        std::chrono::steady_clock::time_point started;
+        std::chrono::steady_clock::time_point last_stats;
+    };
+
+    void push(Stream &stream, FramePtr frame) {
+        if (stream.queue.push({std::move(frame), std::chrono::steady_clock::now()}))
+            signal_ready();
+    }
+
+    void close_stream(Stream &stream) {
+        stream.queue.close();
+        signal_ready();
+    }
+
+    bool pending_end_of_stream(Stream &stream) {
+        return stream.queue.closed() && !stream.end_of_stream_reported && stream.queue.empty();
+    }
+
+    void signal_ready() {
+        {
+            std::lock_guard<std::mutex> lock(_ready_mutex);
+            _ready++;
+        }
+        _ready_condition.notify_one();
+    }
+
+    void update_stats(Stream &stream) {
+        if (_stats_interval.count() == 0)
+            return;
+        auto now = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed = now - stream.last_stats;
+        if (elapsed < _stats_interval)
+            return;
+        const uint64_t decoded = stream.decoded;
+        SPDLOG_LOGGER_INFO(_logger, "Input {} ({}): {:.1f} decode fps", stream.id, stream.url,
+                           (decoded - stream.decoded_at_last_stats) / elapsed.count());
+        stream.decoded_at_last_stats = decoded;
+        stream.last_stats = now;
+    }
+
+    void log_stats(Stream &stream) {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - stream.started;
+        double fps = elapsed.count() > 0 ? stream.decoded / elapsed.count() : 0.0;
+        SPDLOG_LOGGER_INFO(_logger, "Input {} ({}): decoded {} frames in {:.2f} s, {:.1f} fps", stream.id, stream.url,
+                           stream.decoded, elapsed.count(), fps);
+    }
+
     FFmpegContextPtr _ffmpeg_ctx;
     VAAPIContextPtr _vaapi_ctx;
     TransformPtr _postproc;
-    BlockingQueue<FramePtr> _queue;
+    std::shared_ptr<spdlog::logger> _logger;
 
-    struct StreamState {
-        bool active;
-        std::thread thread;
-    };
-    std::vector<StreamState> _streams;
+    size_t _queue_size = 16;
+    Scheduling _scheduling = Scheduling::RoundRobin;
+    int _decoder_threads = 0;
+    int _decoder_thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+    std::chrono::seconds _stats_interval{0};
+
+    std::vector<std::unique_ptr<Stream>> _streams;
+
+    // Serializes readers and protects round-robin position
+    std::mutex _read_mutex;
+    size_t _next_stream = 0;
+
+    // Number of frames queued and End-Of-Stream events over all streams
+    std::mutex _ready_mutex;
+    std::condition_variable _ready_condition;
+    size_t _ready = 0;
 };
 
 extern "C" {
 DLS_EXPORT ElementDesc ffmpeg_multi_source = {.name = "ffmpeg_multi_source",
                                               .description = "Multi video-stream source element based on FFmpeg",
                                               .author = "Intel Corporation",
-                                              .params = nullptr,
+                                              .params = &params_desc,
                                               .input_info = {},
                                               .output_info = {{MediaType::Image}},
                                               .create = create_element<MultiSourceFFMPEG>,
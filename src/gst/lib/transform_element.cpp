@@ -123,8 +123,14 @@ class GstDlsTransform {
 
     ~GstDlsTransform() {
         BaseTransform *base_tran = dynamic_cast<BaseTransform *>(_transform);
-        if (base_tran)
+        if (base_tran) {
+            auto stats = base_tran->pool_stats();
             GST_WARNING("%s: frame pool size on deletion = %ld", _base->element.object.name, base_tran->pool_size());
+            GST_INFO("%s: frame pool hits=%" G_GUINT64_FORMAT " allocations=%" G_GUINT64_FORMAT
+                     " waits=%" G_GUINT64_FORMAT " wait_time=%.3f ms",
+                     _base->element.object.name, stats.hits, stats.allocations, stats.waits,
+                     std::chrono::duration<double, std::milli>(stats.wait_time).count());
+        }
         SharedInstance::global()->clean_up();
     }
 
@@ -209,7 +215,11 @@ class GstDlsTransform {
                 throw std::runtime_error("Params are NULL");
             SharedInstance::InstanceId id = {std::string(_class_data->desc->name), _shared_instance_id, *params,
                                              _input_info, _output_info};
-            _element = SharedInstance::global()->init_or_reuse(id, _element, init_function);
+            id.params.set(dlstreamer::param::logger_name, std::string()); // logger is per GStreamer element
+            auto instance = SharedInstance::global()->acquire(id, _element, init_function);
+            _element = instance.element;
+            if (!(_class_data->desc->flags & ELEMENT_FLAG_CONCURRENT))
+                _shared_instance_mutex = instance.mutex;
             _transform = dynamic_cast<Transform *>(_element.get());
             _transform_inplace = dynamic_cast<TransformInplace *>(_element.get());
         } else {
@@ -219,6 +229,14 @@ class GstDlsTransform {
         _transform_initialized = true;
     }
 
+    // Serializes calls into instance shared with other streams, does nothing if instance is not shared or element
+    // handles concurrent calls itself (ELEMENT_FLAG_CONCURRENT)
+    std::unique_lock<std::mutex> lock_shared_instance() {
+        if (!_shared_instance_mutex)
+            return std::unique_lock<std::mutex>();
+        return std::unique_lock<std::mutex>(*_shared_instance_mutex);
+    }
+
     void log_frame_info(GstDebugLevel level, std::string_view msg, const FrameInfo &info) {
         if (level <= _gst_debug_min) {
             auto str = frame_info_to_string(info);
@@ -253,6 +271,7 @@ class GstDlsTransform {
     DictionaryPtr _params = std::make_shared<BaseDictionary>();
 
     std::string _shared_instance_id;
+    std::shared_ptr<std::mutex> _shared_instance_mutex;
     MemoryMapperPtr _gst_mapper;
     FrameInfo _input_info;
     FrameInfo _output_info;
@@ -447,7 +466,11 @@ GstFlowReturn GstDlsTransform::generate_output(GstBuffer **outbuf) {
         GstFramePtr in = gst_buffer_to_frame(input, _input_info, &_input_video_info, true, _gst_context);
         _base->queued_buf = nullptr; // GSTFrame took ownership
 
-        FramePtr out = _transform->process(in);
+        FramePtr out;
+        {
+            auto lock = lock_shared_instance();
+            out = _transform->process(in);
+        }
 
         if (!out) { // send gap event?
             // auto gap_event = gst_event_new_gap(GST_BUFFER_PTS(input), GST_BUFFER_DURATION(input));
@@ -479,7 +502,10 @@ GstFlowReturn GstDlsTransform::transform(GstBuffer *inbuf, GstBuffer *outbuf) {
     try {
         GstFramePtr in = gst_buffer_to_frame(inbuf, _input_info, &_input_video_info, false, _gst_context);
         GstFramePtr out = gst_buffer_to_frame(outbuf, _output_info, &_output_video_info, false, _gst_context);
-        _transform->process(in, out);
+        {
+            auto lock = lock_shared_instance();
+            _transform->process(in, out);
+        }
 
         // Copy timestamps and metadata
         DLS_CHECK(gst_buffer_copy_into(outbuf, inbuf, GST_BUFFER_COPY_METADATA, 0, static_cast<gsize>(-1)))
@@ -505,7 +531,11 @@ GstFlowReturn GstDlsTransform::transform_ip(GstBuffer *buf) {
 
         // TODO: return value means if we should drop buffer (send GAP) or not
         // May be introduce another method to check if buffer should be dropped, or by transform flag
-        bool accepted = _transform_inplace->process(transformed_frame);
+        bool accepted;
+        {
+            auto lock = lock_shared_instance();
+            accepted = _transform_inplace->process(transformed_frame);
+        }
 
         if (!accepted) {
             GST_DEBUG_OBJECT(_base, "Push GAP event: ts=%" GST_TIME_FORMAT, GST_TIME_ARGS(GST_BUFFER_PTS(buf)));
@@ -545,7 +575,11 @@ GstFlowReturn GstDlsTransform::transform_list(GstBufferList *list) {
         GstFramePtr in = std::make_shared<GSTFrameBatch>(list, info, true, _gst_context);
 
         // Run processing on FramePtr containing list of tensors
-        FramePtr out = _transform->process(in);
+        FramePtr out;
+        {
+            auto lock = lock_shared_instance();
+            out = _transform->process(in);
+        }
 
         if (!out) { // send gap event?
             return GST_FLOW_OK;
@@ -643,7 +677,8 @@ void GstDlsTransformClass::init(gpointer g_class, gpointer class_data) {
             gobject_class, property_id,
             g_param_spec_string(param::shared_instance_id, param::shared_instance_id,
                                 "Identifier for sharing backend instance between multiple elements, for example in "
-                                "elements processing multiple inputs",
+                                "elements processing multiple inputs. Elements with same identifier, parameters and "
+                                "caps use one instance (for inference, one loaded model and pool of requests)",
                                 "", G_PARAM_READWRITE));
     }
 }
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include <string.h>
+
+#include "dlstreamer/gst/metadata/gva_detection_meta.h"
+
+#define UNUSED(x) (void)(x)
+
+GType gst_gva_detection_meta_api_get_type(void) {
+    static GType type;
+    static const gchar *tags[] = {NULL};
+
+    if (g_once_init_enter(&type)) {
+        GType _type = gst_meta_api_type_register(GVA_DETECTION_META_API_NAME, tags);
+        g_once_init_leave(&type, _type);
+    }
+    return type;
+}
+
+gboolean gst_gva_detection_meta_init(GstMeta *meta, gpointer params, GstBuffer *buffer) {
+    UNUSED(params);
+    UNUSED(buffer);
+
+    GstGVADetectionMeta *detection_meta = (GstGVADetectionMeta *)meta;
+    detection_meta->element_id = 0;
+    detection_meta->params = NULL;
+    detection_meta->detections = NULL;
+    detection_meta->size = 0;
+    detection_meta->capacity = 0;
+    detection_meta->structures = NULL;
+    detection_meta->roi_params = FALSE;
+    return TRUE;
+}
+
+void gst_gva_detection_meta_free(GstMeta *meta, GstBuffer *buffer) {
+    UNUSED(buffer);
+
+    GstGVADetectionMeta *detection_meta = (GstGVADetectionMeta *)meta;
+    if (detection_meta->structures) {
+        for (guint i = 0; i < detection_meta->size; i++) {
+            if (detection_meta->structures[i])
+                gst_structure_free(detection_meta->structures[i]);
+        }
+        g_free(detection_meta->structures);
+        detection_meta->structures = NULL;
+    }
+    if (detection_meta->params) {
+        gst_structure_free(detection_meta->params);
+        detection_meta->params = NULL;
+    }
+    g_free(detection_meta->detections);
+    detection_meta->detections = NULL;
+    detection_meta->size = detection_meta->capacity = 0;
+}
+
+gboolean gst_gva_detection_meta_transform(GstBuffer *dest_buf, GstMeta *src_meta, GstBuffer *src_buf, GQuark type,
+                                          gpointer data) {
+    UNUSED(src_buf);
+    UNUSED(type);
+    UNUSED(data);
+
+    g_return_val_if_fail(gst_buffer_is_writable(dest_buf), FALSE);
+
+    GstGVADetectionMeta *dst = GST_GVA_DETECTION_META_ADD(dest_buf);
+    GstGVADetectionMeta *src = (GstGVADetectionMeta *)src_meta;
+
+    dst->element_id = src->element_id;
+    dst->roi_params = src->roi_params;
+    if (src->params)
+        dst->params = gst_structure_copy(src->params);
+    if (src->size) {
+        gva_detection_meta_reserve(dst, src->size);
+        memcpy(dst->detections, src->detections, src->size * sizeof(GVADetection));
+        dst->size = src->size;
+    }
+
+    return TRUE;
+}
+
+const GstMetaInfo *gst_gva_detection_meta_get_info(void) {
+    static const GstMetaInfo *meta_info = NULL;
+
+    if (g_once_init_enter(&meta_info)) {
+        const GstMetaInfo *meta = gst_meta_register(
+            gst_gva_detection_meta_api_get_type(), GVA_DETECTION_META_IMPL_NAME, sizeof(GstGVADetectionMeta),
+            (GstMetaInitFunction)gst_gva_detection_meta_init, (GstMetaFreeFunction)gst_gva_detection_meta_free,
+            (GstMetaTransformFunction)gst_gva_detection_meta_transform);
+        g_once_init_leave(&meta_info, meta);
+    }
+    return meta_info;
+}
+
+void gva_detection_meta_reserve(GstGVADetectionMeta *meta, guint capacity) {
+    g_return_if_fail(meta != NULL);
+
+    if (capacity <= meta->capacity)
+        return;
+
+    meta->detections = g_renew(GVADetection, meta->detections, capacity);
+    if (meta->structures) {
+        meta->structures = g_renew(GstStructure *, meta->structures, capacity);
+        memset(meta->structures + meta->capacity, 0, (capacity - meta->capacity) * sizeof(GstStructure *));
+    }
+    meta->capacity = capacity;
+}
+
+GVADetection *gva_detection_meta_append(GstGVADetectionMeta *meta) {
+    g_return_val_if_fail(meta != NULL, NULL);
+
+    if (meta->size == meta->capacity)
+        gva_detection_meta_reserve(meta, meta->capacity ? meta->capacity * 2 : 8);
+
+    GVADetection *detection = &meta->detections[meta->size++];
+    memset(detection, 0, sizeof(GVADetection));
+    return detection;
+}
+
+const GVADetection *gva_detection_meta_find(const GstGVADetectionMeta *meta, gint roi_id) {
+    g_return_val_if_fail(meta != NULL, NULL);
+
+    for (guint i = 0; i < meta->size; i++) {
+        if (meta->detections[i].roi_id == roi_id)
+            return &meta->detections[i];
+    }
+    return NULL;
+}
+
+GstStructure *gva_detection_meta_get_structure(GstGVADetectionMeta *meta, guint index) {
+    g_return_val_if_fail(meta != NULL, NULL);
+
+    if (index >= meta->size)
+        return NULL;
+
+    if (!meta->structures)
+        meta->structures = g_new0(GstStructure *, meta->capacity);
+    if (meta->structures[index])
+        return meta->structures[index];
+
+    GstStructure *s = gva_detection_meta_new_structure(meta, index);
+    meta->structures[index] = s;
+    return s;
+}
+
+GstGVADetectionMeta *find_detection_meta(GstBuffer *buffer, const char *element_id) {
+    GstGVADetectionMeta *meta = NULL;
+    gpointer state = NULL;
+
+    const GQuark element_quark = element_id ? g_quark_try_string(element_id) : 0;
+    if (element_id && !element_quark)
+        return NULL;
+
+    while ((meta = GST_GVA_DETECTION_META_ITERATE(buffer, &state))) {
+        if (!element_id || meta->element_id == element_quark)
+            return meta;
+    }
+    return NULL;
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Lock-free latency histogram with HDR-style log-linear buckets: values are grouped by power of two and every group
+ * is split into 32 linear sub-buckets, so any recorded value is reported with relative error below 1/32. Counters are
+ * sharded between threads, recording is a couple of relaxed atomic increments on a shard owned by few threads.
+ */
+class LatencyHistogram {
+  public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr unsigned VALUE_BITS = 32; // microseconds, larger values are clamped (~71 minutes)
+    static constexpr size_t BUCKETS = SUB_BUCKETS * (VALUE_BITS - SUB_BUCKET_BITS + 1);
+    static constexpr size_t SHARDS = 4;
+
+    // Merged counters of all shards
+    struct Snapshot {
+        std::vector<uint64_t> counts;
+        uint64_t count = 0;
+        uint64_t sum_us = 0;
+
+        // Counters recorded since 'earlier' snapshot of the same histogram
+        Snapshot since(const Snapshot &earlier) const {
+            Snapshot result = *this;
+            if (earlier.counts.empty())
+                return result;
+            for (size_t i = 0; i < BUCKETS; i++)
+                result.counts[i] -= earlier.counts[i];
+            result.count -= earlier.count;
+            result.sum_us -= earlier.sum_us;
+            return result;
+        }
+
+        // Highest value equivalent to the value at percentile p (0..100) in milliseconds, 0 if empty
+        double percentile_ms(double p) const {
+            if (!count)
+                return 0;
+            uint64_t rank = static_cast<uint64_t>(p / 100.0 * count + 0.5);
+            rank = rank ? rank : 1;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKETS; i++) {
+                seen += counts[i];
+                if (seen >= rank)
+                    return bucket_upper_us(i) / 1000.0;
+            }
+            return bucket_upper_us(BUCKETS - 1) / 1000.0;
+        }
+
+        double sum_ms() const {
+            return sum_us / 1000.0;
+        }
+    };
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram &) = delete;
+    LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+    void record(uint64_t us) {
+        Shard &shard = _shards[shard_index()];
+        shard.counts[bucket_index(us)].fetch_add(1, std::memory_order_relaxed);
+        shard.sum_us.fetch_add(us, std::memory_order_relaxed);
+    }
+
+    // Counters are read without stopping writers, so snapshot may miss values recorded concurrently
+    Snapshot snapshot() const {
+        Snapshot result;
+        result.counts.assign(BUCKETS, 0);
+        for (const Shard &shard : _shards) {
+            for (size_t i = 0; i < BUCKETS; i++) {
+                const uint64_t n = shard.counts[i].load(std::memory_order_relaxed);
+                result.counts[i] += n;
+                result.count += n;
+            }
+            result.sum_us += shard.sum_us.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    // Values recorded concurrently may be lost or survive the clear
+    void clear() {
+        for (Shard &shard : _shards) {
+            for (auto &count : shard.counts)
+                count.store(0, std::memory_order_relaxed);
+            shard.sum_us.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static size_t bucket_index(uint64_t us) {
+        if (us < SUB_BUCKETS)
+            return static_cast<size_t>(us);
+        if (us >= (uint64_t(1) << VALUE_BITS))
+            us = (uint64_t(1) << VALUE_BITS) - 1;
+        const unsigned magnitude = 63 - __builtin_clzll(us);
+        const unsigned shift = magnitude - SUB_BUCKET_BITS;
+        return SUB_BUCKETS * (shift + 1) + static_cast<size_t>((us >> shift) - SUB_BUCKETS);
+    }
+
+    static uint64_t bucket_upper_us(size_t index) {
+        if (index < SUB_BUCKETS)
+            return index;
+        const unsigned shift = static_cast<unsigned>(index / SUB_BUCKETS - 1);
+        const uint64_t sub = SUB_BUCKETS + index % SUB_BUCKETS;
+        return ((sub + 1) << shift) - 1;
+    }
+
+  private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> counts[BUCKETS] = {};
+        alignas(64) std::atomic<uint64_t> sum_us{0};
+    };
+    Shard _shards[SHARDS];
+
+    // Threads are spread over shards round-robin in order of their first record
+    static size_t shard_index() {
+        static std::atomic<size_t> next_shard{0};
+        static thread_local const size_t index = next_shard.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+        return index;
+    }
+};
@@ -5,9 +5,21 @@
  ******************************************************************************/
 
 #include "latency_tracer.h"
+#include "latency_histogram.h"
 #include "latency_tracer_meta.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
 #include <tuple>
+#include <vector>
 using namespace std;
 
 #define ELEMENT_DESCRIPTION "Latency tracer to calculate time it takes to process each frame for element and pipeline"
@@ -18,12 +30,18 @@ static GstTracerRecord *tr_pipeline;
 static GstTracerRecord *tr_element;
 static GstTracerRecord *tr_element_interval;
 static GstTracerRecord *tr_pipeline_interval;
+static GstTracerRecord *tr_pipeline_percentiles;
+static GstTracerRecord *tr_element_percentiles;
 static guint ns_to_ms = 1000000;
 static guint ms_to_s = 1000;
 using BufferListArgs = tuple<LatencyTracer *, guint64, GstPad *>;
 #define UNUSED(x) (void)(x)
 
 static GQuark data_string = g_quark_from_static_string("latency_tracer");
+static GQuark stream_string = g_quark_from_static_string("latency_tracer_stream");
+
+static constexpr guint MAX_STREAMS = 64;
+static const gdouble percentiles[] = {50, 95, 99, 99.9};
 
 static void latency_tracer_constructed(GObject *object) {
     LatencyTracer *lt = LATENCY_TRACER(object);
@@ -56,14 +74,22 @@ static void latency_tracer_constructed(GObject *object) {
         }
         gst_structure_get_int(params_struct, "interval", &lt->interval);
         GST_INFO_OBJECT(lt, "interval set to %d ms", lt->interval);
+        const gchar *prometheus_file = gst_structure_get_string(params_struct, "prometheus-file");
+        if (prometheus_file) {
+            lt->prometheus_file = g_strdup(prometheus_file);
+            GST_INFO_OBJECT(lt, "latency percentiles are written to %s", lt->prometheus_file);
+        }
         gst_structure_free(params_struct);
     }
     g_free(params);
 }
 
+static void latency_tracer_finalize(GObject *object);
+
 static void latency_tracer_class_init(LatencyTracerClass *klass) {
     GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
     gobject_class->constructed = latency_tracer_constructed;
+    gobject_class->finalize = latency_tracer_finalize;
     tr_pipeline = gst_tracer_record_new(
         "latency_tracer_pipeline.class", "frame_latency", GST_TYPE_STRUCTURE,
         gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_DOUBLE, "description", G_TYPE_STRING,
@@ -148,6 +174,55 @@ static void latency_tracer_class_init(LatencyTracerClass *klass) {
                               gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_DOUBLE, "description",
                                                 G_TYPE_STRING, "Max interval frame latency in ms", NULL),
                               NULL);
+    tr_pipeline_percentiles = gst_tracer_record_new(
+        "latency_tracer_pipeline_percentiles.class", "stream", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_STRING, "description", G_TYPE_STRING,
+                          "Source pad the frames were produced by, all for frames of all sources", NULL),
+        "interval", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_DOUBLE, "description", G_TYPE_STRING, "interval in ms",
+                          NULL),
+        "frame_num", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_UINT64, "description", G_TYPE_STRING,
+                          "Number of frames processed within the interval", NULL),
+        "p50", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_DOUBLE, "description", G_TYPE_STRING,
+                          "Median interval frame latency in ms", NULL),
+        "p95", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_DOUBLE, "description", G_TYPE_STRING,
+                          "95th percentile of interval frame latency in ms", NULL),
+        "p99", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_DOUBLE, "description", G_TYPE_STRING,
+                          "99th percentile of interval frame latency in ms", NULL),
+        "p999", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_DOUBLE, "description", G_TYPE_STRING,
+                          "99.9th percentile of interval frame latency in ms", NULL),
+        NULL);
+    tr_element_percentiles = gst_tracer_record_new(
+        "latency_tracer_element_percentiles.class", "name", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_STRING, "description", G_TYPE_STRING, "Element Name",
+                          NULL),
+        "stream", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_STRING, "description", G_TYPE_STRING,
+                          "Source pad the frames were produced by, all for frames of all sources", NULL),
+        "interval", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_DOUBLE, "description", G_TYPE_STRING, "Interval ms",
+                          NULL),
+        "frame_num", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_UINT64, "description", G_TYPE_STRING,
+                          "Number of frames processed within the interval", NULL),
+        "p50", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_DOUBLE, "description", G_TYPE_STRING,
+                          "Median interval frame latency in ms", NULL),
+        "p95", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_DOUBLE, "description", G_TYPE_STRING,
+                          "95th percentile of interval frame latency in ms", NULL),
+        "p99", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_DOUBLE, "description", G_TYPE_STRING,
+                          "99th percentile of interval frame latency in ms", NULL),
+        "p999", GST_TYPE_STRUCTURE,
+        gst_structure_new("value", "type", G_TYPE_GTYPE, G_TYPE_DOUBLE, "description", G_TYPE_STRING,
+                          "99.9th percentile of interval frame latency in ms", NULL),
+        NULL);
     GST_DEBUG_CATEGORY_INIT(latency_tracer_debug, "latency_tracer", 0, "latency tracer");
 }
 
@@ -167,6 +242,239 @@ static GstElement *get_real_pad_parent(GstPad *pad) {
     return GST_ELEMENT_CAST(parent);
 }
 
+// Percentile histograms of frame latency through an element or the whole pipeline, for all streams and per stream
+struct LatencyHistograms {
+    string name;
+    LatencyHistogram total;
+    array<atomic<LatencyHistogram *>, MAX_STREAMS> streams{};
+    // snapshots taken by the previous dump, accessed under LatencyPercentiles::mtx
+    LatencyHistogram::Snapshot last_total;
+    map<guint, LatencyHistogram::Snapshot> last_streams;
+
+    explicit LatencyHistograms(string name) : name(move(name)) {
+    }
+
+    ~LatencyHistograms() {
+        for (auto &stream : streams)
+            delete stream.load();
+    }
+
+    void record(guint stream_id, GstClockTimeDiff latency) {
+        const guint64 us = latency > 0 ? static_cast<guint64>(latency) / GST_USECOND : 0;
+        total.record(us);
+        if (stream_id >= MAX_STREAMS)
+            return;
+        LatencyHistogram *stream = streams[stream_id].load(memory_order_acquire);
+        if (!stream) {
+            auto *created = new LatencyHistogram();
+            if (streams[stream_id].compare_exchange_strong(stream, created, memory_order_acq_rel))
+                stream = created;
+            else
+                delete created;
+        }
+        stream->record(us);
+    }
+
+    // Keeps stream histograms allocated, so streaming threads holding this object can record any time
+    void clear() {
+        total.clear();
+        for (auto &stream : streams) {
+            if (LatencyHistogram *histogram = stream.load(memory_order_acquire))
+                histogram->clear();
+        }
+        last_total = LatencyHistogram::Snapshot();
+        last_streams.clear();
+    }
+};
+
+// Latency histograms of the pipeline and its elements. Streaming threads only record, a dumper thread running while
+// the pipeline is PLAYING logs tracer records with interval percentiles every interval and optionally writes
+// Prometheus text file with percentiles since start.
+struct LatencyPercentiles {
+    // never replaced, streaming threads record to it without locking
+    LatencyHistograms pipeline{"pipeline"};
+
+    mutex mtx; // guards fields below and dumping
+    map<string, shared_ptr<LatencyHistograms>> elements; // by element name
+    vector<string> streams;                              // source pad names by stream id, pads keep their ids
+    GstClockTime last_dump = 0;
+
+    ~LatencyPercentiles() {
+        stop();
+    }
+
+    // Histograms of element with the given name, the same ones when the pipeline goes to PLAYING again
+    shared_ptr<LatencyHistograms> add_element(const gchar *name) {
+        lock_guard<mutex> guard(mtx);
+        auto &histograms = elements[name];
+        if (!histograms)
+            histograms = make_shared<LatencyHistograms>(name);
+        return histograms;
+    }
+
+    // Drops histograms of the previous run, called when the pipeline goes to NULL state
+    void reset() {
+        lock_guard<mutex> guard(mtx);
+        pipeline.clear();
+        elements.clear();
+    }
+
+    guint stream_id(GstElement *elem, GstPad *pad) {
+        gpointer id = g_object_get_qdata(G_OBJECT(pad), stream_string);
+        if (id)
+            return GPOINTER_TO_UINT(id) - 1;
+        lock_guard<mutex> guard(mtx);
+        id = g_object_get_qdata(G_OBJECT(pad), stream_string);
+        if (id)
+            return GPOINTER_TO_UINT(id) - 1;
+        const guint new_id = streams.size();
+        streams.push_back(string(GST_ELEMENT_NAME(elem)) + "." + GST_PAD_NAME(pad));
+        if (new_id == MAX_STREAMS)
+            GST_WARNING("more than %u streams, latency of next streams is accounted in totals only", MAX_STREAMS);
+        g_object_set_qdata(G_OBJECT(pad), stream_string, GUINT_TO_POINTER(new_id + 1));
+        return new_id;
+    }
+
+    void start(LatencyTracer *lt) {
+        lock_guard<mutex> guard(dumper_mtx);
+        if (dumper.joinable())
+            return;
+        stopping = false;
+        {
+            lock_guard<mutex> dump_guard(mtx);
+            last_dump = gst_util_get_timestamp();
+        }
+        dumper = thread([this, lt] { run_dumper(lt); });
+    }
+
+    // Stops dumper thread, percentiles of the last interval are dumped before it exits
+    void stop() {
+        {
+            lock_guard<mutex> guard(dumper_mtx);
+            stopping = true;
+        }
+        dumper_cond.notify_all();
+        if (dumper.joinable())
+            dumper.join();
+    }
+
+  private:
+    thread dumper;
+    mutex dumper_mtx;
+    condition_variable dumper_cond;
+    bool stopping = false;
+
+    void run_dumper(LatencyTracer *lt) {
+        const chrono::milliseconds period(max(lt->interval, 1));
+        auto deadline = chrono::steady_clock::now() + period;
+        unique_lock<mutex> lock(dumper_mtx);
+        while (!dumper_cond.wait_until(lock, deadline, [this] { return stopping; })) {
+            lock.unlock();
+            dump(lt);
+            lock.lock();
+            deadline += period;
+        }
+        lock.unlock();
+        dump(lt);
+    }
+
+    // Percentiles of one histogram: since the previous dump for tracer records, since start for Prometheus file
+    struct DumpEntry {
+        string name;
+        string stream;
+        bool is_pipeline;
+        LatencyHistogram::Snapshot interval;
+        LatencyHistogram::Snapshot total;
+    };
+
+    // Snapshots are taken under mtx, records are logged and file is written without holding it, so streaming threads
+    // registering new streams in stream_id() never wait for file I/O
+    void dump(LatencyTracer *lt) {
+        vector<DumpEntry> entries;
+        gdouble interval;
+        {
+            lock_guard<mutex> guard(mtx);
+            const GstClockTime now = gst_util_get_timestamp();
+            interval = (gdouble)GST_CLOCK_DIFF(last_dump, now) / ns_to_ms;
+            last_dump = now;
+            take_snapshots(pipeline, true, entries);
+            for (auto &element : elements)
+                take_snapshots(*element.second, false, entries);
+        }
+        for (const DumpEntry &entry : entries) {
+            const LatencyTracerFlags flag =
+                entry.is_pipeline ? LATENCY_TRACER_FLAG_PIPELINE : LATENCY_TRACER_FLAG_ELEMENT;
+            if (lt->flags & flag)
+                log_interval(entry.name, entry.stream, interval, entry.interval, entry.is_pipeline);
+        }
+        if (lt->prometheus_file)
+            write_prometheus(lt, entries);
+    }
+
+    void take_snapshots(LatencyHistograms &histograms, bool is_pipeline, vector<DumpEntry> &entries) {
+        LatencyHistogram::Snapshot snapshot = histograms.total.snapshot();
+        entries.push_back({histograms.name, "all", is_pipeline, snapshot.since(histograms.last_total), snapshot});
+        histograms.last_total = move(snapshot);
+        if (streams.size() < 2) // totals are the only stream
+            return;
+        for (guint id = 0; id < streams.size() && id < MAX_STREAMS; id++) {
+            LatencyHistogram *stream = histograms.streams[id].load(memory_order_acquire);
+            if (!stream)
+                continue;
+            snapshot = stream->snapshot();
+            entries.push_back(
+                {histograms.name, streams[id], is_pipeline, snapshot.since(histograms.last_streams[id]), snapshot});
+            histograms.last_streams[id] = move(snapshot);
+        }
+    }
+
+    static void log_interval(const string &name, const string &stream, gdouble interval,
+                             const LatencyHistogram::Snapshot &snapshot, bool is_pipeline) {
+        if (!snapshot.count)
+            return;
+        const guint64 count = snapshot.count;
+        if (is_pipeline)
+            gst_tracer_record_log(tr_pipeline_percentiles, stream.c_str(), interval, count,
+                                  snapshot.percentile_ms(percentiles[0]), snapshot.percentile_ms(percentiles[1]),
+                                  snapshot.percentile_ms(percentiles[2]), snapshot.percentile_ms(percentiles[3]));
+        else
+            gst_tracer_record_log(tr_element_percentiles, name.c_str(), stream.c_str(), interval, count,
+                                  snapshot.percentile_ms(percentiles[0]), snapshot.percentile_ms(percentiles[1]),
+                                  snapshot.percentile_ms(percentiles[2]), snapshot.percentile_ms(percentiles[3]));
+    }
+
+    static void write_summary(ofstream &out, const string &element, const string &stream,
+                              const LatencyHistogram::Snapshot &snapshot) {
+        if (!snapshot.count)
+            return;
+        const string labels = "element=\"" + element + "\",stream=\"" + stream + "\"";
+        for (gdouble p : percentiles)
+            out << "dlstreamer_latency_milliseconds{" << labels << ",quantile=\"" << p / 100 << "\"} "
+                << snapshot.percentile_ms(p) << "\n";
+        out << "dlstreamer_latency_milliseconds_sum{" << labels << "} " << snapshot.sum_ms() << "\n";
+        out << "dlstreamer_latency_milliseconds_count{" << labels << "} " << snapshot.count << "\n";
+    }
+
+    // Percentiles since start, written to temporary file and renamed so scrapers never read partial file
+    static void write_prometheus(LatencyTracer *lt, const vector<DumpEntry> &entries) {
+        const string path = lt->prometheus_file;
+        const string tmp_path = path + ".tmp";
+        {
+            ofstream out(tmp_path);
+            out << "# HELP dlstreamer_latency_milliseconds Frame latency of the pipeline and its elements\n";
+            out << "# TYPE dlstreamer_latency_milliseconds summary\n";
+            for (const DumpEntry &entry : entries)
+                write_summary(out, entry.name, entry.stream, entry.total);
+            if (!out.flush()) {
+                GST_WARNING_OBJECT(lt, "couldn't write %s", tmp_path.c_str());
+                return;
+            }
+        }
+        if (rename(tmp_path.c_str(), path.c_str()) != 0)
+            GST_WARNING_OBJECT(lt, "couldn't write %s", path.c_str());
+    }
+};
+
 struct ElementStats {
     gboolean is_bin;
     gdouble total;
@@ -179,10 +487,12 @@ struct ElementStats {
     gdouble interval_max;
     guint interval_frame_count;
     GstClockTime interval_init_time;
+    shared_ptr<LatencyHistograms> histograms;
     mutex mtx;
 
-    static void create(GstElement *elem, guint64 ts) {
+    static void create(LatencyTracer *lt, GstElement *elem, guint64 ts) {
         auto *stats = new ElementStats{elem, ts};
+        stats->histograms = lt->percentiles->add_element(stats->name);
         g_object_set_qdata_full(reinterpret_cast<GObject *>(elem), data_string, stats,
                                 [](gpointer data) { delete static_cast<ElementStats *>(data); });
     }
@@ -297,7 +607,7 @@ static void cal_log_pipeline_latency(LatencyTracer *lt, guint64 ts, LatencyTrace
 }
 
 static void add_latency_meta(LatencyTracer *lt, LatencyTracerMeta *meta, guint64 ts, GstBuffer *buffer,
-                             GstElement *elem) {
+                             GstElement *elem, GstPad *pad) {
     if (!gst_buffer_is_writable(buffer)) {
         GST_ERROR_OBJECT(lt, "buffer not writable, unable to add LatencyTracerMeta at element=%s, ts=%ld, buffer=%p",
                          GST_ELEMENT_NAME(elem), ts, buffer);
@@ -306,6 +616,7 @@ static void add_latency_meta(LatencyTracer *lt, LatencyTracerMeta *meta, guint64
     meta = LATENCY_TRACER_META_ADD(buffer);
     meta->init_ts = ts;
     meta->last_pad_push_ts = ts;
+    meta->stream_id = lt->percentiles->stream_id(elem, pad);
     if (lt->first_frame_init_ts == 0) {
         reset_pipeline_interval(lt, ts);
         lt->first_frame_init_ts = ts;
@@ -318,17 +629,19 @@ static void do_push_buffer_pre(LatencyTracer *lt, guint64 ts, GstPad *pad, GstBu
         return;
     LatencyTracerMeta *meta = LATENCY_TRACER_META_GET(buffer);
     if (!meta) {
-        add_latency_meta(lt, meta, ts, buffer, elem);
+        add_latency_meta(lt, meta, ts, buffer, elem, pad);
         return;
     }
     if (lt->flags & LATENCY_TRACER_FLAG_ELEMENT) {
         ElementStats *stats = ElementStats::from_element(elem);
         if (stats != nullptr) {
+            stats->histograms->record(meta->stream_id, GST_CLOCK_DIFF(meta->last_pad_push_ts, ts));
             stats->cal_log_element_latency(ts, meta->last_pad_push_ts, lt->interval);
             meta->last_pad_push_ts = ts;
         }
     }
     if (lt->flags & LATENCY_TRACER_FLAG_PIPELINE && lt->sink_element == get_real_pad_parent(GST_PAD_PEER(pad))) {
+        lt->percentiles->pipeline.record(meta->stream_id, GST_CLOCK_DIFF(meta->init_ts, ts));
         cal_log_pipeline_latency(lt, ts, meta);
     }
 }
@@ -338,7 +651,7 @@ static void do_pull_range_post(LatencyTracer *lt, guint64 ts, GstPad *pad, GstBu
     if (!is_parent_pipeline(lt, elem))
         return;
     LatencyTracerMeta *meta = nullptr;
-    add_latency_meta(lt, meta, ts, buffer, elem);
+    add_latency_meta(lt, meta, ts, buffer, elem, pad);
 }
 
 static void do_push_buffer_list_pre(LatencyTracer *lt, guint64 ts, GstPad *pad, GstBufferList *list) {
@@ -371,14 +684,22 @@ static void on_element_change_state_post(LatencyTracer *lt, guint64 ts, GstEleme
             if (GST_OBJECT_FLAG_IS_SET(element, GST_ELEMENT_FLAG_SINK))
                 lt->sink_element = element;
             else if (!GST_OBJECT_FLAG_IS_SET(element, GST_ELEMENT_FLAG_SOURCE)) {
-                ElementStats::create(element, ts);
+                ElementStats::create(lt, element, ts);
             }
         }
         GstTracer *tracer = GST_TRACER(lt);
         gst_tracing_register_hook(tracer, "pad-push-pre", G_CALLBACK(do_push_buffer_pre));
         gst_tracing_register_hook(tracer, "pad-push-list-pre", G_CALLBACK(do_push_buffer_list_pre));
         gst_tracing_register_hook(tracer, "pad-pull-range-post", G_CALLBACK(do_pull_range_post));
+        lt->percentiles->start(lt);
     }
+    if (elem != lt->pipeline)
+        return;
+    // percentiles of the last interval are dumped when dumper stops
+    if (change == GST_STATE_CHANGE_PLAYING_TO_PAUSED)
+        lt->percentiles->stop();
+    else if (change == GST_STATE_CHANGE_READY_TO_NULL)
+        lt->percentiles->reset();
 }
 static void on_element_new(LatencyTracer *lt, guint64 ts, GstElement *elem) {
     UNUSED(ts);
@@ -402,6 +723,8 @@ static void latency_tracer_init(LatencyTracer *lt) {
     lt->max = 0;
     lt->flags = static_cast<LatencyTracerFlags>(LATENCY_TRACER_FLAG_ELEMENT | LATENCY_TRACER_FLAG_PIPELINE);
     lt->interval = 1000;
+    lt->prometheus_file = nullptr;
+    lt->percentiles = new LatencyPercentiles();
 
     GstTracer *tracer = GST_TRACER(lt);
     gst_tracing_register_hook(tracer, "element-new", G_CALLBACK(on_element_new));
@@ -409,6 +732,13 @@ static void latency_tracer_init(LatencyTracer *lt) {
     GST_OBJECT_UNLOCK(lt);
 }
 
+static void latency_tracer_finalize(GObject *object) {
+    LatencyTracer *lt = LATENCY_TRACER(object);
+    delete lt->percentiles;
+    g_free(lt->prometheus_file);
+    G_OBJECT_CLASS(latency_tracer_parent_class)->finalize(object);
+}
+
 static gboolean plugin_init(GstPlugin *plugin) {
     if (!gst_tracer_register(plugin, "latency_tracer", latency_tracer_get_type()))
         return false;
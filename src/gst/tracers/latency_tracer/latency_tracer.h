@@ -41,6 +41,8 @@ struct LatencyTracer {
     gint interval;
     GstClockTime first_frame_init_ts;
     LatencyTracerFlags flags;
+    gchar *prometheus_file;
+    struct LatencyPercentiles *percentiles;
 };
 
 struct LatencyTracerClass {
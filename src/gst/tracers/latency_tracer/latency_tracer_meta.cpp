@@ -21,6 +21,7 @@ gboolean latency_tracer_meta_init(GstMeta *meta, gpointer params, GstBuffer *buf
     LatencyTracerMeta *tracer_meta = (LatencyTracerMeta *)meta;
     tracer_meta->init_ts = 0;
     tracer_meta->last_pad_push_ts = 0;
+    tracer_meta->stream_id = 0;
     return TRUE;
 }
 
@@ -35,6 +36,7 @@ gboolean latency_tracer_meta_transform(GstBuffer *dest_buf, GstMeta *src_meta, G
     LatencyTracerMeta *src = (LatencyTracerMeta *)src_meta;
     dst->init_ts = src->init_ts;
     dst->last_pad_push_ts = src->last_pad_push_ts;
+    dst->stream_id = src->stream_id;
     return TRUE;
 }
 
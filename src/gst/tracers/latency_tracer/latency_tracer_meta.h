@@ -28,6 +28,7 @@ struct _LatencyTracerMeta {
     GstMeta meta; /**< parent GstMeta */
     GstClockTime init_ts;
     GstClockTime last_pad_push_ts;
+    guint stream_id; /**< index of the source pad the buffer was produced by */
 };
 
 /**
@@ -8,7 +8,10 @@
 
 #include "dlstreamer/base/dictionary.h"
 #include "dlstreamer/element.h"
-#include <gst/base/gstbasetransform.h>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
 
 namespace dlstreamer {
@@ -33,26 +36,66 @@ class SharedInstance {
         }
     };
 
-    ElementPtr init_or_reuse(const InstanceId &id, ElementPtr element, std::function<void()> init) {
-        // This code path is work in progress and not active in DLStreamer architecture 1.0
-        assert(false);
+    // Element shared by several GStreamer elements, usually in different streams. Calls into the element from
+    // streaming threads are serialized with 'mutex'.
+    struct Instance {
+        ElementPtr element;
+        std::shared_ptr<std::mutex> mutex;
+    };
 
-        std::lock_guard<std::mutex> guard(_mutex);
-        auto it = _shared_elements.find(id);
-        if (it != _shared_elements.end()) {
-            return it->second;
-        } else {
-            if (init)
-                init();
-            _shared_elements.insert({id, element});
-            return element;
+    /**
+     * Returns instance registered with same id, or registers 'element' and calls 'init' for it. 'init' is called only
+     * by the caller that registered the element, concurrent callers with same id wait until it completes. If 'init'
+     * throws, the element is not registered and the exception is re-thrown, waiting callers then try to register their
+     * own elements.
+     */
+    Instance acquire(const InstanceId &id, ElementPtr element, std::function<void()> init) {
+        for (;;) {
+            std::shared_ptr<Entry> entry;
+            bool registered = false;
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
+                auto it = _shared_elements.find(id);
+                if (it == _shared_elements.end()) {
+                    it = _shared_elements.insert({id, std::make_shared<Entry>(element)}).first;
+                    registered = true;
+                }
+                entry = it->second;
+            }
+
+            if (registered) {
+                // Initialize out of locks, so instances with other ids are not blocked by slow init (model loading)
+                try {
+                    if (init)
+                        init();
+                } catch (...) {
+                    {
+                        std::lock_guard<std::mutex> guard(_mutex);
+                        _shared_elements.erase(id);
+                    }
+                    set_state(*entry, &Entry::failed);
+                    throw;
+                }
+                set_state(*entry, &Entry::initialized);
+                return {entry->element, entry->mutex};
+            }
+
+            std::unique_lock<std::mutex> entry_lock(*entry->mutex);
+            entry->state_changed.wait(entry_lock, [&] { return entry->initialized || entry->failed; });
+            if (entry->failed)
+                continue; // registered by other caller whose init failed, try again
+            return {entry->element, entry->mutex};
         }
     }
 
+    ElementPtr init_or_reuse(const InstanceId &id, ElementPtr element, std::function<void()> init) {
+        return acquire(id, element, init).element;
+    }
+
     void clean_up() {
         std::lock_guard<std::mutex> guard(_mutex);
         for (auto it = _shared_elements.cbegin(); it != _shared_elements.cend();) {
-            if (it->second.use_count() == 1) { // no other references
+            if (it->second->element.use_count() == 1) { // no other references
                 it = _shared_elements.erase(it);
             } else {
                 ++it;
@@ -65,7 +108,26 @@ class SharedInstance {
     }
 
   private:
-    std::map<InstanceId, ElementPtr> _shared_elements;
+    struct Entry {
+        explicit Entry(ElementPtr element) : element(std::move(element)) {
+        }
+
+        ElementPtr element;
+        std::shared_ptr<std::mutex> mutex = std::make_shared<std::mutex>();
+        std::condition_variable state_changed;
+        bool initialized = false;
+        bool failed = false;
+    };
+
+    static void set_state(Entry &entry, bool Entry::*state) {
+        {
+            std::lock_guard<std::mutex> entry_guard(*entry.mutex);
+            entry.*state = true;
+        }
+        entry.state_changed.notify_all();
+    }
+
+    std::map<InstanceId, std::shared_ptr<Entry>> _shared_elements;
     std::mutex _mutex;
 };
 
@@ -7,6 +7,7 @@
 #include "ov_inference.h"
 #include "audio_defs.h"
 #include "core_singleton.h"
+#include "dlstreamer/openvino/model_cache.h"
 #include "dlstreamer/openvino/utils.h"
 #include "dlstreamer/tensor_info.h"
 #include "dlstreamer/utils.h"
@@ -94,7 +95,9 @@ OpenVINOAudioInference::OpenVINOAudioInference(const std::string &model_path, co
     // if (!InferenceBackend::ModelLoader::is_valid_model_path(model_path))
     //     throw std::runtime_error("Invalid model path.");
 
-    _model = _core.read_model(model_path);
+    // model isn't modified, so shared model is used without copying
+    auto &cache = OpenVINOModelCache::instance();
+    _model = cache.read_model(model_path);
     infOutput.model_name = _model->get_friendly_name();
 
     // std::cout << "Params for compile_model:\n";
@@ -102,7 +105,13 @@ OpenVINOAudioInference::OpenVINOAudioInference(const std::string &model_path, co
     // auto ov_params = string_to_openvino_map(config);
     // adjust_ie_config(ov_params); // TODO Do we need it?
     // _compiled_model = _core.compile_model(_model, device, ov_params);
-    _compiled_model = _core.compile_model(_model, device);
+    auto result = cache.compile_model(_model, model_path, "", device, {});
+    if (!result.blob_error.empty())
+        GVA_WARNING("Model cache directory is not used: %s", result.blob_error.c_str());
+    GVA_INFO("Model %s loaded to device %s in %lld ms (%s)", model_path.c_str(), device.c_str(),
+             static_cast<long long>(result.duration.count()), OpenVINOModelCache::source_name(result.source));
+    _compiled_model = result.compiled_model;
+    _compiled_model_reference = result.reference;
     _infer_request = _compiled_model.create_infer_request();
 
     _model_input_info = FrameInfo(MediaType::Tensors);
@@ -28,9 +28,9 @@ class OpenVINOAudioInference {
   private:
     void CreateRemoteContext(const std::string &device);
 
-    ov::Core _core;
-    std::shared_ptr<ov::Model> _model;
+    std::shared_ptr<const ov::Model> _model;
     ov::CompiledModel _compiled_model;
+    std::shared_ptr<const void> _compiled_model_reference; // keeps _compiled_model shared with other elements
     ov::InferRequest _infer_request;
 
     dlstreamer::FrameInfo _model_input_info;
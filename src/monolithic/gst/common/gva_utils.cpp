@@ -23,6 +23,39 @@ void set_object_id(GstVideoRegionOfInterestMeta *meta, gint id) {
     gst_video_region_of_interest_meta_add_param(meta, object_id);
 }
 
+GstEvent *gva_event_new_objects_removed(const gint *object_ids, guint count) {
+    GValue ids = G_VALUE_INIT;
+    g_value_init(&ids, GST_TYPE_ARRAY);
+    GValue id = G_VALUE_INIT;
+    g_value_init(&id, G_TYPE_INT);
+    for (guint i = 0; i < count; i++) {
+        g_value_set_int(&id, object_ids[i]);
+        gst_value_array_append_value(&ids, &id);
+    }
+    g_value_unset(&id);
+
+    GstStructure *structure = gst_structure_new_empty(GVA_OBJECTS_REMOVED_EVENT_NAME);
+    gst_structure_take_value(structure, "object_ids", &ids);
+    return gst_event_new_custom(GST_EVENT_CUSTOM_DOWNSTREAM, structure);
+}
+
+gboolean gva_event_parse_objects_removed(GstEvent *event, GArray **object_ids) {
+    if (GST_EVENT_TYPE(event) != GST_EVENT_CUSTOM_DOWNSTREAM ||
+        !gst_event_has_name(event, GVA_OBJECTS_REMOVED_EVENT_NAME))
+        return FALSE;
+    const GValue *ids = gst_structure_get_value(gst_event_get_structure(event), "object_ids");
+    if (!ids || !GST_VALUE_HOLDS_ARRAY(ids))
+        return FALSE;
+
+    const guint count = gst_value_array_get_size(ids);
+    *object_ids = g_array_sized_new(FALSE, FALSE, sizeof(gint), count);
+    for (guint i = 0; i < count; i++) {
+        gint id = g_value_get_int(gst_value_array_get_value(ids, i));
+        g_array_append_val(*object_ids, id);
+    }
+    return TRUE;
+}
+
 void gva_buffer_check_and_make_writable(GstBuffer **buffer, const char *called_function_name) {
     assert(called_function_name);
 
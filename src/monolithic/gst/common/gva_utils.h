@@ -19,6 +19,12 @@ void set_object_id(GstVideoRegionOfInterestMeta *meta, gint id);
 
 void gva_buffer_check_and_make_writable(GstBuffer **buffer, const char *called_function_name);
 
+/* Serialized downstream event sent by tracker with ids of objects that are no longer tracked */
+#define GVA_OBJECTS_REMOVED_EVENT_NAME "gva-objects-removed"
+GstEvent *gva_event_new_objects_removed(const gint *object_ids, guint count);
+/* Returns TRUE and object ids (free with g_array_unref) if event is objects removed event */
+gboolean gva_event_parse_objects_removed(GstEvent *event, GArray **object_ids);
+
 G_END_DECLS
 
 #define GST_VIDEO_REGION_OF_INTEREST_META_ITERATE(buf, state)                                                          \
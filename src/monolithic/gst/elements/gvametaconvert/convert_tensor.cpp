@@ -6,6 +6,8 @@
 
 #include "convert_tensor.h"
 
+#include <cstring>
+
 using json = nlohmann::json;
 
 template <typename T>
@@ -102,3 +104,91 @@ json convert_tensor(const GVA::Tensor &s_tensor) {
 
     return jobject;
 }
+
+namespace {
+
+void write_string_array(MetaWriter &writer, const GVA::Tensor &tensor, const char *fieldname) {
+    GValueArray *valueArray = nullptr;
+    gst_structure_get_array(tensor.gst_structure(), fieldname, &valueArray);
+    if (!valueArray)
+        return;
+
+    if (valueArray->n_values) {
+        writer.key(fieldname);
+        writer.begin_array();
+        for (guint i = 0; i < valueArray->n_values; ++i) {
+            const gchar *value = g_value_get_string(valueArray->values + i);
+            writer.string(value ? value : "");
+        }
+        writer.end_array();
+    }
+    g_value_array_free(valueArray);
+}
+
+template <typename T, typename Write>
+void write_data(MetaWriter &writer, const void *data, gsize size, Write write) {
+    const size_t count = size / sizeof(T);
+    if (!data || !count)
+        return;
+    writer.key("data");
+    writer.begin_array();
+    for (size_t i = 0; i < count; i++) {
+        T value;
+        std::memcpy(&value, static_cast<const char *>(data) + i * sizeof(T), sizeof(T));
+        write(value);
+    }
+    writer.end_array();
+}
+
+} // namespace
+
+void write_tensor(MetaWriter &writer, const GVA::Tensor &s_tensor) {
+    // Members are written in key order, the order of serialized JSON objects
+    writer.begin_object();
+    if (s_tensor.has_field("confidence")) {
+        writer.key("confidence");
+        writer.number(s_tensor.confidence());
+    }
+
+    gsize size = 0;
+    const void *data = gva_get_tensor_data(s_tensor.gst_structure(), &size);
+    if (s_tensor.precision() == GVA::Tensor::Precision::U8)
+        write_data<uint8_t>(writer, data, size, [&](uint8_t value) { writer.unsigned_integer(value); });
+    else
+        write_data<float>(writer, data, size, [&](float value) { writer.number(value); });
+
+    if (s_tensor.has_field("dims")) {
+        writer.key("dims");
+        const std::vector<guint> dims = s_tensor.dims();
+        if (dims.empty()) {
+            writer.null();
+        } else {
+            writer.begin_array();
+            for (guint dim : dims)
+                writer.unsigned_integer(dim);
+            writer.end_array();
+        }
+    }
+
+    auto write_if_not_empty = [&](const char *key, const std::string &value) {
+        if (!value.empty()) {
+            writer.key(key);
+            writer.string(value);
+        }
+    };
+    write_if_not_empty("format", s_tensor.format());
+    if (!s_tensor.is_detection())
+        write_if_not_empty("label", s_tensor.label());
+    if (s_tensor.has_field("label_id")) {
+        writer.key("label_id");
+        writer.integer(s_tensor.get_int("label_id"));
+    }
+    write_if_not_empty("layer_name", s_tensor.layer_name());
+    write_if_not_empty("layout", s_tensor.layout_as_string());
+    write_if_not_empty("model_name", s_tensor.model_name());
+    write_if_not_empty("name", s_tensor.name());
+    write_string_array(writer, s_tensor, "point_connections");
+    write_string_array(writer, s_tensor, "point_names");
+    write_if_not_empty("precision", s_tensor.precision_as_string());
+    writer.end_object();
+}
@@ -6,9 +6,12 @@
 
 #pragma once
 #include "gva_utils.h"
+#include "meta_writer.h"
 #include "tensor.h"
 #include <iomanip>
 #include <iostream>
 #include <nlohmann/json.hpp>
 
-nlohmann::json convert_tensor(const GVA::Tensor &s_tensor);
\ No newline at end of file
+nlohmann::json convert_tensor(const GVA::Tensor &s_tensor);
+// Writes the same object as convert_tensor() without building it
+void write_tensor(MetaWriter &writer, const GVA::Tensor &s_tensor);
\ No newline at end of file
@@ -60,6 +60,8 @@ static guint gst_interpret_signals[LAST_SIGNAL] = {0};
 
 #define FORMAT_JSON_NAME "json"
 #define FORMAT_DUMP_DETECTION_NAME "dump-detection"
+#define FORMAT_CBOR_NAME "cbor"
+#define FORMAT_MSGPACK_NAME "msgpack"
 
 enum {
     PROP_0,
@@ -78,6 +80,10 @@ static const gchar *format_type_to_string(GstGVAMetaconvertFormatType format) {
         return FORMAT_JSON_NAME;
     case GST_GVA_METACONVERT_DUMP_DETECTION:
         return FORMAT_DUMP_DETECTION_NAME;
+    case GST_GVA_METACONVERT_CBOR:
+        return FORMAT_CBOR_NAME;
+    case GST_GVA_METACONVERT_MSGPACK:
+        return FORMAT_MSGPACK_NAME;
     default:
         return UNKNOWN_VALUE_NAME;
     }
@@ -94,6 +100,9 @@ GType gst_gva_metaconvert_get_format(void) {
     static const GEnumValue format_types[] = {
         {GST_GVA_METACONVERT_JSON, "Conversion to GstGVAJSONMeta", FORMAT_JSON_NAME},
         {GST_GVA_METACONVERT_DUMP_DETECTION, "Dump detection to GST debug log", FORMAT_DUMP_DETECTION_NAME},
+        {GST_GVA_METACONVERT_CBOR, "Conversion to CBOR attached as frame tensor named 'metadata'", FORMAT_CBOR_NAME},
+        {GST_GVA_METACONVERT_MSGPACK, "Conversion to MessagePack attached as frame tensor named 'metadata'",
+         FORMAT_MSGPACK_NAME},
         {0, NULL, NULL}};
 
     if (!gva_metaconvert_format_type) {
@@ -149,7 +158,9 @@ static void gst_gva_meta_convert_class_init(GstGvaMetaConvertClass *klass) {
                                     g_param_spec_enum("format", "Format",
                                                       "Output format for conversion. Enum: (1) "
                                                       "json GstGVAJSONMeta representing inference results. For "
-                                                      "details on the schema please see the user guide.",
+                                                      "details on the schema please see the user guide. "
+                                                      "(3) cbor, (4) msgpack the same document in binary encoding "
+                                                      "attached to the frame as tensor named 'metadata'.",
                                                       GST_TYPE_GVA_METACONVERT_FORMAT, DEFAULT_FORMAT,
                                                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
@@ -207,6 +218,8 @@ static void gst_gva_meta_convert_cleanup(GstGvaMetaConvert *gvametaconvert) {
     gvametaconvert->source = NULL;
     g_free(gvametaconvert->tags);
     gvametaconvert->tags = NULL;
+    release_meta_convert_serializer(gvametaconvert->serializer);
+    gvametaconvert->serializer = NULL;
     if (gvametaconvert->info) {
         gst_video_info_free(gvametaconvert->info);
         gvametaconvert->info = NULL;
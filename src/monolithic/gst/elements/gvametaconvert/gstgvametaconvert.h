@@ -32,8 +32,12 @@ typedef gboolean (*convert_function_type)(GstGvaMetaConvert *converter, GstBuffe
 typedef enum {
     GST_GVA_METACONVERT_JSON,
     GST_GVA_METACONVERT_DUMP_DETECTION,
+    GST_GVA_METACONVERT_CBOR,
+    GST_GVA_METACONVERT_MSGPACK,
 } GstGVAMetaconvertFormatType;
 
+struct MetaConvertSerializer;
+
 struct _GstGvaMetaConvert {
     GstBaseTransform base_gvametaconvert;
 
@@ -49,6 +53,7 @@ struct _GstGvaMetaConvert {
     GstAudioInfo *audio_info;
 #endif
     gint json_indent;
+    struct MetaConvertSerializer *serializer;
 };
 
 struct _GstGvaMetaConvertClass {
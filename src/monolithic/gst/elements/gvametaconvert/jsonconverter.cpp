@@ -1,11 +1,12 @@
 /*******************************************************************************
- * Copyright (C) 2018-2022 Intel Corporation
+ * Copyright (C) 2018-2024 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  ******************************************************************************/
 
 #include "jsonconverter.h"
 #include "gva_utils.h"
+#include "meta_writer.h"
 #include "video_frame.h"
 #include <utils.h>
 
@@ -18,258 +19,405 @@
 
 #include <iomanip>
 #include <iostream>
+#include <memory>
 
 using json = nlohmann::json;
 
 GST_DEBUG_CATEGORY_STATIC(gst_json_converter_debug);
 #define GST_CAT_DEFAULT gst_json_converter_debug
 
-namespace {
 /**
- * @return JSON object which contains parameters such as resolution, timestamp, source and tags.
+ * Per-element serialization state: buffer reused between frames and tags property parsed once per value.
  */
-json get_frame_data(GstGvaMetaConvert *converter, GstBuffer *buffer) {
-    assert(converter && buffer && "Expected valid pointers GstGvaMetaConvert and GstBuffer");
+struct MetaConvertSerializer {
+    MetaWriter writer;
+
+    // Returns tags encoded for the writer, nullptr if tags are not set or are not a valid JSON
+    const std::string *encoded_tags(const gchar *tags, MetaWriter::Encoding encoding, int indent) {
+        if (!tags)
+            return nullptr;
+        if (!tags_parsed || tags_source != tags) {
+            tags_source = tags;
+            tags_parsed = true;
+            tags_valid = json::accept(tags_source);
+            tags_value = tags_valid ? json::parse(tags_source) : json();
+            tags_encoded.clear();
+            tags_encoded_valid = false;
+        }
+        if (!tags_valid)
+            return nullptr;
+
+        if (!tags_encoded_valid || tags_encoding != encoding || tags_indent != indent) {
+            std::vector<uint8_t> bytes;
+            switch (encoding) {
+            case MetaWriter::Encoding::Json:
+                tags_encoded = tags_value.dump(indent);
+                break;
+            case MetaWriter::Encoding::Cbor:
+                bytes = json::to_cbor(tags_value);
+                tags_encoded.assign(bytes.begin(), bytes.end());
+                break;
+            case MetaWriter::Encoding::MsgPack:
+                bytes = json::to_msgpack(tags_value);
+                tags_encoded.assign(bytes.begin(), bytes.end());
+                break;
+            }
+            tags_encoding = encoding;
+            tags_indent = indent;
+            tags_encoded_valid = true;
+        }
+        return &tags_encoded;
+    }
 
-    json res = json::object();
-    GstSegment converter_segment = converter->base_gvametaconvert.segment;
-    GstClockTime timestamp = gst_segment_to_stream_time(&converter_segment, GST_FORMAT_TIME, buffer->pts);
-    if (converter->info)
-        res["resolution"] = json::object({{"width", converter->info->width}, {"height", converter->info->height}});
-    if (converter->source)
-        res["source"] = converter->source;
-    if (timestamp != G_MAXUINT64)
-        res["timestamp"] = timestamp;
-    if (converter->tags && json::accept(converter->tags))
-        res["tags"] = json::parse(converter->tags);
-    return res;
+  private:
+    std::string tags_source;
+    bool tags_parsed = false;
+    bool tags_valid = false;
+    json tags_value;
+
+    std::string tags_encoded;
+    bool tags_encoded_valid = false;
+    MetaWriter::Encoding tags_encoding = MetaWriter::Encoding::Json;
+    int tags_indent = -1;
+};
+
+namespace {
+
+constexpr auto BINARY_META_TENSOR_NAME = "metadata";
+
+const char *encoding_to_string(MetaWriter::Encoding encoding) {
+    switch (encoding) {
+    case MetaWriter::Encoding::Cbor:
+        return "cbor";
+    case MetaWriter::Encoding::MsgPack:
+        return "msgpack";
+    default:
+        return "json";
+    }
 }
 
 /**
- * @return JSON array which contains ROIs attributes and their detection results.
- * Also contains ROIs classification results if any.
+ * Writes resolution, timestamp, source and tags of the frame.
  */
-json convert_roi_detection(GstGvaMetaConvert *converter, GstBuffer *buffer) {
+void write_frame_data(MetaConvertSerializer &serializer, GstGvaMetaConvert *converter, GstBuffer *buffer) {
     assert(converter && buffer && "Expected valid pointers GstGvaMetaConvert and GstBuffer");
+    MetaWriter &writer = serializer.writer;
+
+    if (converter->info) {
+        writer.key("resolution");
+        writer.begin_object();
+        writer.key("height");
+        writer.integer(converter->info->height);
+        writer.key("width");
+        writer.integer(converter->info->width);
+        writer.end_object();
+    }
+    if (converter->source) {
+        writer.key("source");
+        writer.string(converter->source);
+    }
+    const std::string *tags = serializer.encoded_tags(converter->tags, writer.encoding(), converter->json_indent);
+    if (tags) {
+        writer.key("tags");
+        writer.raw(*tags);
+    }
+}
 
-    json res = json::array();
-    GVA::VideoFrame video_frame(buffer, converter->info);
-    for (GVA::RegionOfInterest &roi : video_frame.regions()) {
-        gint id = 0;
-        get_object_id(roi._meta(), &id);
+void write_frame_timestamp(MetaWriter &writer, GstGvaMetaConvert *converter, GstBuffer *buffer) {
+    GstSegment converter_segment = converter->base_gvametaconvert.segment;
+    GstClockTime timestamp = gst_segment_to_stream_time(&converter_segment, GST_FORMAT_TIME, buffer->pts);
+    if (timestamp != G_MAXUINT64) {
+        writer.key("timestamp");
+        writer.unsigned_integer(timestamp);
+    }
+}
 
-        json jobject = json::object();
+void write_detection(MetaWriter &writer, GstVideoRegionOfInterestMeta *meta, GstStructure *s) {
+    double xminval;
+    double xmaxval;
+    double yminval;
+    double ymaxval;
+    double confidence;
+    int label_id;
+    if (!gst_structure_get(s, "x_min", G_TYPE_DOUBLE, &xminval, "x_max", G_TYPE_DOUBLE, &xmaxval, "y_min",
+                           G_TYPE_DOUBLE, &yminval, "y_max", G_TYPE_DOUBLE, &ymaxval, NULL))
+        return;
+
+    writer.key("detection");
+    writer.begin_object();
+    writer.key("bounding_box");
+    writer.begin_object();
+    writer.key("x_max");
+    writer.number(xmaxval);
+    writer.key("x_min");
+    writer.number(xminval);
+    writer.key("y_max");
+    writer.number(ymaxval);
+    writer.key("y_min");
+    writer.number(yminval);
+    writer.end_object();
+
+    if (gst_structure_get(s, "confidence", G_TYPE_DOUBLE, &confidence, NULL)) {
+        writer.key("confidence");
+        writer.number(confidence);
+    }
+    const gchar *label = g_quark_to_string(meta->roi_type);
+    if (label) {
+        writer.key("label");
+        writer.string(label);
+    }
+    if (gst_structure_get(s, "label_id", G_TYPE_INT, &label_id, NULL)) {
+        writer.key("label_id");
+        writer.integer(label_id);
+    }
+    writer.end_object();
+}
 
-        if (converter->add_tensor_data) {
-            jobject["tensors"] = json::array();
-        }
+void write_classification(MetaWriter &writer, GstStructure *s) {
+    char *label = nullptr;
+    char *model_name = nullptr;
+    const gboolean found =
+        gst_structure_get(s, "label", G_TYPE_STRING, &label, "model_name", G_TYPE_STRING, &model_name, NULL);
+    std::unique_ptr<char, decltype(&g_free)> label_holder(label, g_free);
+    std::unique_ptr<char, decltype(&g_free)> model_name_holder(model_name, g_free);
+    if (!found)
+        return;
+
+    double confidence;
+    int label_id;
+    const gchar *attribute_name = gst_structure_has_field(s, "attribute_name")
+                                      ? gst_structure_get_string(s, "attribute_name")
+                                      : gst_structure_get_name(s);
+    if (!attribute_name)
+        throw std::invalid_argument("Classification result has invalid attribute_name");
+
+    writer.key(attribute_name);
+    writer.begin_object();
+    if (gst_structure_get(s, "confidence", G_TYPE_DOUBLE, &confidence, NULL)) {
+        writer.key("confidence");
+        writer.number(confidence);
+    }
+    writer.key("label");
+    writer.string(label);
+    if (gst_structure_get(s, "label_id", G_TYPE_INT, &label_id, NULL)) {
+        writer.key("label_id");
+        writer.integer(label_id);
+    }
+    writer.key("model");
+    writer.begin_object();
+    writer.key("name");
+    writer.string(model_name);
+    writer.end_object();
+    writer.end_object();
+}
 
-        jobject.push_back({"x", roi._meta()->x});
-        jobject.push_back({"y", roi._meta()->y});
-        jobject.push_back({"w", roi._meta()->w});
-        jobject.push_back({"h", roi._meta()->h});
-        jobject.push_back({"region_id", roi.region_id()});
+/**
+ * Writes ROI attributes and its detection and classification results.
+ * Members are written in the insertion order of the former JSON object, so the first of duplicate keys wins as before.
+ */
+void write_roi(MetaWriter &writer, GstGvaMetaConvert *converter, GVA::RegionOfInterest &roi) {
+    GstVideoRegionOfInterestMeta *meta = roi._meta();
+    gint id = 0;
+    get_object_id(meta, &id);
 
-        if (id != 0)
-            jobject.push_back({"id", id});
+    writer.begin_object();
+    if (converter->add_tensor_data) {
+        writer.key("tensors");
+        writer.begin_array();
+        for (GList *l = meta->params; l; l = g_list_next(l))
+            write_tensor(writer, GVA::Tensor(GST_STRUCTURE(l->data)));
+        writer.end_array();
+    }
 
-        const gchar *roi_type = g_quark_to_string(roi._meta()->roi_type);
+    writer.key("x");
+    writer.unsigned_integer(meta->x);
+    writer.key("y");
+    writer.unsigned_integer(meta->y);
+    writer.key("w");
+    writer.unsigned_integer(meta->w);
+    writer.key("h");
+    writer.unsigned_integer(meta->h);
+    writer.key("region_id");
+    writer.integer(roi.region_id());
+
+    if (id != 0) {
+        writer.key("id");
+        writer.integer(id);
+    }
 
-        if (roi_type) {
-            jobject.push_back({"roi_type", roi_type});
-        }
-        for (GList *l = roi._meta()->params; l; l = g_list_next(l)) {
-
-            GstStructure *s = GST_STRUCTURE(l->data);
-            const gchar *s_name = gst_structure_get_name(s);
-            if (strcmp(s_name, "detection") == 0) {
-                double xminval;
-                double xmaxval;
-                double yminval;
-                double ymaxval;
-                double confidence;
-                int label_id;
-                if (gst_structure_get(s, "x_min", G_TYPE_DOUBLE, &xminval, "x_max", G_TYPE_DOUBLE, &xmaxval, "y_min",
-                                      G_TYPE_DOUBLE, &yminval, "y_max", G_TYPE_DOUBLE, &ymaxval, NULL)) {
-                    json detection = json::object(
-                        {{"bounding_box",
-                          {{"x_min", xminval}, {"x_max", xmaxval}, {"y_min", yminval}, {"y_max", ymaxval}}}});
-
-                    if (gst_structure_get(s, "confidence", G_TYPE_DOUBLE, &confidence, NULL)) {
-                        detection.push_back({"confidence", confidence});
-                    }
-
-                    if (gst_structure_get(s, "label_id", G_TYPE_INT, &label_id, NULL)) {
-                        detection.push_back({"label_id", label_id});
-                    }
-
-                    const gchar *label = g_quark_to_string(roi._meta()->roi_type);
-
-                    if (label) {
-                        detection.push_back({"label", label});
-                    }
-                    jobject.push_back(json::object_t::value_type("detection", detection));
-                }
-            } else {
-                char *label;
-                char *model_name;
-                if (gst_structure_get(s, "label", G_TYPE_STRING, &label, "model_name", G_TYPE_STRING, &model_name,
-                                      NULL)) {
-                    double confidence;
-                    int label_id;
-                    const gchar *attribute_name = gst_structure_has_field(s, "attribute_name")
-                                                      ? gst_structure_get_string(s, "attribute_name")
-                                                      : s_name;
-                    json classification = json::object({{"label", label}, {"model", {{"name", model_name}}}});
-
-                    if (gst_structure_get(s, "confidence", G_TYPE_DOUBLE, &confidence, NULL)) {
-                        classification.push_back({"confidence", confidence});
-                    }
-
-                    if (gst_structure_get(s, "label_id", G_TYPE_INT, &label_id, NULL)) {
-                        classification.push_back({"label_id", label_id});
-                    }
-
-                    jobject.push_back(json::object_t::value_type(attribute_name, classification));
-                    g_free(label);
-                    g_free(model_name);
-                }
-            }
-            if (converter->add_tensor_data) {
-                GVA::Tensor s_tensor = GVA::Tensor((GstStructure *)l->data);
-                jobject["tensors"].push_back(convert_tensor(s_tensor));
-            }
-        }
-        if (!jobject.empty()) {
-            res.push_back(jobject);
-        }
+    const gchar *roi_type = g_quark_to_string(meta->roi_type);
+    if (roi_type) {
+        writer.key("roi_type");
+        writer.string(roi_type);
     }
-    return res;
+
+    for (GList *l = meta->params; l; l = g_list_next(l)) {
+        GstStructure *s = GST_STRUCTURE(l->data);
+        if (strcmp(gst_structure_get_name(s), "detection") == 0)
+            write_detection(writer, meta, s);
+        else
+            write_classification(writer, s);
+    }
+    writer.end_object();
 }
 
 /**
- * @return JSON array which contains raw tensor metas from frame.
+ * Writes full-frame attributes and full-frame classification results.
  */
-json convert_frame_tensors(GstGvaMetaConvert *converter, GstBuffer *buffer) {
-    assert(converter && buffer && "Expected valid pointers GstGvaMetaConvert and GstBuffer");
-
-    GVA::VideoFrame video_frame(buffer, converter->info);
-    const std::vector<GVA::Tensor> tensors = video_frame.tensors();
-    json array = json::array();
-    for (auto &tensor : video_frame.tensors()) {
-        if (!tensor.has_field("type")) {
-            array.push_back(convert_tensor(tensor));
+void write_frame_classification(MetaWriter &writer, GstGvaMetaConvert *converter, std::vector<GVA::Tensor> &tensors) {
+    writer.begin_object();
+    if (converter->add_tensor_data) {
+        writer.key("tensors");
+        writer.begin_array();
+        for (GVA::Tensor &tensor : tensors)
+            write_tensor(writer, tensor);
+        writer.end_array();
+    }
+    writer.key("x");
+    writer.integer(0);
+    writer.key("y");
+    writer.integer(0);
+    writer.key("w");
+    writer.integer(converter->info->width);
+    writer.key("h");
+    writer.integer(converter->info->height);
+
+    for (GVA::Tensor &tensor : tensors) {
+        if (!tensor.has_field("label") && !tensor.has_field("label_id"))
+            continue;
+        std::string label = tensor.label();
+        std::string model_name = tensor.model_name();
+        std::string attribute_name =
+            tensor.has_field("attribute_name") ? tensor.get_string("attribute_name") : tensor.name();
+
+        writer.key(attribute_name);
+        writer.begin_object();
+        if (tensor.has_field("confidence")) {
+            writer.key("confidence");
+            writer.number(tensor.confidence());
+        }
+        if (!label.empty()) {
+            writer.key("label");
+            writer.string(label);
+        }
+        if (tensor.has_field("label_id")) {
+            writer.key("label_id");
+            writer.integer(tensor.get_int("label_id"));
         }
+        if (!model_name.empty()) {
+            writer.key("model");
+            writer.begin_object();
+            writer.key("name");
+            writer.string(model_name);
+            writer.end_object();
+        }
+        writer.end_object();
     }
-    return array;
+    writer.end_object();
 }
 
 /**
- * @return JSON object which contains full-frame attributes and full-frame classification results from frame.
+ * Serializes frame metadata with the given encoding into serializer's writer.
+ * @return false if there is nothing to publish for the frame
  */
-json convert_frame_classification(GstGvaMetaConvert *converter, GstBuffer *buffer) {
-    assert(converter && buffer && "Expected valid pointers GstGvaMetaConvert and GstBuffer");
-
+bool serialize_frame(MetaConvertSerializer &serializer, GstGvaMetaConvert *converter, GstBuffer *buffer,
+                     MetaWriter::Encoding encoding) {
     GVA::VideoFrame video_frame(buffer, converter->info);
-    const std::vector<GVA::Tensor> tensors = video_frame.tensors();
-    if (tensors.empty())
-        return json{};
+    std::vector<GVA::RegionOfInterest> regions = video_frame.regions();
+    std::vector<GVA::Tensor> tensors = video_frame.tensors();
 
-    json jobject = json::object();
+    /* roi detections can contain multiple objects, while frame classification - only one */
+    const bool has_objects = !regions.empty() || !tensors.empty();
+    bool has_tensors = false;
     if (converter->add_tensor_data) {
-        jobject["tensors"] = json::array();
+        for (GVA::Tensor &tensor : tensors)
+            has_tensors |= !tensor.has_field("type");
     }
-    jobject.push_back({"x", 0});
-    jobject.push_back({"y", 0});
-    jobject.push_back({"w", converter->info->width});
-    jobject.push_back({"h", converter->info->height});
-
-    for (GVA::Tensor &tensor : video_frame.tensors()) {
-        if (tensor.has_field("label") || tensor.has_field("label_id")) {
-            std::string label = tensor.label();
-            std::string model_name = tensor.model_name();
-            json classification = json::object({});
-            if (!label.empty()) {
-                classification.push_back(json::object_t::value_type("label", label));
-            }
-            if (!model_name.empty()) {
-                classification.push_back(json::object_t::value_type("model", {{"name", model_name}}));
-            }
-            std::string attribute_name =
-                tensor.has_field("attribute_name") ? tensor.get_string("attribute_name") : tensor.name();
 
-            if (tensor.has_field("confidence")) {
-                classification.push_back(json::object_t::value_type("confidence", tensor.confidence()));
-            }
-            if (tensor.has_field("label_id")) {
-                classification.push_back(json::object_t::value_type("label_id", tensor.get_int("label_id")));
-            }
+    if (!has_objects && !has_tensors && !converter->add_empty_detection_results) {
+        GST_DEBUG_OBJECT(converter, "No detections found. Not posting JSON message");
+        return false;
+    }
 
-            jobject.push_back(json::object_t::value_type(attribute_name, classification));
-        }
-        if (converter->add_tensor_data) {
-            jobject["tensors"].push_back(convert_tensor(tensor));
+    // Top-level members are written in key order
+    MetaWriter &writer = serializer.writer;
+    writer.reset(encoding, converter->json_indent);
+    writer.begin_object();
+    if (has_objects) {
+        writer.key("objects");
+        writer.begin_array();
+        for (GVA::RegionOfInterest &roi : regions)
+            write_roi(writer, converter, roi);
+        if (!tensors.empty())
+            write_frame_classification(writer, converter, tensors);
+        writer.end_array();
+    }
+    write_frame_data(serializer, converter, buffer);
+    if (has_tensors) {
+        /* raw tensor metas of the frame */
+        writer.key("tensors");
+        writer.begin_array();
+        for (GVA::Tensor &tensor : tensors) {
+            if (!tensor.has_field("type"))
+                write_tensor(writer, tensor);
         }
+        writer.end_array();
     }
-    return jobject;
+    write_frame_timestamp(writer, converter, buffer);
+    writer.end_object();
+    return true;
 }
 
-} // namespace
+/**
+ * Attaches binary document to the frame as tensor, JSON meta can only hold a C string.
+ */
+void add_binary_message(GstBuffer *buffer, GstVideoInfo *info, const std::string &message,
+                        MetaWriter::Encoding encoding) {
+    GVA::VideoFrame video_frame(buffer, info);
+    GVA::Tensor tensor = video_frame.add_tensor();
+    tensor.set_name(BINARY_META_TENSOR_NAME);
+    tensor.set_string("type", BINARY_META_TENSOR_NAME);
+    tensor.set_string("format", encoding_to_string(encoding));
+    tensor.set_int("precision", GVA_PRECISION_U8);
+
+    GVariant *v = g_variant_new_fixed_array(G_VARIANT_TYPE_BYTE, message.data(), message.size(), 1);
+    gsize n_elem;
+    gst_structure_set(tensor.gst_structure(), "data_buffer", G_TYPE_VARIANT, v, "data", G_TYPE_POINTER,
+                      g_variant_get_fixed_array(v, &n_elem, 1), NULL);
+}
 
-gboolean to_json(GstGvaMetaConvert *converter, GstBuffer *buffer) {
+gboolean convert(GstGvaMetaConvert *converter, GstBuffer *buffer, MetaWriter::Encoding encoding) {
     GST_DEBUG_CATEGORY_INIT(gst_json_converter_debug, "jsonconverter", 0, "JSON converter");
 
     if (!converter) {
-        GST_ERROR("Failed convert to json: GvaMetaConvert is null");
+        GST_ERROR("Failed convert to %s: GvaMetaConvert is null", encoding_to_string(encoding));
         return FALSE;
     }
 
     if (!buffer) {
-        GST_ERROR_OBJECT(converter, "Failed convert to json: GstBuffer is null");
+        GST_ERROR_OBJECT(converter, "Failed convert to %s: GstBuffer is null", encoding_to_string(encoding));
         return FALSE;
     }
 
     try {
         if (converter->info) {
-            json jframe = get_frame_data(converter, buffer);
-            /* objects section */
-            json jframe_objects;
-            json roi_detection = convert_roi_detection(converter, buffer);
-            if (!roi_detection.empty()) {
-                jframe_objects = roi_detection;
-            } /* roi_detection can contain multiple objects, while frame_classification - only one */
-            json frame_classification = convert_frame_classification(converter, buffer);
-            if (!frame_classification.empty()) {
-                jframe_objects.push_back(frame_classification);
-            }
-            /* tensors section */
-            json jframe_tensors;
-            if (converter->add_tensor_data) {
-                jframe_tensors = convert_frame_tensors(converter, buffer);
-            }
+            if (!converter->serializer)
+                converter->serializer = create_meta_convert_serializer();
+            if (!serialize_frame(*converter->serializer, converter, buffer, encoding))
+                return TRUE;
 
-            if (jframe_objects.empty() && jframe_tensors.empty()) {
-                if (!converter->add_empty_detection_results) {
-                    GST_DEBUG_OBJECT(converter, "No detections found. Not posting JSON message");
-                    return TRUE;
-                }
-            }
-
-            if (!jframe.is_null()) {
-                if (!jframe_objects.empty()) {
-                    jframe["objects"] = jframe_objects;
-                }
-                if (!jframe_tensors.empty()) {
-                    jframe["tensors"] = jframe_tensors;
-                }
-                std::string json_message = jframe.dump(converter->json_indent);
+            const std::string &message = converter->serializer->writer.data();
+            if (encoding == MetaWriter::Encoding::Json) {
                 GVA::VideoFrame video_frame(buffer, converter->info);
-                video_frame.add_message(json_message);
-                GST_INFO_OBJECT(converter, "JSON message: %s", json_message.c_str());
+                video_frame.add_message(message);
+                GST_INFO_OBJECT(converter, "JSON message: %s", message.c_str());
+            } else {
+                add_binary_message(buffer, converter->info, message, encoding);
+                GST_INFO_OBJECT(converter, "%s message: %zu bytes", encoding_to_string(encoding), message.size());
             }
         }
 #ifdef AUDIO
-        else {
+        else if (encoding == MetaWriter::Encoding::Json) {
             return convert_audio_meta_to_json(converter, buffer);
         }
 #endif
@@ -279,3 +427,25 @@ gboolean to_json(GstGvaMetaConvert *converter, GstBuffer *buffer) {
     }
     return TRUE;
 }
+
+} // namespace
+
+struct MetaConvertSerializer *create_meta_convert_serializer(void) {
+    return new MetaConvertSerializer();
+}
+
+void release_meta_convert_serializer(struct MetaConvertSerializer *serializer) {
+    delete serializer;
+}
+
+gboolean to_json(GstGvaMetaConvert *converter, GstBuffer *buffer) {
+    return convert(converter, buffer, MetaWriter::Encoding::Json);
+}
+
+gboolean to_cbor(GstGvaMetaConvert *converter, GstBuffer *buffer) {
+    return convert(converter, buffer, MetaWriter::Encoding::Cbor);
+}
+
+gboolean to_msgpack(GstGvaMetaConvert *converter, GstBuffer *buffer) {
+    return convert(converter, buffer, MetaWriter::Encoding::MsgPack);
+}
@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (C) 2018-2020 Intel Corporation
+ * Copyright (C) 2018-2024 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  ******************************************************************************/
@@ -12,7 +12,12 @@
 extern "C" {
 #endif /* __cplusplus */
 
+struct MetaConvertSerializer *create_meta_convert_serializer(void);
+void release_meta_convert_serializer(struct MetaConvertSerializer *serializer);
+
 gboolean to_json(GstGvaMetaConvert *converter, GstBuffer *buffer);
+gboolean to_cbor(GstGvaMetaConvert *converter, GstBuffer *buffer);
+gboolean to_msgpack(GstGvaMetaConvert *converter, GstBuffer *buffer);
 
 #ifdef __cplusplus
 } /* extern C */
@@ -0,0 +1,473 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "meta_writer.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+enum : uint8_t { MAJOR_UNSIGNED = 0, MAJOR_NEGATIVE = 1, MAJOR_STRING = 3, MAJOR_ARRAY = 4, MAJOR_MAP = 5 };
+
+void append_big_endian(std::string &out, uint64_t value, size_t bytes) {
+    for (size_t i = bytes; i-- > 0;)
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+void append_uint(std::string &out, uint64_t value) {
+    char digits[20];
+    size_t n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value);
+    while (n)
+        out.push_back(digits[--n]);
+}
+
+// Length of valid UTF-8 sequence starting at 'at', 0 if it is invalid
+size_t utf8_sequence_size(const unsigned char *at, size_t left) {
+    auto in = [](unsigned char c, unsigned char lo, unsigned char hi) { return c >= lo && c <= hi; };
+    const unsigned char c = at[0];
+    if (in(c, 0xc2, 0xdf))
+        return left >= 2 && in(at[1], 0x80, 0xbf) ? 2 : 0;
+    if (in(c, 0xe0, 0xef)) {
+        const unsigned char lo = c == 0xe0 ? 0xa0 : 0x80;
+        const unsigned char hi = c == 0xed ? 0x9f : 0xbf;
+        return left >= 3 && in(at[1], lo, hi) && in(at[2], 0x80, 0xbf) ? 3 : 0;
+    }
+    if (in(c, 0xf0, 0xf4)) {
+        const unsigned char lo = c == 0xf0 ? 0x90 : 0x80;
+        const unsigned char hi = c == 0xf4 ? 0x8f : 0xbf;
+        return left >= 4 && in(at[1], lo, hi) && in(at[2], 0x80, 0xbf) && in(at[3], 0x80, 0xbf) ? 4 : 0;
+    }
+    return 0;
+}
+
+// Same escaping as nlohmann::json::dump() without ensure_ascii, invalid UTF-8 is an error there as well
+void append_json_string(std::string &out, const char *value, size_t size) {
+    static const char HEX[] = "0123456789abcdef";
+    const auto *bytes = reinterpret_cast<const unsigned char *>(value);
+    out.push_back('"');
+    size_t plain = 0;
+    for (size_t i = 0; i < size;) {
+        const unsigned char c = bytes[i];
+        if (c >= 0x20 && c != '"' && c != '\\' && c < 0x80) {
+            i++;
+            continue;
+        }
+        out.append(value + plain, i - plain);
+        if (c >= 0x80) {
+            const size_t n = utf8_sequence_size(bytes + i, size - i);
+            if (!n)
+                throw std::runtime_error("Invalid UTF-8 byte at index " + std::to_string(i) + " of string value");
+            out.append(value + i, n);
+            i += n;
+            plain = i;
+            continue;
+        }
+        switch (c) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\b':
+            out += "\\b";
+            break;
+        case '\f':
+            out += "\\f";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            out += "\\u00";
+            out.push_back(HEX[c >> 4]);
+            out.push_back(HEX[c & 0xf]);
+            break;
+        }
+        plain = ++i;
+    }
+    out.append(value + plain, size - plain);
+    out.push_back('"');
+}
+
+} // namespace
+
+void MetaWriter::reset(Encoding encoding, int indent) {
+    _encoding = encoding;
+    _indent = encoding == Encoding::Json ? indent : -1;
+    _buffer.clear();
+    _keys.clear();
+    _stack.clear();
+    _members.clear();
+}
+
+void MetaWriter::new_line(size_t level) {
+    _buffer.push_back('\n');
+    _buffer.append(level * _indent, ' ');
+}
+
+void MetaWriter::before_value() {
+    if (_stack.empty() || _stack.back().is_object)
+        return;
+    Container &array = _stack.back();
+    if (_encoding == Encoding::Json) {
+        if (array.items)
+            _buffer.push_back(',');
+        if (_indent >= 0)
+            new_line(_stack.size());
+    }
+    array.items++;
+}
+
+void MetaWriter::write_header(uint8_t major, uint64_t size, std::string &out) const {
+    if (_encoding == Encoding::Cbor) {
+        const char type = static_cast<char>(major << 5);
+        if (size < 24) {
+            out.push_back(static_cast<char>(type | size));
+        } else if (size <= 0xff) {
+            out.push_back(static_cast<char>(type | 24));
+            append_big_endian(out, size, 1);
+        } else if (size <= 0xffff) {
+            out.push_back(static_cast<char>(type | 25));
+            append_big_endian(out, size, 2);
+        } else if (size <= 0xffffffff) {
+            out.push_back(static_cast<char>(type | 26));
+            append_big_endian(out, size, 4);
+        } else {
+            out.push_back(static_cast<char>(type | 27));
+            append_big_endian(out, size, 8);
+        }
+        return;
+    }
+
+    // MessagePack has no 64-bit sizes, documents that large are not produced here
+    switch (major) {
+    case MAJOR_STRING:
+        if (size < 32) {
+            out.push_back(static_cast<char>(0xa0 | size));
+        } else if (size <= 0xff) {
+            out.push_back(static_cast<char>(0xd9));
+            append_big_endian(out, size, 1);
+        } else if (size <= 0xffff) {
+            out.push_back(static_cast<char>(0xda));
+            append_big_endian(out, size, 2);
+        } else {
+            out.push_back(static_cast<char>(0xdb));
+            append_big_endian(out, size, 4);
+        }
+        break;
+    case MAJOR_ARRAY:
+    case MAJOR_MAP: {
+        const bool map = major == MAJOR_MAP;
+        if (size < 16) {
+            out.push_back(static_cast<char>((map ? 0x80 : 0x90) | size));
+        } else if (size <= 0xffff) {
+            out.push_back(static_cast<char>(map ? 0xde : 0xdc));
+            append_big_endian(out, size, 2);
+        } else {
+            out.push_back(static_cast<char>(map ? 0xdf : 0xdd));
+            append_big_endian(out, size, 4);
+        }
+        break;
+    }
+    default:
+        throw std::logic_error("Unexpected MessagePack header type");
+    }
+}
+
+void MetaWriter::begin_object() {
+    before_value();
+    if (_encoding == Encoding::Json)
+        _buffer.push_back('{');
+    _stack.push_back({true, _buffer.size(), _members.size()});
+}
+
+void MetaWriter::begin_array() {
+    before_value();
+    if (_encoding == Encoding::Json)
+        _buffer.push_back('[');
+    _stack.push_back({false, _buffer.size(), _members.size()});
+}
+
+void MetaWriter::key(const char *name) {
+    key(name, std::strlen(name));
+}
+
+void MetaWriter::key(const char *name, size_t size) {
+    if (_stack.empty() || !_stack.back().is_object)
+        throw std::logic_error("Object key written outside of object");
+    Container &object = _stack.back();
+
+    const bool first = _members.size() == object.first_member;
+    if (!first) {
+        Member &previous = _members.back();
+        previous.end = _buffer.size();
+        if (object.sorted) {
+            const int cmp = _keys.compare(previous.key_offset, previous.key_size, name, size);
+            object.sorted = cmp < 0;
+        }
+    }
+
+    if (_encoding == Encoding::Json) {
+        if (!first)
+            _buffer.push_back(',');
+        if (_indent >= 0)
+            new_line(_stack.size());
+    }
+
+    _members.push_back({_keys.size(), size, _buffer.size(), 0});
+    _keys.append(name, size);
+
+    if (_encoding == Encoding::Json) {
+        append_json_string(_buffer, name, size);
+        _buffer.push_back(':');
+        if (_indent >= 0)
+            _buffer.push_back(' ');
+    } else {
+        write_header(MAJOR_STRING, size, _buffer);
+        _buffer.append(name, size);
+    }
+}
+
+void MetaWriter::close_object_members(Container &object) {
+    const size_t count = _members.size() - object.first_member;
+    if (count)
+        _members.back().end = _buffer.size();
+
+    if (object.sorted) {
+        if (_encoding != Encoding::Json) {
+            _scratch.clear();
+            write_header(MAJOR_MAP, count, _scratch);
+            _buffer.insert(object.begin, _scratch);
+        } else if (count && _indent >= 0) {
+            new_line(_stack.size() - 1);
+        }
+        return;
+    }
+
+    // Order members by key keeping the first of duplicates, as std::map based objects do
+    auto key_of = [this](size_t index) {
+        const Member &m = _members[index];
+        return std::make_pair(_keys.data() + m.key_offset, m.key_size);
+    };
+    auto less = [&](size_t a, size_t b) {
+        auto ka = key_of(a), kb = key_of(b);
+        const int cmp = std::memcmp(ka.first, kb.first, std::min(ka.second, kb.second));
+        return cmp ? cmp < 0 : ka.second < kb.second;
+    };
+    _order.clear();
+    for (size_t i = object.first_member; i < _members.size(); i++)
+        _order.push_back(i);
+    std::stable_sort(_order.begin(), _order.end(), less);
+    _order.erase(std::unique(_order.begin(), _order.end(), [&](size_t a, size_t b) { return !less(a, b); }),
+                 _order.end());
+
+    _scratch.assign(_buffer, object.begin, std::string::npos);
+    _buffer.resize(object.begin);
+    if (_encoding != Encoding::Json)
+        write_header(MAJOR_MAP, _order.size(), _buffer);
+    for (size_t i = 0; i < _order.size(); i++) {
+        const Member &m = _members[_order[i]];
+        if (_encoding == Encoding::Json) {
+            if (i)
+                _buffer.push_back(',');
+            if (_indent >= 0)
+                new_line(_stack.size());
+        }
+        _buffer.append(_scratch, m.begin - object.begin, m.end - m.begin);
+    }
+    if (_encoding == Encoding::Json && _indent >= 0)
+        new_line(_stack.size() - 1);
+}
+
+void MetaWriter::end_object() {
+    if (_stack.empty() || !_stack.back().is_object)
+        throw std::logic_error("Unbalanced end of object");
+    Container &object = _stack.back();
+
+    close_object_members(object);
+    if (_encoding == Encoding::Json)
+        _buffer.push_back('}');
+
+    if (_members.size() > object.first_member)
+        _keys.resize(_members[object.first_member].key_offset);
+    _members.resize(object.first_member);
+    _stack.pop_back();
+}
+
+void MetaWriter::end_array() {
+    if (_stack.empty() || _stack.back().is_object)
+        throw std::logic_error("Unbalanced end of array");
+    Container &array = _stack.back();
+
+    if (_encoding == Encoding::Json) {
+        if (array.items && _indent >= 0)
+            new_line(_stack.size() - 1);
+        _buffer.push_back(']');
+    } else {
+        _scratch.clear();
+        write_header(MAJOR_ARRAY, array.items, _scratch);
+        _buffer.insert(array.begin, _scratch);
+    }
+    _stack.pop_back();
+}
+
+void MetaWriter::null() {
+    before_value();
+    switch (_encoding) {
+    case Encoding::Json:
+        _buffer += "null";
+        break;
+    case Encoding::Cbor:
+        _buffer.push_back(static_cast<char>(0xf6));
+        break;
+    case Encoding::MsgPack:
+        _buffer.push_back(static_cast<char>(0xc0));
+        break;
+    }
+}
+
+void MetaWriter::boolean(bool value) {
+    before_value();
+    switch (_encoding) {
+    case Encoding::Json:
+        _buffer += value ? "true" : "false";
+        break;
+    case Encoding::Cbor:
+        _buffer.push_back(static_cast<char>(value ? 0xf5 : 0xf4));
+        break;
+    case Encoding::MsgPack:
+        _buffer.push_back(static_cast<char>(value ? 0xc3 : 0xc2));
+        break;
+    }
+}
+
+void MetaWriter::integer(int64_t value) {
+    if (value >= 0) {
+        unsigned_integer(static_cast<uint64_t>(value));
+        return;
+    }
+    before_value();
+    switch (_encoding) {
+    case Encoding::Json:
+        _buffer.push_back('-');
+        append_uint(_buffer, 0 - static_cast<uint64_t>(value));
+        break;
+    case Encoding::Cbor:
+        write_header(MAJOR_NEGATIVE, ~static_cast<uint64_t>(value), _buffer);
+        break;
+    case Encoding::MsgPack:
+        if (value >= -32) {
+            _buffer.push_back(static_cast<char>(value));
+        } else if (value >= INT8_MIN) {
+            _buffer.push_back(static_cast<char>(0xd0));
+            append_big_endian(_buffer, static_cast<uint64_t>(value), 1);
+        } else if (value >= INT16_MIN) {
+            _buffer.push_back(static_cast<char>(0xd1));
+            append_big_endian(_buffer, static_cast<uint64_t>(value), 2);
+        } else if (value >= INT32_MIN) {
+            _buffer.push_back(static_cast<char>(0xd2));
+            append_big_endian(_buffer, static_cast<uint64_t>(value), 4);
+        } else {
+            _buffer.push_back(static_cast<char>(0xd3));
+            append_big_endian(_buffer, static_cast<uint64_t>(value), 8);
+        }
+        break;
+    }
+}
+
+void MetaWriter::unsigned_integer(uint64_t value) {
+    before_value();
+    switch (_encoding) {
+    case Encoding::Json:
+        append_uint(_buffer, value);
+        break;
+    case Encoding::Cbor:
+        write_header(MAJOR_UNSIGNED, value, _buffer);
+        break;
+    case Encoding::MsgPack:
+        if (value < 128) {
+            _buffer.push_back(static_cast<char>(value));
+        } else if (value <= UINT8_MAX) {
+            _buffer.push_back(static_cast<char>(0xcc));
+            append_big_endian(_buffer, value, 1);
+        } else if (value <= UINT16_MAX) {
+            _buffer.push_back(static_cast<char>(0xcd));
+            append_big_endian(_buffer, value, 2);
+        } else if (value <= UINT32_MAX) {
+            _buffer.push_back(static_cast<char>(0xce));
+            append_big_endian(_buffer, value, 4);
+        } else {
+            _buffer.push_back(static_cast<char>(0xcf));
+            append_big_endian(_buffer, value, 8);
+        }
+        break;
+    }
+}
+
+void MetaWriter::number(double value) {
+    before_value();
+    if (_encoding == Encoding::Json) {
+        if (!std::isfinite(value)) {
+            _buffer += "null";
+            return;
+        }
+        // shortest round-trip representation, the one used by nlohmann::json::dump()
+        char digits[64];
+        const char *end = nlohmann::detail::to_chars(digits, digits + sizeof(digits), value);
+        _buffer.append(digits, static_cast<size_t>(end - digits));
+        return;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    _buffer.push_back(static_cast<char>(_encoding == Encoding::Cbor ? 0xfb : 0xcb));
+    append_big_endian(_buffer, bits, 8);
+}
+
+void MetaWriter::string(const char *value) {
+    string(value, std::strlen(value));
+}
+
+void MetaWriter::string(const char *value, size_t size) {
+    before_value();
+    if (_encoding == Encoding::Json) {
+        append_json_string(_buffer, value, size);
+        return;
+    }
+    write_header(MAJOR_STRING, size, _buffer);
+    _buffer.append(value, size);
+}
+
+void MetaWriter::raw(const std::string &encoded) {
+    before_value();
+    if (_encoding != Encoding::Json || _indent < 0 || _stack.empty()) {
+        _buffer += encoded;
+        return;
+    }
+    // Shift nested lines of indented JSON to the current nesting level, strings can not contain raw line feeds
+    size_t from = 0;
+    for (size_t at = encoded.find('\n'); at != std::string::npos; at = encoded.find('\n', from)) {
+        _buffer.append(encoded, from, at - from);
+        new_line(_stack.size());
+        from = at + 1;
+    }
+    _buffer.append(encoded, from, std::string::npos);
+}
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Streaming serializer of metadata documents into a reusable buffer, producing JSON, CBOR or MessagePack.
+ * JSON output is byte-identical to nlohmann::json::dump(): object members are ordered by key and the first of
+ * duplicate keys wins. Members written in key order are emitted as is, other objects are reordered when closed.
+ */
+class MetaWriter {
+  public:
+    enum class Encoding { Json, Cbor, MsgPack };
+
+    // Starts a new document, buffer capacity is kept. Negative indent produces compact JSON
+    void reset(Encoding encoding, int indent = -1);
+
+    void begin_object();
+    void end_object();
+    void begin_array();
+    void end_array();
+
+    // Key of the next object member
+    void key(const char *name);
+    void key(const char *name, size_t size);
+    void key(const std::string &name) {
+        key(name.data(), name.size());
+    }
+
+    void null();
+    void boolean(bool value);
+    void integer(int64_t value);
+    void unsigned_integer(uint64_t value);
+    void number(double value);
+    void string(const char *value);
+    void string(const char *value, size_t size);
+    void string(const std::string &value) {
+        string(value.data(), value.size());
+    }
+    // Value already serialized with the same encoding, indented JSON is expected to start at nesting level 0
+    void raw(const std::string &encoded);
+
+    Encoding encoding() const {
+        return _encoding;
+    }
+    const std::string &data() const {
+        return _buffer;
+    }
+
+  private:
+    struct Member {
+        size_t key_offset; // in _keys
+        size_t key_size;
+        size_t begin; // of serialized key and value in _buffer
+        size_t end;
+    };
+
+    struct Container {
+        bool is_object;
+        size_t begin;         // first byte after the opening bracket, where header goes for binary encodings
+        size_t first_member;  // index in _members
+        size_t items = 0;     // values written, for arrays
+        bool sorted = true;   // members so far are in strictly increasing key order
+    };
+
+    void before_value();
+    void new_line(size_t level);
+    void write_header(uint8_t major, uint64_t size, std::string &out) const;
+    void close_object_members(Container &container);
+
+    Encoding _encoding = Encoding::Json;
+    int _indent = -1;
+
+    std::string _buffer;
+    std::string _keys;
+    std::string _scratch;
+    std::vector<Container> _stack;
+    std::vector<Member> _members;
+    std::vector<size_t> _order;
+};
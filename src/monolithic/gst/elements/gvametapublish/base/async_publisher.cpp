@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "async_publisher.hpp"
+
+#include <algorithm>
+#include <utility>
+
+AsyncPublisher::AsyncPublisher(const Options &options, Sender sender)
+    : _options(options), _sender(std::move(sender)), _ring(std::max<size_t>(options.queue_size, 1)) {
+    _thread = std::thread(&AsyncPublisher::run, this);
+}
+
+AsyncPublisher::~AsyncPublisher() {
+    stop();
+}
+
+bool AsyncPublisher::push(std::string message) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_stopping)
+        return false;
+    if (_flushing) {
+        _stats.dropped++;
+        return false;
+    }
+
+    if (_count == _ring.size()) {
+        switch (_options.overflow_policy) {
+        case OverflowPolicy::Block:
+            _not_full.wait(lock, [this] { return _count < _ring.size() || _flushing || _stopping; });
+            if (_stopping)
+                return false;
+            if (_flushing) {
+                _stats.dropped++;
+                return false;
+            }
+            break;
+        case OverflowPolicy::DropNewest:
+            _stats.dropped++;
+            return false;
+        case OverflowPolicy::DropOldest:
+            _ring[_head].message.clear();
+            _head = (_head + 1) % _ring.size();
+            _count--;
+            _stats.dropped++;
+            break;
+        }
+    }
+
+    Item &item = _ring[(_head + _count) % _ring.size()];
+    item.message = std::move(message);
+    item.queued_at = std::chrono::steady_clock::now();
+    _count++;
+    _stats.queued++;
+    _stats.max_depth = std::max(_stats.max_depth, _count);
+    lock.unlock();
+    _not_empty.notify_one();
+    return true;
+}
+
+void AsyncPublisher::flush() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _drained.wait(lock, [this] { return _count == 0 && !_sending; });
+}
+
+void AsyncPublisher::set_flushing(bool flushing) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _flushing = flushing;
+    }
+    if (flushing)
+        _not_full.notify_all();
+}
+
+void AsyncPublisher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _not_empty.notify_all();
+    _not_full.notify_all();
+    if (_thread.joinable())
+        _thread.join();
+    _drained.notify_all();
+}
+
+AsyncPublisher::Stats AsyncPublisher::stats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void AsyncPublisher::take_batch(std::vector<std::string> &batch) {
+    const size_t n = std::min(_count, std::max<size_t>(_options.batch_size, 1));
+    for (size_t i = 0; i < n; i++) {
+        batch.push_back(std::move(_ring[_head].message));
+        _ring[_head].message.clear();
+        _head = (_head + 1) % _ring.size();
+    }
+    _count -= n;
+}
+
+void AsyncPublisher::run() {
+    std::vector<std::string> batch;
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        _not_empty.wait(lock, [this] { return _count > 0 || _stopping; });
+        if (_count == 0)
+            break; // stopping and nothing left to publish
+
+        // Let the batch fill up for the rest of the time window of its oldest message
+        if (_count < _options.batch_size && _options.batch_interval.count() > 0 && !_stopping) {
+            const auto deadline = _ring[_head].queued_at + _options.batch_interval;
+            _not_empty.wait_until(lock, deadline, [this] { return _count >= _options.batch_size || _stopping; });
+        }
+
+        batch.clear();
+        take_batch(batch);
+        _sending = true;
+        lock.unlock();
+        _not_full.notify_all();
+
+        bool sent = false;
+        try {
+            sent = _sender(batch);
+        } catch (...) {
+            // sender thread must keep draining the queue, failure is counted below
+        }
+
+        lock.lock();
+        _sending = false;
+        _stats.batches++;
+        if (sent)
+            _stats.published += batch.size();
+        else
+            _stats.failed_batches++;
+        if (_count == 0)
+            _drained.notify_all();
+    }
+}
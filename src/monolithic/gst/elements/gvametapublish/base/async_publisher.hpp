@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include "gvametapublish_export.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Publishes messages from a dedicated thread. Messages are kept in a bounded ring buffer, the sender takes them in
+ * batches of up to 'batch_size' messages, waiting at most 'batch_interval' for a batch to fill. When the buffer is
+ * full, the producer either waits or one message is dropped according to the overflow policy.
+ */
+class GVAMETAPUBLISH_EXPORTS AsyncPublisher {
+  public:
+    enum class OverflowPolicy { Block, DropOldest, DropNewest };
+
+    struct Options {
+        size_t queue_size = 1;
+        size_t batch_size = 1;
+        std::chrono::milliseconds batch_interval{0};
+        OverflowPolicy overflow_policy = OverflowPolicy::Block;
+    };
+
+    struct Stats {
+        uint64_t queued = 0;
+        uint64_t published = 0;
+        uint64_t dropped = 0;
+        uint64_t batches = 0;
+        uint64_t failed_batches = 0;
+        size_t max_depth = 0;
+    };
+
+    // Called on the sender thread with a non-empty batch, returns false if the batch could not be published
+    using Sender = std::function<bool(const std::vector<std::string> &batch)>;
+
+    AsyncPublisher(const Options &options, Sender sender);
+    ~AsyncPublisher();
+
+    AsyncPublisher(const AsyncPublisher &) = delete;
+    AsyncPublisher &operator=(const AsyncPublisher &) = delete;
+
+    // Returns false if the message was dropped or the publisher is stopped or flushing
+    bool push(std::string message);
+    // Waits until all queued messages are handed to the sender
+    void flush();
+    // While flushing, producers waiting for room with Block policy are released and new messages are dropped, so
+    // streaming thread is never stuck in push() during pipeline flush. Queued messages are still published.
+    void set_flushing(bool flushing);
+    // Releases waiting producers, publishes queued messages and joins the sender thread
+    void stop();
+
+    Stats stats() const;
+
+  private:
+    void run();
+    // Called under the lock, removes up to batch_size messages from the head of the ring
+    void take_batch(std::vector<std::string> &batch);
+
+    const Options _options;
+    const Sender _sender;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _not_empty;
+    std::condition_variable _not_full;
+    std::condition_variable _drained;
+
+    struct Item {
+        std::string message;
+        std::chrono::steady_clock::time_point queued_at;
+    };
+    std::vector<Item> _ring;
+    size_t _head = 0;
+    size_t _count = 0;
+    bool _sending = false;
+    bool _flushing = false;
+    bool _stopping = false;
+    Stats _stats;
+
+    std::thread _thread;
+};
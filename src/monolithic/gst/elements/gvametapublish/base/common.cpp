@@ -22,6 +22,19 @@ const gchar *file_format_to_string(FileFormat format) {
     }
 }
 
+const gchar *overflow_policy_to_string(OverflowPolicy policy) {
+    switch (policy) {
+    case GVA_META_PUBLISH_OVERFLOW_BLOCK:
+        return OVERFLOW_POLICY_BLOCK_NAME;
+    case GVA_META_PUBLISH_OVERFLOW_DROP_OLDEST:
+        return OVERFLOW_POLICY_DROP_OLDEST_NAME;
+    case GVA_META_PUBLISH_OVERFLOW_DROP_NEWEST:
+        return OVERFLOW_POLICY_DROP_NEWEST_NAME;
+    default:
+        return UNKNOWN_VALUE_NAME;
+    }
+}
+
 GType gva_metapublish_file_format_get_type(void) {
     static GType gva_metapublish_file_format_type = 0;
     static const GEnumValue file_format_types[] = {
@@ -37,3 +50,21 @@ GType gva_metapublish_file_format_get_type(void) {
 
     return gva_metapublish_file_format_type;
 }
+
+GType gva_metapublish_overflow_policy_get_type(void) {
+    static GType gva_metapublish_overflow_policy_type = 0;
+    static const GEnumValue overflow_policies[] = {
+        {GVA_META_PUBLISH_OVERFLOW_BLOCK, "wait until the queue has room, applies backpressure to the pipeline",
+         OVERFLOW_POLICY_BLOCK_NAME},
+        {GVA_META_PUBLISH_OVERFLOW_DROP_OLDEST, "drop the oldest queued message to make room for the new one",
+         OVERFLOW_POLICY_DROP_OLDEST_NAME},
+        {GVA_META_PUBLISH_OVERFLOW_DROP_NEWEST, "drop the new message", OVERFLOW_POLICY_DROP_NEWEST_NAME},
+        {0, nullptr, nullptr}};
+
+    if (!gva_metapublish_overflow_policy_type) {
+        gva_metapublish_overflow_policy_type =
+            g_enum_register_static("GvaMetaPublishOverflowPolicy", overflow_policies);
+    }
+
+    return gva_metapublish_overflow_policy_type;
+}
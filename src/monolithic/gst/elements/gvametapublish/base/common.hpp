@@ -13,10 +13,17 @@ GST_EXPORT GstStaticPadTemplate gva_meta_publish_src_template;
 
 typedef enum { GVA_META_PUBLISH_JSON = 1, GVA_META_PUBLISH_JSON_LINES = 2 } FileFormat;
 
+typedef enum {
+    GVA_META_PUBLISH_OVERFLOW_BLOCK = 0,
+    GVA_META_PUBLISH_OVERFLOW_DROP_OLDEST = 1,
+    GVA_META_PUBLISH_OVERFLOW_DROP_NEWEST = 2
+} OverflowPolicy;
+
 // File specific constants
 constexpr auto STDOUT = "stdout";
 constexpr auto DEFAULT_FILE_PATH = STDOUT;
 constexpr auto DEFAULT_FILE_FORMAT = GVA_META_PUBLISH_JSON;
+constexpr auto DEFAULT_FLUSH_INTERVAL = 0;
 
 // Enum value names
 constexpr auto UNKNOWN_VALUE_NAME = "unknown";
@@ -28,6 +35,16 @@ constexpr auto PUBLISH_METHOD_KAFKA_NAME = "kafka";
 constexpr auto FILE_FORMAT_JSON_NAME = "json";
 constexpr auto FILE_FORMAT_JSON_LINES_NAME = "json-lines";
 
+constexpr auto OVERFLOW_POLICY_BLOCK_NAME = "block";
+constexpr auto OVERFLOW_POLICY_DROP_OLDEST_NAME = "drop-oldest";
+constexpr auto OVERFLOW_POLICY_DROP_NEWEST_NAME = "drop-newest";
+
+// Asynchronous publishing constants
+constexpr auto DEFAULT_QUEUE_SIZE = 0;
+constexpr auto DEFAULT_BATCH_SIZE = 1;
+constexpr auto DEFAULT_BATCH_INTERVAL = 0;
+constexpr auto DEFAULT_OVERFLOW_POLICY = GVA_META_PUBLISH_OVERFLOW_BLOCK;
+
 // Broker specific constants
 constexpr auto DEFAULT_ADDRESS = "";
 constexpr auto DEFAULT_MQTTCLIENTID = "";
@@ -37,6 +54,10 @@ constexpr auto DEFAULT_MAX_CONNECT_ATTEMPTS = 1;
 constexpr auto DEFAULT_MAX_RECONNECT_INTERVAL = 30;
 
 GST_EXPORT const gchar *file_format_to_string(FileFormat format);
+GST_EXPORT const gchar *overflow_policy_to_string(OverflowPolicy policy);
 
 GST_EXPORT GType gva_metapublish_file_format_get_type(void);
 #define GST_TYPE_GVA_METAPUBLISH_FILE_FORMAT (gva_metapublish_file_format_get_type())
+
+GST_EXPORT GType gva_metapublish_overflow_policy_get_type(void);
+#define GST_TYPE_GVA_METAPUBLISH_OVERFLOW_POLICY (gva_metapublish_overflow_policy_get_type())
@@ -5,11 +5,16 @@
  ******************************************************************************/
 
 #include "gvametapublishbase.hpp"
+#include "async_publisher.hpp"
 #include "common.hpp"
 
 #include <gva_json_meta.h>
 #include <utils.h>
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+
 GST_DEBUG_CATEGORY_STATIC(gva_meta_publish_base_debug_category);
 #define GST_CAT_DEFAULT gva_meta_publish_base_debug_category
 
@@ -22,11 +27,43 @@ enum {
 enum {
     PROP_0,
     PROP_SIGNAL_HANDOFFS,
+    PROP_QUEUE_SIZE,
+    PROP_BATCH_SIZE,
+    PROP_BATCH_INTERVAL,
+    PROP_OVERFLOW_POLICY,
 };
 
 namespace {
 guint gst_interpret_signals[LAST_SIGNAL] = {0};
+
+AsyncPublisher::OverflowPolicy to_async_policy(OverflowPolicy policy) {
+    switch (policy) {
+    case GVA_META_PUBLISH_OVERFLOW_DROP_OLDEST:
+        return AsyncPublisher::OverflowPolicy::DropOldest;
+    case GVA_META_PUBLISH_OVERFLOW_DROP_NEWEST:
+        return AsyncPublisher::OverflowPolicy::DropNewest;
+    default:
+        return AsyncPublisher::OverflowPolicy::Block;
+    }
+}
+
+// Payload of several messages is a JSON array of them
+std::string join_to_json_array(const std::vector<std::string> &messages) {
+    size_t size = 2 + messages.size();
+    for (const auto &message : messages)
+        size += message.size();
+    std::string payload;
+    payload.reserve(size);
+    payload += '[';
+    for (size_t i = 0; i < messages.size(); i++) {
+        if (i)
+            payload += ',';
+        payload += messages[i];
+    }
+    payload += ']';
+    return payload;
 }
+} // namespace
 
 class GvaMetaPublishBasePrivate {
   public:
@@ -40,6 +77,18 @@ class GvaMetaPublishBasePrivate {
         case PROP_SIGNAL_HANDOFFS:
             g_value_set_boolean(value, _signal_handoffs);
             break;
+        case PROP_QUEUE_SIZE:
+            g_value_set_uint(value, _queue_size);
+            break;
+        case PROP_BATCH_SIZE:
+            g_value_set_uint(value, _batch_size);
+            break;
+        case PROP_BATCH_INTERVAL:
+            g_value_set_uint(value, _batch_interval);
+            break;
+        case PROP_OVERFLOW_POLICY:
+            g_value_set_enum(value, _overflow_policy);
+            break;
         default:
             return false;
         }
@@ -51,6 +100,18 @@ class GvaMetaPublishBasePrivate {
         case PROP_SIGNAL_HANDOFFS:
             _signal_handoffs = g_value_get_boolean(value);
             break;
+        case PROP_QUEUE_SIZE:
+            _queue_size = g_value_get_uint(value);
+            break;
+        case PROP_BATCH_SIZE:
+            _batch_size = g_value_get_uint(value);
+            break;
+        case PROP_BATCH_INTERVAL:
+            _batch_interval = g_value_get_uint(value);
+            break;
+        case PROP_OVERFLOW_POLICY:
+            _overflow_policy = static_cast<OverflowPolicy>(g_value_get_enum(value));
+            break;
         default:
             return false;
         }
@@ -69,18 +130,87 @@ class GvaMetaPublishBasePrivate {
             return GST_FLOW_OK;
         }
 
-        GvaMetaPublishBaseClass *klass = GVA_META_PUBLISH_BASE_GET_CLASS(_base);
-        if (!klass->publish(GVA_META_PUBLISH_BASE(_base), std::string(json_meta->message))) {
+        if (_publisher) {
+            if (_publish_failed) {
+                GST_DEBUG_OBJECT(_base, "Publishing has failed earlier");
+                return GST_FLOW_ERROR;
+            }
+            if (!_publisher->push(std::string(json_meta->message)))
+                GST_LOG_OBJECT(_base, "Message dropped, publish queue is full or flushing");
+            return GST_FLOW_OK;
+        }
+
+        if (!publish_batch({std::string(json_meta->message)})) {
             GST_ELEMENT_ERROR(_base, RESOURCE, NOT_FOUND, ("Failed to publish message"), (NULL));
             return GST_FLOW_ERROR;
         }
         return GST_FLOW_OK;
     }
 
+    // Messages are published from a dedicated thread unless queue-size is 0
+    void start_publisher() {
+        _publish_failed = false;
+        if (!_queue_size)
+            return;
+
+        AsyncPublisher::Options options;
+        options.queue_size = _queue_size;
+        options.batch_size = _batch_size;
+        options.batch_interval = std::chrono::milliseconds(_batch_interval);
+        options.overflow_policy = to_async_policy(_overflow_policy);
+        GST_INFO_OBJECT(_base, "Asynchronous publishing: queue size %u, batch size %u, batch interval %u ms, %s",
+                        _queue_size, _batch_size, _batch_interval, overflow_policy_to_string(_overflow_policy));
+
+        _publisher.reset(new AsyncPublisher(options, [this](const std::vector<std::string> &batch) {
+            if (publish_batch(batch))
+                return true;
+            if (!_publish_failed.exchange(true))
+                GST_ELEMENT_ERROR(_base, RESOURCE, NOT_FOUND, ("Failed to publish message"), (NULL));
+            return false;
+        }));
+    }
+
+    void flush_publisher() {
+        if (_publisher)
+            _publisher->flush();
+    }
+
+    void set_publisher_flushing(bool flushing) {
+        if (_publisher)
+            _publisher->set_flushing(flushing);
+    }
+
+    // Publishes everything queued, must be done before the publisher implementation is stopped
+    void stop_publisher() {
+        if (!_publisher)
+            return;
+        _publisher->stop();
+        auto stats = _publisher->stats();
+        GST_INFO_OBJECT(_base,
+                        "Published %" G_GUINT64_FORMAT " of %" G_GUINT64_FORMAT " messages in %" G_GUINT64_FORMAT
+                        " batches, %" G_GUINT64_FORMAT " messages dropped, %" G_GUINT64_FORMAT
+                        " batches failed, maximum queue depth %" G_GSIZE_FORMAT,
+                        stats.published, stats.queued + stats.dropped, stats.batches, stats.dropped,
+                        stats.failed_batches, stats.max_depth);
+        _publisher.reset();
+    }
+
   private:
+    gboolean publish_batch(const std::vector<std::string> &messages) {
+        GvaMetaPublishBaseClass *klass = GVA_META_PUBLISH_BASE_GET_CLASS(_base);
+        return klass->publish_batch(GVA_META_PUBLISH_BASE(_base), messages);
+    }
+
     GstBaseTransform *_base;
 
     bool _signal_handoffs = false;
+    guint _queue_size = DEFAULT_QUEUE_SIZE;
+    guint _batch_size = DEFAULT_BATCH_SIZE;
+    guint _batch_interval = DEFAULT_BATCH_INTERVAL;
+    OverflowPolicy _overflow_policy = DEFAULT_OVERFLOW_POLICY;
+
+    std::unique_ptr<AsyncPublisher> _publisher;
+    std::atomic<bool> _publish_failed{false};
 };
 
 /* class initialization */
@@ -139,6 +269,55 @@ static void gva_meta_publish_base_before_transform(GstBaseTransform *trans, GstB
         gst_object_sync_values(GST_OBJECT(trans), timestamp);
 }
 
+static gboolean gva_meta_publish_base_publish_batch(GvaMetaPublishBase *self,
+                                                    const std::vector<std::string> &messages) {
+    GvaMetaPublishBaseClass *klass = GVA_META_PUBLISH_BASE_GET_CLASS(self);
+    if (messages.size() == 1)
+        return klass->publish(self, messages.front());
+    return klass->publish(self, join_to_json_array(messages));
+}
+
+static gboolean gva_meta_publish_base_sink_event(GstBaseTransform *trans, GstEvent *event) {
+    auto impl = GVA_META_PUBLISH_BASE(trans)->impl;
+    switch (GST_EVENT_TYPE(event)) {
+    case GST_EVENT_EOS:
+        // Downstream gets EOS only after all messages are published
+        impl->flush_publisher();
+        break;
+    case GST_EVENT_FLUSH_START:
+        // Streaming thread waiting for room in the queue must not block the flush
+        impl->set_publisher_flushing(true);
+        break;
+    case GST_EVENT_FLUSH_STOP:
+        impl->set_publisher_flushing(false);
+        break;
+    default:
+        break;
+    }
+
+    return GST_BASE_TRANSFORM_CLASS(gva_meta_publish_base_parent_class)->sink_event(trans, event);
+}
+
+static GstStateChangeReturn gva_meta_publish_base_change_state(GstElement *element, GstStateChange transition) {
+    auto self = GVA_META_PUBLISH_BASE(element);
+
+    switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+        self->impl->start_publisher();
+        break;
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+        self->impl->stop_publisher();
+        break;
+    default:
+        break;
+    }
+
+    auto ret = GST_ELEMENT_CLASS(gva_meta_publish_base_parent_class)->change_state(element, transition);
+    if (transition == GST_STATE_CHANGE_READY_TO_PAUSED && ret == GST_STATE_CHANGE_FAILURE)
+        self->impl->stop_publisher();
+    return ret;
+}
+
 static void gva_meta_publish_base_class_init(GvaMetaPublishBaseClass *klass) {
     GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
 
@@ -153,17 +332,46 @@ static void gva_meta_publish_base_class_init(GvaMetaPublishBaseClass *klass) {
     gobject_class->get_property = gva_meta_publish_base_get_property;
     gobject_class->finalize = gva_meta_publish_base_finalize;
 
+    GST_ELEMENT_CLASS(klass)->change_state = gva_meta_publish_base_change_state;
+
+    base_transform_class->sink_event = gva_meta_publish_base_sink_event;
     base_transform_class->before_transform = gva_meta_publish_base_before_transform;
     base_transform_class->transform_ip = [](GstBaseTransform *base, GstBuffer *buf) {
         return GVA_META_PUBLISH_BASE(base)->impl->transform_ip(buf);
     };
 
+    klass->publish_batch = gva_meta_publish_base_publish_batch;
+
     g_object_class_install_property(
         gobject_class, PROP_SIGNAL_HANDOFFS,
         g_param_spec_boolean("signal-handoffs", "Signal handoffs", "Send signal before pushing the buffer",
                              DEFAULT_SIGNAL_HANDOFFS,
                              static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_CONSTRUCT)));
 
+    auto prm_flags = static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_CONSTRUCT);
+    g_object_class_install_property(
+        gobject_class, PROP_QUEUE_SIZE,
+        g_param_spec_uint("queue-size", "Queue Size",
+                          "Maximum number of messages waiting to be published from a dedicated thread. "
+                          "0 - messages are published synchronously on the streaming thread.",
+                          0, 65536, DEFAULT_QUEUE_SIZE, prm_flags));
+    g_object_class_install_property(
+        gobject_class, PROP_BATCH_SIZE,
+        g_param_spec_uint("batch-size", "Batch Size",
+                          "Maximum number of messages coalesced into one payload published as JSON array "
+                          "(file publisher writes them as separate records). Requires queue-size > 0.",
+                          1, 1024, DEFAULT_BATCH_SIZE, prm_flags));
+    g_object_class_install_property(
+        gobject_class, PROP_BATCH_INTERVAL,
+        g_param_spec_uint("batch-interval", "Batch Interval",
+                          "Maximum time in milliseconds a message waits for the batch to fill up. "
+                          "0 - publish messages already queued without waiting.",
+                          0, 60000, DEFAULT_BATCH_INTERVAL, prm_flags));
+    g_object_class_install_property(
+        gobject_class, PROP_OVERFLOW_POLICY,
+        g_param_spec_enum("overflow-policy", "Overflow Policy", "What to do with a message when the queue is full",
+                          GST_TYPE_GVA_METAPUBLISH_OVERFLOW_POLICY, DEFAULT_OVERFLOW_POLICY, prm_flags));
+
     gst_interpret_signals[SIGNAL_HANDOFF] = g_signal_new(
         "handoff", G_TYPE_FROM_CLASS(klass), G_SIGNAL_RUN_LAST, G_STRUCT_OFFSET(GvaMetaPublishBaseClass, handoff), NULL,
         NULL, g_cclosure_marshal_generic, G_TYPE_NONE, 1, GST_TYPE_BUFFER | G_SIGNAL_TYPE_STATIC_SCOPE);
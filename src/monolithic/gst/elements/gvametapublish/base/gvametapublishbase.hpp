@@ -10,6 +10,7 @@
 #include <gst/base/gstbasetransform.h>
 
 #include <string>
+#include <vector>
 
 G_BEGIN_DECLS
 
@@ -33,6 +34,9 @@ struct GvaMetaPublishBaseClass {
 
     void (*handoff)(GstElement *element, GstBuffer *buf);
     gboolean (*publish)(GvaMetaPublishBase *self, const std::string &message);
+    // Publishes messages coalesced by the asynchronous stage, by default a single message is passed to 'publish' and
+    // several messages are published as one JSON array
+    gboolean (*publish_batch)(GvaMetaPublishBase *self, const std::vector<std::string> &messages);
 };
 
 GVAMETAPUBLISH_EXPORTS GType gva_meta_publish_base_get_type(void);
@@ -8,8 +8,11 @@
 
 #include <common.hpp>
 
+#include <chrono>
+#include <cstdint>
 #include <stdio.h>
 #include <string>
+#include <vector>
 
 #ifdef _MSC_VER
 // MSVC alternative for gcc ftello
@@ -23,6 +26,7 @@ namespace {
 
 constexpr auto JSON_RECORD_PREFIX = ",\n";
 constexpr auto JSON_LINES_RECORD_SUFFIX = "\n";
+constexpr size_t FILE_BUFFER_SIZE = 1 << 20;
 
 } // namespace
 
@@ -31,6 +35,7 @@ enum {
     PROP_0,
     PROP_FILE_PATH,
     PROP_FILE_FORMAT,
+    PROP_FLUSH_INTERVAL,
 };
 
 class GvaMetaPublishFilePrivate {
@@ -38,7 +43,9 @@ class GvaMetaPublishFilePrivate {
     void write_message_prefix() {
         // Add comma and line feed before the record when producing a JSON
         if (_file_format == GVA_META_PUBLISH_JSON) {
-            if (ftello(_output_file) > 2) {
+            // position of the file we opened is known without asking the stream
+            bool prior_record = _output_file == stdout ? ftello(_output_file) > 2 : _records_written > 0;
+            if (prior_record) {
                 // a prior record was written, precede this message with record separator
                 fputs(JSON_RECORD_PREFIX, _output_file);
             }
@@ -52,14 +59,26 @@ class GvaMetaPublishFilePrivate {
         }
     }
 
-    bool write_message(const std::string &message) {
-        if (!_output_file)
-            return false;
+    void write_message(const std::string &message) {
         write_message_prefix();
-        fputs(message.c_str(), _output_file);
+        fwrite(message.data(), 1, message.size(), _output_file);
         write_message_suffix();
-        fflush(_output_file);
-        return true;
+        _records_written++;
+    }
+
+    // Messages are written to the stream buffer, the file is flushed at most once per flush-interval
+    bool write_messages(const std::vector<std::string> &messages) {
+        if (!_output_file)
+            return false;
+        for (const auto &message : messages)
+            write_message(message);
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= _next_flush) {
+            fflush(_output_file);
+            _next_flush = now + std::chrono::milliseconds(_flush_interval);
+        }
+        return !ferror(_output_file);
     }
 
     bool finalize_file() {
@@ -70,6 +89,7 @@ class GvaMetaPublishFilePrivate {
             fputs("]", _output_file);
         }
         fputs("\n", _output_file);
+        fflush(_output_file);
         // For any pathfile we initialized w/ fopen(), invoke corresponding fclose()
         if (_file_path != STDOUT) {
             if (fclose(_output_file) != 0) {
@@ -80,6 +100,8 @@ class GvaMetaPublishFilePrivate {
     }
 
     bool initialize_file() {
+        _records_written = 0;
+        _next_flush = {};
         if (_file_path == STDOUT) {
             _output_file = stdout;
             return true;
@@ -88,12 +110,14 @@ class GvaMetaPublishFilePrivate {
             if (!(_output_file = fopen(_file_path.c_str(), "w+"))) {
                 return false;
             }
+            setvbuf(_output_file, nullptr, _IOFBF, FILE_BUFFER_SIZE);
             // File will be an array of JSON objects. Start the array with '['
             fputs("[", _output_file);
         } else { // GVA_META_PUBLISH_JSON_LINES
             if (!(_output_file = fopen(_file_path.c_str(), "a+"))) {
                 return false;
             }
+            setvbuf(_output_file, nullptr, _IOFBF, FILE_BUFFER_SIZE);
         }
         return true;
     }
@@ -125,13 +149,13 @@ class GvaMetaPublishFilePrivate {
         return true;
     }
 
-    gboolean publish(const std::string &message) {
-        if (!write_message(message)) {
+    gboolean publish(const std::vector<std::string> &messages) {
+        if (!write_messages(messages)) {
             GST_ERROR_OBJECT(_base, "Error writing inference to file.");
             return false;
         }
 
-        GST_DEBUG_OBJECT(_base, "Message was written successfully.");
+        GST_DEBUG_OBJECT(_base, "%zu message(s) written successfully.", messages.size());
 
         return true;
     }
@@ -144,6 +168,9 @@ class GvaMetaPublishFilePrivate {
         case PROP_FILE_FORMAT:
             g_value_set_enum(value, _file_format);
             break;
+        case PROP_FLUSH_INTERVAL:
+            g_value_set_uint(value, _flush_interval);
+            break;
         default:
             return false;
         }
@@ -158,6 +185,9 @@ class GvaMetaPublishFilePrivate {
         case PROP_FILE_FORMAT:
             _file_format = static_cast<FileFormat>(g_value_get_enum(value));
             break;
+        case PROP_FLUSH_INTERVAL:
+            _flush_interval = g_value_get_uint(value);
+            break;
         default:
             return false;
         }
@@ -169,7 +199,10 @@ class GvaMetaPublishFilePrivate {
 
     std::string _file_path;
     FileFormat _file_format = GVA_META_PUBLISH_JSON;
+    guint _flush_interval = DEFAULT_FLUSH_INTERVAL;
     FILE *_output_file = nullptr;
+    uint64_t _records_written = 0;
+    std::chrono::steady_clock::time_point _next_flush;
 };
 
 G_DEFINE_TYPE_EXTENDED(GvaMetaPublishFile, gva_meta_publish_file, GST_TYPE_GVA_META_PUBLISH_BASE, 0,
@@ -221,7 +254,11 @@ static void gva_meta_publish_file_class_init(GvaMetaPublishFileClass *klass) {
     base_transform_class->stop = [](GstBaseTransform *base) { return GVA_META_PUBLISH_FILE(base)->impl->stop(); };
 
     base_metapublish_class->publish = [](GvaMetaPublishBase *base, const std::string &message) {
-        return GVA_META_PUBLISH_FILE(base)->impl->publish(message);
+        return GVA_META_PUBLISH_FILE(base)->impl->publish({message});
+    };
+    // Batched messages are written as separate records
+    base_metapublish_class->publish_batch = [](GvaMetaPublishBase *base, const std::vector<std::string> &messages) {
+        return GVA_META_PUBLISH_FILE(base)->impl->publish(messages);
     };
 
     gst_element_class_set_static_metadata(GST_ELEMENT_CLASS(klass), "File metadata publisher", "Metadata",
@@ -236,4 +273,10 @@ static void gva_meta_publish_file_class_init(GvaMetaPublishFileClass *klass) {
         gobject_class, PROP_FILE_FORMAT,
         g_param_spec_enum("file-format", "File Format", "Structure of JSON objects in the file",
                           GST_TYPE_GVA_METAPUBLISH_FILE_FORMAT, DEFAULT_FILE_FORMAT, prm_flags));
+    g_object_class_install_property(
+        gobject_class, PROP_FLUSH_INTERVAL,
+        g_param_spec_uint("flush-interval", "Flush Interval",
+                          "Minimum time in milliseconds between flushes of buffered records to the file. "
+                          "0 - flush after every write.",
+                          0, 60000, DEFAULT_FLUSH_INTERVAL, prm_flags));
 }
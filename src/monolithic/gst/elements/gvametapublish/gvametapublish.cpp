@@ -44,6 +44,11 @@ enum {
     PROP_MAX_CONNECT_ATTEMPTS,
     PROP_MAX_RECONNECT_INTERVAL,
     PROP_SIGNAL_HANDOFFS,
+    PROP_QUEUE_SIZE,
+    PROP_BATCH_SIZE,
+    PROP_BATCH_INTERVAL,
+    PROP_OVERFLOW_POLICY,
+    PROP_FLUSH_INTERVAL,
 };
 
 class GvaMetaPublishPrivate {
@@ -89,6 +94,21 @@ class GvaMetaPublishPrivate {
         case PROP_MAX_RECONNECT_INTERVAL:
             _max_reconnect_interval = g_value_get_uint(value);
             break;
+        case PROP_QUEUE_SIZE:
+            _queue_size = g_value_get_uint(value);
+            break;
+        case PROP_BATCH_SIZE:
+            _batch_size = g_value_get_uint(value);
+            break;
+        case PROP_BATCH_INTERVAL:
+            _batch_interval = g_value_get_uint(value);
+            break;
+        case PROP_OVERFLOW_POLICY:
+            _overflow_policy = static_cast<OverflowPolicy>(g_value_get_enum(value));
+            break;
+        case PROP_FLUSH_INTERVAL:
+            _flush_interval = g_value_get_uint(value);
+            break;
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(G_OBJECT(_base), prop_id, pspec);
             break;
@@ -121,6 +141,21 @@ class GvaMetaPublishPrivate {
         case PROP_MAX_RECONNECT_INTERVAL:
             g_value_set_uint(value, _max_reconnect_interval);
             break;
+        case PROP_QUEUE_SIZE:
+            g_value_set_uint(value, _queue_size);
+            break;
+        case PROP_BATCH_SIZE:
+            g_value_set_uint(value, _batch_size);
+            break;
+        case PROP_BATCH_INTERVAL:
+            g_value_set_uint(value, _batch_interval);
+            break;
+        case PROP_OVERFLOW_POLICY:
+            g_value_set_enum(value, _overflow_policy);
+            break;
+        case PROP_FLUSH_INTERVAL:
+            g_value_set_uint(value, _flush_interval);
+            break;
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(G_OBJECT(_base), prop_id, pspec);
             break;
@@ -131,15 +166,19 @@ class GvaMetaPublishPrivate {
         GST_INFO_OBJECT(_base,
                         "%s parameters:\n -- Method: %s\n -- File path: %s\n -- File format: %s\n -- Address: %s\n "
                         "-- Mqtt client ID: %s\n -- Kafka topic: %s\n -- Max connect attempts: %d\n "
-                        "-- Max reconnect interval: %d\n -- Signal handoffs: %s\n",
+                        "-- Max reconnect interval: %d\n -- Signal handoffs: %s\n -- Queue size: %u\n "
+                        "-- Batch size: %u\n -- Batch interval: %u\n -- Overflow policy: %s\n -- Flush interval: %u\n",
                         GST_ELEMENT_NAME(GST_ELEMENT_CAST(_base)), method_type_to_string(_method), _file_path.c_str(),
                         file_format_to_string(_file_format), _address.c_str(), _mqtt_client_id.c_str(), _topic.c_str(),
-                        _max_connect_attempts, _max_reconnect_interval, _signal_handoffs ? "true" : "false");
+                        _max_connect_attempts, _max_reconnect_interval, _signal_handoffs ? "true" : "false",
+                        _queue_size, _batch_size, _batch_interval, overflow_policy_to_string(_overflow_policy),
+                        _flush_interval);
 
         switch (_method) {
         case GVA_META_PUBLISH_FILE:
             if ((_metapublish = gst_element_factory_make("gvametapublishfile", nullptr)))
-                g_object_set(_metapublish, "file-format", _file_format, "file-path", _file_path.c_str(), nullptr);
+                g_object_set(_metapublish, "file-format", _file_format, "file-path", _file_path.c_str(),
+                             "flush-interval", _flush_interval, nullptr);
             break;
         case GVA_META_PUBLISH_MQTT:
             if ((_metapublish = gst_element_factory_make("gvametapublishmqtt", nullptr)))
@@ -168,7 +207,8 @@ class GvaMetaPublishPrivate {
                 method_type_to_string(_method));
             return false;
         }
-        g_object_set(_metapublish, "signal-handoffs", _signal_handoffs, nullptr);
+        g_object_set(_metapublish, "signal-handoffs", _signal_handoffs, "queue-size", _queue_size, "batch-size",
+                     _batch_size, "batch-interval", _batch_interval, "overflow-policy", _overflow_policy, nullptr);
         gst_bin_add_many(GST_BIN(_base), _metapublish, nullptr);
 
         bool ret = true;
@@ -200,6 +240,11 @@ class GvaMetaPublishPrivate {
     uint32_t _max_connect_attempts = 0;
     uint32_t _max_reconnect_interval = 0;
     bool _signal_handoffs = false;
+    uint32_t _queue_size = DEFAULT_QUEUE_SIZE;
+    uint32_t _batch_size = DEFAULT_BATCH_SIZE;
+    uint32_t _batch_interval = DEFAULT_BATCH_INTERVAL;
+    OverflowPolicy _overflow_policy = DEFAULT_OVERFLOW_POLICY;
+    uint32_t _flush_interval = DEFAULT_FLUSH_INTERVAL;
 };
 
 G_DEFINE_TYPE_EXTENDED(GvaMetaPublish, gva_meta_publish, GST_TYPE_BIN, 0, G_ADD_PRIVATE(GvaMetaPublish);
@@ -312,4 +357,32 @@ static void gva_meta_publish_class_init(GvaMetaPublishClass *klass) {
                           "[method= kafka | mqtt] Maximum time in seconds between reconnection attempts. Initial "
                           "interval is 1 second and will be doubled on each failure up to this maximum interval.",
                           1, 300, DEFAULT_MAX_RECONNECT_INTERVAL, prm_flags));
+    g_object_class_install_property(
+        gobject_class, PROP_QUEUE_SIZE,
+        g_param_spec_uint("queue-size", "Queue Size",
+                          "Maximum number of messages waiting to be published from a dedicated thread. "
+                          "0 - messages are published synchronously on the streaming thread.",
+                          0, 65536, DEFAULT_QUEUE_SIZE, prm_flags));
+    g_object_class_install_property(
+        gobject_class, PROP_BATCH_SIZE,
+        g_param_spec_uint("batch-size", "Batch Size",
+                          "Maximum number of messages coalesced into one payload published as JSON array "
+                          "(file publisher writes them as separate records). Requires queue-size > 0.",
+                          1, 1024, DEFAULT_BATCH_SIZE, prm_flags));
+    g_object_class_install_property(
+        gobject_class, PROP_BATCH_INTERVAL,
+        g_param_spec_uint("batch-interval", "Batch Interval",
+                          "Maximum time in milliseconds a message waits for the batch to fill up. "
+                          "0 - publish messages already queued without waiting.",
+                          0, 60000, DEFAULT_BATCH_INTERVAL, prm_flags));
+    g_object_class_install_property(
+        gobject_class, PROP_OVERFLOW_POLICY,
+        g_param_spec_enum("overflow-policy", "Overflow Policy", "What to do with a message when the queue is full",
+                          GST_TYPE_GVA_METAPUBLISH_OVERFLOW_POLICY, DEFAULT_OVERFLOW_POLICY, prm_flags));
+    g_object_class_install_property(
+        gobject_class, PROP_FLUSH_INTERVAL,
+        g_param_spec_uint("flush-interval", "Flush Interval",
+                          "[method= file] Minimum time in milliseconds between flushes of buffered records to the "
+                          "file. 0 - flush after every write.",
+                          0, 60000, DEFAULT_FLUSH_INTERVAL, prm_flags));
 }
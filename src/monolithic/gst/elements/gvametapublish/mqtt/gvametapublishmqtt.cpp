@@ -12,7 +12,10 @@
 #include <MQTTAsync.h>
 #include <uuid/uuid.h>
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -90,12 +93,45 @@ class GvaMetaPublishMqttPrivate {
         _connection_attempt++;
         _sleep_time = std::min(2 * _sleep_time, _max_reconnect_interval);
 
-        std::this_thread::sleep_for(std::chrono::seconds(_sleep_time));
-        GST_DEBUG_OBJECT(_base, "Attempt %d to connect to MQTT.", _connection_attempt);
-        auto c = MQTTAsync_connect(_client, &_connect_options);
-        if (c != MQTTASYNC_SUCCESS) {
-            GST_ERROR_OBJECT(_base, "Failed to start connection attempt to MQTT. Error code %d.", c);
+        // Client callbacks must not block, connection is retried from the reconnect thread
+        {
+            std::lock_guard<std::mutex> lock(_reconnect_mutex);
+            _reconnect_at = std::chrono::steady_clock::now() + std::chrono::seconds(_sleep_time);
+            _reconnect_pending = true;
         }
+        _reconnect_cv.notify_one();
+    }
+
+    void reconnect_loop() {
+        std::unique_lock<std::mutex> lock(_reconnect_mutex);
+        while (!_reconnect_stopping) {
+            if (!_reconnect_pending) {
+                _reconnect_cv.wait(lock, [this] { return _reconnect_pending || _reconnect_stopping; });
+                continue;
+            }
+            if (_reconnect_cv.wait_until(lock, _reconnect_at, [this] { return _reconnect_stopping; }))
+                break;
+            _reconnect_pending = false;
+            lock.unlock();
+
+            GST_DEBUG_OBJECT(_base, "Attempt %d to connect to MQTT.", _connection_attempt);
+            auto c = MQTTAsync_connect(_client, &_connect_options);
+            if (c != MQTTASYNC_SUCCESS) {
+                GST_ERROR_OBJECT(_base, "Failed to start connection attempt to MQTT. Error code %d.", c);
+            }
+            lock.lock();
+        }
+    }
+
+    void stop_reconnect_thread() {
+        {
+            std::lock_guard<std::mutex> lock(_reconnect_mutex);
+            _reconnect_stopping = true;
+            _reconnect_pending = false;
+        }
+        _reconnect_cv.notify_one();
+        if (_reconnect_thread.joinable())
+            _reconnect_thread.join();
     }
 
   public:
@@ -138,6 +174,7 @@ class GvaMetaPublishMqttPrivate {
     }
 
     ~GvaMetaPublishMqttPrivate() {
+        stop_reconnect_thread();
         MQTTAsync_destroy(&_client);
         GST_DEBUG("Successfully freed MQTT client.");
     }
@@ -184,6 +221,10 @@ class GvaMetaPublishMqttPrivate {
             return false;
         }
 
+        _reconnect_stopping = false;
+        _reconnect_pending = false;
+        _reconnect_thread = std::thread(&GvaMetaPublishMqttPrivate::reconnect_loop, this);
+
         auto c = MQTTAsync_connect(_client, &_connect_options);
         if (c != MQTTASYNC_SUCCESS) {
             GST_ERROR_OBJECT(_base, "Failed to start connection attempt to MQTT. Error code %d.", c);
@@ -226,6 +267,7 @@ class GvaMetaPublishMqttPrivate {
     }
 
     gboolean stop() {
+        stop_reconnect_thread();
         if (!MQTTAsync_isConnected(_client)) {
             GST_DEBUG_OBJECT(_base, "MQTT client is not connected. Nothing to disconnect");
             return true;
@@ -301,6 +343,13 @@ class GvaMetaPublishMqttPrivate {
     MQTTAsync_disconnectOptions _disconnect_options;
     uint32_t _connection_attempt;
     uint32_t _sleep_time;
+
+    std::thread _reconnect_thread;
+    std::mutex _reconnect_mutex;
+    std::condition_variable _reconnect_cv;
+    std::chrono::steady_clock::time_point _reconnect_at;
+    bool _reconnect_pending = false;
+    bool _reconnect_stopping = false;
 };
 
 G_DEFINE_TYPE_EXTENDED(GvaMetaPublishMqtt, gva_meta_publish_mqtt, GST_TYPE_GVA_META_PUBLISH_BASE, 0,
@@ -20,13 +20,28 @@
 GST_DEBUG_CATEGORY_STATIC(gst_gva_python_debug_category);
 #define GST_CAT_DEFAULT gst_gva_python_debug_category
 
-enum { PROP_0, PROP_MODULE, PROP_CLASS, PROP_FUNCTION, PROP_ARGUMENT, PROP_KW_ARGUMENT };
+enum {
+    PROP_0,
+    PROP_MODULE,
+    PROP_CLASS,
+    PROP_FUNCTION,
+    PROP_ARGUMENT,
+    PROP_KW_ARGUMENT,
+    PROP_BATCH_SIZE,
+    PROP_BATCH_TIMEOUT,
+    PROP_BATCH_FUNCTION
+};
 
 #define DEFAULT_MODULE ""
 #define DEFAULT_CLASS ""
 #define DEFAULT_FUNCTION "process_frame"
 #define DEFAULT_ARGUMENT "[]"
 #define DEFAULT_KW_ARGUMENT "{}"
+#define DEFAULT_BATCH_SIZE 0
+#define DEFAULT_BATCH_TIMEOUT 50
+#define DEFAULT_BATCH_FUNCTION "process_frames"
+// Buffers queued for the batch worker, in batches
+#define BATCH_QUEUE_DEPTH 2
 
 #ifdef NDEBUG
 #define LOG_PYTHON_ERROR(ELEMENT, ...) GST_ERROR_OBJECT(ELEMENT, __VA_ARGS__)
@@ -39,8 +54,12 @@ enum { PROP_0, PROP_MODULE, PROP_CLASS, PROP_FUNCTION, PROP_ARGUMENT, PROP_KW_AR
 /* prototypes */
 static void gst_gva_python_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
 static void gst_gva_python_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+static gboolean gst_gva_python_start_batch_worker(GstGvaPython *gvapython);
 static gboolean gst_gva_python_set_caps(GstBaseTransform *trans, GstCaps *incaps, GstCaps *outcaps);
 static gboolean gst_gva_python_start(GstBaseTransform *trans);
+static gboolean gst_gva_python_stop(GstBaseTransform *trans);
+static gboolean gst_gva_python_sink_event(GstBaseTransform *trans, GstEvent *event);
+static GstFlowReturn gst_gva_python_generate_output(GstBaseTransform *trans, GstBuffer **outbuf);
 static void gst_gva_python_dispose(GObject *object);
 static void gst_gva_python_finalize(GObject *object);
 
@@ -80,6 +99,9 @@ static void gst_gva_python_class_init(GstGvaPythonClass *klass) {
     gobject_class->dispose = gst_gva_python_dispose;
     gobject_class->finalize = gst_gva_python_finalize;
     base_transform_class->start = GST_DEBUG_FUNCPTR(gst_gva_python_start);
+    base_transform_class->stop = GST_DEBUG_FUNCPTR(gst_gva_python_stop);
+    base_transform_class->sink_event = GST_DEBUG_FUNCPTR(gst_gva_python_sink_event);
+    base_transform_class->generate_output = GST_DEBUG_FUNCPTR(gst_gva_python_generate_output);
     base_transform_class->set_caps = GST_DEBUG_FUNCPTR(gst_gva_python_set_caps);
     base_transform_class->transform = NULL;
     base_transform_class->transform_ip = GST_DEBUG_FUNCPTR(gst_gva_python_transform_ip);
@@ -115,6 +137,26 @@ static void gst_gva_python_class_init(GstGvaPythonClass *klass) {
     g_object_class_install_property(gobject_class, PROP_FUNCTION,
                                     g_param_spec_string("function", "Python function name", "Python function name",
                                                         DEFAULT_FUNCTION, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+    g_object_class_install_property(
+        gobject_class, PROP_BATCH_SIZE,
+        g_param_spec_uint("batch-size", "Batch size",
+                          "(optional) If non-zero, frames are collected into batches of up to batch-size frames and "
+                          "passed as a list to 'batch-function' on a separate thread, so the GIL is taken once per "
+                          "batch. The function returns a list with a value per frame or a single value for all frames, "
+                          "frames with false values are dropped. If zero, 'function' is called for every frame.",
+                          0, 1024, DEFAULT_BATCH_SIZE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+    g_object_class_install_property(
+        gobject_class, PROP_BATCH_TIMEOUT,
+        g_param_spec_uint("batch-timeout", "Batch timeout",
+                          "Maximum time in milliseconds to wait for a batch to fill up, counted from arrival of its "
+                          "first frame. Incomplete batch is processed on timeout.",
+                          0, G_MAXUINT, DEFAULT_BATCH_TIMEOUT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+    g_object_class_install_property(
+        gobject_class, PROP_BATCH_FUNCTION,
+        g_param_spec_string("batch-function", "Python batch function name",
+                            "Python function called with a list of frames if batch-size is non-zero",
+                            DEFAULT_BATCH_FUNCTION, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void gst_gva_python_init(GstGvaPython *gvapython) {
@@ -123,7 +165,11 @@ static void gst_gva_python_init(GstGvaPython *gvapython) {
     gvapython->class_name = NULL;
     create_arguments(&gvapython->args, &gvapython->kwargs);
     gvapython->function_name = g_strdup(DEFAULT_FUNCTION);
+    gvapython->batch_size = DEFAULT_BATCH_SIZE;
+    gvapython->batch_timeout = DEFAULT_BATCH_TIMEOUT;
+    gvapython->batch_function_name = g_strdup(DEFAULT_BATCH_FUNCTION);
     gvapython->python_callback = NULL;
+    gvapython->batch_worker = NULL;
 }
 
 void gst_gva_python_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec) {
@@ -150,6 +196,15 @@ void gst_gva_python_get_property(GObject *object, guint property_id, GValue *val
         g_value_set_string(value, argument_string);
         g_free(argument_string);
         break;
+    case PROP_BATCH_SIZE:
+        g_value_set_uint(value, gvapython->batch_size);
+        break;
+    case PROP_BATCH_TIMEOUT:
+        g_value_set_uint(value, gvapython->batch_timeout);
+        break;
+    case PROP_BATCH_FUNCTION:
+        g_value_set_string(value, gvapython->batch_function_name);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -185,6 +240,16 @@ void gst_gva_python_set_property(GObject *object, guint property_id, const GValu
                               ("%s is invalid JSON", g_value_get_string(value)));
         }
         break;
+    case PROP_BATCH_SIZE:
+        gvapython->batch_size = g_value_get_uint(value);
+        break;
+    case PROP_BATCH_TIMEOUT:
+        gvapython->batch_timeout = g_value_get_uint(value);
+        break;
+    case PROP_BATCH_FUNCTION:
+        g_free(gvapython->batch_function_name);
+        gvapython->batch_function_name = g_value_dup_string(value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -195,7 +260,7 @@ static gboolean gst_gva_python_start(GstBaseTransform *trans) {
     GstGvaPython *gvapython = GST_GVA_PYTHON(trans);
     GST_DEBUG_OBJECT(gvapython, "start");
     if (gvapython->python_callback) {
-        return TRUE;
+        return gst_gva_python_start_batch_worker(gvapython);
     }
     gchar *argument_string = NULL;
     gchar *keyword_argument_string = NULL;
@@ -204,7 +269,8 @@ static gboolean gst_gva_python_start(GstBaseTransform *trans) {
         GST_ELEMENT_ERROR(gvapython, LIBRARY, INIT, ("Error creating Python callback"), ("Invalid module"));
         return FALSE;
     }
-    if (!gvapython->function_name) {
+    const gchar *function_name = gvapython->batch_size ? gvapython->batch_function_name : gvapython->function_name;
+    if (!function_name) {
         GST_ERROR_OBJECT(gvapython, "Parameter 'function-name' is null");
         GST_ELEMENT_ERROR(gvapython, LIBRARY, INIT, ("Error creating Python callback."), ("Invalid function name."));
         return FALSE;
@@ -214,26 +280,62 @@ static gboolean gst_gva_python_start(GstBaseTransform *trans) {
 
     GST_INFO_OBJECT(gvapython,
                     "%s parameters:\n -- Module: %s\n -- Class: %s\n -- Function: %s\n -- Arg: %s\n "
-                    "-- Keyword Arg: %s\n",
+                    "-- Keyword Arg: %s\n -- Batch size: %u\n -- Batch timeout: %u\n",
                     GST_ELEMENT_NAME(GST_ELEMENT_CAST(gvapython)), gvapython->module_name, gvapython->class_name,
-                    gvapython->function_name, argument_string, keyword_argument_string);
+                    function_name, argument_string, keyword_argument_string, gvapython->batch_size,
+                    gvapython->batch_timeout);
 
     if (keyword_argument_string && argument_string) {
-        gvapython->python_callback =
-            create_python_callback(gvapython->module_name, gvapython->class_name, gvapython->function_name,
-                                   argument_string, keyword_argument_string);
+        gvapython->python_callback = create_python_callback(gvapython->module_name, gvapython->class_name,
+                                                            function_name, argument_string, keyword_argument_string);
     }
 
     if (!gvapython->python_callback) {
         GST_ELEMENT_ERROR(trans, LIBRARY, INIT, ("Error creating Python callback"),
                           ("Module: %s\n Class: %s\n Function: %s\n Arg: %s\n Keyword Arg: %s\n",
-                           gvapython->module_name, gvapython->class_name, gvapython->function_name, argument_string,
+                           gvapython->module_name, gvapython->class_name, function_name, argument_string,
                            keyword_argument_string));
     }
 
     g_free(argument_string);
     g_free(keyword_argument_string);
-    return gvapython->python_callback != NULL;
+    return gvapython->python_callback != NULL && gst_gva_python_start_batch_worker(gvapython);
+}
+
+static gboolean gst_gva_python_stop(GstBaseTransform *trans) {
+    GstGvaPython *gvapython = GST_GVA_PYTHON(trans);
+    GST_DEBUG_OBJECT(gvapython, "stop");
+    // Buffers still queued are dropped, src pad is already inactive
+    if (gvapython->batch_worker) {
+        delete_python_batch_worker(gvapython->batch_worker);
+        gvapython->batch_worker = NULL;
+    }
+    return TRUE;
+}
+
+static gboolean gst_gva_python_sink_event(GstBaseTransform *trans, GstEvent *event) {
+    GstGvaPython *gvapython = GST_GVA_PYTHON(trans);
+    if (gvapython->batch_worker) {
+        // Keep serialized events (caps, segment, EOS, ...) in order with the buffers processed on the batch thread
+        if (GST_EVENT_IS_SERIALIZED(event))
+            drain_python_batch_worker(gvapython->batch_worker);
+        // Pushes failed while flushing, start over
+        if (GST_EVENT_TYPE(event) == GST_EVENT_FLUSH_STOP)
+            reset_python_batch_worker(gvapython->batch_worker);
+    }
+    return GST_BASE_TRANSFORM_CLASS(gst_gva_python_parent_class)->sink_event(trans, event);
+}
+
+static gboolean gst_gva_python_start_batch_worker(GstGvaPython *gvapython) {
+    if (!gvapython->batch_size || gvapython->batch_worker)
+        return TRUE;
+    gvapython->batch_worker = create_python_batch_worker(gvapython, gvapython->batch_size, gvapython->batch_timeout,
+                                                         gvapython->batch_size * BATCH_QUEUE_DEPTH);
+    if (!gvapython->batch_worker) {
+        GST_ELEMENT_ERROR(gvapython, LIBRARY, INIT, ("Error creating Python batch worker"), (NULL));
+        return FALSE;
+    }
+    return TRUE;
 }
 
 static gboolean gst_gva_python_set_caps(GstBaseTransform *trans, GstCaps *incaps, GstCaps *outcaps) {
@@ -264,6 +366,8 @@ void gst_gva_python_finalize(GObject *object) {
     gvapython->class_name = NULL;
     g_free(gvapython->function_name);
     gvapython->function_name = NULL;
+    g_free(gvapython->batch_function_name);
+    gvapython->batch_function_name = NULL;
 
     if (gvapython->python_callback) {
         delete_python_callback(gvapython->python_callback);
@@ -288,6 +392,20 @@ static GstFlowReturn gst_gva_python_transform_ip(GstBaseTransform *trans, GstBuf
     return invoke_python_callback(gvapython, buf);
 }
 
+static GstFlowReturn gst_gva_python_generate_output(GstBaseTransform *trans, GstBuffer **outbuf) {
+    GstGvaPython *gvapython = GST_GVA_PYTHON(trans);
+    if (!gvapython->batch_worker)
+        return GST_BASE_TRANSFORM_CLASS(gst_gva_python_parent_class)->generate_output(trans, outbuf);
+
+    // Batch mode: take over the input buffer, the batch thread pushes it downstream after processing
+    *outbuf = NULL;
+    GstBuffer *buffer = trans->queued_buf;
+    trans->queued_buf = NULL;
+    if (!buffer)
+        return GST_FLOW_OK;
+    return push_python_batch_worker(gvapython->batch_worker, gst_buffer_make_writable(buffer));
+}
+
 static gboolean plugin_init(GstPlugin *plugin) {
     if (!gst_element_register(plugin, "gvapython", GST_RANK_NONE, GST_TYPE_GVA_PYTHON)) {
         return FALSE;
@@ -30,7 +30,11 @@ struct _GstGvaPython {
     gchar *function_name;
     void *kwargs;
     void *args;
+    guint batch_size;
+    guint batch_timeout;
+    gchar *batch_function_name;
     struct PythonCallback *python_callback;
+    struct PythonBatchWorker *batch_worker;
 };
 
 struct _GstGvaPythonClass {
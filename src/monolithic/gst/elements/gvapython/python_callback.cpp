@@ -145,6 +145,8 @@ PythonCallback::PythonCallback(const char *module_path, const char *class_name,
 void PythonCallback::SetCaps(GstCaps *caps) {
     assert(caps && "Expected vaild caps in PythonCallback::SetCaps!");
     caps_ptr = caps;
+    py_caps.reset();
+    py_video_info.reset();
     if (!(PyObject *)py_frame_class) {
         GstStructure *caps_s = gst_caps_get_structure((const GstCaps *)caps, 0);
         const gchar *name = gst_structure_get_name(caps_s);
@@ -176,3 +178,53 @@ gboolean PythonCallback::CallPython(GstBuffer *buffer) {
     gboolean result = callPython(buffer, caps_ptr, py_frame_class, py_function);
     return result;
 }
+
+void PythonCallback::CallPythonBatch(const std::vector<GstBuffer *> &buffers, std::vector<bool> &keep) {
+    ITT_TASK(module_name.c_str());
+    if (!(PyObject *)py_caps)
+        py_caps.reset(pyg_boxed_new(caps_ptr->mini_object.type, caps_ptr, FALSE /*copy_boxed*/, FALSE /*own_ref*/),
+                      "py_caps");
+
+    DECL_WRAPPER(frames, PyList_New(buffers.size()));
+    for (size_t i = 0; i < buffers.size(); i++) {
+        GstBuffer *buffer = buffers[i];
+        DECL_WRAPPER(py_buffer,
+                     pyg_boxed_new(buffer->mini_object.type, buffer, FALSE /*copy_boxed*/, FALSE /*own_ref*/));
+        // Frame info is parsed from caps once, next frames get it ready-made
+        PyObject *video_info = py_video_info ? (PyObject *)py_video_info : Py_None;
+        PyObject *caps = py_video_info ? Py_None : (PyObject *)py_caps;
+        PyObject *frame =
+            PyObject_CallFunctionObjArgs(py_frame_class, (PyObject *)py_buffer, video_info, caps, nullptr);
+        if (!frame)
+            throw std::runtime_error("Error creating Python frame object");
+        if (!py_video_info && PyObject_HasAttrString(frame, "video_info")) {
+            PyObject *info = PyObject_CallMethod(frame, "video_info", nullptr);
+            if (info && info != Py_None)
+                py_video_info.reset(info);
+            else
+                Py_XDECREF(info);
+            PyErr_Clear();
+        }
+        PyList_SET_ITEM((PyObject *)frames, i, frame); // steals reference
+    }
+
+    PyObjectWrapper result(PyObject_CallFunctionObjArgs(py_function, (PyObject *)frames, nullptr));
+    PyObject *py_result = result;
+    if (py_result == nullptr) {
+        throw std::runtime_error("Error in Python function");
+    }
+
+    if (!PyList_Check(py_result) && !PyTuple_Check(py_result)) {
+        keep.assign(buffers.size(), PyObject_IsTrue(py_result) == 1);
+        return;
+    }
+    const size_t size = static_cast<size_t>(PySequence_Size(py_result));
+    if (size != buffers.size())
+        throw std::runtime_error("Python function returned " + std::to_string(size) + " results for " +
+                                 std::to_string(buffers.size()) + " frames");
+    keep.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        PyObject *item = PyList_Check(py_result) ? PyList_GET_ITEM(py_result, i) : PyTuple_GET_ITEM(py_result, i);
+        keep[i] = PyObject_IsTrue(item) == 1;
+    }
+}
@@ -10,11 +10,16 @@
 
 #include <gst/video/video.h>
 
+#include <vector>
+
 class PythonCallback {
     PyObjectWrapper py_function;
     PyObjectWrapper py_frame_class;
     std::string module_name;
     GstCaps *caps_ptr;
+    // Reused for all frames of the stream in batch mode, reset on caps change
+    PyObjectWrapper py_caps;
+    PyObjectWrapper py_video_info;
 
   public:
     PythonCallback(const char *module_path, const char *class_name, const char *function_name, const char *args_string,
@@ -23,6 +28,9 @@ class PythonCallback {
     ~PythonCallback() = default;
 
     gboolean CallPython(GstBuffer *buf);
+    // Calls function once with list of frames. Sets 'keep' to per-frame result: function returns either a sequence
+    // with one value per frame or a single value applied to all frames
+    void CallPythonBatch(const std::vector<GstBuffer *> &buffers, std::vector<bool> &keep);
 };
 
 class PythonContextInitializer {
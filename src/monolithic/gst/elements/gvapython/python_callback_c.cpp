@@ -9,7 +9,12 @@
 #include "python_callback.h"
 
 #include "utils.h"
+#include <dlstreamer/base/blocking_queue.h>
 #include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <thread>
 using nlohmann::json;
 
 namespace {
@@ -200,3 +205,145 @@ void delete_python_callback(struct PythonCallback *python_callback) {
         GST_ERROR("%s", e.what());
     }
 }
+
+/**
+ * Collects buffers into batches on a dedicated thread and calls Python function once per batch, so GIL is acquired
+ * once per batch and the streaming thread never waits for it. Processed buffers are pushed to the src pad in order.
+ */
+class PythonBatchWorker {
+  public:
+    PythonBatchWorker(GstGvaPython *gvapython, size_t batch_size, std::chrono::milliseconds batch_timeout,
+                      size_t queue_size)
+        : _gvapython(gvapython), _batch_size(batch_size), _batch_timeout(batch_timeout), _queue(queue_size) {
+        _thread = std::thread(&PythonBatchWorker::run, this);
+    }
+
+    ~PythonBatchWorker() {
+        _stopping = true;
+        _queue.close();
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    // Takes ownership of buffer. Waits if queue is full, returns error of previously processed buffers if any
+    GstFlowReturn push(GstBuffer *buffer) {
+        GstFlowReturn ret = _flow_ret.load();
+        if (ret != GST_FLOW_OK) {
+            gst_buffer_unref(buffer);
+            return ret;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _in_flight++;
+        }
+        if (!_queue.push(buffer)) {
+            gst_buffer_unref(buffer);
+            finished(1);
+            return GST_FLOW_FLUSHING;
+        }
+        return GST_FLOW_OK;
+    }
+
+    // Waits until all pushed buffers are processed and sent downstream
+    void drain() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _drained.wait(lock, [this] { return _in_flight == 0; });
+    }
+
+    void reset_flow_return() {
+        _flow_ret = GST_FLOW_OK;
+    }
+
+  private:
+    void run() {
+        std::vector<GstBuffer *> batch;
+        std::vector<bool> keep;
+        for (;;) {
+            // Timeout counts from arrival of the first buffer of a batch
+            GstBuffer *first = _queue.pop();
+            if (!first)
+                break; // closed and empty
+            batch.assign(1, first);
+            if (_batch_size > 1) {
+                auto rest = _queue.pop_batch(_batch_size - 1, std::chrono::steady_clock::now() + _batch_timeout);
+                batch.insert(batch.end(), rest.begin(), rest.end());
+            }
+            process(batch, keep);
+            finished(batch.size());
+        }
+    }
+
+    void process(const std::vector<GstBuffer *> &batch, std::vector<bool> &keep) {
+        GstFlowReturn ret = _stopping ? GST_FLOW_FLUSHING : _flow_ret.load();
+        if (ret == GST_FLOW_OK) {
+            auto context_initializer = PythonContextInitializer();
+            try {
+                _gvapython->python_callback->CallPythonBatch(batch, keep);
+            } catch (const std::exception &e) {
+                GST_ERROR_OBJECT(_gvapython, "%s", Utils::createNestedErrorMsg(e).c_str());
+                log_python_error(_gvapython, true);
+                PyErr_Clear();
+                ret = GST_FLOW_ERROR;
+            }
+        }
+
+        // Python context is released here, downstream elements may take the GIL themselves
+        GstPad *srcpad = GST_BASE_TRANSFORM_SRC_PAD(_gvapython);
+        for (size_t i = 0; i < batch.size(); i++) {
+            if (ret != GST_FLOW_OK || !keep[i]) {
+                gst_buffer_unref(batch[i]);
+                continue;
+            }
+            ret = gst_pad_push(srcpad, batch[i]);
+        }
+        if (ret != GST_FLOW_OK) {
+            GstFlowReturn expected = GST_FLOW_OK;
+            _flow_ret.compare_exchange_strong(expected, ret);
+        }
+    }
+
+    void finished(size_t count) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _in_flight -= count;
+        }
+        _drained.notify_all();
+    }
+
+    GstGvaPython *_gvapython;
+    const size_t _batch_size;
+    const std::chrono::milliseconds _batch_timeout;
+    dlstreamer::BlockingQueue<GstBuffer *> _queue;
+    std::atomic<GstFlowReturn> _flow_ret{GST_FLOW_OK};
+    std::atomic<bool> _stopping{false};
+    std::mutex _mutex;
+    std::condition_variable _drained;
+    size_t _in_flight = 0;
+    std::thread _thread;
+};
+
+PythonBatchWorker *create_python_batch_worker(GstGvaPython *gvapython, guint batch_size, guint batch_timeout,
+                                              guint queue_size) {
+    try {
+        return new PythonBatchWorker(gvapython, batch_size, std::chrono::milliseconds(batch_timeout), queue_size);
+    } catch (const std::exception &e) {
+        GST_ERROR_OBJECT(gvapython, "%s", Utils::createNestedErrorMsg(e).c_str());
+        return nullptr;
+    }
+}
+
+GstFlowReturn push_python_batch_worker(PythonBatchWorker *worker, GstBuffer *buffer) {
+    return worker->push(buffer);
+}
+
+void drain_python_batch_worker(PythonBatchWorker *worker) {
+    worker->drain();
+}
+
+void reset_python_batch_worker(PythonBatchWorker *worker) {
+    worker->reset_flow_return();
+}
+
+void delete_python_batch_worker(PythonBatchWorker *worker) {
+    delete worker;
+}
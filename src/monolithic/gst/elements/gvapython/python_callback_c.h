@@ -12,6 +12,7 @@
 G_BEGIN_DECLS
 
 typedef struct PythonCallback PythonCallback;
+typedef struct PythonBatchWorker PythonBatchWorker;
 
 gboolean set_python_callback_caps(struct PythonCallback *python_callback, GstCaps *caps);
 
@@ -21,6 +22,13 @@ GstFlowReturn invoke_python_callback(GstGvaPython *gvapython, GstBuffer *buffer)
 void delete_python_callback(struct PythonCallback *python_callback);
 void log_python_error(GstGvaPython *gvapython, gboolean is_fatal);
 
+PythonBatchWorker *create_python_batch_worker(GstGvaPython *gvapython, guint batch_size, guint batch_timeout,
+                                              guint queue_size);
+GstFlowReturn push_python_batch_worker(PythonBatchWorker *worker, GstBuffer *buffer);
+void drain_python_batch_worker(PythonBatchWorker *worker);
+void reset_python_batch_worker(PythonBatchWorker *worker);
+void delete_python_batch_worker(PythonBatchWorker *worker);
+
 void create_arguments(void **args, void **kwargs);
 gboolean update_arguments(const char *argument, void **args);
 gboolean update_keyword_arguments(const char *argument, void **kwargs);
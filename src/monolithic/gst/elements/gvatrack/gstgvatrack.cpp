@@ -5,6 +5,7 @@
  ******************************************************************************/
 
 #include "gstgvatrack.h"
+#include "gva_utils.h"
 #include "tracker_factory.h"
 #include "utils.h"
 #include "video_frame.h"
@@ -351,6 +352,12 @@ static GstFlowReturn gst_gva_track_transform_ip(GstBaseTransform *trans, GstBuff
             GVA::VideoFrame video_frame(buf, gva_track->info);
 
             gva_track->tracker->track(gstbuffer, video_frame);
+
+            // lets downstream elements drop state of the objects, e.g. gvaclassify history
+            const std::vector<int> removed = gva_track->tracker->removed_objects();
+            if (!removed.empty())
+                gst_pad_push_event(GST_BASE_TRANSFORM_SRC_PAD(trans),
+                                   gva_event_new_objects_removed(removed.data(), removed.size()));
         } catch (const std::exception &e) {
             GST_ELEMENT_ERROR(gva_track, STREAM, FAILED, ("transform_ip failed"),
                               ("%s", Utils::createNestedErrorMsg(e).c_str()));
@@ -9,8 +9,14 @@
 #include <dlstreamer/frame.h>
 #include <video_frame.h>
 
+#include <vector>
+
 class ITracker {
   public:
     virtual ~ITracker() = default;
     virtual void track(dlstreamer::FramePtr buffer, GVA::VideoFrame &frame_meta) = 0;
+    // Returns ids of objects that stopped being tracked during last track() call
+    virtual std::vector<int> removed_objects() const {
+        return {};
+    }
 };
@@ -21,6 +21,7 @@ namespace {
 
 constexpr int DEFAULT_MAX_NUM_OBJECTS = -1;
 constexpr bool DEFAULT_TRACKING_PER_CLASS = true;
+constexpr auto DEFAULT_ASSOCIATION_SOLVER = "sparse";
 constexpr int NO_ASSOCIATION = -1;
 
 bool CaseInsCompare(const std::string &s1, const std::string &s2) {
@@ -148,6 +149,17 @@ Tracker::Tracker(const std::string &device, vas::ot::TrackingType tracking_type,
             builder->tracking_per_class = Utils::strToBool(iter->second);
             cfg.erase(iter);
         }
+
+        // "hungarian" keeps dense association solver, e.g. to compare tracking results
+        std::string association_solver = DEFAULT_ASSOCIATION_SOLVER;
+        iter = cfg.find("association_solver");
+        if (iter != cfg.end()) {
+            association_solver = iter->second;
+            if (association_solver != "sparse" && association_solver != "hungarian")
+                throw std::invalid_argument("Expected 'sparse' or 'hungarian'");
+            cfg.erase(iter);
+        }
+        builder->dense_association = association_solver == "hungarian";
     } catch (...) {
         if (iter == cfg.end())
             std::throw_with_nested(std::runtime_error("Error occured while parsing key/value parameters"));
@@ -159,6 +171,7 @@ Tracker::Tracker(const std::string &device, vas::ot::TrackingType tracking_type,
     GVA_INFO("-- input_image_format: %d", static_cast<int>(builder->input_image_format));
     GVA_INFO("-- max_num_objects: %#x", builder->max_num_objects);
     GVA_INFO("-- tracking_per_class: %u", builder->tracking_per_class);
+    GVA_INFO("-- association_solver: %s", builder->dense_association ? "hungarian" : "sparse");
 
     builder->backend_type = backend_type;
     GVA_INFO("-- backend_type: %d", static_cast<int>(builder->backend_type));
@@ -187,6 +200,16 @@ void Tracker::track(dls::FramePtr buffer, GVA::VideoFrame &frame_meta) {
         throw std::runtime_error("Track: error while tracking objects");
     }
 
+    std::unordered_set<int> alive_objects;
+    for (const auto &tracked_object : tracked_objects)
+        alive_objects.insert(static_cast<int>(tracked_object.tracking_id));
+    _removed_objects.clear();
+    for (int id : _alive_objects) {
+        if (!alive_objects.count(id))
+            _removed_objects.push_back(id);
+    }
+    _alive_objects = std::move(alive_objects);
+
     for (const auto &tracked_object : tracked_objects) {
         if (tracked_object.status == vas::ot::TrackingStatus::LOST)
             continue;
@@ -200,4 +223,8 @@ void Tracker::track(dls::FramePtr buffer, GVA::VideoFrame &frame_meta) {
     }
 }
 
+std::vector<int> Tracker::removed_objects() const {
+    return _removed_objects;
+}
+
 } // namespace VasWrapper
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "itracker.h"
 #include <dlstreamer/base/memory_mapper.h>
@@ -24,10 +25,13 @@ class Tracker : public ITracker {
     ~Tracker() = default;
 
     void track(dlstreamer::FramePtr buffer, GVA::VideoFrame &frame_meta) override;
+    std::vector<int> removed_objects() const override;
 
   private:
     std::unique_ptr<class TrackerBackend> _impl;
     std::unordered_map<int, std::string> labels;
+    std::unordered_set<int> _alive_objects; // tracked or lost, but not yet removed by the tracker
+    std::vector<int> _removed_objects;
 };
 
 } // namespace VasWrapper
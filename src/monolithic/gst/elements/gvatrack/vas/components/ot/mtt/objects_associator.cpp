@@ -11,6 +11,8 @@
 #include "vas/components/ot/mtt/spatial_rgb_histogram.h"
 #include "vas/components/ot/prof_def.h"
 
+#include "sparse_assignment.h"
+
 namespace vas {
 namespace ot {
 
@@ -20,7 +22,8 @@ const float kRgbHistDistScale = 0.25f;
 const float kNormCenterDistScale = 0.5f;
 const float kNormShapeDistScale = 0.75f;
 
-ObjectsAssociator::ObjectsAssociator(bool tracking_per_class) : tracking_per_class_(tracking_per_class) {
+ObjectsAssociator::ObjectsAssociator(bool tracking_per_class, bool dense_association)
+    : tracking_per_class_(tracking_per_class), dense_association_(dense_association) {
 }
 
 ObjectsAssociator::~ObjectsAssociator() {
@@ -30,6 +33,15 @@ std::pair<std::vector<bool>, std::vector<int32_t>>
 ObjectsAssociator::Associate(const std::vector<Detection> &detections,
                              const std::vector<std::shared_ptr<Tracklet>> &tracklets,
                              const std::vector<cv::Mat> *detection_rgb_features) {
+    if (dense_association_)
+        return AssociateDense(detections, tracklets, detection_rgb_features);
+    return AssociateSparse(detections, tracklets, detection_rgb_features);
+}
+
+std::pair<std::vector<bool>, std::vector<int32_t>>
+ObjectsAssociator::AssociateDense(const std::vector<Detection> &detections,
+                                  const std::vector<std::shared_ptr<Tracklet>> &tracklets,
+                                  const std::vector<cv::Mat> *detection_rgb_features) {
     PROF_START(PROF_COMPONENTS_OT_ASSOCIATE_COMPUTE_DIST_TABLE);
     std::vector<std::vector<float>> d2t_rgb_dist_table;
 
@@ -125,6 +137,70 @@ ObjectsAssociator::Associate(const std::vector<Detection> &detections,
     return std::make_pair(d_is_associated, t_associated_d_index);
 }
 
+std::pair<std::vector<bool>, std::vector<int32_t>>
+ObjectsAssociator::AssociateSparse(const std::vector<Detection> &detections,
+                                   const std::vector<std::shared_ptr<Tracklet>> &tracklets,
+                                   const std::vector<cv::Mat> *detection_rgb_features) {
+    const size_t n_detections = detections.size();
+    const size_t n_tracklets = tracklets.size();
+
+    if (n_detections == 0 || n_tracklets == 0)
+        return std::make_pair(std::vector<bool>(n_detections, false), std::vector<int32_t>(n_tracklets, -1));
+
+    PROF_START(PROF_COMPONENTS_OT_ASSOCIATE_COMPUTE_COST_TABLE);
+    std::vector<assignment::Box> d_boxes(n_detections), t_boxes(n_tracklets);
+    std::vector<float> t_log_term(n_tracklets), t_norm_center_dist_scale(n_tracklets),
+        t_norm_shape_dist_scale(n_tracklets);
+    for (size_t t = 0; t < n_tracklets; ++t) {
+        const auto &tracklet = tracklets[t];
+        const cv::Rect2f &rect = tracklet->trajectory.back();
+
+        float const_ratio = 0.95f;
+        t_norm_center_dist_scale[t] =
+            (1.0 - const_ratio) * kNormCenterDistScale * tracklet->association_delta_t / 0.033f +
+            const_ratio * kNormCenterDistScale; // adaptive to delta_t
+        t_norm_shape_dist_scale[t] =
+            (1.0 - const_ratio) * kNormShapeDistScale * tracklet->association_delta_t / 0.033f +
+            const_ratio * kNormShapeDistScale; // adaptive to delta_t
+        t_log_term[t] = logf(kRgbHistDistScale * t_norm_center_dist_scale[t] * t_norm_shape_dist_scale[t]);
+        t_boxes[t] = {rect.x, rect.y, rect.width, rect.height};
+    }
+    for (size_t d = 0; d < n_detections; ++d) {
+        const cv::Rect2f &rect = detections[d].rect;
+        TRACE("input detect(%.0f,%.0f %.0fx%.0f)", rect.x, rect.y, rect.width, rect.height);
+        d_boxes[d] = {rect.x, rect.y, rect.width, rect.height};
+    }
+
+    RgbFeatures rgb_features;
+    if (detection_rgb_features != nullptr)
+        rgb_features = NormalizeRgbFeatures(*detection_rgb_features, tracklets);
+
+    const assignment::SparseCostMatrix d2t_costs = assignment::gatedCosts(
+        d_boxes, t_boxes, t_log_term, t_norm_center_dist_scale, kAssociationCostThreshold, [&](size_t d, size_t t) {
+            if (tracking_per_class_ && (detections[d].class_label != tracklets[t]->label))
+                return kAssociationCostThreshold;
+
+            const cv::Rect2f &rect = detections[d].rect;
+            const cv::Rect2f &t_rect = tracklets[t]->trajectory.back();
+            float cost = t_log_term[t] + NormalizedCenterDistance(rect, t_rect) / t_norm_center_dist_scale[t] +
+                         NormalizedShapeDistance(rect, t_rect) / t_norm_shape_dist_scale[t];
+            // RGB distance is non-negative, so it is computed only for pairs which may still be associated
+            if (cost >= kAssociationCostThreshold)
+                return cost;
+            if (detection_rgb_features != nullptr)
+                cost += RgbDistance(rgb_features, d, t) / kRgbHistDistScale;
+            return cost;
+        });
+    PROF_END(PROF_COMPONENTS_OT_ASSOCIATE_COMPUTE_COST_TABLE);
+
+    // Unassigned detection costs kAssociationCostThreshold, the same as its dummy column in dense cost table
+    PROF_START(PROF_COMPONENTS_OT_ASSOCIATE_WITH_SPARSE_SOLVER);
+    const std::vector<int32_t> d_associated_t_index = assignment::solve(d2t_costs, kAssociationCostThreshold, true);
+    PROF_END(PROF_COMPONENTS_OT_ASSOCIATE_WITH_SPARSE_SOLVER);
+
+    return assignment::toAssociation(d_associated_t_index, n_tracklets);
+}
+
 std::vector<std::vector<float>>
 ObjectsAssociator::ComputeRgbDistance(const std::vector<Detection> &detections,
                                       const std::vector<std::shared_ptr<Tracklet>> &tracklets,
@@ -132,18 +208,23 @@ ObjectsAssociator::ComputeRgbDistance(const std::vector<Detection> &detections,
     int32_t n_detections = detections.size();
     int32_t n_tracklets = tracklets.size();
 
+    // Similarity of all detection-tracklet feature pairs in one pass
+    RgbFeatures features = NormalizeRgbFeatures(*detection_rgb_features, tracklets);
+    cv::Mat similarity;
+    RgbHistogram::ComputeSimilarityMatrix(features.detections, features.tracklets, &similarity);
+
     // Compute detection-tracklet RGB feature distance table
     std::vector<std::vector<float>> d2t_rgb_dist_table(n_detections, std::vector<float>(n_tracklets, 1000.0f));
     for (int32_t d = 0; d < n_detections; ++d) {
-        const auto &d_rgb_feature = (*detection_rgb_features)[d];
+        const float *similarity_ptr = similarity.ptr<float>(d);
         for (int32_t t = 0; t < n_tracklets; ++t) {
             if (tracking_per_class_ && (detections[d].class_label != tracklets[t]->label))
                 continue;
 
             // Find best match in rgb feature history
             float min_dist = 1000.0f;
-            for (const auto &t_rgb_feature : *(tracklets[t]->GetRgbFeatures())) {
-                min_dist = std::min(min_dist, 1.0f - RgbHistogram::ComputeSimilarity(d_rgb_feature, t_rgb_feature));
+            for (int32_t i = features.tracklet_begin[t]; i < features.tracklet_begin[t + 1]; ++i) {
+                min_dist = std::min(min_dist, 1.0f - similarity_ptr[i]);
             }
             d2t_rgb_dist_table[d][t] = min_dist;
         }
@@ -152,6 +233,38 @@ ObjectsAssociator::ComputeRgbDistance(const std::vector<Detection> &detections,
     return d2t_rgb_dist_table;
 }
 
+ObjectsAssociator::RgbFeatures
+ObjectsAssociator::NormalizeRgbFeatures(const std::vector<cv::Mat> &detection_rgb_features,
+                                        const std::vector<std::shared_ptr<Tracklet>> &tracklets) {
+    RgbFeatures features;
+
+    std::vector<const cv::Mat *> hists;
+    for (const auto &d_rgb_feature : detection_rgb_features)
+        hists.push_back(&d_rgb_feature);
+    RgbHistogram::NormalizeForSimilarity(hists, &features.detections);
+
+    hists.clear();
+    features.tracklet_begin.push_back(0);
+    for (const auto &tracklet : tracklets) {
+        for (const auto &t_rgb_feature : *(tracklet->GetRgbFeatures()))
+            hists.push_back(&t_rgb_feature);
+        features.tracklet_begin.push_back(static_cast<int32_t>(hists.size()));
+    }
+    RgbHistogram::NormalizeForSimilarity(hists, &features.tracklets);
+
+    return features;
+}
+
+float ObjectsAssociator::RgbDistance(const RgbFeatures &features, int32_t d, int32_t t) {
+    // Find best match in rgb feature history
+    float min_dist = 1000.0f;
+    const cv::Mat d_rgb_feature = features.detections.row(d);
+    for (int32_t i = features.tracklet_begin[t]; i < features.tracklet_begin[t + 1]; ++i) {
+        min_dist = std::min(min_dist, 1.0f - static_cast<float>(d_rgb_feature.dot(features.tracklets.row(i))));
+    }
+    return min_dist;
+}
+
 float ObjectsAssociator::NormalizedCenterDistance(const cv::Rect2f &r1, const cv::Rect2f &r2) {
     float normalizer = std::min(0.5f * (r1.width + r1.height), 0.5f * (r2.width + r2.height));
 
@@ -16,7 +16,10 @@ namespace ot {
 
 class ObjectsAssociator {
   public:
-    explicit ObjectsAssociator(bool tracking_per_class);
+    // Dense association solves full detection-tracklet cost table with Hungarian algorithm, otherwise only pairs of
+    // nearby detections and tracklets are scored and the sparse cost table is solved by shortest augmenting path
+    // algorithm. Both give the same association up to ties.
+    explicit ObjectsAssociator(bool tracking_per_class, bool dense_association = false);
     virtual ~ObjectsAssociator();
     ObjectsAssociator() = delete;
 
@@ -26,15 +29,34 @@ class ObjectsAssociator {
               const std::vector<cv::Mat> *detection_rgb_features = nullptr);
 
   private:
+    // RGB features normalized by RgbHistogram::NormalizeForSimilarity
+    struct RgbFeatures {
+        cv::Mat detections; // one row per detection
+        cv::Mat tracklets;  // feature histories of all tracklets
+        // history of tracklet t is in rows [tracklet_begin[t], tracklet_begin[t + 1]) of tracklets
+        std::vector<int32_t> tracklet_begin;
+    };
+
+    std::pair<std::vector<bool>, std::vector<int32_t>>
+    AssociateDense(const std::vector<Detection> &detections, const std::vector<std::shared_ptr<Tracklet>> &tracklets,
+                   const std::vector<cv::Mat> *detection_rgb_features);
+    std::pair<std::vector<bool>, std::vector<int32_t>>
+    AssociateSparse(const std::vector<Detection> &detections, const std::vector<std::shared_ptr<Tracklet>> &tracklets,
+                    const std::vector<cv::Mat> *detection_rgb_features);
+
     std::vector<std::vector<float>> ComputeRgbDistance(const std::vector<Detection> &detections,
                                                        const std::vector<std::shared_ptr<Tracklet>> &tracklets,
                                                        const std::vector<cv::Mat> *detection_rgb_features);
 
+    static RgbFeatures NormalizeRgbFeatures(const std::vector<cv::Mat> &detection_rgb_features,
+                                            const std::vector<std::shared_ptr<Tracklet>> &tracklets);
+    static float RgbDistance(const RgbFeatures &features, int32_t d, int32_t t);
     static float NormalizedCenterDistance(const cv::Rect2f &r1, const cv::Rect2f &r2);
     static float NormalizedShapeDistance(const cv::Rect2f &r1, const cv::Rect2f &r2);
 
   private:
     bool tracking_per_class_;
+    bool dense_association_;
 };
 
 }; // namespace ot
@@ -67,6 +67,33 @@ float RgbHistogram::ComputeSimilarity(const cv::Mat &hist1, const cv::Mat &hist2
     }
 }
 
+void RgbHistogram::NormalizeForSimilarity(const std::vector<const cv::Mat *> &hists, cv::Mat *normalized) {
+    const float eps = 0.0001f;
+    const int32_t hist_size = hists.empty() ? 0 : hists.front()->cols;
+    normalized->create(static_cast<int32_t>(hists.size()), hist_size, CV_32F);
+    for (int32_t i = 0; i < normalized->rows; ++i) {
+        cv::Mat row = normalized->row(i);
+        const float sum = static_cast<float>(cv::sum(*hists[i])[0]);
+        if (sum > eps) {
+            cv::sqrt(*hists[i], row);
+            row *= 1.0f / sqrtf(sum);
+        } else {
+            // the same as zero similarity of ComputeSimilarity
+            row = cv::Scalar(0);
+        }
+    }
+}
+
+void RgbHistogram::ComputeSimilarityMatrix(const cv::Mat &normalized1, const cv::Mat &normalized2,
+                                           cv::Mat *similarity) {
+    if (normalized1.empty() || normalized2.empty()) {
+        similarity->create(normalized1.rows, normalized2.rows, CV_32F);
+        (*similarity) = cv::Scalar(0);
+        return;
+    }
+    cv::gemm(normalized1, normalized2, 1.0, cv::noArray(), 0.0, *similarity, cv::GEMM_2_T);
+}
+
 void RgbHistogram::AccumulateRgbHistogram(const cv::Mat &patch, float *rgb_hist) const {
     for (int32_t y = 0; y < patch.rows; ++y) {
         const cv::Vec3b *patch_ptr = patch.ptr<cv::Vec3b>(y);
@@ -23,6 +23,15 @@ class RgbHistogram {
 
     static float ComputeSimilarity(const cv::Mat &hist1, const cv::Mat &hist2);
 
+    // Converts histograms of equal size to rows of square roots of bins scaled to unit length. Bhattacharyya
+    // coefficient of two histograms, as ComputeSimilarity returns, is the dot product of their rows, so similarity of
+    // many pairs is computed without square roots per pair.
+    static void NormalizeForSimilarity(const std::vector<const cv::Mat *> &hists, cv::Mat *normalized);
+    // Similarity of every pair of rows of two NormalizeForSimilarity results in one matrix product.
+    // Only Bhattacharyya coefficient is provided: association costs and kRgbHistDistScale of ObjectsAssociator are
+    // tuned for it, so other measures such as histogram intersection could not replace it without retuning.
+    static void ComputeSimilarityMatrix(const cv::Mat &normalized1, const cv::Mat &normalized2, cv::Mat *similarity);
+
   protected:
     int32_t rgb_bin_size_;
     int32_t rgb_num_bins_;
@@ -8,9 +8,128 @@
 
 #include "vas/components/ot/prof_def.h"
 
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SRGB_HIST_X86_KERNELS
+#include <immintrin.h>
+#endif
+
 namespace vas {
 namespace ot {
 
+namespace {
+
+// ITU-R BT.601 coefficients of YUV to RGB conversion in the same fixed-point format as OpenCV uses
+const int32_t kYuvShift = 20;
+const int32_t kYuvRound = 1 << (kYuvShift - 1);
+const int32_t kYuvCY = 1220542;
+const int32_t kYuvCUB = 2116026;
+const int32_t kYuvCUG = -409993;
+const int32_t kYuvCVG = -852492;
+const int32_t kYuvCVR = 1673527;
+
+inline int32_t SaturateToByte(int32_t value) {
+    return std::min(std::max(value, 0), 255);
+}
+
+// Histogram bin of BGR pixel, see RgbHistogram::AccumulateRgbHistogram
+void BinRowScalar(const uint8_t *y, const uint8_t *u, const uint8_t *v, int32_t uv_step, int32_t begin, int32_t end,
+                  int32_t bin_size, int32_t num_bins, int32_t *bins) {
+    for (int32_t x = begin; x < end; ++x) {
+        const int32_t c = (x / 2) * uv_step;
+        const int32_t uu = u[c] - 128;
+        const int32_t vv = v[c] - 128;
+        const int32_t yy = std::max(0, y[x] - 16) * kYuvCY;
+        const int32_t b = SaturateToByte((yy + kYuvRound + kYuvCUB * uu) >> kYuvShift);
+        const int32_t g = SaturateToByte((yy + kYuvRound + kYuvCVG * vv + kYuvCUG * uu) >> kYuvShift);
+        const int32_t r = SaturateToByte((yy + kYuvRound + kYuvCVR * vv) >> kYuvShift);
+        bins[x] = num_bins * (num_bins * (b / bin_size) + g / bin_size) + r / bin_size;
+    }
+}
+
+void BinRowDefault(const uint8_t *y, const uint8_t *u, const uint8_t *v, int32_t uv_step, int32_t width,
+                   int32_t bin_size, int32_t num_bins, int32_t *bins) {
+    BinRowScalar(y, u, v, uv_step, 0, width, bin_size, num_bins, bins);
+}
+
+#ifdef SRGB_HIST_X86_KERNELS
+
+// Saturates sum of luma and chroma terms to byte and quantizes it
+__attribute__((target("avx2"))) inline __m256i QuantizeAvx2(__m256i luma, __m256i chroma, __m128i shift) {
+    const __m256i value = _mm256_srai_epi32(_mm256_add_epi32(luma, chroma), kYuvShift);
+    const __m256i saturated = _mm256_min_epi32(_mm256_max_epi32(value, _mm256_setzero_si256()), _mm256_set1_epi32(255));
+    return _mm256_srl_epi32(saturated, shift);
+}
+
+__attribute__((target("avx2"))) void BinRowAvx2(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                                                int32_t uv_step, int32_t width, int32_t bin_size, int32_t num_bins,
+                                                int32_t *bins) {
+    // quantization by shift needs power of two bin size
+    if (bin_size <= 0 || (bin_size & (bin_size - 1))) {
+        BinRowScalar(y, u, v, uv_step, 0, width, bin_size, num_bins, bins);
+        return;
+    }
+    int32_t bin_shift = 0;
+    while ((1 << bin_shift) < bin_size)
+        ++bin_shift;
+    const __m128i shift = _mm_cvtsi32_si128(bin_shift);
+
+    const __m256i c16 = _mm256_set1_epi32(16);
+    const __m256i cy = _mm256_set1_epi32(kYuvCY);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i bins_number = _mm256_set1_epi32(num_bins);
+    const __m128i c128 = _mm_set1_epi32(128);
+    const __m128i round = _mm_set1_epi32(kYuvRound);
+    // every chroma sample covers two neighbour pixels
+    const __m256i duplicate = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+
+    int32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        __m256i yy = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + x)));
+        yy = _mm256_mullo_epi32(_mm256_max_epi32(_mm256_sub_epi32(yy, c16), zero), cy);
+
+        const int32_t c = (x / 2) * uv_step;
+        const __m128i uu = _mm_sub_epi32(_mm_setr_epi32(u[c], u[c + uv_step], u[c + 2 * uv_step], u[c + 3 * uv_step]),
+                                         c128);
+        const __m128i vv = _mm_sub_epi32(_mm_setr_epi32(v[c], v[c + uv_step], v[c + 2 * uv_step], v[c + 3 * uv_step]),
+                                         c128);
+        const __m128i buv = _mm_add_epi32(round, _mm_mullo_epi32(uu, _mm_set1_epi32(kYuvCUB)));
+        const __m128i guv = _mm_add_epi32(_mm_add_epi32(round, _mm_mullo_epi32(vv, _mm_set1_epi32(kYuvCVG))),
+                                          _mm_mullo_epi32(uu, _mm_set1_epi32(kYuvCUG)));
+        const __m128i ruv = _mm_add_epi32(round, _mm_mullo_epi32(vv, _mm_set1_epi32(kYuvCVR)));
+
+        const __m256i b = QuantizeAvx2(yy, _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(buv), duplicate), shift);
+        const __m256i g = QuantizeAvx2(yy, _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(guv), duplicate), shift);
+        const __m256i r = QuantizeAvx2(yy, _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(ruv), duplicate), shift);
+        const __m256i index = _mm256_add_epi32(
+            _mm256_mullo_epi32(_mm256_add_epi32(_mm256_mullo_epi32(b, bins_number), g), bins_number), r);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(bins + x), index);
+    }
+    BinRowScalar(y, u, v, uv_step, x, width, bin_size, num_bins, bins);
+}
+
+#endif // SRGB_HIST_X86_KERNELS
+
+struct Kernels {
+    decltype(&BinRowDefault) bin_row = BinRowDefault;
+
+    Kernels() {
+#ifdef SRGB_HIST_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            bin_row = BinRowAvx2;
+#endif
+    }
+};
+
+const Kernels &kernels() {
+    static const Kernels instance;
+    return instance;
+}
+
+} // namespace
+
 SpatialRgbHistogram::SpatialRgbHistogram(int32_t canonical_patch_size, int32_t spatial_bin_size,
                                          int32_t spatial_bin_stride, int32_t rgb_bin_size)
     : RgbHistogram(rgb_bin_size), canonical_patch_size_(canonical_patch_size), spatial_bin_size_(spatial_bin_size),
@@ -130,38 +249,13 @@ void SpatialRgbHistogram::ComputeFromNv12(const YuvImage &image, const cv::Rect
         return;
     }
 
-    cv::Mat patch;
     YuvImage roi_patch(canonical_patch_size_, canonical_patch_size_, false);
     image.CropAndResizeNv12(cp, cv::Size2f(roi.width, roi.height), &roi_patch);
-    cv::cvtColor(roi_patch.ToCVMat(), patch, cv::COLOR_YUV2BGR_NV12);
 
-#if 0 // Debugging
-    if (false)
-    {
-        char filename[256] = {};
-        std::snprintf(filename, sizeof(filename), "C:/Users/byungilm/Desktop/vbshared/intel_exported_working/engine/imv-lib/out_win64_icc/nv12_%dx%d_%d.yuv", canonical_patch_size_, canonical_patch_size_, canonical_patch_size_);
-        std::ofstream write_file(filename, std::ofstream::out | std::ofstream::binary);
-        write_file.write(const_cast<char*>(reinterpret_cast<char*>(roi_patch.data_)), roi_patch.size_);
-        write_file.close();
-    }
-
-    const char* window_name = "Debugging ComputeFromNv12";
-    cv::namedWindow(window_name, cv::WINDOW_NORMAL | cv::WINDOW_KEEPRATIO);
-    cv::imshow(window_name, patch);
-    cv::waitKey(0);
-#endif
-
-    // Compute spatial histogram
-    for (int32_t y_bin = 0; y_bin < spatial_num_bins_; ++y_bin) {
-        int32_t y = y_bin * spatial_bin_stride_;
-        for (int32_t x_bin = 0; x_bin < spatial_num_bins_; ++x_bin) {
-            int32_t x = x_bin * spatial_bin_stride_;
-            // Compute RGB histogram per each spatial bin
-            AccumulateRgbHistogram(patch(cv::Rect(x, y, spatial_bin_size_, spatial_bin_size_)),
-                                   weight_(cv::Rect(x, y, spatial_bin_size_, spatial_bin_size_)), rgb_hist_ptr);
-            rgb_hist_ptr += rgb_hist_size_;
-        }
-    }
+    // Histogram bins are computed from YUV patch directly, without intermediate BGR patch
+    ComputeBinIndex(roi_patch.data_, roi_patch.stride_, roi_patch.data_uv_, roi_patch.data_uv_ + 1, roi_patch.stride_,
+                    2);
+    AccumulateSpatialHistogram(rgb_hist_ptr);
 
     PROF_END(PROF_COMPONENTS_OT_SHORTTERM_COMPUTE_HIST);
 }
@@ -181,40 +275,45 @@ void SpatialRgbHistogram::ComputeFromI420(const YuvImage &image, const cv::Rect
         return;
     }
 
-    cv::Mat patch;
     YuvImage roi_patch(canonical_patch_size_, canonical_patch_size_, false, YuvImage::FMT_I420);
     image.CropAndResizeI420(cp, cv::Size2f(roi.width, roi.height), &roi_patch);
-    cv::cvtColor(roi_patch.ToCVMat(), patch, cv::COLOR_YUV2BGR_I420);
 
-#if 0 // Debugging
-    if (false)
-    {
-        char filename[256] = {};
-        std::snprintf(filename, sizeof(filename), "C:/Users/byungilm/Desktop/vbshared/intel_exported_working/engine/imv-lib/out_win64_icc/nv12_%dx%d_%d.yuv", canonical_patch_size_, canonical_patch_size_, canonical_patch_size_);
-        std::ofstream write_file(filename, std::ofstream::out | std::ofstream::binary);
-        write_file.write(const_cast<char*>(reinterpret_cast<char*>(roi_patch.data_)), roi_patch.size_);
-        write_file.close();
-    }
+    // Planes are dense and follow one another, see CropAndResizeI420
+    const int32_t y_size = canonical_patch_size_ * canonical_patch_size_;
+    const uint8_t *u = roi_patch.data_ + y_size;
+    const uint8_t *v = u + y_size / 4;
+    ComputeBinIndex(roi_patch.data_, canonical_patch_size_, u, v, canonical_patch_size_ / 2, 1);
+    AccumulateSpatialHistogram(rgb_hist_ptr);
 
-    const char* window_name = "Debugging ComputeFromNv12";
-    cv::namedWindow(window_name, cv::WINDOW_NORMAL | cv::WINDOW_KEEPRATIO);
-    cv::imshow(window_name, patch);
-    cv::waitKey(0);
-#endif
+    PROF_END(PROF_COMPONENTS_OT_SHORTTERM_COMPUTE_HIST);
+}
 
-    // Compute spatial histogram
+void SpatialRgbHistogram::ComputeBinIndex(const uint8_t *y, int32_t y_stride, const uint8_t *u, const uint8_t *v,
+                                          int32_t uv_stride, int32_t uv_step) {
+    bin_index_.create(cv::Size(canonical_patch_size_, canonical_patch_size_), CV_32S);
+    const auto &k = kernels();
+    for (int32_t row = 0; row < canonical_patch_size_; ++row) {
+        const int32_t uv_offset = (row / 2) * uv_stride;
+        k.bin_row(y + row * y_stride, u + uv_offset, v + uv_offset, uv_step, canonical_patch_size_, rgb_bin_size_,
+                  rgb_num_bins_, bin_index_.ptr<int32_t>(row));
+    }
+}
+
+void SpatialRgbHistogram::AccumulateSpatialHistogram(float *hist) const {
+    // Same order of summation as in AccumulateRgbHistogram, so histogram does not depend on input format
     for (int32_t y_bin = 0; y_bin < spatial_num_bins_; ++y_bin) {
-        int32_t y = y_bin * spatial_bin_stride_;
+        const int32_t y0 = y_bin * spatial_bin_stride_;
         for (int32_t x_bin = 0; x_bin < spatial_num_bins_; ++x_bin) {
-            int32_t x = x_bin * spatial_bin_stride_;
-            // Compute RGB histogram per each spatial bin
-            AccumulateRgbHistogram(patch(cv::Rect(x, y, spatial_bin_size_, spatial_bin_size_)),
-                                   weight_(cv::Rect(x, y, spatial_bin_size_, spatial_bin_size_)), rgb_hist_ptr);
-            rgb_hist_ptr += rgb_hist_size_;
+            const int32_t x0 = x_bin * spatial_bin_stride_;
+            for (int32_t y = y0; y < y0 + spatial_bin_size_; ++y) {
+                const int32_t *index_ptr = bin_index_.ptr<int32_t>(y);
+                const float *weight_ptr = weight_.ptr<float>(y);
+                for (int32_t x = x0; x < x0 + spatial_bin_size_; ++x)
+                    hist[index_ptr[x]] += weight_ptr[x];
+            }
+            hist += rgb_hist_size_;
         }
     }
-
-    PROF_END(PROF_COMPONENTS_OT_SHORTTERM_COMPUTE_HIST);
 }
 
 int32_t SpatialRgbHistogram::FeatureSize(void) const {
@@ -28,12 +28,20 @@ class SpatialRgbHistogram : public RgbHistogram {
     virtual int32_t FeatureSize(void) const;
 
   protected:
+    // Computes histogram bin of every pixel of canonical YUV patch into bin_index_, colors are converted to BGR as
+    // cv::cvtColor does. Chroma of pixel (x, y) is u[(y / 2) * uv_stride + (x / 2) * uv_step], the same for v.
+    void ComputeBinIndex(const uint8_t *y, int32_t y_stride, const uint8_t *u, const uint8_t *v, int32_t uv_stride,
+                         int32_t uv_step);
+    // Accumulates weighted RGB histograms of spatial bins from bin_index_
+    void AccumulateSpatialHistogram(float *hist) const;
+
     int32_t canonical_patch_size_;
     int32_t spatial_bin_size_;
     int32_t spatial_bin_stride_;
     int32_t spatial_num_bins_;
     int32_t spatial_hist_size_;
     cv::Mat weight_;
+    cv::Mat bin_index_;
 };
 
 }; // namespace ot
@@ -274,7 +274,7 @@ std::vector<Object> ObjectTracker::Impl::Track(const cv::Mat &frame,
 
 ObjectTracker::Builder::Builder()
     : backend_type(vas::BackendType::CPU), max_num_objects(kDefaultMaxNumObjects),
-      input_image_format(vas::ColorFormat::BGR), tracking_per_class(true) {
+      input_image_format(vas::ColorFormat::BGR), tracking_per_class(true), dense_association(false) {
 }
 
 ObjectTracker::Builder::~Builder() {
@@ -291,6 +291,7 @@ std::unique_ptr<ObjectTracker> ObjectTracker::Builder::Build(TrackingType tracki
     param.backend_type = backend_type;
     param.tracking_type = tracking_type;
     param.tracking_per_class = tracking_per_class;
+    param.dense_association = dense_association;
 
     if (static_cast<int32_t>(vas::ColorFormat::BGR) > static_cast<int32_t>(input_image_format) ||
         static_cast<int32_t>(vas::ColorFormat::I420) < static_cast<int32_t>(input_image_format)) {
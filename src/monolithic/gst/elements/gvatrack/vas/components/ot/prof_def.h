@@ -26,5 +26,7 @@
     PROF_TAG_GENERATE(OT, 1600, " Association::ComputeDistanceTable")
 #define PROF_COMPONENTS_OT_ASSOCIATE_COMPUTE_COST_TABLE PROF_TAG_GENERATE(OT, 1610, " Association::ComputeCostTable")
 #define PROF_COMPONENTS_OT_ASSOCIATE_WITH_HUNGARIAN PROF_TAG_GENERATE(OT, 1620, " Association::AssociateWithHungarian")
+#define PROF_COMPONENTS_OT_ASSOCIATE_WITH_SPARSE_SOLVER                                                                \
+    PROF_TAG_GENERATE(OT, 1630, " Association::AssociateWithSparseSolver")
 
 #endif // __OT_PROF_DEF_H__
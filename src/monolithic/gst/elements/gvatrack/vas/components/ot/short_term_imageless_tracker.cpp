@@ -27,7 +27,7 @@ const int32_t kMaxTrajectorySize = 30;
  **/
 ShortTermImagelessTracker::ShortTermImagelessTracker(vas::ot::Tracker::InitParameters init_param)
     : Tracker(init_param.max_num_objects, init_param.min_region_ratio_in_boundary, init_param.format,
-              init_param.tracking_per_class),
+              init_param.tracking_per_class, init_param.dense_association),
       image_sz(0, 0) {
     TRACE(" - Created tracker = ShortTermImagelessTracker");
 }
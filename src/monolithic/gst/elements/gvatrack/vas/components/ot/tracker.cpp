@@ -13,10 +13,11 @@
 namespace vas {
 namespace ot {
 
-Tracker::Tracker(int32_t max_objects, float min_region_ratio_in_boundary, vas::ColorFormat format, bool class_per_class)
+Tracker::Tracker(int32_t max_objects, float min_region_ratio_in_boundary, vas::ColorFormat format, bool class_per_class,
+                 bool dense_association)
     : max_objects_(max_objects), next_id_(1), frame_count_(0),
       min_region_ratio_in_boundary_(min_region_ratio_in_boundary), input_image_format_(format),
-      associator_(ObjectsAssociator(class_per_class)) {
+      associator_(ObjectsAssociator(class_per_class, dense_association)) {
 }
 
 Tracker::~Tracker() {
@@ -41,6 +41,7 @@ class Tracker {
         int32_t max_num_threads; // for Parallelization
         vas::ColorFormat format;
         bool tracking_per_class;
+        bool dense_association; // solve association with Hungarian algorithm on dense cost table
 
         // Won't be exposed to the external
         float min_region_ratio_in_boundary; // For ST, ZT
@@ -93,7 +94,7 @@ class Tracker {
 
   protected:
     explicit Tracker(int32_t max_objects, float min_region_ratio_in_boundary, vas::ColorFormat format,
-                     bool class_per_class = true);
+                     bool class_per_class = true, bool dense_association = false);
     Tracker() = delete;
 
     int32_t GetNextTrackingID();
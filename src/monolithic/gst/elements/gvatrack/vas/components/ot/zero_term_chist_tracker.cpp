@@ -35,7 +35,7 @@ const int32_t kMinBirthCount = 3;
  **/
 ZeroTermChistTracker::ZeroTermChistTracker(vas::ot::Tracker::InitParameters init_param)
     : Tracker(init_param.max_num_objects, init_param.min_region_ratio_in_boundary, init_param.format,
-              init_param.tracking_per_class),
+              init_param.tracking_per_class, init_param.dense_association),
       rgb_hist_(kSrgbCanonicalPatchSize, kRgbSpatialBinSize, kSrgbSpatialBinStride, kSrgbRgbBinSize) {
     TRACE(" - Created tracker = ZeroTermChistTracker");
 }
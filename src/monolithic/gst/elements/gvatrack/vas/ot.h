@@ -418,6 +418,18 @@ class ObjectTracker::Builder {
      */
     bool tracking_per_class;
 
+    /**
+     * Specifies which algorithm solves association of new detections with tracked objects.
+     * If it is false, only pairs of detection and object close enough to be associated are scored, and the resulting
+     * sparse cost table is solved by shortest augmenting path (Jonker-Volgenant) algorithm per group of overlapping
+     * candidates. Cost grows nearly linearly with number of objects in a frame.
+     * If it is true, cost of every pair is computed and dense cost table is solved by Hungarian algorithm, which takes
+     * cubic time. Both algorithms give the same association up to ties, dense one is kept for comparison.
+     * @n
+     * Default value is false.
+     */
+    bool dense_association;
+
     /**
      * Platform configuration
      * You can set various configuraions
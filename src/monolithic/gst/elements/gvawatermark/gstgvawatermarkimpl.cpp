@@ -16,6 +16,7 @@
 #include <inference_backend/logger.h>
 #include <safe_arithmetic.hpp>
 
+#include "bitmask.h"
 #include "gva_caps.h"
 #include "gva_utils.h"
 #include "inference_backend/buffer_mapper.h"
@@ -563,26 +564,51 @@ void Impl::preparePrimsForTensor(const GVA::Tensor &tensor, GVA::Rect<double> re
         }
     }
 
-    if (tensor.format() == "segmentation_mask") {
-        std::vector<float> mask = tensor.data<float>();
+    if (tensor.format() == "segmentation_mask" || tensor.format() == "segmentation_bitmask") {
         std::vector<guint> dims = tensor.dims();
         assert(dims.size() == 2);
-        const cv::Size &mask_size{int(dims[0]), int(dims[1])};
+        // dims are [height, width]
+        const cv::Size mask_size{int(dims[1]), int(dims[0])};
+        if (mask_size.empty())
+            return;
+        std::vector<uint8_t> bits;
+        std::vector<float> mask;
+        if (tensor.format() == "segmentation_bitmask") {
+            bits = tensor.data<uint8_t>();
+            if (bits.size() < bitmask::packedSize(mask_size.width, mask_size.height))
+                throw std::runtime_error("Segmentation bitmask is smaller than its dimensions.");
+        } else {
+            mask = tensor.data<float>();
+            if (mask.size() < size_t(mask_size.area()))
+                throw std::runtime_error("Segmentation mask is smaller than its dimensions.");
+        }
         cv::Rect2f box(rect.x, rect.y, rect.w, rect.h);
         Color color = indexToColor(color_index);
 
         if (!_obb) {
-            // overlay mask on top of image pixels
-            prims.emplace_back(render::Mask(mask, mask_size, color, box));
+            // overlay mask on top of image pixels, it is scaled to the box while drawing
+            if (mask.empty())
+                prims.emplace_back(render::Mask(std::move(bits), mask_size, color, box));
+            else
+                prims.emplace_back(render::Mask(std::move(mask), mask_size, color, box));
         } else {
             // resize mask to non-rotated bounding box and convert to binary
-            cv::Mat mask_resized, mask_converted;
-            cv::resize(cv::Mat{mask_size, CV_32F, mask.data()}, mask_resized, cv::Size(rect.w, rect.h));
-            cv::threshold(mask_resized, mask_resized, 0.5f, 1.0f, cv::THRESH_BINARY);
-            mask_resized.convertTo(mask_converted, CV_8UC1);
+            cv::Mat mask_resized;
+            if (mask.empty()) {
+                cv::Mat mask_unpacked(mask_size, CV_8UC1);
+                bitmask::unpack(bits.data(), mask_size.width, mask_size.height, mask_unpacked.data, 255);
+                cv::resize(mask_unpacked, mask_resized, cv::Size(rect.w, rect.h));
+                cv::threshold(mask_resized, mask_resized, 127, 1, cv::THRESH_BINARY);
+            } else {
+                cv::resize(cv::Mat(mask_size, CV_32FC1, mask.data()), mask_resized, cv::Size(rect.w, rect.h));
+                cv::threshold(mask_resized, mask_resized, 0.5, 1, cv::THRESH_BINARY);
+                mask_resized.convertTo(mask_resized, CV_8UC1);
+            }
             // find contours in binary mask and derive minimal bounding box
             std::vector<std::vector<cv::Point>> contours;
-            cv::findContours(mask_converted, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+            cv::findContours(mask_resized, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+            if (contours.empty())
+                return;
             cv::RotatedRect rotated = cv::minAreaRect(contours[0]);
             // shift minimal rotated box to original box position and draw
             rotated.center = rotated.center + cv::Point2f(rect.x, rect.y);
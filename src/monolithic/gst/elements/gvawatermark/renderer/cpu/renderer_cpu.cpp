@@ -6,6 +6,7 @@
 
 #include "renderer_cpu.h"
 
+#include "bitmask.h"
 #include "render_prim.h"
 #include <inference_backend/buffer_mapper.h>
 
@@ -45,6 +46,37 @@ cv::Rect expand_box(const cv::Rect2f &box, float w_scale, float h_scale) {
             cv::Point(int(center.x + w_half), int(center.y + h_half))};
 }
 
+// Mask with one-pixel border of zeros is stretched over expanded box, as if mask pixels were sampled at their centers
+cv::Rect expand_box_for_mask(const render::Mask &mask) {
+    return expand_box(mask.box, float(mask.size.width + 2) / mask.size.width,
+                      float(mask.size.height + 2) / mask.size.height);
+}
+
+bitmask::ScaledMask scale_mask(const render::Mask &mask, const cv::Size &dst_size) {
+    if (!mask.values.empty())
+        return bitmask::ScaledMask(mask.values.data(), mask.size.width, mask.size.height, dst_size.width,
+                                   dst_size.height);
+    return bitmask::ScaledMask(mask.bits.data(), mask.size.width, mask.size.height, dst_size.width, dst_size.height);
+}
+
+// Blends color with 0.5 opacity into 'roi' of 8-bit plane where mask scaled to 'mask_rect' is set. Only rows and
+// columns inside 'roi' are scaled.
+void blend_mask(cv::Mat &plane, const bitmask::ScaledMask &scaled, const cv::Rect &mask_rect, const cv::Rect &roi,
+                const cv::Scalar &color) {
+    if (roi.empty())
+        return;
+    const int channels = plane.channels();
+    const size_t row_size = size_t(roi.width) * channels;
+    std::vector<uint8_t> color_row(row_size);
+    std::vector<uint8_t> mask_row(row_size);
+    for (size_t i = 0; i < row_size; i++)
+        color_row[i] = cv::saturate_cast<uint8_t>(color[i % channels]);
+    for (int y = roi.y; y < roi.y + roi.height; y++) {
+        scaled.row(y - mask_rect.y, roi.x - mask_rect.x, roi.x + roi.width - mask_rect.x, channels, mask_row.data());
+        bitmask::blend(plane.ptr<uint8_t>(y, roi.x), mask_row.data(), color_row.data(), row_size);
+    }
+}
+
 RendererCPU::~RendererCPU() {
 }
 
@@ -220,12 +252,8 @@ void RendererNV12::draw_mask(std::vector<cv::Mat> &mats, render::Mask mask) {
     cv::Mat &y = mats[0];
     cv::Mat &u_v = mats[1];
 
-    cv::Mat unpadded{mask.size, CV_32F, mask.data.data()};
-    cv::Mat raw_cls_mask;
-    cv::copyMakeBorder(unpadded, raw_cls_mask, 1, 1, 1, 1, cv::BORDER_CONSTANT, {0});
-    cv::Rect extended_box = expand_box(mask.box, float(raw_cls_mask.cols) / (raw_cls_mask.cols - 2),
-                                       float(raw_cls_mask.rows) / (raw_cls_mask.rows - 2));
-
+    // Mask is drawn on chroma plane only
+    cv::Rect extended_box = expand_box_for_mask(mask);
     int w = std::max(extended_box.width + 1, 1);
     int h = std::max(extended_box.height + 1, 1);
     int x0_y = clamp(extended_box.x, 0, y.cols);
@@ -233,45 +261,12 @@ void RendererNV12::draw_mask(std::vector<cv::Mat> &mats, render::Mask mask) {
     int x1_y = clamp(extended_box.x + extended_box.width + 1, 0, y.cols);
     int y1_y = clamp(extended_box.y + extended_box.height + 1, 0, y.rows);
 
-    auto p0_u_v = calc_point_for_u_v_planes(cv::Point(x0_y, y0_y));
-    auto p1_u_v = calc_point_for_u_v_planes(cv::Point(x1_y, y1_y));
-
-    int x0_u_v = p0_u_v.x;
-    int y0_u_v = p0_u_v.y;
-    int x1_u_v = p1_u_v.x;
-    int y1_u_v = p1_u_v.y;
-
-    cv::Mat resized_y;
-    cv::resize(raw_cls_mask, resized_y, {w, h});
-
-    cv::Mat resized_u_v;
     auto max_point = calc_point_for_u_v_planes(cv::Point(w, h));
-    cv::resize(raw_cls_mask, resized_u_v, {max_point.x + 1, max_point.y + 1});
-
-    cv::Mat binaryMask_y;
-    cv::threshold(resized_y({cv::Point(x0_y - extended_box.x, y0_y - extended_box.y),
-                             cv::Point(x1_y - extended_box.x, y1_y - extended_box.y)}),
-                  binaryMask_y, 0.5f, 1.0f, cv::THRESH_BINARY);
-    binaryMask_y.convertTo(binaryMask_y, y.type());
-
-    cv::Mat binaryMask_u_v;
-    auto extended_box_u_v = calc_point_for_u_v_planes(cv::Point(extended_box.x, extended_box.y));
-    cv::threshold(resized_u_v({cv::Point((x0_u_v - extended_box_u_v.x), (y0_u_v - extended_box_u_v.y)),
-                               cv::Point((x1_u_v - extended_box_u_v.x), (y1_u_v - extended_box_u_v.y))}),
-                  binaryMask_u_v, 0.5f, 1.0f, cv::THRESH_BINARY);
-    binaryMask_u_v.convertTo(binaryMask_u_v, u_v.type());
-
-    cv::Rect roi_y(x0_y, y0_y, x1_y - x0_y, y1_y - y0_y);
-    cv::Rect roi_u_v(x0_u_v, y0_u_v, x1_u_v - x0_u_v, y1_u_v - y0_u_v);
-    cv::Mat colorMask_u_v(roi_u_v.size(), u_v.type(), mask.color[2]);
-
-    cv::Mat roiSrc_y = y(roi_y);
-    cv::Mat roiSrc_u_v = u_v(roi_u_v);
-    cv::Mat dst_y, dst_u_v;
-    float alpha = 0.5f;
-    cv::addWeighted(colorMask_u_v, alpha, roiSrc_u_v, 1.0 - alpha, 0.0, dst_u_v);
-
-    dst_u_v.copyTo(roiSrc_u_v, binaryMask_u_v);
+    cv::Rect mask_rect_u_v(calc_point_for_u_v_planes(extended_box.tl()), cv::Size(max_point.x + 1, max_point.y + 1));
+    cv::Rect roi_u_v(calc_point_for_u_v_planes(cv::Point(x0_y, y0_y)),
+                     calc_point_for_u_v_planes(cv::Point(x1_y, y1_y)));
+    bitmask::ScaledMask scaled = scale_mask(mask, mask_rect_u_v.size());
+    blend_mask(u_v, scaled, mask_rect_u_v, roi_u_v & mask_rect_u_v, {mask.color[1], mask.color[2]});
 }
 
 void RendererBGR::draw_rectangle(std::vector<cv::Mat> &mats, render::Rect rect) {
@@ -291,35 +286,9 @@ void RendererBGR::draw_line(std::vector<cv::Mat> &mats, render::Line line) {
 }
 
 void RendererBGR::draw_mask(std::vector<cv::Mat> &mats, render::Mask mask) {
-    cv::Mat unpadded{mask.size, CV_32F, mask.data.data()};
-    cv::Mat raw_cls_mask;
-    cv::copyMakeBorder(unpadded, raw_cls_mask, 1, 1, 1, 1, cv::BORDER_CONSTANT, {0});
-    cv::Rect extended_box = expand_box(mask.box, float(raw_cls_mask.cols) / (raw_cls_mask.cols - 2),
-                                       float(raw_cls_mask.rows) / (raw_cls_mask.rows - 2));
-
-    int w = std::max(extended_box.width + 1, 1);
-    int h = std::max(extended_box.height + 1, 1);
-    int x0 = clamp(extended_box.x, 0, mats[0].cols);
-    int y0 = clamp(extended_box.y, 0, mats[0].rows);
-    int x1 = clamp(extended_box.x + extended_box.width + 1, 0, mats[0].cols);
-    int y1 = clamp(extended_box.y + extended_box.height + 1, 0, mats[0].rows);
-
-    cv::Mat resized;
-    cv::resize(raw_cls_mask, resized, {w, h});
-
-    cv::Mat binaryMask;
-    cv::threshold(resized({cv::Point(x0 - extended_box.x, y0 - extended_box.y),
-                           cv::Point(x1 - extended_box.x, y1 - extended_box.y)}),
-                  binaryMask, 0.5f, 1.0f, cv::THRESH_BINARY);
-    binaryMask.convertTo(binaryMask, mats[0].type());
-
-    cv::Rect roi(x0, y0, x1 - x0, y1 - y0);
-    cv::Mat colorMask(roi.size(), mats[0].type(), mask.color);
-
-    cv::Mat roiSrc = mats[0](roi);
-    cv::Mat dst;
-    float alpha = 0.5f;
-    cv::addWeighted(colorMask, alpha, roiSrc, 1.0 - alpha, 0.0, dst);
-
-    dst.copyTo(roiSrc, binaryMask);
+    cv::Rect extended_box = expand_box_for_mask(mask);
+    cv::Rect mask_rect(extended_box.x, extended_box.y, std::max(extended_box.width + 1, 1),
+                       std::max(extended_box.height + 1, 1));
+    bitmask::ScaledMask scaled = scale_mask(mask, mask_rect.size());
+    blend_mask(mats[0], scaled, mask_rect, mask_rect & cv::Rect(0, 0, mats[0].cols, mats[0].rows), mask.color);
 }
@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include <opencv2/opencv.hpp>
 
@@ -69,15 +71,20 @@ struct Line {
 };
 
 struct Mask {
-    std::vector<float> data;
+    std::vector<uint8_t> bits; // packed binary mask of 'size' (see utils/bitmask.h), scaled to box when drawn
+    std::vector<float> values; // float mask of 'size', used instead of 'bits' if not empty
     cv::Size size;
     cv::Scalar color;
     cv::Rect2f box;
 
     Mask() = default;
 
-    Mask(const std::vector<float> &data, const cv::Size &size, const cv::Scalar &color, const cv::Rect2f &box)
-        : data(data), size(size), color(color), box(box) {
+    Mask(std::vector<uint8_t> bits, const cv::Size &size, const cv::Scalar &color, const cv::Rect2f &box)
+        : bits(std::move(bits)), size(size), color(color), box(box) {
+    }
+
+    Mask(std::vector<float> values, const cv::Size &size, const cv::Scalar &color, const cv::Rect2f &box)
+        : values(std::move(values)), size(size), color(color), box(box) {
     }
 };
 
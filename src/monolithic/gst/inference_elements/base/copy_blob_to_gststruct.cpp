@@ -98,6 +98,23 @@ void copy_buffer_to_structure(GstStructure *structure, const void *buffer, size_
                       g_variant_get_fixed_array(v, &n_elem, 1), NULL);
 }
 
+void share_buffer_with_structure(GstStructure *structure, const void *buffer, size_t size,
+                                 std::shared_ptr<const void> owner) {
+    ITT_TASK(__FUNCTION__);
+    if (!structure || !buffer || !owner)
+        throw std::invalid_argument("Failed to share buffer with structure: null arguments");
+
+    // GVariant references the buffer and releases owner when the last reference to metadata is dropped
+    auto holder = new std::shared_ptr<const void>(std::move(owner));
+    GVariant *v = g_variant_new_from_data(
+        G_VARIANT_TYPE("ay"), buffer, size, TRUE,
+        [](gpointer data) { delete static_cast<std::shared_ptr<const void> *>(data); }, holder);
+    if (not v)
+        throw std::invalid_argument("Failed to create GVariant array");
+    gsize n_elem;
+    gst_structure_set(structure, "data_buffer", G_TYPE_VARIANT, v, "data", G_TYPE_POINTER,
+                      g_variant_get_fixed_array(v, &n_elem, 1), NULL);
+}
 
 void CopyOutputBlobToGstStructure(InferenceBackend::OutputBlob::Ptr blob, GstStructure *gst_struct,
                                   const char *model_name, const char *layer_name, int32_t batch_size,
@@ -113,7 +130,10 @@ void CopyOutputBlobToGstStructure(InferenceBackend::OutputBlob::Ptr blob, GstStr
         size_t size = GetUnbatchedSizeInBytes(blob, batch_size);
 
         // TODO: check data buffer size
-        copy_buffer_to_structure(gst_struct, data + batch_index * size, size);
+        if (auto owner = blob->GetSharedData())
+            share_buffer_with_structure(gst_struct, data + batch_index * size, size, std::move(owner));
+        else
+            copy_buffer_to_structure(gst_struct, data + batch_index * size, size);
 
         gst_structure_set(gst_struct, "layer_name", G_TYPE_STRING, layer_name, "model_name", G_TYPE_STRING, model_name,
                           "precision", G_TYPE_INT, static_cast<int>(blob->GetPrecision()), "layout", G_TYPE_INT,
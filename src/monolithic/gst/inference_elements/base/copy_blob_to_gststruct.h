@@ -17,3 +17,6 @@ void EndoStreamer_CopyOutputBlobToGstStructure(InferenceBackend::OutputBlob::Ptr
                                   const char *model_name, const char *layer_name, int32_t batch_size,
                                   int32_t batch_index, size_t input_width, size_t input_height );
 void copy_buffer_to_structure(GstStructure *structure, const void *buffer, size_t size);
+// Same as copy_buffer_to_structure, but structure references the buffer kept alive by owner instead of copying it
+void share_buffer_with_structure(GstStructure *structure, const void *buffer, size_t size,
+                                 std::shared_ptr<const void> owner);
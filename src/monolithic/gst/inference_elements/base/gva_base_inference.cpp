@@ -42,6 +42,22 @@
 #define DEFAULT_MAX_BATCH_SIZE 1024
 #define DEFAULT_BATCH_SIZE 0
 
+#define DEFAULT_MIN_BATCH_TIMEOUT 0
+#define DEFAULT_MAX_BATCH_TIMEOUT UINT_MAX
+#define DEFAULT_BATCH_TIMEOUT 0
+
+#define DEFAULT_MIN_POSTPROC_THREADS 0
+#define DEFAULT_MAX_POSTPROC_THREADS 1024
+#define DEFAULT_POSTPROC_THREADS 0
+
+#define DEFAULT_MIN_OUTPUT_ARENA_SIZE 0
+#define DEFAULT_MAX_OUTPUT_ARENA_SIZE UINT_MAX
+#define DEFAULT_OUTPUT_ARENA_SIZE 0
+
+#define DEFAULT_MIN_PRE_PROC_CACHE_SIZE 0
+#define DEFAULT_MAX_PRE_PROC_CACHE_SIZE UINT_MAX
+#define DEFAULT_PRE_PROC_CACHE_SIZE 0
+
 #define DEFAULT_MIN_RESHAPE_WIDTH 0
 #define DEFAULT_MAX_RESHAPE_WIDTH UINT_MAX
 #define DEFAULT_RESHAPE_WIDTH 0
@@ -78,6 +94,9 @@ enum {
     PROP_INFERENCE_INTERVAL,
     PROP_RESHAPE,
     PROP_BATCH_SIZE,
+    PROP_BATCH_TIMEOUT,
+    PROP_POSTPROC_THREADS,
+    PROP_OUTPUT_ARENA_SIZE,
     PROP_RESHAPE_WIDTH,
     PROP_RESHAPE_HEIGHT,
     PROP_NO_BLOCK,
@@ -89,11 +108,13 @@ enum {
     PROP_GPU_THROUGHPUT_STREAMS,
     PROP_IE_CONFIG,
     PROP_PRE_PROC_CONFIG,
+    PROP_PRE_PROC_CACHE_SIZE,
     PROP_INFERENCE_REGION,
     PROP_OBJECT_CLASS,
     PROP_LABELS,
     PROP_LABELS_FILE,
-    PROP_SCALE_METHOD
+    PROP_SCALE_METHOD,
+    PROP_OUTPUT_QUEUE_DEPTH
 };
 
 GType gst_gva_base_inference_get_inf_region(void) {
@@ -214,6 +235,37 @@ void gva_base_inference_class_init(GvaBaseInferenceClass *klass) {
                           "that the model has batching support.",
                           DEFAULT_MIN_BATCH_SIZE, DEFAULT_MAX_BATCH_SIZE, DEFAULT_BATCH_SIZE, param_flags));
 
+    g_object_class_install_property(
+        gobject_class, PROP_BATCH_TIMEOUT,
+        g_param_spec_uint("batch-timeout", "Batch timeout",
+                          "Maximum time in microseconds a partially filled batch waits for more frames before it is "
+                          "submitted for inference. Models with dynamic batch dimension are inferred with the actual "
+                          "number of frames, otherwise the batch is padded. If the batch-timeout is 0 (Default), "
+                          "a batch is submitted only when it is full or on flush.",
+                          DEFAULT_MIN_BATCH_TIMEOUT, DEFAULT_MAX_BATCH_TIMEOUT, DEFAULT_BATCH_TIMEOUT, param_flags));
+
+    g_object_class_install_property(
+        gobject_class, PROP_POSTPROC_THREADS,
+        g_param_spec_uint("postproc-threads", "Post-processing threads",
+                          "Number of threads converting inference results to metadata and pushing frames downstream. "
+                          "Inference requests are returned to the device right after completion, so slow "
+                          "post-processing doesn't stall the device. At most nireq batches of an element wait for or "
+                          "run post-processing on the threads, further ones are post-processed on OpenVINO™ callback "
+                          "threads. The threads are shared by all inference elements of the process. If the "
+                          "postproc-threads is 0 (Default), post-processing runs on OpenVINO™ callback threads.",
+                          DEFAULT_MIN_POSTPROC_THREADS, DEFAULT_MAX_POSTPROC_THREADS, DEFAULT_POSTPROC_THREADS,
+                          param_flags));
+
+    g_object_class_install_property(
+        gobject_class, PROP_OUTPUT_ARENA_SIZE,
+        g_param_spec_uint("output-arena-size", "Output arena size",
+                          "Maximum size in megabytes of the pool of inference output tensors. Output tensors attached "
+                          "to metadata reference pooled memory instead of copying it, the memory returns to the pool "
+                          "when the metadata is freed. If the pool is exhausted, results are copied. If the "
+                          "output-arena-size is 0 (Default), results are always copied.",
+                          DEFAULT_MIN_OUTPUT_ARENA_SIZE, DEFAULT_MAX_OUTPUT_ARENA_SIZE, DEFAULT_OUTPUT_ARENA_SIZE,
+                          param_flags));
+
     g_object_class_install_property(
         gobject_class, PROP_INFERENCE_INTERVAL,
         g_param_spec_uint("inference-interval", "Inference Interval",
@@ -281,6 +333,17 @@ void gva_base_inference_class_init(GvaBaseInferenceClass *klass) {
                             "Comma separated list of KEY=VALUE parameters for image processing pipeline configuration",
                             "", param_flags));
 
+    g_object_class_install_property(
+        gobject_class, PROP_PRE_PROC_CACHE_SIZE,
+        g_param_spec_uint("pre-process-cache-size", "Pre-processing cache size",
+                          "Maximum size in bytes of pre-processed images cached per frame for reuse by downstream "
+                          "inference elements. Cache is attached to the buffer and shared by all elements which have "
+                          "this property set, so a region converted and resized for one model is copied for another "
+                          "model with the same input size and format. Applies to software pre-processing without "
+                          "model-proc pre-processing options. If 0 (Default), caching is disabled.",
+                          DEFAULT_MIN_PRE_PROC_CACHE_SIZE, DEFAULT_MAX_PRE_PROC_CACHE_SIZE,
+                          DEFAULT_PRE_PROC_CACHE_SIZE, param_flags));
+
     g_object_class_install_property(
         gobject_class, PROP_INFERENCE_REGION,
         g_param_spec_enum("inference-region", "Inference-Region",
@@ -311,6 +374,13 @@ void gva_base_inference_class_init(GvaBaseInferenceClass *klass) {
                                                         " Only default and scale-method=fast (VAAPI based) supported "
                                                         "in this element",
                                                         nullptr, param_flags));
+
+    g_object_class_install_property(
+        gobject_class, PROP_OUTPUT_QUEUE_DEPTH,
+        g_param_spec_uint("output-queue-depth", "Output queue depth",
+                          "(Read-only) Number of frames currently queued in this element's output queue, waiting for "
+                          "inference completion or for downstream to accept them",
+                          0, G_MAXUINT, 0, static_cast<GParamFlags>(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
 }
 
 void gva_base_inference_cleanup(GvaBaseInference *base_inference) {
@@ -402,6 +472,9 @@ void gva_base_inference_init(GvaBaseInference *base_inference) {
     base_inference->inference_interval = DEFAULT_INFERENCE_INTERVAL;
     base_inference->reshape = DEFAULT_RESHAPE;
     base_inference->batch_size = DEFAULT_BATCH_SIZE;
+    base_inference->batch_timeout = DEFAULT_BATCH_TIMEOUT;
+    base_inference->postproc_threads = DEFAULT_POSTPROC_THREADS;
+    base_inference->output_arena_size = DEFAULT_OUTPUT_ARENA_SIZE;
     base_inference->reshape_width = DEFAULT_RESHAPE_WIDTH;
     base_inference->reshape_height = DEFAULT_RESHAPE_HEIGHT;
     base_inference->no_block = DEFAULT_NO_BLOCK;
@@ -413,6 +486,7 @@ void gva_base_inference_init(GvaBaseInference *base_inference) {
     base_inference->gpu_streams = DEFAULT_GPU_THROUGHPUT_STREAMS;
     base_inference->ie_config = g_strdup("");
     base_inference->pre_proc_config = g_strdup("");
+    base_inference->pre_proc_cache_size = DEFAULT_PRE_PROC_CACHE_SIZE;
     base_inference->allocator_name = g_strdup(DEFAULT_ALLOCATOR_NAME);
 
     base_inference->initialized = FALSE;
@@ -426,6 +500,7 @@ void gva_base_inference_init(GvaBaseInference *base_inference) {
     base_inference->pre_proc = nullptr;
     base_inference->input_prerocessors_factory = GET_INPUT_PREPROCESSORS;
     base_inference->post_proc = nullptr;
+    base_inference->roi_detection_params = TRUE;
 
     base_inference->frame_num = DEFAULT_FIRST_FRAME_NUM;
     base_inference->object_class = DEFAULT_OBJECT_CLASS;
@@ -526,6 +601,15 @@ void gva_base_inference_set_property(GObject *object, guint property_id, const G
     case PROP_BATCH_SIZE:
         base_inference->batch_size = g_value_get_uint(value);
         break;
+    case PROP_BATCH_TIMEOUT:
+        base_inference->batch_timeout = g_value_get_uint(value);
+        break;
+    case PROP_POSTPROC_THREADS:
+        base_inference->postproc_threads = g_value_get_uint(value);
+        break;
+    case PROP_OUTPUT_ARENA_SIZE:
+        base_inference->output_arena_size = g_value_get_uint(value);
+        break;
     case PROP_RESHAPE_WIDTH:
         base_inference->reshape_width = g_value_get_uint(value);
         break;
@@ -570,6 +654,9 @@ void gva_base_inference_set_property(GObject *object, guint property_id, const G
         g_free(base_inference->pre_proc_config);
         base_inference->pre_proc_config = g_value_dup_string(value);
         break;
+    case PROP_PRE_PROC_CACHE_SIZE:
+        base_inference->pre_proc_cache_size = g_value_get_uint(value);
+        break;
     case PROP_INFERENCE_REGION:
         base_inference->inference_region = static_cast<InferenceRegionType>(g_value_get_enum(value));
         break;
@@ -635,6 +722,15 @@ void gva_base_inference_get_property(GObject *object, guint property_id, GValue
     case PROP_BATCH_SIZE:
         g_value_set_uint(value, base_inference->batch_size);
         break;
+    case PROP_BATCH_TIMEOUT:
+        g_value_set_uint(value, base_inference->batch_timeout);
+        break;
+    case PROP_POSTPROC_THREADS:
+        g_value_set_uint(value, base_inference->postproc_threads);
+        break;
+    case PROP_OUTPUT_ARENA_SIZE:
+        g_value_set_uint(value, base_inference->output_arena_size);
+        break;
     case PROP_RESHAPE_WIDTH:
         g_value_set_uint(value, base_inference->reshape_width);
         break;
@@ -665,6 +761,9 @@ void gva_base_inference_get_property(GObject *object, guint property_id, GValue
     case PROP_PRE_PROC_CONFIG:
         g_value_set_string(value, base_inference->pre_proc_config);
         break;
+    case PROP_PRE_PROC_CACHE_SIZE:
+        g_value_set_uint(value, base_inference->pre_proc_cache_size);
+        break;
     case PROP_INFERENCE_REGION:
         g_value_set_enum(value, base_inference->inference_region);
         break;
@@ -680,6 +779,11 @@ void gva_base_inference_get_property(GObject *object, guint property_id, GValue
     case PROP_SCALE_METHOD:
         g_value_set_string(value, base_inference->scale_method);
         break;
+    case PROP_OUTPUT_QUEUE_DEPTH:
+        g_value_set_uint(value, base_inference->inference
+                                    ? static_cast<guint>(base_inference->inference->GetOutputQueueDepth(base_inference))
+                                    : 0);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -868,14 +972,16 @@ gboolean gva_base_inference_start(GstBaseTransform *trans) {
     GST_INFO_OBJECT(base_inference,
                     "%s inference parameters:\n -- Model: %s\n -- Model proc: %s\n "
                     "-- Device: %s\n -- Inference interval: %d\n -- Reshape: %s\n -- Batch size: %d\n "
-                    "-- Reshape width: %d\n -- Reshape height: %d\n -- No block: %s\n -- Num of requests: %d\n "
-                    "-- Model instance ID: %s\n -- CPU streams: %d\n -- GPU streams: %d\n -- IE config: %s\n "
-                    "-- Allocator name: %s\n -- Preprocessing type: %s\n -- Object class: %s\n "
+                    "-- Batch timeout: %u us\n -- Post-processing threads: %u\n -- Output arena size: %u MB\n "
+                    "-- Reshape width: %d\n -- Reshape height: %d\n -- No block: %s\n "
+                    "-- Num of requests: %d\n -- Model instance ID: %s\n -- CPU streams: %d\n -- GPU streams: %d\n "
+                    "-- IE config: %s\n -- Allocator name: %s\n -- Preprocessing type: %s\n -- Object class: %s\n "
                     "-- Labels: %s\n",
                     GST_ELEMENT_NAME(GST_ELEMENT_CAST(base_inference)), base_inference->model,
                     base_inference->model_proc, base_inference->device, base_inference->inference_interval,
                     base_inference->reshape ? "true" : "false", base_inference->batch_size,
-                    base_inference->reshape_width, base_inference->reshape_height,
+                    base_inference->batch_timeout, base_inference->postproc_threads,
+                    base_inference->output_arena_size, base_inference->reshape_width, base_inference->reshape_height,
                     base_inference->no_block ? "true" : "false", base_inference->nireq,
                     base_inference->model_instance_id, base_inference->cpu_streams, base_inference->gpu_streams,
                     base_inference->ie_config, base_inference->allocator_name, base_inference->pre_proc_type,
@@ -921,6 +1027,11 @@ gboolean gva_base_inference_sink_event(GstBaseTransform *trans, GstEvent *event)
     try {
         if (base_inference->inference && (event->type == GST_EVENT_EOS || event->type == GST_EVENT_FLUSH_STOP)) {
             base_inference->inference->FlushInference();
+            // frames are pushed by pusher pool, make sure they are sent before EOS and dropped on flush
+            if (event->type == GST_EVENT_EOS)
+                base_inference->inference->DrainOutputs(base_inference);
+            else
+                base_inference->inference->DropOutputs(base_inference);
         }
     } catch (const std::exception &e) {
         GST_ELEMENT_ERROR(base_inference, CORE, EVENT, ("base_inference failed while handling sink"),
@@ -41,6 +41,9 @@ typedef struct _GvaBaseInference {
     guint inference_interval;
     gboolean reshape;
     guint batch_size;
+    guint batch_timeout;
+    guint postproc_threads;
+    guint output_arena_size;
     guint reshape_width;
     guint reshape_height;
     gboolean no_block;
@@ -50,6 +53,7 @@ typedef struct _GvaBaseInference {
     guint gpu_streams;
     gchar *ie_config;
     gchar *pre_proc_config;
+    guint pre_proc_cache_size;
     gchar *allocator_name;
     gchar *pre_proc_type;
     gchar *object_class;
@@ -72,6 +76,8 @@ typedef struct _GvaBaseInference {
     PreProcFunction pre_proc;
     InputPreprocessorsFactory input_prerocessors_factory;
     PostProcessor *post_proc;
+    // attach "detection" GstStructure to ROI params, set by gvadetect 'roi-detection-params' property
+    gboolean roi_detection_params;
 
     gboolean initialized;
     guint64 num_skipped_frames;
@@ -18,13 +18,16 @@
 #include "inference_backend/pre_proc.h"
 #include "logger_functions.h"
 #include "model_proc_provider.h"
+#include "pre_proc_cache_meta.h"
 #include "region_of_interest.h"
 #include "safe_arithmetic.hpp"
 #include "scope_guard.h"
 #include "utils.h"
 #include "video_frame.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 #include <exception>
@@ -166,6 +169,9 @@ InferenceConfig CreateNestedInferenceConfig(GvaBaseInference *gva_base_inference
 
     const uint32_t batch = gva_base_inference->batch_size;
     base[KEY_BATCH_SIZE] = std::to_string(batch);
+    base[KEY_BATCH_TIMEOUT] = std::to_string(gva_base_inference->batch_timeout);
+    base[KEY_POSTPROC_THREADS] = std::to_string(gva_base_inference->postproc_threads);
+    base[KEY_OUTPUT_ARENA_SIZE] = std::to_string(gva_base_inference->output_arena_size);
     base[KEY_RESHAPE] = std::to_string(gva_base_inference->reshape);
     if (gva_base_inference->reshape) {
         if ((gva_base_inference->reshape_width) || (gva_base_inference->reshape_height) || (batch > 1)) {
@@ -650,7 +656,11 @@ InferenceImpl::InferenceImpl(GvaBaseInference *gva_base_inference) {
 
     GVA_INFO("Loading model: device=%s, path=%s", std::string(gva_base_inference->device).c_str(), model_file.c_str());
     GVA_INFO("Initial settings: batch_size=%u, nireq=%u", gva_base_inference->batch_size, gva_base_inference->nireq);
+    const auto start = std::chrono::steady_clock::now();
     this->model = CreateModel(gva_base_inference, model_file, model_proc, labels_str);
+    const auto load_time =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    GVA_INFO("Model loaded in %lld ms: path=%s", static_cast<long long>(load_time.count()), model_file.c_str());
 }
 
 dlstreamer::ContextPtr InferenceImpl::GetDisplay(GvaBaseInference *gva_base_inference) {
@@ -665,7 +675,74 @@ void InferenceImpl::FlushInference() {
 }
 
 void InferenceImpl::FlushOutputs() {
-    PushOutput();
+    std::lock_guard<std::mutex> guard(output_queues_mutex);
+    for (auto &it : output_queues)
+        ScheduleOutputQueue(*it.second);
+}
+
+/**
+ * Blocks until all frames queued for 'filter' are pushed downstream. Expected to be called after FlushInference, when
+ * there are no inference requests in flight.
+ */
+void InferenceImpl::DrainOutputs(GvaBaseInference *filter) {
+    ITT_TASK(__FUNCTION__);
+    std::unique_lock<std::mutex> lock(output_queues_mutex);
+    auto it = output_queues.find(filter);
+    if (it == output_queues.end())
+        return;
+
+    OutputQueue *queue = it->second.get();
+    ScheduleOutputQueue(*queue);
+    // do not wait for frames that can't be completed anymore
+    queue->drained_cond.wait(
+        lock, [queue] { return queue->frames.empty() || (!queue->pushing && !queue->IsHeadReady()) || queue->stop; });
+}
+
+/**
+ * Drops all frames queued for 'filter' without pushing them downstream, used on FLUSH_STOP. Expected to be called
+ * after FlushInference, when there are no inference requests in flight.
+ */
+void InferenceImpl::DropOutputs(GvaBaseInference *filter) {
+    ITT_TASK(__FUNCTION__);
+    std::list<OutputFrame> dropped;
+    {
+        std::unique_lock<std::mutex> lock(output_queues_mutex);
+        auto it = output_queues.find(filter);
+        if (it == output_queues.end())
+            return;
+
+        OutputQueue &queue = *it->second;
+        dropped.swap(queue.frames);
+        // frame being pushed right now is already out of the queue, let it complete before flush reaches downstream
+        queue.drained_cond.wait(lock, [&queue] { return !queue.pushing; });
+    }
+    GVA_DEBUG("Dropped %zu queued frames on flush <%s>", dropped.size(), GST_ELEMENT_NAME(filter));
+    ReleaseOutputFrames(dropped);
+}
+
+/**
+ * Stops pushing frames of 'filter' and frees frames left in its output queue.
+ */
+void InferenceImpl::ReleaseOutputQueue(GvaBaseInference *filter) {
+    std::unique_ptr<OutputQueue> queue;
+    {
+        std::unique_lock<std::mutex> lock(output_queues_mutex);
+        auto it = output_queues.find(filter);
+        if (it == output_queues.end())
+            return;
+        queue = std::move(it->second);
+        output_queues.erase(it);
+        StopOutputQueue(lock, *queue);
+    }
+    // completion callbacks may still write results to buffers of the queued frames
+    FlushInference();
+    ReleaseOutputFrames(queue->frames);
+}
+
+size_t InferenceImpl::GetOutputQueueDepth(GvaBaseInference *filter) {
+    std::lock_guard<std::mutex> guard(output_queues_mutex);
+    auto it = output_queues.find(filter);
+    return it != output_queues.end() ? it->second->frames.size() : 0;
 }
 
 void InferenceImpl::UpdateObjectClasses(const gchar *obj_classes_str) {
@@ -718,6 +795,19 @@ bool InferenceImpl::FilterObjectClass(const std::string &object_class) const {
 }
 
 InferenceImpl::~InferenceImpl() {
+    {
+        std::lock_guard<std::mutex> guard(output_queues_mutex);
+        pushers_stop = true;
+        pushers_cond.notify_all();
+    }
+    for (auto &pusher : pushers)
+        pusher.join();
+
+    if (model.inference)
+        FlushInference();
+    for (auto &it : output_queues)
+        ReleaseOutputFrames(it.second->frames);
+
     for (auto proc : model.output_processor_info)
         gst_structure_free(proc.second);
 }
@@ -727,57 +817,102 @@ bool InferenceImpl::IsRoiSizeValid(const GstVideoRegionOfInterestMeta *roi_meta)
 }
 
 /**
- * Acquires output_frames_mutex with std::lock_guard.
+ * Returns output queue of 'filter', creates it on first use. Grows the shared pusher pool to one pusher per queue: a
+ * queue is served by one pusher at a time, so pushers blocked by downstream of other streams always leave an idle
+ * pusher for a ready queue. Pushers are mostly idle, they only wait for downstream.
+ * Expects output_queues_mutex to be acquired.
  */
-void InferenceImpl::PushOutput() {
-    ITT_TASK(__FUNCTION__);
-    std::lock_guard<std::mutex> guard(output_frames_mutex);
+InferenceImpl::OutputQueue &InferenceImpl::GetOutputQueue(GvaBaseInference *filter) {
+    auto &queue = output_queues[filter];
+    if (!queue) {
+        queue = std::make_unique<OutputQueue>();
+        if (pushers.size() < output_queues.size())
+            pushers.emplace_back(&InferenceImpl::PusherLoop, this);
+    }
+    return *queue;
+}
 
-    // track output queues that are full
-    std::map<std::string, bool> output_full;
+/**
+ * Hands 'queue' over to the pusher pool if its head frame is ready and it isn't scheduled yet.
+ * Expects output_queues_mutex to be acquired.
+ */
+void InferenceImpl::ScheduleOutputQueue(OutputQueue &queue) {
+    if (queue.scheduled || queue.stop || !queue.IsHeadReady())
+        return;
+    queue.scheduled = true;
+    ready_queues.push_back(&queue);
+    pushers_cond.notify_one();
+}
+
+/**
+ * Unschedules 'queue' and waits until the pusher serving it finishes the current push.
+ * Expects 'lock' to hold output_queues_mutex.
+ */
+void InferenceImpl::StopOutputQueue(std::unique_lock<std::mutex> &lock, OutputQueue &queue) {
+    queue.stop = true;
+    ready_queues.erase(std::remove(ready_queues.begin(), ready_queues.end(), &queue), ready_queues.end());
+    queue.drained_cond.notify_all();
+    queue.drained_cond.wait(lock, [&queue] { return !queue.pushing; });
+}
 
-    auto frame = output_frames.begin();
-    while (frame != output_frames.end()) {
-        if ((*frame).inference_count != 0) {
-            break; // inference not completed yet
+void InferenceImpl::ReleaseOutputFrames(std::list<OutputFrame> &frames) {
+    for (OutputFrame &frame : frames)
+        gst_buffer_unref(frame.buffer);
+    frames.clear();
+}
+
+/**
+ * Pusher thread of the shared pool. Takes the next queue with a ready head frame and pushes that frame downstream
+ * without holding any lock, so completions of other streams are never blocked by this src pad. The queue is put back
+ * at the end of ready_queues if more frames are ready, which keeps streams served round-robin.
+ */
+void InferenceImpl::PusherLoop() {
+    std::unique_lock<std::mutex> lock(output_queues_mutex);
+    while (true) {
+        pushers_cond.wait(lock, [this] { return pushers_stop || !ready_queues.empty(); });
+        if (pushers_stop)
+            break;
+
+        OutputQueue *queue = ready_queues.front();
+        ready_queues.pop_front();
+        if (!queue->IsHeadReady()) {
+            // frames were dropped on flush after scheduling
+            queue->scheduled = false;
+            continue;
         }
+        OutputFrame frame = std::move(queue->frames.front());
+        queue->frames.pop_front();
+        queue->pushing = true;
+        lock.unlock();
 
-        for (const std::shared_ptr<InferenceFrame> &inference_roi : (*frame).inference_rois) {
+        ITT_TASK("InferenceImpl::PushOutput");
+        for (const std::shared_ptr<InferenceFrame> &inference_roi : frame.inference_rois) {
             for (const GstStructure *roi_classification : inference_roi->roi_classifications) {
-                UpdateClassificationHistory(&inference_roi->roi, (*frame).filter, roi_classification);
+                UpdateClassificationHistory(&inference_roi->roi, frame.filter, roi_classification);
             }
         }
+        PushBufferToSrcPad(frame);
 
-        // 'output_frames' queue can be shared across streams and it is subject to HOL blocking
-        // do not send frame to a blocked output, but check if there frames ready to non-blocked outputs
-        GstObject *src = &(*frame).filter->base_transform.element.object;
-        if (CheckSrcPadBlocked(src) || output_full[src->name]) {
-            output_full[src->name] = true;
-            frame++; // output blocked, try next frame
-        } else {
-            PushBufferToSrcPad(*frame);
-            frame = output_frames.erase(frame);
-        }
+        lock.lock();
+        queue->pushing = false;
+        queue->scheduled = false;
+        queue->drained_cond.notify_all();
+        ScheduleOutputQueue(*queue);
     }
 }
 
-bool InferenceImpl::CheckSrcPadBlocked(GstObject *src) {
-    bool blocked = false;
-
-    GstObject *dst = gst_pad_get_parent(gst_pad_get_peer(GST_BASE_TRANSFORM_SRC_PAD(src)));
-    if (strcmp(dst->name, "queue") > 0) {
-        guint buf_cnt;
-        g_object_get(dst, "current-level-buffers", &buf_cnt, NULL);
-        GstState state, pending;
-        gst_element_get_state(GST_ELEMENT(dst), &state, &pending, GST_CLOCK_TIME_NONE);
-
-        if ((buf_cnt > 1) && (state == GST_STATE_PAUSED)) {
-            blocked = true;
-        }
+/**
+ * Pauses accepting a new frame while the pusher of 'filter' is blocked downstream and more frames are ready behind it.
+ * Woken up as soon as downstream accepts a frame.
+ */
+void InferenceImpl::WaitDownstreamReady(GvaBaseInference *filter) {
+    std::unique_lock<std::mutex> lock(output_queues_mutex);
+    OutputQueue &queue = GetOutputQueue(filter);
+    if (queue.pushing && queue.IsHeadReady()) {
+        ITT_TASK("InferenceImpl::WaitDownstreamReady");
+        GVA_INFO("Wait on blocking output <%s>", GST_ELEMENT_NAME(filter));
+        queue.drained_cond.wait(lock, [&queue] { return queue.stop || !queue.pushing || !queue.IsHeadReady(); });
     }
-    gst_object_unref(dst);
-
-    return blocked;
 }
 
 void InferenceImpl::PushBufferToSrcPad(OutputFrame &output_frame) {
@@ -841,6 +976,11 @@ GstFlowReturn InferenceImpl::SubmitImages(GvaBaseInference *gva_base_inference,
         if (!image)
             throw std::invalid_argument("image is null");
 
+        // buffer is a copy made in TransformFrameIp, so metadata can be attached
+        InferenceBackend::PreProcCache::Ptr pre_proc_cache;
+        if (gva_base_inference->pre_proc_cache_size)
+            pre_proc_cache = pre_proc_cache_meta_acquire(buffer, gva_base_inference->pre_proc_cache_size);
+
         size_t i = 0;
         for (const auto meta : metas) {
             // Workaround for CodeCoverity
@@ -849,6 +989,7 @@ GstFlowReturn InferenceImpl::SubmitImages(GvaBaseInference *gva_base_inference,
 
             ApplyImageBoundaries(image, meta, gva_base_inference->inference_region);
             auto result = MakeInferenceResult(gva_base_inference, model, meta, image, buffer);
+            result->pre_proc_cache = pre_proc_cache;
             // Because image is a shared pointer with custom deleter which performs buffer unmapping
             // we need to manually reset it after we passed it to the last InferenceResult
             // Otherwise it may try to unmap buffer which is already pushed to downstream
@@ -875,12 +1016,15 @@ const InferenceImpl::Model &InferenceImpl::GetModel() const {
 
 GstFlowReturn InferenceImpl::TransformFrameIp(GvaBaseInference *gva_base_inference, GstBuffer *buffer) {
     ITT_TASK(__FUNCTION__);
-    std::unique_lock<std::mutex> lock(_mutex);
-
     assert(gva_base_inference != nullptr && "Expected a valid pointer to gva_base_inference");
     assert(gva_base_inference->info != nullptr && "Expected a valid pointer to GstVideoInfo");
     assert(buffer != nullptr && "Expected a valid pointer to GstBuffer");
 
+    // pause on accepting a new frame if downstream already blocks, other streams are not affected
+    WaitDownstreamReady(gva_base_inference);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
     // Shallow copy input buffer instead of increasing ref count
     buffer = gst_buffer_copy(buffer);
     // Unref buffer automatically on early exit
@@ -944,23 +1088,13 @@ GstFlowReturn InferenceImpl::TransformFrameIp(GvaBaseInference *gva_base_inferen
         GVA_WARNING("The frame counter value limit has been reached. This value will be reset.");
     }
 
-    // push into output_frames queue
+    // push into output queue of this element
     {
         ITT_TASK("InferenceImpl::TransformFrameIp pushIntoOutputFramesQueue");
-        std::unique_lock output_lock(output_frames_mutex);
-
-        // pause on accepting a new frame if downstream already blocks
-        GstObject *src = &gva_base_inference->base_transform.element.object;
-        while (CheckSrcPadBlocked(src)) {
-            output_lock.unlock();
-            lock.unlock();
-            GVA_INFO("Wait on blocking output <%s>", src->name);
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            lock.lock();
-            output_lock.lock();
-        }
+        std::lock_guard<std::mutex> output_lock(output_queues_mutex);
+        OutputQueue &queue = GetOutputQueue(gva_base_inference);
 
-        if (!inference_count && output_frames.empty()) {
+        if (!inference_count && queue.frames.empty() && !queue.pushing) {
             // If we don't need to run inference and there are no frames queued for inference then finish transform
             return GST_FLOW_OK;
         }
@@ -970,8 +1104,9 @@ GstFlowReturn InferenceImpl::TransformFrameIp(GvaBaseInference *gva_base_inferen
 
         InferenceImpl::OutputFrame output_frame = {
             .buffer = buffer, .inference_count = inference_count, .filter = gva_base_inference, .inference_rois = {}};
-        output_frames.push_back(output_frame);
+        queue.frames.push_back(output_frame);
         if (!inference_count) {
+            ScheduleOutputQueue(queue);
             return GST_BASE_TRANSFORM_FLOW_DROPPED;
         }
     }
@@ -981,61 +1116,69 @@ GstFlowReturn InferenceImpl::TransformFrameIp(GvaBaseInference *gva_base_inferen
 
 void InferenceImpl::PushFramesIfInferenceFailed(
     std::vector<std::shared_ptr<InferenceBackend::ImageInference::IFrameBase>> frames) {
-    std::lock_guard<std::mutex> guard(output_frames_mutex);
+    std::lock_guard<std::mutex> guard(output_queues_mutex);
     for (auto &frame : frames) {
         auto inference_result = std::dynamic_pointer_cast<InferenceResult>(frame);
         /* InferenceResult is inherited from IFrameBase */
         assert(inference_result.get() != nullptr && "Expected a valid InferenceResult");
 
         std::shared_ptr<InferenceFrame> inference_roi = inference_result->inference_frame;
-        auto it =
-            std::find_if(output_frames.begin(), output_frames.end(), [inference_roi](const OutputFrame &output_frame) {
-                return output_frame.buffer == inference_roi->buffer;
-            });
+        auto queue_it = output_queues.find(inference_roi->gva_base_inference);
+        if (queue_it == output_queues.end())
+            continue;
 
-        if (it == output_frames.end())
+        OutputQueue &queue = *queue_it->second;
+        auto it = std::find_if(queue.frames.begin(), queue.frames.end(), [inference_roi](const OutputFrame &output_frame) {
+            return output_frame.buffer == inference_roi->buffer;
+        });
+
+        if (it == queue.frames.end())
             continue;
 
-        PushBufferToSrcPad(*it);
-        output_frames.erase(it);
+        // mark frame as completed, it is pushed without results keeping the order of the stream
+        it->inference_count = 0;
+        ScheduleOutputQueue(queue);
     }
 }
 
 /**
  * Updates buffer pointers for corresponding to 'inference_roi' output_frame, decreases it's inference_count.
- * May affect buffer if it's not writable.
- * Acquires output_frames_mutex with std::lock_guard.
+ * Wakes up pusher of the element's output queue if the frame at its head became ready.
+ * Acquires output_queues_mutex with std::lock_guard.
  *
  * @param[in] inference_roi - InferenceFrame to provide buffer's and inference element's info
  */
 void InferenceImpl::UpdateOutputFrames(std::shared_ptr<InferenceFrame> &inference_roi) {
     assert(inference_roi && "Inference frame is null");
-    std::lock_guard<std::mutex> guard(output_frames_mutex);
+    std::lock_guard<std::mutex> guard(output_queues_mutex);
+
+    auto queue_it = output_queues.find(inference_roi->gva_base_inference);
+    if (queue_it == output_queues.end())
+        return;
+    OutputQueue &queue = *queue_it->second;
 
     /* we must iterate through std::list because it has no lookup operations */
-    for (auto &output_frame : output_frames) {
+    for (auto &output_frame : queue.frames) {
         if (output_frame.buffer != inference_roi->buffer)
             continue;
 
-        /* only gvadetect or full-frame elements are affecting buffer */
-        if (inference_roi->gva_base_inference->type == GST_GVA_DETECT_TYPE ||
-            inference_roi->gva_base_inference->inference_region == FULL_FRAME) {
-            if (output_frame.inference_count == 0)
-                // This condition is necessary if two items in output_frames refer to the same buffer.
-                // If current output_frame.inference_count equals 0, then inference for this output_frame
-                // already happened, but buffer wasn't pushed further by pipeline yet. We skip this buffer
-                // to find another, to which current inference callback really belongs
-                continue;
-        }
+        if (output_frame.inference_count == 0)
+            // This condition is necessary if two items in output queue refer to the same buffer.
+            // If current output_frame.inference_count equals 0, then inference for this output_frame
+            // already happened, but buffer wasn't pushed further by pipeline yet. We skip this buffer
+            // to find another, to which current inference callback really belongs
+            continue;
+
         output_frame.inference_rois.push_back(inference_roi);
-        --output_frame.inference_count;
+        if (--output_frame.inference_count == 0 && &output_frame == &queue.frames.front())
+            ScheduleOutputQueue(queue);
         break;
     }
 }
 
 /**
- * Callback called when the inference request is completed. Updates output_frames and invokes post-processing for
- * corresponding inference element then makes gst_pad_push to send buffer further down the pipeline.
+ * Callback called when the inference request is completed. Invokes post-processing for corresponding inference
+ * element and updates output queues, completed frames are sent further down the pipeline by the shared pusher pool.
  * Nullifies shared_ptr for InferenceBackend::Image created during 'SubmitImages'.
  *
  * @param[in] blobs - the resulting blobs obtained after executing inference
@@ -1079,5 +1222,4 @@ void InferenceImpl::InferenceCompletionCallback(
     for (auto &inference_roi : inference_frames) {
         UpdateOutputFrames(inference_roi);
     }
-    PushOutput();
 }
@@ -16,10 +16,14 @@
 
 #include <gst/video/video.h>
 
+#include <condition_variable>
+#include <deque>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 class InferenceImpl {
@@ -39,6 +43,10 @@ class InferenceImpl {
 
     GstFlowReturn TransformFrameIp(GvaBaseInference *element, GstBuffer *buffer);
     void FlushOutputs();
+    void DrainOutputs(GvaBaseInference *filter);
+    void DropOutputs(GvaBaseInference *filter);
+    void ReleaseOutputQueue(GvaBaseInference *filter);
+    size_t GetOutputQueueDepth(GvaBaseInference *filter);
     void FlushInference();
     const Model &GetModel() const;
 
@@ -63,9 +71,13 @@ class InferenceImpl {
         InferenceBackend::ImagePtr GetImage() const override {
             return image;
         }
+        InferenceBackend::PreProcCache::Ptr GetPreProcCache() const override {
+            return pre_proc_cache;
+        }
         std::shared_ptr<InferenceFrame> inference_frame;
         Model *model;
         std::shared_ptr<InferenceBackend::Image> image;
+        InferenceBackend::PreProcCache::Ptr pre_proc_cache;
     };
 
     enum InferenceStatus {
@@ -88,11 +100,34 @@ class InferenceImpl {
         std::vector<std::shared_ptr<InferenceFrame>> inference_rois;
     };
 
-    std::list<OutputFrame> output_frames;
-    std::mutex output_frames_mutex;
+    // Frames of one inference element (stream) waiting for inference completion and push to its src pad.
+    // Frames are pushed in order by the shared pusher pool, one frame per turn. The pool has as many pushers as
+    // there are queues, so a blocked downstream stalls only its own stream.
+    struct OutputQueue {
+        std::list<OutputFrame> frames;
+        std::condition_variable drained_cond; // signaled when downstream accepted a frame or queue is stopped
+        bool pushing = false;
+        bool scheduled = false; // waits in ready_queues or is served by a pusher
+        bool stop = false;
+
+        bool IsHeadReady() const {
+            return !frames.empty() && frames.front().inference_count == 0;
+        }
+    };
 
-    void PushOutput();
-    bool CheckSrcPadBlocked(GstObject *src);
+    std::map<GvaBaseInference *, std::unique_ptr<OutputQueue>> output_queues;
+    std::deque<OutputQueue *> ready_queues;
+    std::condition_variable pushers_cond; // signaled when a queue is scheduled or pushers are stopped
+    std::vector<std::thread> pushers;
+    bool pushers_stop = false;
+    std::mutex output_queues_mutex;
+
+    OutputQueue &GetOutputQueue(GvaBaseInference *filter);
+    void ScheduleOutputQueue(OutputQueue &queue);
+    void PusherLoop();
+    void WaitDownstreamReady(GvaBaseInference *filter);
+    void StopOutputQueue(std::unique_lock<std::mutex> &lock, OutputQueue &queue);
+    static void ReleaseOutputFrames(std::list<OutputFrame> &frames);
     void PushBufferToSrcPad(OutputFrame &output_frame);
     void PushFramesIfInferenceFailed(std::vector<std::shared_ptr<InferenceBackend::ImageInference::IFrameBase>> frames);
     void InferenceCompletionCallback(std::map<std::string, InferenceBackend::OutputBlob::Ptr> blobs,
@@ -17,6 +17,7 @@ struct InferenceRefs {
     std::set<GvaBaseInference *> refs;
     InferenceImpl *proxy = nullptr;
     dlstreamer::ContextPtr context = nullptr;
+    std::mutex proxy_mutex; // guards proxy and context while instance is created outside of inference_pool_mutex_
     GstVideoFormat videoFormat = GST_VIDEO_FORMAT_UNKNOWN;
     CapsFeature capsFeature = ANY_CAPS_FEATURE;
 };
@@ -78,6 +79,9 @@ void fillElementProps(GvaBaseInference *targetElem, GvaBaseInference *masterElem
     COPY_GSTRING(targetElem->device, masterElem->device);
     COPY_GSTRING(targetElem->model_proc, masterElem->model_proc);
     targetElem->batch_size = masterElem->batch_size;
+    targetElem->batch_timeout = masterElem->batch_timeout;
+    targetElem->postproc_threads = masterElem->postproc_threads;
+    targetElem->output_arena_size = masterElem->output_arena_size;
     targetElem->inference_interval = masterElem->inference_interval;
     targetElem->no_block = masterElem->no_block;
     targetElem->nireq = masterElem->nireq;
@@ -157,18 +161,24 @@ InferenceImpl *acquire_inference_instance(GvaBaseInference *base_inference) {
         if (!base_inference)
             throw std::invalid_argument("GvaBaseInference is null");
 
-        std::lock_guard<std::mutex> guard(inference_pool_mutex_);
         InferenceRefs *infRefs = nullptr;
-        std::string name = get_inference_key(base_inference);
-        GST_INFO_OBJECT(base_inference, "key: %s\n", name.c_str());
-        infRefs = registerElementUnlocked(base_inference);
+        {
+            std::lock_guard<std::mutex> guard(inference_pool_mutex_);
+            std::string name = get_inference_key(base_inference);
+            GST_INFO_OBJECT(base_inference, "key: %s\n", name.c_str());
+            infRefs = registerElementUnlocked(base_inference);
 
-        initInferenceProps(*infRefs, base_inference->info->finfo->format, base_inference->caps_feature);
-        check_inference_props_same(*infRefs, base_inference->info->finfo->format, base_inference->caps_feature);
+            initInferenceProps(*infRefs, base_inference->info->finfo->format, base_inference->caps_feature);
+            check_inference_props_same(*infRefs, base_inference->info->finfo->format, base_inference->caps_feature);
 
-        // if base_inference is not master element, it will get all master element's properties here
-        initExistingElements(infRefs);
+            // if base_inference is not master element, it will get all master element's properties here
+            initExistingElements(infRefs);
+        }
 
+        // Model is loaded without holding the pool lock, so elements with different model-instance-id started from
+        // different streaming threads compile their models in parallel. infRefs can't be released meanwhile because
+        // this element is registered in it.
+        std::lock_guard<std::mutex> guard(infRefs->proxy_mutex);
         if (infRefs->proxy == nullptr) {                        // no instance for current inference-id acquired yet
             infRefs->proxy = new InferenceImpl(base_inference); // one instance for all elements with same inference-id
             infRefs->context = InferenceImpl::GetDisplay(base_inference);
@@ -186,6 +196,10 @@ InferenceImpl *acquire_inference_instance(GvaBaseInference *base_inference) {
 
 void release_inference_instance(GvaBaseInference *base_inference) {
     try {
+        // Stop pushing frames of this element before taking the pool lock: pusher may be blocked downstream
+        if (base_inference->inference)
+            base_inference->inference->ReleaseOutputQueue(base_inference);
+
         std::lock_guard<std::mutex> guard(inference_pool_mutex_);
         std::string name = get_inference_key(base_inference);
         GST_INFO_OBJECT(base_inference, "key: %s\n", name.c_str());
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "pre_proc_cache_meta.h"
+
+#include <gst/video/video.h>
+
+#define UNUSED(x) (void)(x)
+
+#define PRE_PROC_CACHE_META_GET(buf)                                                                                   \
+    ((PreProcCacheMeta *)gst_buffer_get_meta(buf, pre_proc_cache_meta_api_get_type()))
+#define PRE_PROC_CACHE_META_ADD(buf)                                                                                   \
+    ((PreProcCacheMeta *)gst_buffer_add_meta(buf, pre_proc_cache_meta_get_info(), NULL))
+
+GType pre_proc_cache_meta_api_get_type(void) {
+    static GType type;
+    // Cached images depend on pixels, size and orientation of the frame, so elements changing any of them (e.g.
+    // videoconvert, videobalance, videoscale, videoflip) drop the meta instead of copying it
+    static const gchar *tags[] = {GST_META_TAG_VIDEO_STR, GST_META_TAG_VIDEO_COLORSPACE_STR,
+                                  GST_META_TAG_VIDEO_SIZE_STR, GST_META_TAG_VIDEO_ORIENTATION_STR, NULL};
+
+    if (g_once_init_enter(&type)) {
+        GType _type = gst_meta_api_type_register(PRE_PROC_CACHE_META_API_NAME, tags);
+        g_once_init_leave(&type, _type);
+    }
+    return type;
+}
+
+gboolean pre_proc_cache_meta_init(GstMeta *meta, gpointer params, GstBuffer *buffer) {
+    UNUSED(params);
+    UNUSED(buffer);
+
+    PreProcCacheMeta *cache_meta = (PreProcCacheMeta *)meta;
+    cache_meta->cache = nullptr;
+    return TRUE;
+}
+
+void pre_proc_cache_meta_free(GstMeta *meta, GstBuffer *buffer) {
+    UNUSED(buffer);
+
+    PreProcCacheMeta *cache_meta = (PreProcCacheMeta *)meta;
+    delete cache_meta->cache;
+    cache_meta->cache = nullptr;
+}
+
+gboolean pre_proc_cache_meta_transform(GstBuffer *dest_buf, GstMeta *src_meta, GstBuffer *src_buf, GQuark type,
+                                       gpointer data) {
+    UNUSED(src_buf);
+
+    // Only plain copy of the whole buffer (gst_buffer_copy) has the same pixels and shares the cache. Cache is not
+    // valid for any other transformation (scaling, copy of region).
+    if (!GST_META_TRANSFORM_IS_COPY(type) || static_cast<GstMetaTransformCopy *>(data)->region)
+        return FALSE;
+
+    g_return_val_if_fail(gst_buffer_is_writable(dest_buf), FALSE);
+    PreProcCacheMeta *src = (PreProcCacheMeta *)src_meta;
+    if (!src->cache || PRE_PROC_CACHE_META_GET(dest_buf))
+        return TRUE;
+    PreProcCacheMeta *dst = PRE_PROC_CACHE_META_ADD(dest_buf);
+    dst->cache = new InferenceBackend::PreProcCache::Ptr(*src->cache);
+    return TRUE;
+}
+
+const GstMetaInfo *pre_proc_cache_meta_get_info(void) {
+    static const GstMetaInfo *meta_info = NULL;
+
+    if (g_once_init_enter(&meta_info)) {
+        const GstMetaInfo *meta = gst_meta_register(
+            pre_proc_cache_meta_api_get_type(), PRE_PROC_CACHE_META_IMPL_NAME, sizeof(PreProcCacheMeta),
+            (GstMetaInitFunction)pre_proc_cache_meta_init, (GstMetaFreeFunction)pre_proc_cache_meta_free,
+            (GstMetaTransformFunction)pre_proc_cache_meta_transform);
+        g_once_init_leave(&meta_info, meta);
+    }
+    return meta_info;
+}
+
+InferenceBackend::PreProcCache::Ptr pre_proc_cache_meta_acquire(GstBuffer *buffer, size_t budget) {
+    PreProcCacheMeta *meta = PRE_PROC_CACHE_META_GET(buffer);
+    if (meta && meta->cache) {
+        (*meta->cache)->ExtendBudget(budget);
+        return *meta->cache;
+    }
+
+    if (!meta)
+        meta = PRE_PROC_CACHE_META_ADD(buffer);
+    auto cache = std::make_shared<InferenceBackend::PreProcCache>(budget);
+    meta->cache = new InferenceBackend::PreProcCache::Ptr(cache);
+    return cache;
+}
@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+/**
+ * @file pre_proc_cache_meta.h
+ * @brief This file contains helper functions to control _PreProcCacheMeta instances
+ */
+
+#pragma once
+
+#include "inference_backend/pre_proc_cache.h"
+
+#include <gst/gst.h>
+
+#define PRE_PROC_CACHE_META_API_NAME "PreProcCacheMetaAPI"
+#define PRE_PROC_CACHE_META_IMPL_NAME "PreProcCacheMeta"
+
+typedef struct _PreProcCacheMeta PreProcCacheMeta;
+
+/**
+ * @brief This struct attaches cache of pre-processed images to GstBuffer. Cache is reference-counted: it is shared
+ * with copies of the buffer and with inference requests in flight, and freed when the last of them is released.
+ */
+struct _PreProcCacheMeta {
+    GstMeta meta;                               /**< parent GstMeta */
+    InferenceBackend::PreProcCache::Ptr *cache; /**< shared cache, heap-allocated as GstMeta is not constructed */
+};
+
+/**
+ * @brief This function registers, if needed, and returns GstMetaInfo for _PreProcCacheMeta
+ * @return const GstMetaInfo* for registered type
+ */
+const GstMetaInfo *pre_proc_cache_meta_get_info(void);
+
+/**
+ * @brief This function registers, if needed, and returns a GType for api "PreProcCacheMetaAPI"
+ * @return GType type
+ */
+GType pre_proc_cache_meta_api_get_type(void);
+
+/**
+ * @brief This function returns cache attached to buffer, attaching a new one if there is none. Budget of existing
+ * cache is extended to budget if the latter is larger.
+ * @param buffer writable GstBuffer
+ * @param budget memory budget of cache in bytes
+ * @return shared cache
+ */
+InferenceBackend::PreProcCache::Ptr pre_proc_cache_meta_acquire(GstBuffer *buffer, size_t budget);
@@ -93,12 +93,21 @@ TensorsTable BlobToROIConverter::toTensorsTable(const DetectedObjectsTable &bbox
         throw std::logic_error("bboxes_table and batch_size must be equal.");
 
     TensorsTable tensors_table(batch_size);
+    tensors_table.detections.resize(batch_size);
+    tensors_table.detection_params = getModelProcOutputInfo().get();
 
     for (size_t image_id = 0; image_id < batch_size; ++image_id) {
         auto &tensors_batch = tensors_table[image_id];
+        auto &detections = tensors_table.detections[image_id];
         const auto &bboxes = bboxes_table[image_id];
+        tensors_batch.reserve(bboxes.size());
+        detections.reserve(bboxes.size());
         for (const DetectedObject &object : bboxes) {
-            tensors_batch.emplace_back(object.toTensor(getModelProcOutputInfo()));
+            // detection itself is kept typed, only additional tensors are structures
+            std::vector<GstStructure *> tensors{nullptr};
+            tensors.insert(tensors.end(), object.tensors.cbegin(), object.tensors.cend());
+            tensors_batch.push_back(std::move(tensors));
+            detections.push_back(object.toDetection());
         }
     }
 
@@ -114,36 +123,44 @@ TensorsTable BlobToROIConverter::storeObjects(DetectedObjectsTable &objects_tabl
     return toTensorsTable(objects_table);
 }
 
+nms::Options BlobToROIConverter::readNmsOptions(const GstStructure *model_proc_output_info, double iou_threshold) {
+    nms::Options options;
+    options.iou_threshold = static_cast<float>(iou_threshold);
+    if (model_proc_output_info == nullptr)
+        return options;
+
+    const gchar *method = gst_structure_get_string(model_proc_output_info, "nms_method");
+    if (method)
+        options.method = nms::methodFromString(method);
+    int top_k = 0;
+    if (gst_structure_get_int(model_proc_output_info, "nms_top_k", &top_k) && top_k > 0)
+        options.top_k = static_cast<size_t>(top_k);
+    return options;
+}
+
 void BlobToROIConverter::runNms(std::vector<DetectedObject> &candidates) const {
     ITT_TASK(__FUNCTION__);
-    std::sort(candidates.rbegin(), candidates.rend());
-
-    for (auto p_first_candidate = candidates.begin(); p_first_candidate != candidates.end(); ++p_first_candidate) {
-        const auto &first_candidate = *p_first_candidate;
-        double first_candidate_area = first_candidate.w * first_candidate.h;
-
-        for (auto p_candidate = p_first_candidate + 1; p_candidate != candidates.end();) {
-            const auto &candidate = *p_candidate;
-
-            const double inter_width = std::min(first_candidate.x + first_candidate.w, candidate.x + candidate.w) -
-                                       std::max(first_candidate.x, candidate.x);
-            const double inter_height = std::min(first_candidate.y + first_candidate.h, candidate.y + candidate.h) -
-                                        std::max(first_candidate.y, candidate.y);
-            if (inter_width <= 0.0 || inter_height <= 0.0) {
-                ++p_candidate;
-                continue;
-            }
-
-            const double inter_area = inter_width * inter_height;
-            const double candidate_area = candidate.w * candidate.h;
-            const double union_area = candidate_area + first_candidate_area - inter_area;
-
-            assert(union_area != 0 && "union_area is null. Both of the boxes have zero areas.");
-            const double overlap = inter_area / union_area;
-            if (overlap > iou_threshold)
-                p_candidate = candidates.erase(p_candidate);
-            else
-                ++p_candidate;
-        }
+    nms::Boxes boxes;
+    boxes.reserve(candidates.size());
+    for (const auto &candidate : candidates)
+        boxes.add(candidate.x, candidate.y, candidate.x + candidate.w, candidate.y + candidate.h, candidate.confidence,
+                  static_cast<int32_t>(candidate.label_id));
+
+    const std::vector<size_t> kept = nms::run(boxes, nms_options);
+
+    std::vector<bool> is_kept(candidates.size(), false);
+    std::vector<DetectedObject> result;
+    result.reserve(kept.size());
+    for (size_t index : kept) {
+        is_kept[index] = true;
+        result.push_back(std::move(candidates[index]));
+    }
+    // Suppressed candidates own their additional tensors
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (is_kept[i])
+            continue;
+        for (GstStructure *tensor : candidates[i].tensors)
+            gst_structure_free(tensor);
     }
+    candidates = std::move(result);
 }
@@ -9,6 +9,8 @@
 #include "post_processor/blob_to_meta_converter.h"
 #include "post_processor/post_proc_common.h"
 
+#include "nms.h"
+
 #include <gst/gst.h>
 
 #include <map>
@@ -61,22 +63,18 @@ class BlobToROIConverter : public BlobToMetaConverter {
             return this->confidence > other.confidence;
         }
 
-        std::vector<GstStructure *> toTensor(const GstStructureUniquePtr &detection_result) const {
-            GstStructure *detection_tensor = gst_structure_copy(detection_result.get());
-
-            gst_structure_set_name(detection_tensor, "detection"); // make sure name="detection"
-            gst_structure_set(detection_tensor, "label_id", G_TYPE_INT, label_id, "confidence", G_TYPE_DOUBLE,
-                              confidence, "x_min", G_TYPE_DOUBLE, x, "x_max", G_TYPE_DOUBLE, x + w, "y_min",
-                              G_TYPE_DOUBLE, y, "y_max", G_TYPE_DOUBLE, y + h, "rotation", G_TYPE_DOUBLE, r, NULL);
-
+        GVADetection toDetection() const {
+            GVADetection detection = {};
+            detection.x_min = x;
+            detection.y_min = y;
+            detection.x_max = x + w;
+            detection.y_max = y + h;
+            detection.confidence = confidence;
+            detection.rotation = r;
+            detection.label_id = static_cast<gint>(label_id);
             if (not label.empty())
-                gst_structure_set(detection_tensor, "label", G_TYPE_STRING, label.c_str(), NULL);
-
-            std::vector<GstStructure *> results{detection_tensor};
-            for (size_t i = 0; i < tensors.size(); i++)
-                results.push_back(tensors[i]);
-
-            return results;
+                detection.label = g_quark_from_string(label.c_str());
+            return detection;
         }
     };
     using DetectedObjectsTable = std::vector<std::vector<DetectedObject>>;
@@ -88,6 +86,10 @@ class BlobToROIConverter : public BlobToMetaConverter {
     const double confidence_threshold;
     const bool need_nms;
     const double iou_threshold;
+    // Read from model-proc "nms_method" and "nms_top_k" fields
+    const nms::Options nms_options;
+
+    static nms::Options readNmsOptions(const GstStructure *model_proc_output_info, double iou_threshold);
 
   public:
     BlobToROIConverter() = delete;
@@ -95,7 +97,7 @@ class BlobToROIConverter : public BlobToMetaConverter {
     BlobToROIConverter(BlobToMetaConverter::Initializer initializer, double confidence_threshold, bool need_nms,
                        double iou_threshold)
         : BlobToMetaConverter(std::move(initializer)), confidence_threshold(confidence_threshold), need_nms(need_nms),
-          iou_threshold(iou_threshold) {
+          iou_threshold(iou_threshold), nms_options(readNmsOptions(getModelProcOutputInfo().get(), iou_threshold)) {
     }
 
     TensorsTable convert(const OutputBlobs &output_blobs) const = 0;
@@ -6,6 +6,7 @@
 
 #include "mask_rcnn.h"
 
+#include "bitmask.h"
 #include "copy_blob_to_gststruct.h"
 #include "inference_backend/image_inference.h"
 #include "inference_backend/logger.h"
@@ -20,6 +21,18 @@
 
 using namespace post_processing;
 
+MaskRCNNConverter::MaskRCNNConverter(BlobToMetaConverter::Initializer initializer, double confidence_threshold,
+                                     double iou_threshold)
+    : BlobToROIConverter(std::move(initializer), confidence_threshold, true, iou_threshold) {
+    const gchar *mask_format = gst_structure_get_string(getModelProcOutputInfo().get(), "mask_format");
+    if (mask_format) {
+        const std::string format = mask_format;
+        if (format != "bitmask" && format != "float")
+            throw std::invalid_argument("Unsupported mask_format '" + format + "', expected 'bitmask' or 'float'.");
+        float_masks = format == "float";
+    }
+}
+
 TensorsTable MaskRCNNConverter::convert(const OutputBlobs &output_blobs) const {
     ITT_TASK(__FUNCTION__);
     try {
@@ -30,6 +43,7 @@ TensorsTable MaskRCNNConverter::convert(const OutputBlobs &output_blobs) const {
         size_t input_height = getModelInputImageInfo().height;
 
         DetectedObjectsTable objects_table(batch_size);
+        std::vector<uint8_t> bits;
 
         bool three_output_tensors = false;
         std::string BOXES_KEY = TWO_TENSORS_BOXES_KEY;
@@ -142,8 +156,10 @@ TensorsTable MaskRCNNConverter::convert(const OutputBlobs &output_blobs) const {
                 // create segmentation mask tensor
                 GstStructure *tensor = gst_structure_copy(getModelProcOutputInfo().get());
                 gst_structure_set_name(tensor, "mask_rcnn");
-                gst_structure_set(tensor, "precision", G_TYPE_INT, GVA_PRECISION_FP32, NULL);
-                gst_structure_set(tensor, "format", G_TYPE_STRING, "segmentation_mask", NULL);
+                gst_structure_set(tensor, "precision", G_TYPE_INT, float_masks ? GVA_PRECISION_FP32 : GVA_PRECISION_U8,
+                                  NULL);
+                gst_structure_set(tensor, "format", G_TYPE_STRING,
+                                  float_masks ? "segmentation_mask" : "segmentation_bitmask", NULL);
 
                 GValueArray *data = g_value_array_new(2);
                 GValue gvalue = G_VALUE_INIT;
@@ -155,8 +171,14 @@ TensorsTable MaskRCNNConverter::convert(const OutputBlobs &output_blobs) const {
                 gst_structure_set_array(tensor, "dims", data);
                 g_value_array_free(data);
 
-                copy_buffer_to_structure(tensor, reinterpret_cast<const void *>(mask),
-                                         masks_height * masks_width * sizeof(float));
+                if (float_masks) {
+                    copy_buffer_to_structure(tensor, reinterpret_cast<const void *>(mask),
+                                             masks_height * masks_width * sizeof(float));
+                } else {
+                    bits.resize(bitmask::packedSize(masks_width, masks_height));
+                    bitmask::pack(mask, masks_width, masks_height, MASK_THRESHOLD, bits.data());
+                    copy_buffer_to_structure(tensor, bits.data(), bits.size());
+                }
                 detected_object.tensors.push_back(tensor);
 
                 objects.push_back(detected_object);
@@ -75,11 +75,17 @@ const int TWO_TENSORS_OFFSET_Y2 = 6; // y coordinate of the bottom right corner
 const std::string TWO_TENSORS_BOXES_KEY = "reshape_do_2d";
 const std::string TWO_TENSORS_MASKS_KEY = "SecondStageBoxPredictor_1/Conv_3/BiasAdd";
 
+/*
+Segmentation masks are attached to detected objects at model resolution (dims = [height, width]), as raw FP32
+"segmentation_mask" tensors. Model-proc option "mask_format": "bitmask" attaches "segmentation_bitmask" tensors of U8
+precision instead, thresholded at MASK_THRESHOLD and packed one bit per pixel (see utils/bitmask.h). They are 32 times
+smaller, but scaled to object size their edges follow the pixel grid of the model output.
+*/
+const float MASK_THRESHOLD = 0.5f;
+
 class MaskRCNNConverter : public BlobToROIConverter {
   public:
-    MaskRCNNConverter(BlobToMetaConverter::Initializer initializer, double confidence_threshold, double iou_threshold)
-        : BlobToROIConverter(std::move(initializer), confidence_threshold, true, iou_threshold) {
-    }
+    MaskRCNNConverter(BlobToMetaConverter::Initializer initializer, double confidence_threshold, double iou_threshold);
 
     TensorsTable convert(const OutputBlobs &output_blobs) const override;
 
@@ -90,5 +96,8 @@ class MaskRCNNConverter : public BlobToROIConverter {
     static std::string getDepricatedName() {
         return "tensor_to_bbox_mask_rcnn";
     }
+
+  private:
+    bool float_masks = true;
 };
 } // namespace post_processing
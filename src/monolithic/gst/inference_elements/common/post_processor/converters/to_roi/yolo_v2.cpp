@@ -10,6 +10,7 @@
 
 #include "inference_backend/image_inference.h"
 #include "inference_backend/logger.h"
+#include "yolo_decode.h"
 
 #include <gst/gst.h>
 
@@ -43,6 +44,9 @@ void YOLOv2Converter::parseOutputBlob(const float *blob_data, const std::vector<
     if (not blob_data)
         throw std::invalid_argument("Output blob data is nullptr");
 
+    // allows to skip sigmoid for cells with low objectness
+    const float objectness_threshold = yolo::rawThreshold(confidence_threshold, output_sigmoid_activation);
+
     for (size_t bbox_scale_index = 0; bbox_scale_index < output_shape_info.bbox_number_on_cell; ++bbox_scale_index) {
         const float anchor_scale_w = anchors[bbox_scale_index * 2];
         const float anchor_scale_h = anchors[bbox_scale_index * 2 + 1];
@@ -56,6 +60,8 @@ void YOLOv2Converter::parseOutputBlob(const float *blob_data, const std::vector<
                 using Index = YOLOv2Converter::OutputLayerShapeConfig::Index;
 
                 float bbox_confidence = blob_data[getIndex(Index::CONFIDENCE, common_offset)];
+                if (bbox_confidence < objectness_threshold)
+                    continue;
                 if (output_sigmoid_activation)
                     bbox_confidence = sigmoid(bbox_confidence);
                 if (bbox_confidence <= confidence_threshold)
@@ -8,6 +8,7 @@
 
 #include "inference_backend/image_inference.h"
 #include "inference_backend/logger.h"
+#include "yolo_decode.h"
 
 #include <gst/gst.h>
 
@@ -65,10 +66,18 @@ void YOLOv3Converter::parseOutputBlob(const float *blob_data, const std::vector<
     size_t input_height = getModelInputImageInfo().height;
     const size_t side_square = side_w * side_h;
 
-    for (size_t i = 0; i < side_square; ++i) {
-        const size_t row = i / side_w;
-        const size_t col = i % side_w;
-        for (size_t bbox_cell_num = 0; bbox_cell_num < output_shape_info.bbox_number_on_cell; ++bbox_cell_num) {
+    // Objectness of all cells is compared with threshold before activation, so that sigmoid, class scores and box are
+    // computed only for cells that may pass the threshold
+    const float objectness_threshold = yolo::rawThreshold(confidence_threshold, output_sigmoid_activation);
+    std::vector<size_t> cells;
+    for (size_t bbox_cell_num = 0; bbox_cell_num < output_shape_info.bbox_number_on_cell; ++bbox_cell_num) {
+        cells.clear();
+        yolo::selectAtLeast(blob_data + entryIndex(side_square, bbox_cell_num * side_square, coords), side_square,
+                            objectness_threshold, cells);
+
+        for (size_t i : cells) {
+            const size_t row = i / side_w;
+            const size_t col = i % side_w;
             const size_t common_offset = bbox_cell_num * side_square + i;
             const size_t bbox_conf_index = entryIndex(side_square, common_offset, coords);
             const size_t bbox_index = entryIndex(side_square, common_offset, 0);
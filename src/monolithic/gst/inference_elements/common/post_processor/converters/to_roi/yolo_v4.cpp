@@ -6,15 +6,17 @@
 
 #include "yolo_v4.h"
 
-#include <opencv2/core.hpp>
+#include "yolo_decode.h"
+
+#include <gst/gst.h>
+
+#include <algorithm>
+#include <cmath>
 
 using namespace post_processing;
 
 void YOLOv4Converter::parseOutputBlob(const float *blob_data, const std::vector<size_t> &blob_dims, size_t blob_size,
                                       std::vector<DetectedObject> &objects) const {
-
-    // Transpose output data from NHWC to NCHW layout
-
     if (!blob_data)
         throw std::invalid_argument("Output blob data is nullptr.");
 
@@ -22,27 +24,63 @@ void YOLOv4Converter::parseOutputBlob(const float *blob_data, const std::vector<
     if (!desc)
         throw std::runtime_error("Unsupported output layout.");
 
-    size_t _N = blob_dims[desc.N];
-    size_t _C = blob_dims[desc.B];
-    size_t _W = blob_dims[desc.Cx];
-    size_t _H = blob_dims[desc.Cy];
-
-    float _transposed_blob_data[blob_size] = {0};
-
-    size_t offset_nhwc = 0; // n * HWC + h * WC + w * C + c
-    size_t offset_nchw = 0; // n * CHW + c * HW + h * W + w
-    for (size_t iN = 0; iN < _N; iN++) {
-        for (size_t iH = 0; iH < _H; iH++) {
-            for (size_t iW = 0; iW < _W; iW++) {
-                for (size_t iC = 0; iC < _C; iC++) {
-                    offset_nhwc = iN * _H * _W * _C + iH * _W * _C + iW * _C + iC;
-                    offset_nchw = iN * _C * _H * _W + iC * _H * _W + iH * _W + iW;
-                    // NHWC -> NCHW
-                    _transposed_blob_data[offset_nchw] = blob_data[offset_nhwc];
+    const size_t side_w = blob_dims[desc.Cx];
+    const size_t side_h = blob_dims[desc.Cy];
+    const size_t channels = blob_dims[desc.B];
+    const size_t classes_number = output_shape_info.classes_number;
+    const size_t one_bbox_size = classes_number + 5;
+    if (channels < output_shape_info.bbox_number_on_cell * one_bbox_size || blob_size < side_w * side_h * channels)
+        throw std::invalid_argument("Output blob size doesn't match output layer configuration.");
+
+    const std::vector<size_t> &mask = masks.at(std::min(side_w, side_h));
+    const size_t input_width = getModelInputImageInfo().width;
+    const size_t input_height = getModelInputImageInfo().height;
+
+    // NHWC output keeps all channels of a cell together, so it is read as is instead of being transposed to NCHW:
+    // class scores of a box form one contiguous row. Results are the same as of YOLOv3Converter on transposed data.
+    const float objectness_threshold = yolo::rawThreshold(confidence_threshold, output_sigmoid_activation);
+    for (size_t row = 0; row < side_h; ++row) {
+        for (size_t col = 0; col < side_w; ++col) {
+            const float *cell = blob_data + (row * side_w + col) * channels;
+            for (size_t bbox_cell_num = 0; bbox_cell_num < output_shape_info.bbox_number_on_cell; ++bbox_cell_num) {
+                const float *bbox = cell + bbox_cell_num * one_bbox_size;
+                if (bbox[coords] < objectness_threshold)
+                    continue;
+
+                float bbox_conf = bbox[coords];
+                if (output_sigmoid_activation)
+                    bbox_conf = sigmoid(bbox_conf);
+                if (bbox_conf < confidence_threshold)
+                    continue;
+
+                const yolo::Proposal main_class = yolo::argMax(bbox + 5, classes_number);
+                float bbox_class_prob = main_class.score;
+                if (do_cls_softmax) {
+                    float sum = 0;
+                    for (size_t i = 0; i < classes_number; ++i)
+                        sum += std::exp(bbox[5 + i]);
+                    bbox_class_prob = std::exp(main_class.score) / sum;
+                }
+                // class search of YOLOv3Converter starts from probability 0 of class 0
+                const bool has_class = bbox_class_prob > 0.f;
+                const size_t bbox_class_id = has_class ? main_class.class_id : 0;
+                if (!has_class)
+                    bbox_class_prob = 0.f;
+                if (bbox_class_prob > 1.f) {
+                    GST_WARNING("bbox_class_prob %f.is out of range [0,1].", bbox_class_prob);
+                }
+
+                const float confidence = bbox_conf * bbox_class_prob;
+                if (confidence > 1.f || confidence < 0.f) {
+                    GST_WARNING("confidence %f.is out of range [0,1].", confidence);
                 }
+                if (confidence < confidence_threshold)
+                    continue;
+
+                objects.push_back(calculateBoundingBox(col, row, bbox[0], bbox[1], bbox[2], bbox[3], side_w, side_h,
+                                                       input_width, input_height, mask[0], bbox_cell_num, confidence,
+                                                       bbox_class_id));
             }
         }
     }
-
-    YOLOv3Converter::parseOutputBlob(_transposed_blob_data, blob_dims, blob_size, objects);
-}
\ No newline at end of file
+}
@@ -9,6 +9,7 @@
 #include "inference_backend/image_inference.h"
 #include "inference_backend/logger.h"
 #include "safe_arithmetic.hpp"
+#include "yolo_decode.h"
 
 #include <gst/gst.h>
 
@@ -40,10 +41,6 @@ void YOLOv7Converter::parseOutputBlob(const float *data, const std::vector<size_
 
         const float *output_data = &data[box_index * object_size];
 
-        float x = output_data[YOLOV7_OFFSET_X];
-        float y = output_data[YOLOV7_OFFSET_Y];
-        float w = output_data[YOLOV7_OFFSET_W];
-        float h = output_data[YOLOV7_OFFSET_H];
         float confidence = output_data[YOLOV7_OFFSET_BS];
 
         // early exit if entire box has low detection confidence
@@ -52,22 +49,22 @@ void YOLOv7Converter::parseOutputBlob(const float *data, const std::vector<size_
         }
 
         // find main class with highest probability
-        size_t main_class = 0;
-        for (size_t class_index = 0; class_index < (size_t)NUM_CLASSES; ++class_index) {
-            if (output_data[YOLOV7_OFFSET_CS + class_index] > output_data[YOLOV7_OFFSET_CS + main_class]) {
-                main_class = class_index;
-            }
-        }
+        const auto main_class = yolo::argMax(output_data + YOLOV7_OFFSET_CS, NUM_CLASSES);
 
         // update with main class confidence
-        confidence *= output_data[YOLOV7_OFFSET_CS + main_class];
+        confidence *= main_class.score;
         if (confidence < confidence_threshold) {
             continue;
         }
 
-        objects.push_back(DetectedObject(x, y, w, h, 0, confidence, main_class,
-                                         BlobToMetaConverter::getLabelByLabelId(main_class), 1.0f / input_width,
-                                         1.0f / input_height, true));
+        float x = output_data[YOLOV7_OFFSET_X];
+        float y = output_data[YOLOV7_OFFSET_Y];
+        float w = output_data[YOLOV7_OFFSET_W];
+        float h = output_data[YOLOV7_OFFSET_H];
+
+        objects.push_back(DetectedObject(x, y, w, h, 0, confidence, main_class.class_id,
+                                         BlobToMetaConverter::getLabelByLabelId(main_class.class_id),
+                                         1.0f / input_width, 1.0f / input_height, true));
     }
 }
 
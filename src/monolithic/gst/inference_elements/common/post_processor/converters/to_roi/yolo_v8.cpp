@@ -9,6 +9,7 @@
 #include "inference_backend/image_inference.h"
 #include "inference_backend/logger.h"
 #include "safe_arithmetic.hpp"
+#include "yolo_decode.h"
 
 #include <gst/gst.h>
 
@@ -33,30 +34,27 @@ void YOLOv8Converter::parseOutputBlob(const float *data, const std::vector<size_
 
     size_t object_size = dims[dims_size - 2];
     size_t max_proposal_count = dims[dims_size - 1];
-
-    // transpose
-    cv::Mat outputs(object_size, max_proposal_count, CV_32F, (float *)data);
-    cv::transpose(outputs, outputs);
-    float *output_data = (float *)outputs.data;
-
-    for (size_t i = 0; i < max_proposal_count; ++i) {
-        float *classes_scores = output_data + YOLOV8_OFFSET_CS;
-        cv::Mat scores(1, object_size - YOLOV8_OFFSET_CS - (oob ? 1 : 0), CV_32FC1, classes_scores);
-        cv::Point class_id;
-        double maxClassScore;
-        cv::minMaxLoc(scores, 0, &maxClassScore, 0, &class_id);
-        if (maxClassScore > confidence_threshold) {
-
-            float x = output_data[YOLOV8_OFFSET_X];
-            float y = output_data[YOLOV8_OFFSET_Y];
-            float w = output_data[YOLOV8_OFFSET_W];
-            float h = output_data[YOLOV8_OFFSET_H];
-            float r = oob ? output_data[object_size - 1] : 0;
-            objects.push_back(DetectedObject(x, y, w, h, r, maxClassScore, class_id.x,
-                                             BlobToMetaConverter::getLabelByLabelId(class_id.x), 1.0f / input_width,
-                                             1.0f / input_height, true));
-        }
-        output_data += object_size;
+    const size_t non_class_channels = YOLOV8_OFFSET_CS + (oob ? 1 : 0);
+    if (object_size <= non_class_channels)
+        throw std::invalid_argument("Output blob object size " + std::to_string(object_size) + " is too small.");
+
+    // Output is read in its original [object_size, max_proposal_count] layout: class maximum is computed for a number
+    // of proposals at once and only boxes of proposals above threshold are read.
+    const size_t classes_number = object_size - non_class_channels;
+    std::vector<yolo::Proposal> proposals;
+    yolo::classMaxPlanar(data + YOLOV8_OFFSET_CS * max_proposal_count, classes_number, max_proposal_count,
+                         max_proposal_count, confidence_threshold, proposals);
+
+    for (const auto &proposal : proposals) {
+        const float *proposal_data = data + proposal.index;
+        float x = proposal_data[YOLOV8_OFFSET_X * max_proposal_count];
+        float y = proposal_data[YOLOV8_OFFSET_Y * max_proposal_count];
+        float w = proposal_data[YOLOV8_OFFSET_W * max_proposal_count];
+        float h = proposal_data[YOLOV8_OFFSET_H * max_proposal_count];
+        float r = oob ? proposal_data[(object_size - 1) * max_proposal_count] : 0;
+        objects.push_back(DetectedObject(x, y, w, h, r, proposal.score, proposal.class_id,
+                                         BlobToMetaConverter::getLabelByLabelId(proposal.class_id),
+                                         1.0f / input_width, 1.0f / input_height, true));
     }
 }
 
@@ -8,6 +8,7 @@
 
 #include "inference_backend/image_inference.h"
 #include "inference_backend/logger.h"
+#include "yolo_decode.h"
 
 #include <string>
 #include <vector>
@@ -52,10 +53,6 @@ void YOLOxConverter::parseOutputBlob(const float *data, const std::vector<size_t
                 const float *box_data = &data[box_index * object_size];
                 box_index++;
 
-                float x = (box_data[OFFSET_X] + grid_w) * stride;
-                float y = (box_data[OFFSET_Y] + grid_h) * stride;
-                float w = std::exp(box_data[OFFSET_W]) * stride;
-                float h = std::exp(box_data[OFFSET_H]) * stride;
                 float confidence = box_data[OFFSET_BS];
 
                 // early exit if entire box has low detection confidence
@@ -63,23 +60,22 @@ void YOLOxConverter::parseOutputBlob(const float *data, const std::vector<size_t
                     continue;
 
                 // find main class with highest probability
-                size_t main_class = 0;
-                for (size_t class_index = 0; class_index < (size_t)NUM_CLASSES; ++class_index) {
-                    // float class_score = box_data[OFFSET_CS + class_index];
-                    if (box_data[OFFSET_CS + class_index] > box_data[OFFSET_CS + main_class]) {
-                        main_class = class_index;
-                    }
-                }
+                const auto main_class = yolo::argMax(box_data + OFFSET_CS, NUM_CLASSES);
 
                 // update with main class confidence
-                confidence *= box_data[OFFSET_CS + main_class];
+                confidence *= main_class.score;
                 if (confidence < confidence_threshold)
                     continue;
 
+                float x = (box_data[OFFSET_X] + grid_w) * stride;
+                float y = (box_data[OFFSET_Y] + grid_h) * stride;
+                float w = std::exp(box_data[OFFSET_W]) * stride;
+                float h = std::exp(box_data[OFFSET_H]) * stride;
+
                 // add box to detected objects list
-                objects.push_back(DetectedObject(x, y, w, h, 0, confidence, main_class,
-                                                 BlobToMetaConverter::getLabelByLabelId(main_class), 1.0f / input_width,
-                                                 1.0f / input_height, true));
+                objects.push_back(DetectedObject(x, y, w, h, 0, confidence, main_class.class_id,
+                                                 BlobToMetaConverter::getLabelByLabelId(main_class.class_id),
+                                                 1.0f / input_width, 1.0f / input_height, true));
             } // height loop
         }     // width  loop
     }         // stride loop
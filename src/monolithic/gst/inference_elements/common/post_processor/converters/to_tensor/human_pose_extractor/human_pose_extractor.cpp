@@ -45,8 +45,7 @@ HumanPoseExtractor::HumanPoses HumanPoseExtractor::postprocess(const float *heat
 HumanPoseExtractor::HumanPoses HumanPoseExtractor::extractPoses(const std::vector<cv::Mat> &heat_maps,
                                                                 const std::vector<cv::Mat> &pafs) const {
     std::vector<std::vector<Peak>> peaks_from_heat_map(heat_maps.size());
-    FindPeaksBody find_peaks_body(heat_maps, min_peaks_distance, peaks_from_heat_map);
-    cv::parallel_for_(cv::Range(0, safe_convert<int>(heat_maps.size())), find_peaks_body);
+    FindAllPeaks(heat_maps, min_peaks_distance, peaks_from_heat_map);
     int peaks_before = 0;
     for (size_t heatmap_id = 1; heatmap_id < heat_maps.size(); heatmap_id++) {
         peaks_before += safe_convert<int>(peaks_from_heat_map[heatmap_id - 1].size());
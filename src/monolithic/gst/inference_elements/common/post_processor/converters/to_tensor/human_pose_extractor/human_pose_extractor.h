@@ -7,6 +7,7 @@
 #pragma once
 
 #include "inference_backend/input_image_layer_descriptor.h"
+#include "peak.h"
 
 #include <opencv2/core/core.hpp>
 
@@ -18,16 +19,9 @@ class HumanPoseExtractor {
     const size_t keypoints_number;
 
     enum class ResizeDeviceType { CPU_OCV, GPU_OCV };
-    struct HumanPose {
-        HumanPose(const std::vector<cv::Point2f> &keypoints = std::vector<cv::Point2f>(), const float &score = 0)
-            : keypoints(keypoints), score(score) {
-        }
-
-        std::vector<cv::Point2f> keypoints;
-        float score;
-    };
-
-    using HumanPoses = std::vector<HumanPose>;
+    // Same types as peak search and grouping (src/utils/human_pose) produce
+    using HumanPose = ::HumanPose;
+    using HumanPoses = ::HumanPoses;
 
     HumanPoseExtractor(size_t, ResizeDeviceType maps_resize_device_type = ResizeDeviceType::CPU_OCV);
 
@@ -107,34 +107,15 @@ void ROICoordinatesRestorer::updateCoordinatesToFullFrame(double &x_min, double
     }
 }
 
-void ROICoordinatesRestorer::getRealCoordinates(GstStructure *detection_tensor, double &x_min_real, double &y_min_real,
-                                                double &x_max_real, double &y_max_real) {
-
-    if (!gst_structure_get(detection_tensor, "x_min", G_TYPE_DOUBLE, &x_min_real, "x_max", G_TYPE_DOUBLE, &x_max_real,
-                           "y_min", G_TYPE_DOUBLE, &y_min_real, "y_max", G_TYPE_DOUBLE, &y_max_real, NULL)) {
-
-        throw std::runtime_error("Invalid gst_structure_get() method field(s) requested");
-    }
-}
-
-void ROICoordinatesRestorer::getCoordinates(GstStructure *detection_tensor, const FrameWrapper &frame,
-                                            double &x_min_real, double &y_min_real, double &x_max_real,
-                                            double &y_max_real, uint32_t &x_abs, uint32_t &y_abs, uint32_t &w_abs,
-                                            uint32_t &h_abs) {
-
-    getRealCoordinates(detection_tensor, x_min_real, y_min_real, x_max_real, y_max_real);
-
+void ROICoordinatesRestorer::restoreCoordinates(GVADetection &detection, const FrameWrapper &frame) {
     if (frame.image_transform_info and frame.image_transform_info->WasTransformation()) {
-        restoreActualCoordinates(frame, x_min_real, y_min_real);
-        restoreActualCoordinates(frame, x_max_real, y_max_real);
+        restoreActualCoordinates(frame, detection.x_min, detection.y_min);
+        restoreActualCoordinates(frame, detection.x_max, detection.y_max);
     }
 
-    updateCoordinatesToFullFrame(x_min_real, y_min_real, x_max_real, y_max_real, frame);
+    updateCoordinatesToFullFrame(detection.x_min, detection.y_min, detection.x_max, detection.y_max, frame);
 
-    clipNormalizedRect(x_min_real, y_min_real, x_max_real, y_max_real);
-
-    getAbsoluteCoordinates(frame.width, frame.height, x_min_real, y_min_real, x_max_real, y_max_real, x_abs, y_abs,
-                           w_abs, h_abs);
+    clipNormalizedRect(detection.x_min, detection.y_min, detection.x_max, detection.y_max);
 }
 
 void ROICoordinatesRestorer::restore(TensorsTable &tensors_batch, const FramesWrapper &frames) {
@@ -142,22 +123,8 @@ void ROICoordinatesRestorer::restore(TensorsTable &tensors_batch, const FramesWr
         checkFramesAndTensorsTable(frames, tensors_batch);
 
         for (size_t i = 0; i < frames.size(); ++i) {
-            const auto &frame = frames[i];
-            const auto &tensor = tensors_batch[i];
-
-            for (size_t j = 0; j < tensor.size(); ++j) {
-                GstStructure *detection_tensor = tensor[j][DETECTION_TENSOR_ID];
-
-                double x_min_real, y_min_real, x_max_real, y_max_real;
-                uint32_t x_abs, y_abs, w_abs, h_abs;
-                getCoordinates(detection_tensor, frame, x_min_real, y_min_real, x_max_real, y_max_real, x_abs, y_abs,
-                               w_abs, h_abs);
-
-                gst_structure_set(detection_tensor, "x_min", G_TYPE_DOUBLE, x_min_real, "x_max", G_TYPE_DOUBLE,
-                                  x_max_real, "y_min", G_TYPE_DOUBLE, y_min_real, "y_max", G_TYPE_DOUBLE, y_max_real,
-                                  "x_abs", G_TYPE_UINT, x_abs, "y_abs", G_TYPE_UINT, y_abs, "w_abs", G_TYPE_UINT, w_abs,
-                                  "h_abs", G_TYPE_UINT, h_abs, NULL);
-            }
+            for (GVADetection &detection : tensors_batch.detections.at(i))
+                restoreCoordinates(detection, frames[i]);
         }
     } catch (const std::exception &e) {
         GVA_ERROR("An error occurred while restoring coordinates for ROI: %s", e.what());
@@ -40,14 +40,7 @@ class ROICoordinatesRestorer : public CoordinatesRestorer {
     GstVideoRegionOfInterestMeta *findDetectionMeta(const FrameWrapper &frame);
     void updateCoordinatesToFullFrame(double &x_min, double &y_min, double &x_max, double &y_max,
                                       const FrameWrapper &frame);
-    void getAbsoluteCoordinates(int orig_image_width, int orig_image_height, double real_x_min, double real_y_min,
-                                double real_x_max, double real_y_max, uint32_t &abs_x, uint32_t &abs_y, uint32_t &abs_w,
-                                uint32_t &abs_h);
-    void getRealCoordinates(GstStructure *detection_tensor, double &x_min_real, double &y_min_real, double &x_max_real,
-                            double &y_max_real);
-    void getCoordinates(GstStructure *detection_tensor, const FrameWrapper &frame, double &x_min_real,
-                        double &y_min_real, double &x_max_real, double &y_max_real, uint32_t &x_abs, uint32_t &y_abs,
-                        uint32_t &w_abs, uint32_t &h_abs);
+    void restoreCoordinates(GVADetection &detection, const FrameWrapper &frame);
 
   public:
     ROICoordinatesRestorer(const ModelImageInputInfo &input_info, AttachType type)
@@ -55,6 +48,10 @@ class ROICoordinatesRestorer : public CoordinatesRestorer {
     }
 
     virtual void restore(TensorsTable &tensors_batch, const FramesWrapper &frames) override;
+
+    static void getAbsoluteCoordinates(int orig_image_width, int orig_image_height, double real_x_min,
+                                       double real_y_min, double real_x_max, double real_y_max, uint32_t &abs_x,
+                                       uint32_t &abs_y, uint32_t &abs_w, uint32_t &abs_h);
 };
 
 class KeypointsCoordinatesRestorer : public CoordinatesRestorer {
@@ -16,14 +16,15 @@ using namespace post_processing;
 FrameWrapper::FrameWrapper(InferenceFrame &frame)
     : buffer(frame.buffer), model_instance_id(frame.gva_base_inference->model_instance_id), roi(&frame.roi),
       image_transform_info(frame.image_transform_info), width(frame.info->width), height(frame.info->height),
-      roi_classifications(&frame.roi_classifications) {
+      roi_classifications(&frame.roi_classifications),
+      roi_detection_params(frame.gva_base_inference->roi_detection_params) {
 }
 
 // This constructor is only called for micro-elements, initialization of the rest of the fields is not required because
 // they are not used there
 FrameWrapper::FrameWrapper(GstBuffer *buf, const std::string &instance_id)
     : buffer(buf), model_instance_id(instance_id), roi(nullptr), image_transform_info(nullptr), width(0), height(0),
-      roi_classifications(nullptr) {
+      roi_classifications(nullptr), roi_detection_params(true) {
 }
 
 /* class FramesWrapper */
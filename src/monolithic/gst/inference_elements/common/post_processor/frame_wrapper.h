@@ -30,6 +30,8 @@ class FrameWrapper {
     size_t width;
     size_t height;
     std::vector<GstStructure *> *roi_classifications;
+    // add "detection" GstStructure to params of attached ROI, it's built on request from GstGVADetectionMeta otherwise
+    bool roi_detection_params;
 };
 
 using InferenceFrames = std::vector<std::shared_ptr<InferenceFrame>>;
@@ -6,6 +6,8 @@
 
 #include "meta_attacher.h"
 
+#include "coordinates_restorer.h"
+#include "gva_detection_meta.h"
 #include "gva_utils.h"
 #include "processor_types.h"
 
@@ -37,24 +39,37 @@ MetaAttacher::Ptr MetaAttacher::create(ConverterType converter_type, AttachType
 
 void ROIToFrameAttacher::attach(const TensorsTable &tensors, FramesWrapper &frames) {
     checkFramesAndTensorsTable(frames, tensors);
+    if (tensors.detections.size() != tensors.size())
+        throw std::invalid_argument("Detections and tensors table must have equal size");
 
     for (size_t i = 0; i < frames.size(); ++i) {
         auto &frame = frames[i];
         const auto &tensor = tensors[i];
+        const auto &detections = tensors.detections[i];
+        if (detections.empty())
+            continue;
 
-        for (size_t j = 0; j < tensor.size(); ++j) {
-            GstStructure *detection_tensor = tensor[j][DETECTION_TENSOR_ID];
+        GstBuffer **writable_buffer = &frame.buffer;
+        gva_buffer_check_and_make_writable(writable_buffer, PRETTY_FUNCTION_NAME);
 
-            uint32_t x_abs, y_abs, w_abs, h_abs;
-            gst_structure_get_uint(detection_tensor, "x_abs", &x_abs);
-            gst_structure_get_uint(detection_tensor, "y_abs", &y_abs);
-            gst_structure_get_uint(detection_tensor, "w_abs", &w_abs);
-            gst_structure_get_uint(detection_tensor, "h_abs", &h_abs);
+        // all detections of the frame are stored in one typed meta, "detection" structures are built from it
+        GstGVADetectionMeta *detection_meta = GST_GVA_DETECTION_META_ADD(*writable_buffer);
+        detection_meta->element_id = g_quark_from_string(frame.model_instance_id.c_str());
+        if (tensors.detection_params)
+            detection_meta->params = gst_structure_copy(tensors.detection_params);
+        detection_meta->roi_params = frame.roi_detection_params;
+        gva_detection_meta_reserve(detection_meta, static_cast<guint>(detections.size()));
 
-            const gchar *label = gst_structure_get_string(detection_tensor, "label");
+        for (size_t j = 0; j < detections.size(); ++j) {
+            GVADetection *detection = gva_detection_meta_append(detection_meta);
+            *detection = detections[j];
 
-            GstBuffer **writable_buffer = &frame.buffer;
-            gva_buffer_check_and_make_writable(writable_buffer, PRETTY_FUNCTION_NAME);
+            uint32_t x_abs, y_abs, w_abs, h_abs;
+            ROICoordinatesRestorer::getAbsoluteCoordinates(frame.width, frame.height, detection->x_min,
+                                                           detection->y_min, detection->x_max, detection->y_max, x_abs,
+                                                           y_abs, w_abs, h_abs);
+
+            const gchar *label = detection->label ? g_quark_to_string(detection->label) : nullptr;
             GstVideoRegionOfInterestMeta *roi_meta =
                 gst_buffer_add_video_region_of_interest_meta(*writable_buffer, label, x_abs, y_abs, w_abs, h_abs);
 
@@ -62,14 +77,11 @@ void ROIToFrameAttacher::attach(const TensorsTable &tensors, FramesWrapper &fram
                 throw std::runtime_error("Failed to add GstVideoRegionOfInterestMeta to buffer");
 
             roi_meta->id = gst_util_seqnum_next();
+            detection->roi_id = roi_meta->id;
 
-            gst_structure_remove_field(detection_tensor, "label");
-            gst_structure_remove_field(detection_tensor, "x_abs");
-            gst_structure_remove_field(detection_tensor, "y_abs");
-            gst_structure_remove_field(detection_tensor, "w_abs");
-            gst_structure_remove_field(detection_tensor, "h_abs");
-
-            gst_video_region_of_interest_meta_add_param(roi_meta, detection_tensor);
+            if (frame.roi_detection_params)
+                gst_video_region_of_interest_meta_add_param(roi_meta,
+                                                            gva_detection_meta_new_structure(detection_meta, j));
 
             // add tensors other than detection_tensor
             for (size_t k = 1; k < tensor[j].size(); k++) {
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "frame_wrapper.h"
+#include "gva_detection_meta.h"
 #include "inference_backend/image_inference.h"
 
 #include <gst/video/gstvideometa.h>
@@ -18,9 +19,19 @@
 
 namespace post_processing {
 
+// DetectionsTable = frames<objects>
+using DetectionsTable = std::vector<std::vector<GVADetection>>;
+
 // TensorTable = frames<objects<tensors>>>
 static const int DETECTION_TENSOR_ID = 0;
-using TensorsTable = std::vector<std::vector<std::vector<GstStructure *>>>;
+// ROI converters leave DETECTION_TENSOR_ID tensor nullptr and put detection to 'detections' at the same frame and
+// object indexes, "detection" GstStructure is built from it only if needed
+struct TensorsTable : std::vector<std::vector<std::vector<GstStructure *>>> {
+    using vector::vector;
+
+    DetectionsTable detections;
+    const GstStructure *detection_params = nullptr; // fields common to all detections, owned by converter
+};
 using OutputBlobs = std::map<std::string, InferenceBackend::OutputBlob::Ptr>;
 // <layer_name, blob_dims>
 using ModelOutputsInfo = std::map<std::string, std::vector<size_t>>;
@@ -13,39 +13,184 @@
 
 #include <algorithm>
 
+namespace {
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+// Slots of shard before it grows, enough for a few objects per shard as streams usually have
+const size_t INITIAL_SHARD_SLOTS = 16;
+
+uint64_t HashObjectId(int object_id) {
+    // Fibonacci hashing spreads sequential tracker ids over shards and slots
+    return static_cast<uint64_t>(static_cast<uint32_t>(object_id)) * 0x9E3779B97F4A7C15ull;
+}
+
+} // namespace
+
+size_t ClassificationHistory::Shard::Home(int object_id) const {
+    return static_cast<size_t>(HashObjectId(object_id) >> 8) & (slots.size() - 1);
+}
+
+ClassificationHistory::Entry *ClassificationHistory::Shard::Find(int object_id) {
+    const size_t mask = slots.size() - 1;
+    for (size_t i = Home(object_id); slots[i].object_id; i = (i + 1) & mask) {
+        if (slots[i].object_id == object_id)
+            return &slots[i];
+    }
+    return nullptr;
+}
+
+ClassificationHistory::Entry &ClassificationHistory::Shard::Insert(int object_id, bool &evicted) {
+    evicted = false;
+    if (size >= max_size) {
+        const auto oldest = std::min_element(slots.begin(), slots.end(), [](const Entry &a, const Entry &b) {
+            // empty slots are never the oldest
+            return a.object_id && (!b.object_id || a.frame_of_last_lookup < b.frame_of_last_lookup);
+        });
+        Erase(oldest->object_id);
+        evicted = true;
+    }
+
+    // slots are added as objects come, so large history-size costs nothing until that many objects are tracked
+    if ((size + 1) * 2 > slots.size())
+        Grow();
+
+    Entry &entry = slots[FreeSlot(object_id)];
+    entry.object_id = object_id;
+    size++;
+    return entry;
+}
+
+size_t ClassificationHistory::Shard::FreeSlot(int object_id) const {
+    const size_t mask = slots.size() - 1;
+    size_t i = Home(object_id);
+    while (slots[i].object_id)
+        i = (i + 1) & mask;
+    return i;
+}
+
+void ClassificationHistory::Shard::Grow() {
+    std::vector<Entry> old_slots(slots.size() * 2);
+    slots.swap(old_slots);
+    for (Entry &entry : old_slots) {
+        if (entry.object_id)
+            slots[FreeSlot(entry.object_id)] = std::move(entry);
+    }
+}
+
+bool ClassificationHistory::Shard::Erase(int object_id) {
+    Entry *entry = Find(object_id);
+    if (!entry)
+        return false;
+
+    // backward shift deletion keeps probe sequences without tombstones
+    const size_t mask = slots.size() - 1;
+    size_t hole = entry - slots.data();
+    for (size_t i = (hole + 1) & mask; slots[i].object_id; i = (i + 1) & mask) {
+        const size_t home = Home(slots[i].object_id);
+        // entry may move to the hole if its home isn't cyclically within (hole, i]
+        const bool movable = hole <= i ? (home <= hole || home > i) : (home <= hole && home > i);
+        if (movable) {
+            slots[hole] = std::move(slots[i]);
+            hole = i;
+        }
+    }
+    slots[hole] = Entry();
+    size--;
+    return true;
+}
+
+void ClassificationHistory::Shard::RememberRemoved(int object_id) {
+    removed_ids.push_back(object_id);
+    if (removed_ids.size() > max_size)
+        removed_ids.pop_front();
+}
+
+bool ClassificationHistory::Shard::ForgetRemoved(int object_id) {
+    const auto it = std::find(removed_ids.begin(), removed_ids.end(), object_id);
+    if (it == removed_ids.end())
+        return false;
+    removed_ids.erase(it);
+    return true;
+}
+
 ClassificationHistory::ClassificationHistory(GstGvaClassify *gva_classify)
-    : gva_classify(gva_classify), current_num_frame(0), history(CLASSIFICATION_HISTORY_SIZE) {
+    : gva_classify(gva_classify), current_num_frame(0) {
+    SetSize(DEFAULT_CLASSIFICATION_HISTORY_SIZE);
+}
+
+ClassificationHistory::~ClassificationHistory() {
+    const uint64_t lookups = hits + misses;
+    if (lookups) {
+        GVA_INFO("Classification history of %s: %llu lookups, hit rate %.1f%%, miss rate %.1f%%, %llu objects removed "
+                 "by tracker, %llu evicted by size limit",
+                 GST_ELEMENT_NAME(gva_classify), static_cast<unsigned long long>(lookups), 100.0 * hits / lookups,
+                 100.0 * misses / lookups, static_cast<unsigned long long>(removed.load()),
+                 static_cast<unsigned long long>(evicted.load()));
+    }
+}
+
+void ClassificationHistory::SetSize(size_t size) {
+    const size_t max_shard_size = std::max<size_t>((size + SHARDS - 1) / SHARDS, 1);
+    for (Shard &shard : shards) {
+        std::lock_guard<std::mutex> guard(shard.mutex);
+        shard.slots.assign(std::min(RoundUpToPowerOfTwo(max_shard_size * 2), INITIAL_SHARD_SLOTS), Entry());
+        shard.size = 0;
+        shard.max_size = max_shard_size;
+        shard.removed_ids.clear();
+    }
+}
+
+ClassificationHistory::Shard &ClassificationHistory::ShardOf(int object_id) {
+    return shards[HashObjectId(object_id) >> 60];
 }
 
 bool ClassificationHistory::IsROIClassificationNeeded(GstVideoRegionOfInterestMeta *roi, uint64_t current_num_frame) {
     try {
-        std::lock_guard<std::mutex> guard(history_mutex);
         this->current_num_frame = current_num_frame;
 
-        // by default we assume that
-        // we have recent classification result or classification is not required for this object
-        bool result = false;
         gint id;
-        if (!get_object_id(roi, &id))
+        if (!get_object_id(roi, &id) || !id)
             // object has not been tracked
             return true;
-        if (history.count(id) == 0) { // new object
-            history.put(id);
-            history.get(id).frame_of_last_update = current_num_frame;
-            result = true;
-        } else if (gva_classify->reclassify_interval == 0) {
-            return false;
-        } else {
-            auto current_interval = current_num_frame - history.get(id).frame_of_last_update;
-            if (current_interval > INT64_MAX && history.get(id).frame_of_last_update > current_num_frame)
-                current_interval = (UINT64_MAX - history.get(id).frame_of_last_update) + current_num_frame + 1;
-            if (current_interval >= gva_classify->reclassify_interval) {
-                // new object or reclassify old object
-                history.get(id).frame_of_last_update = current_num_frame;
-                result = true;
-            }
+
+        Shard &shard = ShardOf(id);
+        std::lock_guard<std::mutex> guard(shard.mutex);
+        Entry *entry = shard.Find(id);
+        if (!entry) { // new object, or object with id of removed one
+            misses++;
+            shard.ForgetRemoved(id);
+            bool evicted_oldest = false;
+            entry = &shard.Insert(id, evicted_oldest);
+            if (evicted_oldest && evicted++ == 0)
+                GVA_WARNING("Classification history size limit is exceeded, objects may be reclassified before "
+                            "reclassify-interval passes. Consider increasing history-size.");
+            entry->history.frame_of_last_update = current_num_frame;
+            entry->frame_of_last_lookup = current_num_frame;
+            return true;
         }
+        hits++;
+        entry->frame_of_last_lookup = current_num_frame;
+        if (gva_classify->reclassify_interval == 0)
+            return false;
 
+        // by default we assume that
+        // we have recent classification result or classification is not required for this object
+        bool result = false;
+        uint64_t &frame_of_last_update = entry->history.frame_of_last_update;
+        auto current_interval = current_num_frame - frame_of_last_update;
+        if (current_interval > INT64_MAX && frame_of_last_update > current_num_frame)
+            current_interval = (UINT64_MAX - frame_of_last_update) + current_num_frame + 1;
+        if (current_interval >= gva_classify->reclassify_interval) {
+            // reclassify old object
+            frame_of_last_update = current_num_frame;
+            result = true;
+        }
         return result;
     } catch (const std::exception &e) {
         std::throw_with_nested(std::runtime_error("Failed to check if detection tensor classification needed"));
@@ -54,19 +199,20 @@ bool ClassificationHistory::IsROIClassificationNeeded(GstVideoRegionOfInterestMe
 
 void ClassificationHistory::UpdateROIParams(int roi_id, const GstStructure *roi_param) {
     try {
-        std::lock_guard<std::mutex> guard(history_mutex);
-
         const gchar *layer_c = gst_structure_get_name(roi_param);
         if (not layer_c)
             throw std::runtime_error("Can't get name of region of interest param structure");
         std::string layer(layer_c);
+        if (!roi_id) // not tracked
+            return;
+        GstStructureSharedPtr param(gst_structure_copy(roi_param), gst_structure_free);
 
-        // To prevent attempts to access removed objects,
+        Shard &shard = ShardOf(roi_id);
+        std::lock_guard<std::mutex> guard(shard.mutex);
+        // To prevent attempts to access evicted objects,
         // we should readd lost objects to history if needed
-        CheckExistingAndReaddObjectId(roi_id);
-
-        history.get(roi_id).layers_to_roi_params[layer] =
-            GstStructureSharedPtr(gst_structure_copy(roi_param), gst_structure_free);
+        if (Entry *entry = GetOrReadd(shard, roi_id))
+            entry->history.layers_to_roi_params[layer] = std::move(param);
     } catch (const std::exception &e) {
         std::throw_with_nested(std::runtime_error("Failed to update detection tensor parameters"));
     }
@@ -75,30 +221,38 @@ void ClassificationHistory::UpdateROIParams(int roi_id, const GstStructure *roi_
 void ClassificationHistory::FillROIParams(GstBuffer *buffer) {
     try {
         GVA::VideoFrame video_frame(buffer, gva_classify->base_inference.info);
-        std::lock_guard<std::mutex> guard(history_mutex);
         for (GVA::RegionOfInterest &region : video_frame.regions()) {
             gint id = region.object_id();
             if (!id)
                 continue;
             InferenceImpl *inference = gva_classify->base_inference.inference;
             assert(inference && "Empty inference instance");
-            bool is_appropriate_object_class = inference->FilterObjectClass(region.label());
-            if (history.count(id) && is_appropriate_object_class) {
-                const auto &roi_history = history.get(id);
-                int frames_ago = this->current_num_frame - roi_history.frame_of_last_update;
-                for (const auto &layer_to_roi_param : roi_history.layers_to_roi_params) {
-                    if (!gst_video_region_of_interest_meta_get_param(
-                            region._meta(), gst_structure_get_name(layer_to_roi_param.second.get()))) {
-                        if (not region._meta())
-                            throw std::logic_error(
-                                "GstVideoRegionOfInterestMeta is nullptr for current region of interest");
-                        auto tensor = GstStructureUniquePtr(gst_structure_copy(layer_to_roi_param.second.get()),
-                                                            gst_structure_free);
-                        if (not tensor)
-                            throw std::runtime_error("Failed to create classification tensor");
-                        gst_structure_set(tensor.get(), "frames_ago", G_TYPE_INT, frames_ago, NULL);
-                        gst_video_region_of_interest_meta_add_param(region._meta(), tensor.release());
-                    }
+            if (!inference->FilterObjectClass(region.label()))
+                continue;
+
+            // results are copied out of the shard, so meta is updated without holding the lock
+            ROIClassificationHistory roi_history;
+            {
+                Shard &shard = ShardOf(id);
+                std::lock_guard<std::mutex> guard(shard.mutex);
+                const Entry *entry = shard.Find(id);
+                if (!entry)
+                    continue;
+                roi_history = entry->history;
+            }
+            int frames_ago = this->current_num_frame - roi_history.frame_of_last_update;
+            for (const auto &layer_to_roi_param : roi_history.layers_to_roi_params) {
+                if (!gst_video_region_of_interest_meta_get_param(
+                        region._meta(), gst_structure_get_name(layer_to_roi_param.second.get()))) {
+                    if (not region._meta())
+                        throw std::logic_error(
+                            "GstVideoRegionOfInterestMeta is nullptr for current region of interest");
+                    auto tensor = GstStructureUniquePtr(gst_structure_copy(layer_to_roi_param.second.get()),
+                                                        gst_structure_free);
+                    if (not tensor)
+                        throw std::runtime_error("Failed to create classification tensor");
+                    gst_structure_set(tensor.get(), "frames_ago", G_TYPE_INT, frames_ago, NULL);
+                    gst_video_region_of_interest_meta_add_param(region._meta(), tensor.release());
                 }
             }
         }
@@ -108,20 +262,34 @@ void ClassificationHistory::FillROIParams(GstBuffer *buffer) {
     }
 }
 
-LRUCache<int, ClassificationHistory::ROIClassificationHistory> &ClassificationHistory::GetHistory() {
-    std::lock_guard<std::mutex> guard(history_mutex);
-    return history;
+void ClassificationHistory::RemoveObjects(const std::vector<int> &roi_ids) {
+    for (int roi_id : roi_ids) {
+        if (!roi_id)
+            continue;
+        Shard &shard = ShardOf(roi_id);
+        std::lock_guard<std::mutex> guard(shard.mutex);
+        if (shard.Erase(roi_id))
+            removed++;
+        // object may still be classified, its result must not add it back
+        shard.RememberRemoved(roi_id);
+    }
 }
 
-void ClassificationHistory::CheckExistingAndReaddObjectId(int roi_id) {
-    if (history.count(roi_id) == 0) {
-        GVA_WARNING("Classification history size limit is exceeded. "
-                    "Additional reclassification within reclassify-interval is required.");
-        GvaBaseInference *base_inference = GVA_BASE_INFERENCE(gva_classify);
-        current_num_frame = base_inference->frame_num;
-        history.put(roi_id);
-        history.get(roi_id).frame_of_last_update = current_num_frame;
-    }
+ClassificationHistory::Entry *ClassificationHistory::GetOrReadd(Shard &shard, int roi_id) {
+    if (Entry *entry = shard.Find(roi_id))
+        return entry;
+    if (std::find(shard.removed_ids.begin(), shard.removed_ids.end(), roi_id) != shard.removed_ids.end())
+        return nullptr;
+
+    GvaBaseInference *base_inference = GVA_BASE_INFERENCE(gva_classify);
+    current_num_frame = base_inference->frame_num;
+    bool evicted_oldest = false;
+    Entry &entry = shard.Insert(roi_id, evicted_oldest);
+    if (evicted_oldest)
+        evicted++;
+    entry.history.frame_of_last_update = current_num_frame;
+    entry.frame_of_last_lookup = current_num_frame;
+    return &entry;
 }
 
 ClassificationHistory *create_classification_history(GstGvaClassify *gva_classify) {
@@ -141,3 +309,20 @@ void release_classification_history(ClassificationHistory *classification_histor
 void fill_roi_params_from_history(ClassificationHistory *classification_history, GstBuffer *buffer) {
     classification_history->FillROIParams(buffer);
 }
+
+void set_classification_history_size(ClassificationHistory *classification_history, guint size) {
+    try {
+        classification_history->SetSize(size);
+    } catch (const std::exception &e) {
+        GVA_ERROR("Failed to set classification history size to %u:\n%s", size, Utils::createNestedErrorMsg(e).c_str());
+    }
+}
+
+void remove_objects_from_history(ClassificationHistory *classification_history, GstEvent *event) {
+    GArray *object_ids = nullptr;
+    if (!gva_event_parse_objects_removed(event, &object_ids))
+        return;
+    const gint *ids = reinterpret_cast<const gint *>(object_ids->data);
+    classification_history->RemoveObjects(std::vector<int>(ids, ids + object_ids->len));
+    g_array_unref(object_ids);
+}
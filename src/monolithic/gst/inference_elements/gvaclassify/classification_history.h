@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (C) 2018-2021 Intel Corporation
+ * Copyright (C) 2018-2024 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  ******************************************************************************/
@@ -18,18 +18,29 @@ struct ClassificationHistory;
 struct ClassificationHistory *create_classification_history(GstGvaClassify *gva_classify);
 void release_classification_history(struct ClassificationHistory *classification_history);
 void fill_roi_params_from_history(struct ClassificationHistory *classification_history, GstBuffer *buffer);
+void set_classification_history_size(struct ClassificationHistory *classification_history, guint size);
+void remove_objects_from_history(struct ClassificationHistory *classification_history, GstEvent *event);
 
 G_END_DECLS
 
 #ifdef __cplusplus
 #include "gst_smart_pointer_types.hpp"
-#include "lru_cache.h"
 
+#include <array>
+#include <atomic>
+#include <deque>
 #include <map>
 #include <mutex>
+#include <vector>
 
-const size_t CLASSIFICATION_HISTORY_SIZE = 100;
+const size_t DEFAULT_CLASSIFICATION_HISTORY_SIZE = 1024;
 
+/**
+ * Classification results of tracked objects, reused for the objects until reclassify-interval passes.
+ * Objects are kept in open-addressing hash tables split into shards with their own locks, so streaming and inference
+ * threads looking up different objects rarely wait for each other. Object is removed when tracker reports it is gone,
+ * least recently seen object of the shard is evicted only if the shard is full.
+ */
 struct ClassificationHistory {
   public:
     struct ROIClassificationHistory {
@@ -43,18 +54,58 @@ struct ClassificationHistory {
     };
 
     ClassificationHistory(GstGvaClassify *gva_classify);
+    ~ClassificationHistory();
+
+    // Drops all objects, 'size' is the approximate maximum number of objects kept
+    void SetSize(size_t size);
 
     bool IsROIClassificationNeeded(GstVideoRegionOfInterestMeta *roi, uint64_t current_num_frame);
     void UpdateROIParams(int roi_id, const GstStructure *roi_param);
     void FillROIParams(GstBuffer *buffer);
-    LRUCache<int, ROIClassificationHistory> &GetHistory();
+    void RemoveObjects(const std::vector<int> &roi_ids);
 
   private:
-    void CheckExistingAndReaddObjectId(int roi_id);
+    struct Entry {
+        int object_id = 0; // 0 - empty slot, objects with id 0 are not tracked and never stored
+        uint64_t frame_of_last_lookup = 0;
+        ROIClassificationHistory history;
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::vector<Entry> slots; // power of two size, at most half of slots are used, grows up to 2 * max_size
+        size_t size = 0;
+        size_t max_size = 0;
+        // Objects recently removed by tracker, at most max_size. Results of their inference still in flight are
+        // dropped instead of adding the objects back.
+        std::deque<int> removed_ids;
+
+        size_t Home(int object_id) const;
+        Entry *Find(int object_id);
+        // Returns inserted entry and sets 'evicted' if least recently seen object was evicted to make room
+        Entry &Insert(int object_id, bool &evicted);
+        size_t FreeSlot(int object_id) const;
+        // Doubles number of slots keeping all objects
+        void Grow();
+        bool Erase(int object_id);
+        void RememberRemoved(int object_id);
+        // Returns true if object was recently removed by tracker and forgets about it
+        bool ForgetRemoved(int object_id);
+    };
+
+    static constexpr size_t SHARDS = 16;
+
+    Shard &ShardOf(int object_id);
+    // Returns entry of object, adds it again if it was evicted. Returns nullptr if object was removed by tracker.
+    Entry *GetOrReadd(Shard &shard, int roi_id);
 
     GstGvaClassify *gva_classify;
-    uint64_t current_num_frame;
-    LRUCache<int, ROIClassificationHistory> history;
-    std::mutex history_mutex;
+    std::atomic<uint64_t> current_num_frame;
+    std::array<Shard, SHARDS> shards;
+
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> removed{0};
+    std::atomic<uint64_t> evicted{0};
 };
 #endif
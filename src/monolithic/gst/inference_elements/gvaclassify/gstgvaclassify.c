@@ -26,12 +26,17 @@
 enum {
     PROP_0,
     PROP_RECLASSIFY_INTERVAL,
+    PROP_HISTORY_SIZE,
 };
 
 #define DEFAULT_RECLASSIFY_INTERVAL 1
 #define DEFAULT_MIN_RECLASSIFY_INTERVAL 0
 #define DEFAULT_MAX_RECLASSIFY_INTERVAL UINT_MAX
 
+#define DEFAULT_HISTORY_SIZE 1024
+#define DEFAULT_MIN_HISTORY_SIZE 1
+#define DEFAULT_MAX_HISTORY_SIZE UINT_MAX
+
 GST_DEBUG_CATEGORY_STATIC(gst_gva_classify_debug_category);
 #define GST_CAT_DEFAULT gst_gva_classify_debug_category
 
@@ -44,6 +49,7 @@ static void gst_gva_classify_finalize(GObject *);
 static void gst_gva_classify_cleanup(GstGvaClassify *);
 static gboolean gst_gva_classify_check_properties_correctness(GstGvaClassify *gvaclassify);
 static gboolean gst_gva_classify_start(GstBaseTransform *trans);
+static gboolean gst_gva_classify_sink_event(GstBaseTransform *trans, GstEvent *event);
 
 void gst_gva_classify_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec) {
     GstGvaClassify *gvaclassify = GST_GVA_CLASSIFY(object);
@@ -69,6 +75,11 @@ void gst_gva_classify_set_property(GObject *object, guint property_id, const GVa
         }
         break;
     }
+    case PROP_HISTORY_SIZE:
+        gvaclassify->history_size = g_value_get_uint(value);
+        if (gvaclassify->classification_history)
+            set_classification_history_size(gvaclassify->classification_history, gvaclassify->history_size);
+        break;
     default: {
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -85,6 +96,9 @@ void gst_gva_classify_get_property(GObject *object, guint property_id, GValue *v
     case PROP_RECLASSIFY_INTERVAL:
         g_value_set_uint(value, gvaclassify->reclassify_interval);
         break;
+    case PROP_HISTORY_SIZE:
+        g_value_set_uint(value, gvaclassify->history_size);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -109,6 +123,7 @@ void gst_gva_classify_class_init(GstGvaClassifyClass *gvaclassify_class) {
 
     GstBaseTransformClass *base_transform_class = GST_BASE_TRANSFORM_CLASS(gvaclassify_class);
     base_transform_class->start = GST_DEBUG_FUNCPTR(gst_gva_classify_start);
+    base_transform_class->sink_event = GST_DEBUG_FUNCPTR(gst_gva_classify_sink_event);
 
     g_object_class_install_property(
         gobject_class, PROP_RECLASSIFY_INTERVAL,
@@ -124,6 +139,15 @@ void gst_gva_classify_class_init(GstGvaClassifyClass *gvaclassify_class) {
             "inference interval)",
             DEFAULT_MIN_RECLASSIFY_INTERVAL, DEFAULT_MAX_RECLASSIFY_INTERVAL, DEFAULT_RECLASSIFY_INTERVAL,
             (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_HISTORY_SIZE,
+        g_param_spec_uint("history-size", "History Size",
+                          "Maximum number of tracked objects whose classification results are reused within "
+                          "reclassify-interval. Objects are removed when gvatrack stops tracking them, the least "
+                          "recently seen object is evicted only if the limit is reached.",
+                          DEFAULT_MIN_HISTORY_SIZE, DEFAULT_MAX_HISTORY_SIZE, DEFAULT_HISTORY_SIZE,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 }
 
 void gst_gva_classify_init(GstGvaClassify *gvaclassify) {
@@ -137,6 +161,7 @@ void gst_gva_classify_init(GstGvaClassify *gvaclassify) {
     gvaclassify->base_inference.type = GST_GVA_CLASSIFY_TYPE;
     gvaclassify->base_inference.inference_region = ROI_LIST;
     gvaclassify->reclassify_interval = DEFAULT_RECLASSIFY_INTERVAL;
+    gvaclassify->history_size = DEFAULT_HISTORY_SIZE;
     gvaclassify->classification_history = create_classification_history(gvaclassify);
     if (gvaclassify->classification_history == NULL)
         return;
@@ -191,11 +216,21 @@ gboolean gst_gva_classify_check_properties_correctness(GstGvaClassify *gvaclassi
 gboolean gst_gva_classify_start(GstBaseTransform *trans) {
     GstGvaClassify *gvaclassify = GST_GVA_CLASSIFY(trans);
 
-    GST_INFO_OBJECT(gvaclassify, "%s parameters:\n -- Reclassify interval: %d\n",
-                    GST_ELEMENT_NAME(GST_ELEMENT_CAST(gvaclassify)), gvaclassify->reclassify_interval);
+    GST_INFO_OBJECT(gvaclassify, "%s parameters:\n -- Reclassify interval: %d\n -- History size: %u\n",
+                    GST_ELEMENT_NAME(GST_ELEMENT_CAST(gvaclassify)), gvaclassify->reclassify_interval,
+                    gvaclassify->history_size);
 
     if (!gst_gva_classify_check_properties_correctness(gvaclassify))
         return FALSE;
 
     return GST_BASE_TRANSFORM_CLASS(gst_gva_classify_parent_class)->start(trans);
 }
+
+gboolean gst_gva_classify_sink_event(GstBaseTransform *trans, GstEvent *event) {
+    GstGvaClassify *gvaclassify = GST_GVA_CLASSIFY(trans);
+
+    if (gvaclassify->classification_history && GST_EVENT_TYPE(event) == GST_EVENT_CUSTOM_DOWNSTREAM)
+        remove_objects_from_history(gvaclassify->classification_history, event);
+
+    return GST_BASE_TRANSFORM_CLASS(gst_gva_classify_parent_class)->sink_event(trans, event);
+}
@@ -22,6 +22,7 @@ typedef struct _GstGvaClassify {
     GvaBaseInference base_inference;
     // properties:
     guint reclassify_interval;
+    guint history_size;
 
     struct ClassificationHistory *classification_history;
 } GstGvaClassify;
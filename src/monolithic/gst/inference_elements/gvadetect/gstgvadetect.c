@@ -22,11 +22,13 @@
 enum {
     PROP_0,
     PROP_THRESHOLD,
+    PROP_ROI_DETECTION_PARAMS,
 };
 
 #define DEFAULT_MIN_THRESHOLD 0.
 #define DEFAULT_MAX_THRESHOLD 1.
 #define DEFAULT_THRESHOLD 0.5
+#define DEFAULT_ROI_DETECTION_PARAMS TRUE
 
 GST_DEBUG_CATEGORY_STATIC(gst_gva_detect_debug_category);
 #define GST_CAT_DEFAULT gst_gva_detect_debug_category
@@ -56,6 +58,9 @@ void gst_gva_detect_set_property(GObject *object, guint property_id, const GValu
     case PROP_THRESHOLD:
         gvadetect->threshold = g_value_get_float(value);
         break;
+    case PROP_ROI_DETECTION_PARAMS:
+        gvadetect->base_inference.roi_detection_params = g_value_get_boolean(value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -71,6 +76,9 @@ void gst_gva_detect_get_property(GObject *object, guint property_id, GValue *val
     case PROP_THRESHOLD:
         g_value_set_float(value, gvadetect->threshold);
         break;
+    case PROP_ROI_DETECTION_PARAMS:
+        g_value_set_boolean(value, gvadetect->base_inference.roi_detection_params);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -103,6 +111,17 @@ void gst_gva_detect_class_init(GstGvaDetectClass *klass) {
                            "with confidence values above the threshold will be added to the frame",
                            DEFAULT_MIN_THRESHOLD, DEFAULT_MAX_THRESHOLD, DEFAULT_THRESHOLD,
                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_ROI_DETECTION_PARAMS,
+        g_param_spec_boolean(
+            "roi-detection-params", "ROI Detection Params",
+            "Add \"detection\" GstStructure to params of every region of interest. Detections are always stored in "
+            "GstGVADetectionMeta. If false, the structure is created from it only when GVA::VideoFrame regions are "
+            "requested, which saves GstStructure allocations for frames with many objects. Keep it true if downstream "
+            "reads region params directly: gvametaaggregate, Python gstgva, applications using "
+            "gst_video_region_of_interest_meta_get_param",
+            DEFAULT_ROI_DETECTION_PARAMS, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 }
 
 void gst_gva_detect_init(GstGvaDetect *gvadetect) {
@@ -111,4 +130,5 @@ void gst_gva_detect_init(GstGvaDetect *gvadetect) {
 
     gvadetect->base_inference.type = GST_GVA_DETECT_TYPE;
     gvadetect->threshold = DEFAULT_THRESHOLD;
+    gvadetect->base_inference.roi_detection_params = DEFAULT_ROI_DETECTION_PARAMS;
 }
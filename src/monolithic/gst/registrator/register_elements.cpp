@@ -21,6 +21,7 @@
 #include "inference_backend/logger.h"
 #include "logger_functions.h"
 
+#include "gva_detection_meta.h"
 #include "gva_json_meta.h"
 #include "gva_tensor_meta.h"
 
@@ -54,6 +55,8 @@ static gboolean plugin_init(GstPlugin *plugin) {
     gst_gva_json_meta_api_get_type();
     gst_gva_tensor_meta_get_info();
     gst_gva_tensor_meta_api_get_type();
+    gst_gva_detection_meta_get_info();
+    gst_gva_detection_meta_api_get_type();
     return TRUE;
 }
 
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <dlstreamer/base/lock_free_queue.h>
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+/**
+ * Batch request being filled, shared by submitters: (request index + 1) << 32 | next free slot, zero if there is
+ * none. Submitters claim batch slots with CAS on it, so batch filling never takes a lock. Requests are identified by
+ * their 'index' field, free ones are kept in MpmcQueue.
+ */
+class BatchFillState {
+  public:
+    struct Claim {
+        uint32_t request = 0;   // request index
+        uint32_t slot = 0;      // claimed slot, number of claimed slots for Detach
+        bool published = false; // request was taken from the free queue and published for other submitters
+    };
+
+    explicit BatchFillState(uint32_t batch_size) : _batch_size(batch_size) {
+    }
+
+    /**
+     * Joins the batch request being filled if there is one, otherwise takes a free request (blocks if all requests are
+     * busy) and publishes it for other submitters. The submitter taking the last slot detaches the request, so it is
+     * never seen by others after it is started. 'prepare' is called for the taken request before it is published.
+     */
+    template <typename RequestPtr, typename Prepare>
+    Claim Acquire(dlstreamer::MpmcQueue<RequestPtr> &free_requests, Prepare prepare) {
+        uint64_t state = _state.load(std::memory_order_acquire);
+        for (;;) {
+            if (state == 0) {
+                RequestPtr request = free_requests.pop();
+                if (_batch_size == 1)
+                    return {request->index, 0, false};
+                prepare(*request);
+                if (_state.compare_exchange_strong(state, MakeState(request->index, 1), std::memory_order_acq_rel))
+                    return {request->index, 0, true};
+                // another submitter has published its request meanwhile, join it instead
+                free_requests.push(std::move(request));
+                continue;
+            }
+
+            const uint32_t next_slot = Slot(state) + 1;
+            const uint64_t new_state = next_slot < _batch_size ? state + 1 : 0;
+            if (_state.compare_exchange_weak(state, new_state, std::memory_order_acq_rel, std::memory_order_acquire))
+                return {RequestIndex(state), Slot(state), false};
+        }
+    }
+
+    /**
+     * Detaches request being filled if 'can_detach(request index)' allows it. Returns false if there is no such
+     * request, otherwise 'claimed' receives the request index and the number of claimed slots.
+     */
+    template <typename CanDetach>
+    bool Detach(Claim &claimed, CanDetach can_detach) {
+        uint64_t state = _state.load(std::memory_order_acquire);
+        for (;;) {
+            if (state == 0 || !can_detach(RequestIndex(state)))
+                return false;
+            if (_state.compare_exchange_weak(state, 0, std::memory_order_acq_rel, std::memory_order_acquire))
+                break;
+        }
+        claimed = {RequestIndex(state), Slot(state), false};
+        return true;
+    }
+
+    // Returns false if no request is being filled, otherwise its index
+    bool Current(uint32_t &request, std::memory_order order = std::memory_order_acquire) const {
+        const uint64_t state = _state.load(order);
+        if (state == 0)
+            return false;
+        request = RequestIndex(state);
+        return true;
+    }
+
+  private:
+    static constexpr uint64_t MakeState(uint32_t request_index, uint32_t next_slot) {
+        return (static_cast<uint64_t>(request_index + 1) << 32) | next_slot;
+    }
+    static constexpr uint32_t RequestIndex(uint64_t state) {
+        return static_cast<uint32_t>(state >> 32) - 1;
+    }
+    static constexpr uint32_t Slot(uint64_t state) {
+        return static_cast<uint32_t>(state);
+    }
+
+    const uint32_t _batch_size;
+    std::atomic<uint64_t> _state{0};
+};
@@ -85,9 +85,11 @@ class OpenvinoInputTensor : public OpenvinoInputBlob {
 class OpenvinoOutputTensor : public InferenceBackend::OutputBlob {
     ov::Tensor _tensor;
     mutable ov::Shape _shape;
+    std::shared_ptr<const void> _owner; // memory of tensor lent to the blob, empty if tensor memory is reused
 
   public:
-    OpenvinoOutputTensor(ov::Tensor tensor) : _tensor(std::move(tensor)) {
+    OpenvinoOutputTensor(ov::Tensor tensor, std::shared_ptr<const void> owner = nullptr)
+        : _tensor(std::move(tensor)), _owner(std::move(owner)) {
     }
 
     const std::vector<size_t> &GetDims() const override {
@@ -137,4 +139,10 @@ class OpenvinoOutputTensor : public InferenceBackend::OutputBlob {
     const void *GetData() const override {
         return _tensor.data();
     }
+
+    std::shared_ptr<const void> GetSharedData() const override {
+        if (!_owner)
+            return nullptr;
+        return std::shared_ptr<const void>(_owner, _tensor.data());
+    }
 };
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <openvino/runtime/properties.hpp>
 
 #include <dlstreamer/openvino/context.h>
+#include <dlstreamer/openvino/model_cache.h>
 #include <dlstreamer/vaapi/context.h>
 // For logger_name
 #include <dlstreamer/element.h>
@@ -31,7 +32,11 @@
 #endif
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <functional>
+#include <limits>
 #include <stdio.h>
 #include <thread>
 
@@ -228,10 +233,39 @@ struct ConfigHelper {
         return base_config.at(KEY_MODEL);
     }
 
+    // Describes changes applied to model after reading, so that identical compiled models are shared between elements
+    std::string model_variant() const {
+        std::string variant;
+        for (const auto &section : config) {
+            if (section.first == KEY_INFERENCE) // passed to compile_model as properties
+                continue;
+            for (const auto &item : section.second) {
+                // don't affect compiled model
+                if (section.first == KEY_BASE &&
+                    (item.first == KEY_NIREQ || item.first == KEY_BATCH_TIMEOUT ||
+                     item.first == KEY_POSTPROC_THREADS || item.first == KEY_OUTPUT_ARENA_SIZE))
+                    continue;
+                variant += section.first + "." + item.first + "=" + item.second + ";";
+            }
+        }
+        // batch timeout value doesn't affect compiled model, but whether batch dimension is made dynamic does
+        variant += std::string("dynamic-batch=") + (dynamic_batch_requested() ? "1" : "0") + ";";
+        return variant;
+    }
+
     int batch_size() const {
         return std::stoi(base_config.at(KEY_BATCH_SIZE));
     }
 
+    std::chrono::microseconds batch_timeout() const {
+        return std::chrono::microseconds(base_get_or(KEY_BATCH_TIMEOUT, 0));
+    }
+
+    // Partial batches are submitted on timeout, model is given dynamic batch dimension if it supports one
+    bool dynamic_batch_requested() const {
+        return batch_timeout().count() && batch_size() > 1;
+    }
+
     const std::string &image_format() const {
         return base_get_or_empty(KEY_IMAGE_FORMAT);
     }
@@ -432,8 +466,8 @@ class OpenVinoNewApiImpl {
         _device = config.device();
         _nireq = config.nireq();
 
-        // read model & configure model
-        _model = core().read_model(config.model_path());
+        // read model & configure model, parsed model is shared with other elements using the same file
+        _model = dlstreamer::OpenVINOModelCache::instance().clone_model(config.model_path());
 
         {
             size_t bs;
@@ -459,7 +493,7 @@ class OpenVinoNewApiImpl {
     auto get_model_inputs_info() const {
         std::map<std::string, std::vector<size_t>> res;
         for (auto node : _model->get_parameters()) {
-            auto shape = node->is_dynamic() ? node->get_input_partial_shape(0).get_min_shape() : node->get_shape();
+            auto shape = node->is_dynamic() ? reported_shape(node->get_output_partial_shape(0)) : node->get_shape();
             res.emplace(node->get_friendly_name(), std::move(shape));
         }
 
@@ -469,7 +503,7 @@ class OpenVinoNewApiImpl {
     auto get_model_outputs_info() const {
         std::map<std::string, std::vector<size_t>> res;
         for (auto &node : _model->outputs()) {
-            auto shape = node.get_node()->is_dynamic() ? node.get_partial_shape().get_min_shape() : node.get_shape();
+            auto shape = node.get_node()->is_dynamic() ? reported_shape(node.get_partial_shape()) : node.get_shape();
             auto name = node.get_names().size() > 0 ? node.get_any_name() : std::string("output");
             res.emplace(name, std::move(shape));
         }
@@ -564,8 +598,8 @@ class OpenVinoNewApiImpl {
         GstStructure *s = nullptr;
         ov::AnyMap modelConfig;
 
-        std::shared_ptr<ov::Model> _model;
-        _model = core().read_model(model_file);
+        // only runtime info is needed, so shared model is used without copying
+        std::shared_ptr<const ov::Model> _model = dlstreamer::OpenVINOModelCache::instance().read_model(model_file);
 
         if (_model->has_rt_info({"model_info"})) {
             modelConfig = _model->get_rt_info<ov::AnyMap>("model_info");
@@ -630,6 +664,9 @@ class OpenVinoNewApiImpl {
             if (ov::layout::has_batch(layout)) {
                 const std::int64_t batch_idx = ov::layout::batch_idx(layout);
                 batch_size = shape[batch_idx];
+                // bounded dynamic batch is reported by its upper bound
+                if (partial_shape[batch_idx].is_dynamic() && partial_shape[batch_idx].get_max_length() > 0)
+                    batch_size = safe_convert<size_t>(partial_shape[batch_idx].get_max_length());
             }
 
             if (ov::layout::has_width(layout)) {
@@ -806,8 +843,7 @@ class OpenVinoNewApiImpl {
 
     // Singleton core object
     static ov::Core &core() {
-        static ov::Core ovcore;
-        return ovcore;
+        return dlstreamer::OpenVINOModelCache::instance().core();
     }
 
   protected:
@@ -817,9 +853,12 @@ class OpenVinoNewApiImpl {
     dlstreamer::ContextPtr _app_context;
     dlstreamer::OpenVINOContextPtr _openvino_context;
     ov::CompiledModel _compiled_model;
+    std::shared_ptr<const void> _compiled_model_reference; // keeps _compiled_model shared with other elements
     MemoryType _memory_type;
     int _nireq = 0;
     int _batch_size = 0;
+    // batch dimension is kept dynamic in range [1, _batch_size], partial batches are inferred without padding
+    bool _dynamic_batch = false;
 
     size_t _origin_model_in_w = 0;
     size_t _origin_model_in_h = 0;
@@ -847,8 +886,15 @@ class OpenVinoNewApiImpl {
         }
 
         _batch_size = config.batch_size();
-        GVA_DEBUG("Setting batch size of %d to model", _batch_size);
-        ov::set_batch(_model, _batch_size);
+        if (config.dynamic_batch_requested() && has_dynamic_batch()) {
+            GVA_DEBUG("Setting dynamic batch size of [1, %d] to model", _batch_size);
+            ov::set_batch(_model, ov::Dimension(1, _batch_size));
+            _dynamic_batch = is_batch_the_only_dynamic_dim();
+        }
+        if (!_dynamic_batch) {
+            GVA_DEBUG("Setting batch size of %d to model", _batch_size);
+            ov::set_batch(_model, _batch_size);
+        }
 
         GVA_DEBUG("Model inputs after configuration:");
         size_t idx = 0;
@@ -863,6 +909,46 @@ class OpenVinoNewApiImpl {
         _image_input_name = item.get_any_name();
     }
 
+    bool has_dynamic_batch() const {
+        try {
+            return ov::get_batch(_model).is_dynamic();
+        } catch (const std::exception &e) {
+            GVA_DEBUG("Couldn't get model batch dimension: %s", e.what());
+            return false;
+        }
+    }
+
+    // Partial batch results are handed to post-processing as a full batch, so batch must be the leading and the
+    // only dynamic dimension of all batched inputs and outputs
+    bool is_batch_the_only_dynamic_dim() const {
+        const auto is_batched = [this](const ov::PartialShape &shape) {
+            if (shape.rank().is_dynamic() || shape.size() == 0 || shape[0].get_max_length() != _batch_size)
+                return false;
+            for (size_t i = 1; i < shape.size(); i++) {
+                if (shape[i].is_dynamic())
+                    return false;
+            }
+            return true;
+        };
+        for (const auto &input : _model->inputs()) {
+            if (input.get_partial_shape().is_dynamic() && !is_batched(input.get_partial_shape()))
+                return false;
+        }
+        for (const auto &output : _model->outputs()) {
+            if (!is_batched(output.get_partial_shape()))
+                return false;
+        }
+        return true;
+    }
+
+    // Shape reported to pre- and post-processing for dynamic shape
+    ov::Shape reported_shape(const ov::PartialShape &shape) const {
+        ov::Shape result = shape.get_min_shape();
+        if (_dynamic_batch && !result.empty())
+            result[0] = safe_convert<size_t>(_batch_size);
+        return result;
+    }
+
     void configure_model_inputs(const ConfigHelper &config, ov::preprocess::PrePostProcessor &preproc) {
         const auto &inputs = _model->inputs();
 
@@ -1085,12 +1171,19 @@ class OpenVinoNewApiImpl {
         }
 
         // print_input_and_outputs_info(*_model);
-        if (_openvino_context) {
-            _compiled_model = core().compile_model(_model, _openvino_context->remote_context(), ov_params);
-        } else {
-            _compiled_model = core().compile_model(_model, _device, ov_params);
-        }
-        GVA_INFO("Network loaded to device");
+        auto &cache = dlstreamer::OpenVINOModelCache::instance();
+        dlstreamer::OpenVINOModelCache::CompileResult result =
+            _openvino_context ? cache.compile_model(_model, config.model_path(), config.model_variant(),
+                                                    _openvino_context->remote_context(), ov_params)
+                              : cache.compile_model(_model, config.model_path(), config.model_variant(), _device,
+                                                    ov_params);
+        _compiled_model = result.compiled_model;
+        _compiled_model_reference = result.reference;
+        if (!result.blob_error.empty())
+            GVA_WARNING("Model cache directory is not used: %s", result.blob_error.c_str());
+        GVA_INFO("Network loaded to device in %lld ms (%s, %s start)", static_cast<long long>(result.duration.count()),
+                 dlstreamer::OpenVINOModelCache::source_name(result.source),
+                 result.source == dlstreamer::OpenVINOModelCache::Source::Compiled ? "cold" : "warm");
 
         auto supported_properties = _compiled_model.get_property(ov::supported_properties);
         for (const auto &cfg : supported_properties) {
@@ -1157,14 +1250,21 @@ void OpenVINOImageInference::SetCompletionCallback(std::shared_ptr<BatchRequest>
 
     auto cb = [=](std::exception_ptr ex) {
         ITT_TASK("completion_callback_lambda_new");
+        const auto completed = std::chrono::steady_clock::now();
+        infer_time_.Add(completed - batch_request->started);
 
         try {
+            if (!ex && (post_proc_pool_ || share_outputs_) && PostProcessDetached(batch_request, completed)) {
+                // request is returned to free queue right away, before its results are processed
+                return;
+            }
             if (ex) {
                 std::string ex_string = fmt::format("exception occured during inference: {}", ex);
                 GVA_ERROR("%s", ex_string.c_str());
                 this->handleError(batch_request->buffers);
             } else {
                 this->WorkingFunction(batch_request);
+                post_proc_time_.Add(std::chrono::steady_clock::now() - completed);
             }
         } catch (const std::exception &e) {
             GVA_ERROR("An error occurred at inference request completion callback [new]:\n%s",
@@ -1180,7 +1280,8 @@ OpenVINOImageInference::OpenVINOImageInference(const InferenceBackend::Inference
                                                dlstreamer::ContextPtr context, CallbackFunc callback,
                                                ErrorHandlingFunc error_handler, MemoryType memory_type)
     : context_(context), memory_type(memory_type), callback(callback), handleError(error_handler),
-      batch_size(std::stoi(config.at(KEY_BASE).at(KEY_BATCH_SIZE))), requests_processing_(0U) {
+      batch_size(std::stoi(config.at(KEY_BASE).at(KEY_BATCH_SIZE))),
+      filling_state_(safe_convert<uint32_t>(batch_size)), requests_processing_(0U) {
 
     try {
         ConfigHelper cfg_helper(config);
@@ -1190,15 +1291,27 @@ OpenVINOImageInference::OpenVINOImageInference(const InferenceBackend::Inference
         nireq = _impl->_nireq;
         image_layer = _impl->_image_input_name;
 
-        for (int i = 0; i < nireq; i++) {
-            std::shared_ptr<BatchRequest> batch_request = std::make_shared<BatchRequest>();
-            batch_request->infer_request_new = _impl->_compiled_model.create_infer_request();
-            batch_request->in_tensors.resize(_impl->_model->inputs().size());
-            SetCompletionCallback(batch_request);
-            freeRequests.push(batch_request);
-        }
-
         const auto pp_type = cfg_helper.pp_type();
+        batch_timeout = cfg_helper.batch_timeout();
+        if (const size_t post_proc_threads = cfg_helper.base_get_or(KEY_POSTPROC_THREADS, 0))
+            post_proc_pool_ = PostProcPool::Acquire(post_proc_threads);
+
+        const size_t output_arena_size = cfg_helper.base_get_or(KEY_OUTPUT_ARENA_SIZE, 0);
+        if (output_arena_size || post_proc_pool_) {
+            const auto &outputs = _impl->_compiled_model.outputs();
+            const bool static_outputs =
+                _impl->_dynamic_batch || std::all_of(outputs.begin(), outputs.end(), [](const auto &output) {
+                    return output.get_partial_shape().is_static();
+                });
+            if (static_outputs) {
+                // without output sharing the arena only recycles tensors detached for post-processing threads
+                output_arena_ = std::make_unique<OutputTensorArena>(
+                    output_arena_size ? output_arena_size * 1024 * 1024 : std::numeric_limits<size_t>::max());
+                share_outputs_ = output_arena_size != 0;
+            } else if (output_arena_size) {
+                GVA_WARNING("output-arena-size is ignored: outputs of model %s have dynamic shape", model_name.c_str());
+            }
+        }
 
         // FIXME: why VAAPI ?
         if (pp_type == InferenceBackend::ImagePreprocessorType::OPENCV ||
@@ -1206,8 +1319,54 @@ OpenVINOImageInference::OpenVINOImageInference(const InferenceBackend::Inference
             std::string pp_type_string = fmt::format("creating pre-processor, type: {}", pp_type);
             GVA_INFO("%s", pp_type_string.c_str());
             pre_processor.reset(InferenceBackend::ImagePreprocessor::Create(pp_type));
+            pre_processor_type = pp_type;
+        }
+
+        freeRequests = std::make_unique<dlstreamer::MpmcQueue<std::shared_ptr<BatchRequest>>>(nireq);
+        for (int i = 0; i < nireq; i++) {
+            std::shared_ptr<BatchRequest> batch_request = std::make_shared<BatchRequest>();
+            batch_request->infer_request_new = _impl->_compiled_model.create_infer_request();
+            batch_request->index = safe_convert<uint32_t>(i);
+            batch_request->buffers.resize(batch_size);
+            batch_request->in_tensors.resize(_impl->_model->inputs().size());
+            if (batch_size > 1 && !DoNeedImagePreProcessing()) {
+                for (auto &in_vec : batch_request->in_tensors)
+                    in_vec.resize(batch_size);
+            }
+            // FIXME: single input
+            if (DoNeedImagePreProcessing()) {
+                if (_impl->_dynamic_batch) {
+                    // dynamic input has no tensor until its shape is set, allocate one for the whole batch
+                    const auto &input = _impl->_compiled_model.input(image_layer);
+                    batch_request->image_tensor =
+                        ov::Tensor(input.get_element_type(), _impl->reported_shape(input.get_partial_shape()));
+                } else {
+                    batch_request->image_tensor = batch_request->infer_request_new.get_tensor(image_layer);
+                }
+            }
+            if (output_arena_) {
+                if (!AllocateOutputTensors(batch_request))
+                    throw std::runtime_error("output-arena-size is too small to hold outputs of " +
+                                             std::to_string(nireq) + " inference requests");
+            } else if (_impl->_dynamic_batch) {
+                // outputs are allocated for the whole batch, so partial batch results are laid out as a full batch
+                const auto &outputs = _impl->_compiled_model.outputs();
+                for (size_t i = 0; i < outputs.size(); i++) {
+                    batch_request->out_tensors.emplace_back(outputs[i].get_element_type(),
+                                                            _impl->reported_shape(outputs[i].get_partial_shape()));
+                    batch_request->infer_request_new.set_output_tensor(i, batch_request->out_tensors.back());
+                }
+            }
+            SetCompletionCallback(batch_request);
+            requests.push_back(batch_request);
+            freeRequests->push(batch_request);
         }
 
+        if (batch_timeout.count() && batch_size > 1) {
+            GVA_INFO("Partially filled batch is submitted after %lld us%s",
+                     static_cast<long long>(batch_timeout.count()), _impl->_dynamic_batch ? " without padding" : "");
+            batch_timer_ = std::thread(&OpenVINOImageInference::BatchTimerFunction, this);
+        }
     } catch (const std::exception &e) {
         std::throw_with_nested(std::runtime_error("Failed to construct OpenVINOImageInference"));
     }
@@ -1219,16 +1378,173 @@ OpenVINOImageInference::~OpenVINOImageInference() {
 }
 
 void OpenVINOImageInference::FreeRequest(std::shared_ptr<BatchRequest> request) {
+    FramesProcessed(ReleaseRequest(request));
+}
+
+/**
+ * Returns request to the free queue. Its frames are still accounted as being processed until FramesProcessed.
+ */
+size_t OpenVINOImageInference::ReleaseRequest(const std::shared_ptr<BatchRequest> &request) {
     const size_t buffer_size = request->buffers.size();
-    request->buffers.clear();
+    request->buffers.assign(batch_size, nullptr);
     for (auto &in_vec : request->in_tensors) {
-        in_vec.clear();
+        std::fill(in_vec.begin(), in_vec.end(), ov::Tensor());
     }
-    freeRequests.push(request);
-    requests_processing_ -= buffer_size;
+    request->filled.store(0, std::memory_order_relaxed);
+    freeRequests->push(request);
+    return buffer_size;
+}
+
+void OpenVINOImageInference::FramesProcessed(size_t frames) {
+    // Flush may destroy this instance as soon as counter drops to zero, so nothing is touched after unlocking
+    std::lock_guard<std::mutex> lock(flush_mutex);
+    requests_processing_ -= frames;
     request_processed_.notify_all();
 }
 
+void OpenVINOImageInference::StageTimer::Add(std::chrono::steady_clock::duration duration) {
+    const uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    count.fetch_add(1, std::memory_order_relaxed);
+    total_us.fetch_add(us, std::memory_order_relaxed);
+    uint64_t max = max_us.load(std::memory_order_relaxed);
+    while (us > max && !max_us.compare_exchange_weak(max, us, std::memory_order_relaxed))
+        ;
+}
+
+std::string OpenVINOImageInference::StageTimer::ToString() const {
+    const uint64_t n = count.load(std::memory_order_relaxed);
+    const double avg_ms = n ? total_us.load(std::memory_order_relaxed) / 1000.0 / n : 0.0;
+    return fmt::format("avg {:.2f} ms, max {:.2f} ms", avg_ms, max_us.load(std::memory_order_relaxed) / 1000.0);
+}
+
+namespace {
+int64_t steady_clock_ticks(std::chrono::steady_clock::time_point time_point) {
+    return time_point.time_since_epoch().count();
+}
+
+// Tensor over the memory of 'tensor' with the leading (batch) dimension replaced
+ov::Tensor batch_view(const ov::Tensor &tensor, size_t batch) {
+    ov::Shape shape = tensor.get_shape();
+    shape[0] = batch;
+    return ov::Tensor(tensor.get_element_type(), shape, tensor.data());
+}
+} // namespace
+
+/**
+ * Claims a batch slot without locking, see BatchFillState::Acquire.
+ */
+std::shared_ptr<OpenVINOImageInference::BatchRequest> OpenVINOImageInference::AcquireBatchSlot(size_t &slot) {
+    ITT_TASK(__FUNCTION__);
+    const BatchFillState::Claim claim = filling_state_.Acquire(*freeRequests, [this](BatchRequest &request) {
+        // deadline is published to the batch timer together with the request
+        request.deadline.store(steady_clock_ticks(std::chrono::steady_clock::now() + batch_timeout),
+                               std::memory_order_relaxed);
+    });
+    if (claim.published && batch_timeout.count()) {
+        std::lock_guard<std::mutex> lock(batch_timer_mutex_);
+        batch_timer_cond_.notify_one();
+    }
+    slot = claim.slot;
+    return requests[claim.request];
+}
+
+void OpenVINOImageInference::StartRequest(const std::shared_ptr<BatchRequest> &request) {
+    const size_t filled = request->buffers.size();
+    ITT_TASK(fmt::format("{} {}/{}", __FUNCTION__, filled, batch_size));
+    if (batch_size > 1 && !DoNeedImagePreProcessing()) {
+        for (size_t i = 0; i < request->in_tensors.size(); i++) {
+            ov::TensorVector &in_vec = request->in_tensors[i];
+            // WA: Fill non-complete batch with last element. Can be removed once supported in OV
+            if (!_impl->_dynamic_batch) {
+                for (size_t j = filled; j < in_vec.size(); j++)
+                    in_vec[j] = in_vec[filled - 1];
+            }
+            // FIXME: move?
+            if (_impl->_dynamic_batch && filled < in_vec.size())
+                request->infer_request_new.set_input_tensors(
+                    i, ov::TensorVector(in_vec.begin(), in_vec.begin() + safe_convert<std::ptrdiff_t>(filled)));
+            else
+                request->infer_request_new.set_input_tensors(i, in_vec);
+        }
+    } else if (DoNeedImagePreProcessing() && _impl->_dynamic_batch) {
+        request->infer_request_new.set_tensor(image_layer, batch_view(request->image_tensor, filled));
+    }
+    batches_started_.fetch_add(1, std::memory_order_relaxed);
+    frames_started_.fetch_add(filled, std::memory_order_relaxed);
+    request->started = std::chrono::steady_clock::now();
+    request->start_async();
+}
+
+/**
+ * Removes slots committed empty after failed pre-processing. Inputs of the following slots are moved down, so batch
+ * index of every remaining frame still matches its input and results. Returns false if no frames are left, in this
+ * case the request is returned to the free queue.
+ */
+bool OpenVINOImageInference::DropFailedSlots(const std::shared_ptr<BatchRequest> &request) {
+    std::vector<IFrameBase::Ptr> &buffers = request->buffers;
+    const size_t image_slot_size =
+        request->image_tensor ? request->image_tensor.get_byte_size() / request->image_tensor.get_shape()[0] : 0;
+    size_t kept = 0;
+    for (size_t i = 0; i < buffers.size(); i++) {
+        if (!buffers[i])
+            continue;
+        if (kept != i) {
+            if (DoNeedImagePreProcessing()) {
+                uint8_t *data = static_cast<uint8_t *>(request->image_tensor.data());
+                std::memcpy(data + kept * image_slot_size, data + i * image_slot_size, image_slot_size);
+            }
+            for (auto &in_vec : request->in_tensors)
+                in_vec[kept] = std::move(in_vec[i]);
+            buffers[kept] = std::move(buffers[i]);
+        }
+        kept++;
+    }
+
+    const size_t failed = buffers.size() - kept;
+    if (!failed)
+        return true;
+    buffers.resize(kept);
+    if (!kept) {
+        ReleaseRequest(request);
+        FramesProcessed(failed);
+        return false;
+    }
+    FramesProcessed(failed);
+    return true;
+}
+
+/**
+ * Detaches partially filled batch request and starts inference on it once all claimed slots are written.
+ * With expired_only set the request is detached only if its batch timeout has expired.
+ */
+void OpenVINOImageInference::DispatchPartialBatch(bool expired_only) {
+    BatchFillState::Claim detached;
+    const bool found = filling_state_.Detach(detached, [&](uint32_t index) {
+        return !expired_only || requests[index]->deadline.load(std::memory_order_relaxed) <=
+                                    steady_clock_ticks(std::chrono::steady_clock::now());
+    });
+    if (!found)
+        return;
+
+    const std::shared_ptr<BatchRequest> &request = requests[detached.request];
+    const size_t claimed = detached.slot;
+    while (request->filled.load(std::memory_order_acquire) < claimed)
+        std::this_thread::yield();
+
+    (expired_only ? partial_batches_on_timeout_ : partial_batches_on_flush_).fetch_add(1, std::memory_order_relaxed);
+    GVA_DEBUG("Starting partially filled batch on %s: %zu of %d frames, fill ratio %.2f",
+              expired_only ? "timeout" : "flush", claimed, batch_size, static_cast<double>(claimed) / batch_size);
+    request->buffers.resize(claimed);
+    try {
+        if (DropFailedSlots(request))
+            StartRequest(request);
+    } catch (const std::exception &e) {
+        GVA_ERROR("Couldn't start inferece on flush: %s", e.what());
+        this->handleError(request->buffers);
+        FreeRequest(request);
+    }
+}
+
 #if 0
 InferenceEngine::RemoteContext::Ptr
 OpenVINOImageInference::CreateRemoteContext(const InferenceBackend::InferenceConfig &config) {
@@ -1327,7 +1643,8 @@ OpenVINOImageInference::CreateRemoteContext(const InferenceBackend::InferenceCon
 #endif
 
 bool OpenVINOImageInference::IsQueueFull() {
-    return freeRequests.empty();
+    uint32_t filling;
+    return freeRequests->empty() && !filling_state_.Current(filling, std::memory_order_relaxed);
 }
 
 Image fill_image(ov::Tensor &tensor, size_t bindex) {
@@ -1376,29 +1693,35 @@ Image map_ov_tensor_to_img(ov::Tensor &tensor, size_t batch_index) {
     return image;
 }
 
-void OpenVINOImageInference::SubmitImageProcessing(const std::string &input_name, std::shared_ptr<BatchRequest> request,
+void OpenVINOImageInference::SubmitImageProcessing(std::shared_ptr<BatchRequest> request, size_t batch_index,
                                                    const Image &src_img, const InputImageLayerDesc::Ptr &pre_proc_info,
-                                                   const ImageTransformationParams::Ptr image_transform_info) {
+                                                   const ImageTransformationParams::Ptr image_transform_info,
+                                                   const PreProcCache::Ptr &cache) {
     ITT_TASK(__FUNCTION__);
     assert(request);
 
-    // FIXME: single input
-    if (request->in_tensors.front().empty()) {
-        request->in_tensors.front().push_back(request->infer_request_new.get_tensor(input_name));
-    }
-    const size_t batch_index = request->buffers.size();
-    Image dst_img = map_ov_tensor_to_img(request->in_tensors.front().front(), batch_index);
+    Image dst_img = map_ov_tensor_to_img(request->image_tensor, batch_index);
     if (src_img.planes[0] != dst_img.planes[0]) { // only convert if different buffers
+        // custom pre-processing depends on model-proc and fills image_transform_info, so its result is not shared
+        const bool use_cache =
+            cache && !(pre_proc_info && pre_proc_info->isDefined()) && PreProcCache::IsCacheable(dst_img);
+        const PreProcCache::Key cache_key =
+            use_cache ? PreProcCache::MakeKey(src_img, dst_img, static_cast<int>(pre_processor_type), pre_proc_info)
+                      : PreProcCache::Key();
+        if (use_cache && cache->Lookup(cache_key, dst_img))
+            return;
         try {
             pre_processor->Convert(src_img, dst_img, pre_proc_info, image_transform_info);
         } catch (const std::exception &e) {
             std::throw_with_nested(std::runtime_error("Failed while software frame preprocessing"));
         }
+        if (use_cache)
+            cache->Store(cache_key, dst_img);
     }
 }
 
 void OpenVINOImageInference::BypassImageProcessing(const std::string &input_name, std::shared_ptr<BatchRequest> request,
-                                                   const Image &src_img, size_t batch_size) {
+                                                   size_t batch_index, const Image &src_img, size_t batch_size) {
     ITT_TASK(__FUNCTION__);
 
     auto ov_tensor = _impl->image_to_tensors(src_img);
@@ -1406,19 +1729,12 @@ void OpenVINOImageInference::BypassImageProcessing(const std::string &input_name
     if (batch_size > 1) {
         if (ov_tensor.size() != request->in_tensors.size())
             throw std::runtime_error("BypassImageProcessing - unexpected number of tensors!");
+        // input tensors are set to infer request in StartRequest once the batch is complete
         size_t input_idx = 0;
         for (auto &t : ov_tensor) {
-            request->in_tensors[input_idx].emplace_back(std::move(t));
+            request->in_tensors[input_idx][batch_index] = std::move(t);
             input_idx++;
         }
-
-        if (request->in_tensors.front().size() == batch_size) {
-            // FIXME: input name ?
-            for (size_t i = 0; i < request->in_tensors.size(); i++) {
-                // FIXME: move?
-                request->infer_request_new.set_input_tensors(i, request->in_tensors[i]);
-            }
-        }
     } else {
         if (ov_tensor.size() == 1) {
             request->infer_request_new.set_tensor(input_name, ov_tensor.front());
@@ -1469,40 +1785,48 @@ void OpenVINOImageInference::SubmitImage(
     if (!frame)
         throw std::invalid_argument("Invalid frame provided");
 
-    std::unique_lock<std::mutex> lk(requests_mutex_);
     ++requests_processing_;
-    std::shared_ptr<BatchRequest> request = freeRequests.pop();
+    size_t slot = 0;
+    std::shared_ptr<BatchRequest> request = AcquireBatchSlot(slot);
+
+    // Claimed slot must be committed even if pre-processing fails, otherwise the batch never completes. Failed slot
+    // is committed empty and dropped before the batch is started, the frame is handled by the caller only.
+    bool batch_complete = false;
+    auto commit_slot = [&](IFrameBase::Ptr slot_frame) {
+        request->buffers[slot] = std::move(slot_frame);
+        batch_complete =
+            request->filled.fetch_add(1, std::memory_order_acq_rel) + 1 == safe_convert<size_t>(batch_size);
+    };
 
     try {
         if (DoNeedImagePreProcessing()) {
             SubmitImageProcessing(
-                image_layer, request, *frame->GetImage(),
+                request, slot, *frame->GetImage(),
                 getImagePreProcInfo(input_preprocessors), // contain operations order for Custom Image PreProcessing
-                frame->GetImageTransformationParams()     // during CIPP will be filling of crop and aspect-ratio
+                frame->GetImageTransformationParams(),    // during CIPP will be filling of crop and aspect-ratio
                                                           // parameters
-            );
+                frame->GetPreProcCache());
             // After running this function self-managed image memory appears, and the old image memory can be
             // released
             frame->SetImage(nullptr);
         } else {
-            BypassImageProcessing(image_layer, request, *frame->GetImage(), safe_convert<size_t>(batch_size));
+            BypassImageProcessing(image_layer, request, slot, *frame->GetImage(), safe_convert<size_t>(batch_size));
         }
 
         ApplyInputPreprocessors(request, input_preprocessors);
-
-        request->buffers.push_back(frame);
+        commit_slot(frame);
     } catch (const std::exception &e) {
         GVA_ERROR("Pre-processing has failed: %s", e.what());
+        commit_slot(nullptr);
+        if (batch_complete && DropFailedSlots(request))
+            StartRequest(request);
         std::throw_with_nested(std::runtime_error("Pre-processing was failed."));
     }
 
     try {
-        // start inference asynchronously if enough buffers for batching
-        if (request->buffers.size() >= safe_convert<size_t>(batch_size)) {
-            request->start_async();
-        } else {
-            freeRequests.push_front(request);
-        }
+        // start inference asynchronously when all slots of the batch are filled
+        if (batch_complete && DropFailedSlots(request))
+            StartRequest(request);
     } catch (const std::exception &e) {
         std::throw_with_nested(std::runtime_error("Inference async start was failed."));
     }
@@ -1546,36 +1870,14 @@ void OpenVINOImageInference::Flush() {
 
     // because Flush can execute by several threads for one InferenceImpl instance
     // it must be synchronous.
-    std::unique_lock<std::mutex> requests_lk(requests_mutex_);
-
     std::unique_lock<std::mutex> flush_lk(flush_mutex);
 
     while (requests_processing_ != 0) {
-        auto request = freeRequests.pop();
-
-        if (request->buffers.size() > 0) {
-            try {
-                // WA: Fill non-complete batch with last element. Can be removed once supported in OV
-                if (batch_size > 1 && !DoNeedImagePreProcessing()) {
-                    size_t input_idx = 0;
-                    for (auto &input_vec : request->in_tensors) {
-                        for (int i = input_vec.size(); i < batch_size; i++)
-                            input_vec.push_back(input_vec.back());
-                        // FIXME: move?
-                        request->infer_request_new.set_input_tensors(input_idx, input_vec);
-                        input_idx++;
-                    }
-                }
-
-                request->start_async();
-            } catch (const std::exception &e) {
-                GVA_ERROR("Couldn't start inferece on flush: %s", e.what());
-                this->handleError(request->buffers);
-                FreeRequest(request);
-            }
-        } else {
-            freeRequests.push(request);
-        }
+        // Dispatch out of flush_mutex: dropped slots and failed start account their frames in FramesProcessed, which
+        // locks it
+        flush_lk.unlock();
+        DispatchPartialBatch();
+        flush_lk.lock();
 
         // wait_for unlocks flush_mutex until we get notify
         // waiting will be continued if requests_processing_ != 0
@@ -1583,22 +1885,183 @@ void OpenVINOImageInference::Flush() {
     }
 }
 
+/**
+ * Starts partially filled batch request when its batch timeout expires.
+ */
+void OpenVINOImageInference::BatchTimerFunction() {
+    std::unique_lock<std::mutex> lock(batch_timer_mutex_);
+    while (!batch_timer_stop_) {
+        uint32_t filling;
+        if (!filling_state_.Current(filling)) {
+            // woken up by AcquireBatchSlot when next batch request is published
+            batch_timer_cond_.wait(lock);
+            continue;
+        }
+
+        const std::chrono::steady_clock::time_point deadline(std::chrono::steady_clock::duration(
+            requests[filling]->deadline.load(std::memory_order_relaxed)));
+        if (std::chrono::steady_clock::now() < deadline) {
+            batch_timer_cond_.wait_until(lock, deadline);
+            continue;
+        }
+
+        lock.unlock();
+        DispatchPartialBatch(/*expired_only=*/true);
+        lock.lock();
+    }
+}
+
 void OpenVINOImageInference::Close() {
+    if (batch_timer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(batch_timer_mutex_);
+            batch_timer_stop_ = true;
+        }
+        batch_timer_cond_.notify_all();
+        batch_timer_.join();
+    }
     Flush();
-    while (!freeRequests.empty()) {
-        auto req = freeRequests.pop();
+    for (auto &req : requests) {
         req->infer_request_new.set_callback([](std::exception_ptr) {});
     }
+    if (infer_time_.count.load(std::memory_order_relaxed)) {
+        GVA_INFO("Inference requests of %s: %llu completed, infer: %s, post-processing queue: %s, post-processing: %s",
+                 model_name.c_str(), static_cast<unsigned long long>(infer_time_.count.load()),
+                 infer_time_.ToString().c_str(), queue_time_.ToString().c_str(), post_proc_time_.ToString().c_str());
+    }
+    const uint64_t batches = batches_started_.load(std::memory_order_relaxed);
+    if (batch_size > 1 && batches) {
+        GVA_INFO("Batches of %s: %llu started, average fill ratio %.2f, partial on timeout: %llu, on flush: %llu",
+                 model_name.c_str(), static_cast<unsigned long long>(batches),
+                 static_cast<double>(frames_started_.load(std::memory_order_relaxed)) / (batches * batch_size),
+                 static_cast<unsigned long long>(partial_batches_on_timeout_.load(std::memory_order_relaxed)),
+                 static_cast<unsigned long long>(partial_batches_on_flush_.load(std::memory_order_relaxed)));
+    }
+    if (share_outputs_)
+        GVA_INFO("Output arena of %s: %s", model_name.c_str(), output_arena_->GetStats().ToString().c_str());
 }
 
 void OpenVINOImageInference::WorkingFunction(const std::shared_ptr<BatchRequest> &request) {
     assert(request);
+    callback(GetOutputBlobs(request), request->buffers);
+}
 
+std::map<std::string, OutputBlob::Ptr>
+OpenVINOImageInference::GetOutputBlobs(const std::shared_ptr<BatchRequest> &request, bool shared) {
     std::map<std::string, OutputBlob::Ptr> output_blobs;
     const auto &outputs = _impl->_compiled_model.outputs();
     for (size_t i = 0; i < outputs.size(); i++) {
         auto name = outputs[i].get_names().size() > 0 ? outputs[i].get_any_name() : std::string("output");
-        output_blobs[name] = std::make_shared<OpenvinoOutputTensor>(request->infer_request_new.get_output_tensor(i));
+        ov::Tensor tensor = _impl->_dynamic_batch
+                                ? batch_view(request->out_tensors[i], safe_convert<size_t>(batch_size))
+                                : request->infer_request_new.get_output_tensor(i);
+        std::shared_ptr<const void> owner = shared ? request->out_blocks.at(i) : nullptr;
+        output_blobs[name] = std::make_shared<OpenvinoOutputTensor>(std::move(tensor), std::move(owner));
+    }
+    return output_blobs;
+}
+
+/**
+ * Sets request outputs to new tensors in arena memory. Returns false and leaves request intact if arena is exhausted.
+ */
+bool OpenVINOImageInference::AllocateOutputTensors(const std::shared_ptr<BatchRequest> &request) {
+    const auto &outputs = _impl->_compiled_model.outputs();
+    ov::TensorVector tensors(outputs.size());
+    std::vector<std::shared_ptr<void>> blocks(outputs.size());
+    for (size_t i = 0; i < outputs.size(); i++) {
+        const ov::element::Type type = outputs[i].get_element_type();
+        // outputs are allocated for the whole batch, so partial batch results are laid out as a full batch
+        const ov::Shape shape = _impl->_dynamic_batch ? _impl->reported_shape(outputs[i].get_partial_shape())
+                                                      : outputs[i].get_shape();
+        blocks[i] = output_arena_->Allocate((ov::shape_size(shape) * type.bitwidth() + 7) / 8);
+        if (!blocks[i])
+            return false;
+        tensors[i] = ov::Tensor(type, shape, blocks[i].get());
     }
-    callback(output_blobs, request->buffers);
+
+    for (size_t i = 0; i < outputs.size(); i++)
+        request->infer_request_new.set_output_tensor(i, tensors[i]);
+    if (_impl->_dynamic_batch)
+        request->out_tensors = std::move(tensors);
+    request->out_blocks = std::move(blocks);
+    return true;
+}
+
+/**
+ * Replaces output tensors of completed request, so it can be started again while results are post-processed.
+ * Returns false if output arena is exhausted, then request keeps its tensors.
+ */
+bool OpenVINOImageInference::DetachOutputTensors(const std::shared_ptr<BatchRequest> &request,
+                                                 DetachedOutputs &detached) {
+    const size_t outputs_number = _impl->_compiled_model.outputs().size();
+    ov::TensorVector tensors(outputs_number);
+    for (size_t i = 0; i < outputs_number; i++)
+        tensors[i] = _impl->_dynamic_batch ? request->out_tensors[i] : request->infer_request_new.get_output_tensor(i);
+
+    std::vector<std::shared_ptr<void>> blocks = request->out_blocks;
+    if (output_arena_) {
+        if (!AllocateOutputTensors(request))
+            return false;
+    } else {
+        // outputs of dynamic shape can't be allocated in advance
+        for (size_t i = 0; i < outputs_number; i++)
+            request->infer_request_new.set_output_tensor(
+                i, ov::Tensor(tensors[i].get_element_type(), tensors[i].get_shape()));
+    }
+
+    detached.tensors = std::move(tensors);
+    detached.blocks = std::move(blocks);
+    return true;
+}
+
+/**
+ * Returns completed request to the free queue and post-processes its detached results on post-processing thread if
+ * there is one, otherwise on the calling thread. Returns false if results couldn't be detached or nireq jobs of this
+ * instance are already pending on post-processing threads.
+ */
+bool OpenVINOImageInference::PostProcessDetached(const std::shared_ptr<BatchRequest> &request,
+                                                 std::chrono::steady_clock::time_point completed) {
+    ITT_TASK(__FUNCTION__);
+    if (post_proc_pool_ && post_proc_pending_.fetch_add(1) >= nireq) {
+        post_proc_pending_--;
+        return false;
+    }
+    auto output_blobs = GetOutputBlobs(request, share_outputs_);
+    DetachedOutputs detached;
+    if (!DetachOutputTensors(request, detached)) {
+        if (post_proc_pool_)
+            post_proc_pending_--;
+        if (!arena_exhausted_reported_.exchange(true))
+            GVA_WARNING("Output arena of %s is exhausted, inference results are copied: %s", model_name.c_str(),
+                        output_arena_->GetStats().ToString().c_str());
+        return false;
+    }
+    std::vector<IFrameBase::Ptr> frames = request->buffers;
+    const size_t frames_number = ReleaseRequest(request);
+
+    auto post_process = [this, completed, frames_number, output_blobs = std::move(output_blobs),
+                         detached = std::move(detached), frames = std::move(frames)]() mutable {
+        const auto started = std::chrono::steady_clock::now();
+        if (post_proc_pool_)
+            queue_time_.Add(started - completed);
+        try {
+            callback(output_blobs, frames);
+        } catch (const std::exception &e) {
+            GVA_ERROR("An error occurred at post-processing of inference results:\n%s",
+                      Utils::createNestedErrorMsg(e).c_str());
+        }
+        // memory not referenced by metadata returns to the arena
+        output_blobs.clear();
+        frames.clear();
+        detached = DetachedOutputs();
+        post_proc_time_.Add(std::chrono::steady_clock::now() - started);
+        if (post_proc_pool_)
+            post_proc_pending_--;
+        FramesProcessed(frames_number);
+    };
+    if (post_proc_pool_)
+        post_proc_pool_->Submit(std::move(post_process));
+    else
+        post_process();
+    return true;
 }
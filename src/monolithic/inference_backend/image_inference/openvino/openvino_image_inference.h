@@ -13,13 +13,20 @@
 #include <openvino/openvino.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <gst/gst.h>
 #include <map>
+#include <mutex>
 #include <string>
 #include <thread>
 
+#include "batch_fill_state.h"
 #include "config.h"
-#include "safe_queue.h"
+#include "output_tensor_arena.h"
+#include "post_proc_pool.h"
+
+#include <dlstreamer/base/lock_free_queue.h>
 
 class OpenVINOImageInference : public InferenceBackend::ImageInference {
   public:
@@ -55,8 +62,16 @@ class OpenVINOImageInference : public InferenceBackend::ImageInference {
 
     struct BatchRequest {
         ov::InferRequest infer_request_new;
-        std::vector<IFrameBase::Ptr> buffers;
+        std::vector<IFrameBase::Ptr> buffers; // one slot per batch index
         std::vector<ov::TensorVector> in_tensors;
+        ov::Tensor image_tensor;      // image input tensor, written by software pre-processing
+        ov::TensorVector out_tensors; // whole batch output tensors, allocated for dynamic batch only
+        uint32_t index = 0;           // position in 'requests'
+        std::atomic<size_t> filled{0};
+        std::atomic<int64_t> deadline{0}; // steady clock ticks, partially filled batch is started after it
+        std::chrono::steady_clock::time_point started;
+
+        std::vector<std::shared_ptr<void>> out_blocks; // arena memory of output tensors, empty without arena
 
         void start_async() {
             return this->infer_request_new.start_async();
@@ -64,7 +79,24 @@ class OpenVINOImageInference : public InferenceBackend::ImageInference {
     };
 
     void HandleError(const std::shared_ptr<BatchRequest> &request);
+    std::shared_ptr<BatchRequest> AcquireBatchSlot(size_t &slot);
+    void StartRequest(const std::shared_ptr<BatchRequest> &request);
+    bool DropFailedSlots(const std::shared_ptr<BatchRequest> &request);
+    void DispatchPartialBatch(bool expired_only = false);
+    void BatchTimerFunction();
     void WorkingFunction(const std::shared_ptr<BatchRequest> &request);
+    std::map<std::string, InferenceBackend::OutputBlob::Ptr>
+    GetOutputBlobs(const std::shared_ptr<BatchRequest> &request, bool shared = false);
+
+    // Output tensors taken from completed request along with the memory they reference
+    struct DetachedOutputs {
+        ov::TensorVector tensors;
+        std::vector<std::shared_ptr<void>> blocks;
+    };
+    bool AllocateOutputTensors(const std::shared_ptr<BatchRequest> &request);
+    bool DetachOutputTensors(const std::shared_ptr<BatchRequest> &request, DetachedOutputs &detached);
+    bool PostProcessDetached(const std::shared_ptr<BatchRequest> &request,
+                             std::chrono::steady_clock::time_point completed);
 
     dlstreamer::ContextPtr context_;
     InferenceBackend::MemoryType memory_type;
@@ -76,25 +108,68 @@ class OpenVINOImageInference : public InferenceBackend::ImageInference {
 
     const int batch_size;
     int nireq;
-    SafeQueue<std::shared_ptr<BatchRequest>> freeRequests;
+    std::vector<std::shared_ptr<BatchRequest>> requests;
+    std::unique_ptr<dlstreamer::MpmcQueue<std::shared_ptr<BatchRequest>>> freeRequests;
+    BatchFillState filling_state_;
+
+    // Partially filled batch request is started after batch_timeout, zero means no timeout
+    std::chrono::microseconds batch_timeout{0};
+    std::thread batch_timer_;
+    std::mutex batch_timer_mutex_;
+    std::condition_variable batch_timer_cond_;
+    bool batch_timer_stop_ = false;
 
     std::unique_ptr<InferenceBackend::ImagePreprocessor> pre_processor;
+    InferenceBackend::ImagePreprocessorType pre_processor_type = InferenceBackend::ImagePreprocessorType::AUTO;
+
+    // Completion callbacks run on this pool if post-processing threads are configured, otherwise on OpenVINO™ threads
+    PostProcPool::Ptr post_proc_pool_;
+    // Jobs of this instance queued or running on the pool, at most nireq. Beyond that results are post-processed on
+    // the callback thread, which keeps the request, so slow post-processing throttles submission as without the pool.
+    std::atomic<int> post_proc_pending_{0};
+
+    // Memory of output tensors, lent to requests and then to their results. If outputs are shared, metadata references
+    // the memory instead of copying it, otherwise the memory returns to the arena after post-processing.
+    std::unique_ptr<OutputTensorArena> output_arena_;
+    bool share_outputs_ = false;
+    std::atomic<bool> arena_exhausted_reported_{false};
+
+    // Time spent by requests in inference, waiting for post-processing thread and in post-processing
+    struct StageTimer {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> total_us{0};
+        std::atomic<uint64_t> max_us{0};
+
+        void Add(std::chrono::steady_clock::duration duration);
+        std::string ToString() const;
+    };
+    StageTimer infer_time_;
+    StageTimer queue_time_;
+    StageTimer post_proc_time_;
+
+    // Batch fill statistics, reported on close
+    std::atomic<uint64_t> batches_started_{0};
+    std::atomic<uint64_t> frames_started_{0};
+    std::atomic<uint64_t> partial_batches_on_timeout_{0};
+    std::atomic<uint64_t> partial_batches_on_flush_{0};
 
     // Threading
-    std::mutex requests_mutex_;
     std::atomic<unsigned int> requests_processing_;
     std::condition_variable request_processed_;
     std::mutex flush_mutex;
 
   private:
     void FreeRequest(std::shared_ptr<BatchRequest> request);
+    size_t ReleaseRequest(const std::shared_ptr<BatchRequest> &request);
+    void FramesProcessed(size_t frames);
     bool DoNeedImagePreProcessing() const;
-    void SubmitImageProcessing(const std::string &input_name, std::shared_ptr<BatchRequest> request,
+    void SubmitImageProcessing(std::shared_ptr<BatchRequest> request, size_t batch_index,
                                const InferenceBackend::Image &src_img,
                                const InferenceBackend::InputImageLayerDesc::Ptr &pre_proc_info,
-                               const InferenceBackend::ImageTransformationParams::Ptr image_transform_info);
+                               const InferenceBackend::ImageTransformationParams::Ptr image_transform_info,
+                               const InferenceBackend::PreProcCache::Ptr &cache);
     void BypassImageProcessing(const std::string &input_name, std::shared_ptr<BatchRequest> request,
-                               const InferenceBackend::Image &src_img, size_t batch_size);
+                               size_t batch_index, const InferenceBackend::Image &src_img, size_t batch_size);
     void SetCompletionCallback(std::shared_ptr<BatchRequest> &batch_request);
     void
     ApplyInputPreprocessors(std::shared_ptr<BatchRequest> &request,
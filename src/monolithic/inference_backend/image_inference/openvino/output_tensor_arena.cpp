@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "output_tensor_arena.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace {
+constexpr size_t BLOCK_ALIGNMENT = 64;
+constexpr size_t MB = 1024 * 1024;
+} // namespace
+
+struct OutputTensorArena::State {
+    std::mutex mutex;
+    Stats stats;
+    bool closed = false;
+    std::map<size_t, std::vector<void *>> free_blocks; // by block size
+
+    // Frees pooled blocks until 'size' more bytes fit into capacity
+    bool MakeRoom(size_t size) {
+        for (auto it = free_blocks.begin(); stats.in_use + stats.pooled + size > stats.capacity;) {
+            if (it == free_blocks.end())
+                return false;
+            if (it->second.empty()) {
+                it = free_blocks.erase(it);
+                continue;
+            }
+            std::free(it->second.back());
+            it->second.pop_back();
+            stats.pooled -= it->first;
+        }
+        return true;
+    }
+
+    void Release(void *block, size_t size) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.in_use -= size;
+        if (closed) {
+            std::free(block);
+            return;
+        }
+        free_blocks[size].push_back(block);
+        stats.pooled += size;
+    }
+};
+
+std::string OutputTensorArena::Stats::ToString() const {
+    return fmt::format("capacity {:.1f} MB, in use {:.1f} MB, pooled {:.1f} MB, peak {:.1f} MB, allocated {}, "
+                       "reused {}, exhausted {}",
+                       double(capacity) / MB, double(in_use) / MB, double(pooled) / MB, double(peak) / MB, allocated,
+                       reused, exhausted);
+}
+
+OutputTensorArena::OutputTensorArena(size_t capacity) : _state(std::make_shared<State>()) {
+    _state->stats.capacity = capacity;
+}
+
+OutputTensorArena::~OutputTensorArena() {
+    // blocks still referenced by metadata are freed when released
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->closed = true;
+    for (auto &blocks : _state->free_blocks) {
+        for (void *block : blocks.second)
+            std::free(block);
+    }
+    _state->free_blocks.clear();
+    _state->stats.pooled = 0;
+}
+
+std::shared_ptr<void> OutputTensorArena::Allocate(size_t size) {
+    size = std::max((size + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT, BLOCK_ALIGNMENT);
+
+    void *block = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        Stats &stats = _state->stats;
+        auto it = _state->free_blocks.find(size);
+        if (it != _state->free_blocks.end() && !it->second.empty()) {
+            block = it->second.back();
+            it->second.pop_back();
+            stats.pooled -= size;
+            stats.reused++;
+        } else {
+            if (!_state->MakeRoom(size)) {
+                stats.exhausted++;
+                return nullptr;
+            }
+            block = std::aligned_alloc(BLOCK_ALIGNMENT, size);
+            if (!block)
+                throw std::bad_alloc();
+            stats.allocated++;
+        }
+        stats.in_use += size;
+        stats.peak = std::max(stats.peak, stats.in_use);
+    }
+
+    std::shared_ptr<State> state = _state;
+    return std::shared_ptr<void>(block, [state, size](void *ptr) { state->Release(ptr, size); });
+}
+
+OutputTensorArena::Stats OutputTensorArena::GetStats() const {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    return _state->stats;
+}
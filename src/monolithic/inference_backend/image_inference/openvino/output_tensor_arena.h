@@ -0,0 +1,47 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * Bounded pool of memory blocks used as output tensors of inference requests. A block is lent to a request, then to
+ * the results of the request and to metadata referencing them, and returns to the pool when the last reference is
+ * released, possibly after the arena itself is destroyed.
+ */
+class OutputTensorArena {
+  public:
+    struct Stats {
+        size_t capacity = 0;  // bytes
+        size_t in_use = 0;    // bytes referenced by requests, results or metadata
+        size_t pooled = 0;    // bytes of free blocks kept for reuse
+        size_t peak = 0;      // maximum of in_use
+        uint64_t allocated = 0;
+        uint64_t reused = 0;
+        uint64_t exhausted = 0; // allocations refused because of capacity
+
+        std::string ToString() const;
+    };
+
+    explicit OutputTensorArena(size_t capacity);
+    ~OutputTensorArena();
+
+    OutputTensorArena(const OutputTensorArena &) = delete;
+    OutputTensorArena &operator=(const OutputTensorArena &) = delete;
+
+    // Returns block of at least 'size' bytes aligned to 64 bytes, nullptr if capacity would be exceeded
+    std::shared_ptr<void> Allocate(size_t size);
+
+    Stats GetStats() const;
+
+  private:
+    struct State;
+    std::shared_ptr<State> _state;
+};
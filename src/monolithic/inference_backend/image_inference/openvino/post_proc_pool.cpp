@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "post_proc_pool.h"
+
+#include "inference_backend/logger.h"
+#include "utils.h"
+
+PostProcPool::Ptr PostProcPool::Acquire(size_t threads) {
+    static std::mutex pool_mutex;
+    static std::weak_ptr<PostProcPool> shared_pool;
+
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    Ptr pool = shared_pool.lock();
+    if (!pool) {
+        pool = Ptr(new PostProcPool());
+        shared_pool = pool;
+    }
+    pool->Grow(threads);
+    return pool;
+}
+
+PostProcPool::~PostProcPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _task_added.notify_all();
+    for (auto &thread : _threads)
+        thread.join();
+}
+
+void PostProcPool::Grow(size_t threads) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (threads > _threads.size())
+        GVA_INFO("Post-processing threads: %zu", threads);
+    while (_threads.size() < threads)
+        _threads.emplace_back(&PostProcPool::WorkerFunction, this);
+}
+
+void PostProcPool::Submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(std::move(task));
+    }
+    _task_added.notify_one();
+}
+
+size_t PostProcPool::Size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _threads.size();
+}
+
+void PostProcPool::WorkerFunction() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        // remaining tasks are still executed on stop, they release frames and requests of their instances
+        _task_added.wait(lock, [this] { return _stop || !_tasks.empty(); });
+        if (_tasks.empty())
+            return;
+
+        std::function<void()> job = std::move(_tasks.front());
+        _tasks.pop_front();
+        lock.unlock();
+        try {
+            ITT_TASK("post-processing");
+            job();
+        } catch (const std::exception &e) {
+            GVA_ERROR("Error during post-processing: %s", Utils::createNestedErrorMsg(e).c_str());
+        }
+        // captured frames are released before taking the lock
+        job = nullptr;
+        lock.lock();
+    }
+}
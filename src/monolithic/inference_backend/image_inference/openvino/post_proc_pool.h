@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Threads running post-processing of completed inference requests (blob to meta conversion, NMS, pushing frames
+ * downstream) instead of OpenVINO™ callback threads. One pool is shared by all inference instances of the process and
+ * tasks of all streams go to a single queue, so any idle worker takes over post-processing of a stream whose requests
+ * complete faster than its post-processing keeps up.
+ */
+class PostProcPool {
+  public:
+    using Ptr = std::shared_ptr<PostProcPool>;
+
+    // Returns pool shared by all inference instances, grown to at least 'threads' workers.
+    // Pool is stopped when the last instance releases it.
+    static Ptr Acquire(size_t threads);
+
+    ~PostProcPool();
+
+    PostProcPool(const PostProcPool &) = delete;
+    PostProcPool &operator=(const PostProcPool &) = delete;
+
+    void Submit(std::function<void()> task);
+
+    size_t Size() const;
+
+  private:
+    PostProcPool() = default;
+    void Grow(size_t threads);
+    void WorkerFunction();
+
+    std::vector<std::thread> _threads;
+    std::deque<std::function<void()>> _tasks;
+    mutable std::mutex _mutex;
+    std::condition_variable _task_added;
+    bool _stop = false;
+};
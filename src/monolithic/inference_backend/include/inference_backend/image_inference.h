@@ -15,6 +15,7 @@
 
 #include "image.h"
 #include "input_image_layer_descriptor.h"
+#include "pre_proc_cache.h"
 
 namespace InferenceBackend {
 
@@ -43,6 +44,10 @@ class ImageInference {
         virtual ImageTransformationParams::Ptr GetImageTransformationParams() {
             return image_trans_params;
         }
+        // Pre-processed images of the frame shared with other inference elements, nullptr if caching is disabled
+        virtual PreProcCache::Ptr GetPreProcCache() const {
+            return nullptr;
+        }
 
         virtual ~IFrameBase() = default;
     };
@@ -123,6 +128,11 @@ class OutputBlob : public virtual Blob {
   public:
     using Ptr = std::shared_ptr<OutputBlob>;
     virtual const void *GetData() const = 0;
+    // Returns owner of the data if it is not reused after the blob is released, so metadata may reference the data
+    // instead of copying it. nullptr if the data must be copied.
+    virtual std::shared_ptr<const void> GetSharedData() const {
+        return nullptr;
+    }
     virtual ~OutputBlob() = default;
 };
 
@@ -170,6 +180,9 @@ __DECLARE_CONFIG_KEY(IMAGE_FORMAT);
 __DECLARE_CONFIG_KEY(MODEL_FORMAT);
 __DECLARE_CONFIG_KEY(RESHAPE);
 __DECLARE_CONFIG_KEY(BATCH_SIZE);
+__DECLARE_CONFIG_KEY(BATCH_TIMEOUT); // microseconds a partially filled batch may wait, 0 - no timeout
+__DECLARE_CONFIG_KEY(POSTPROC_THREADS); // threads running post-processing, 0 - OpenVINO™ callback threads
+__DECLARE_CONFIG_KEY(OUTPUT_ARENA_SIZE); // MB of output tensors shared with metadata, 0 - results are copied
 __DECLARE_CONFIG_KEY(RESHAPE_WIDTH);
 __DECLARE_CONFIG_KEY(RESHAPE_HEIGHT);
 __DECLARE_CONFIG_KEY(image);
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include "image.h"
+#include "input_image_layer_descriptor.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace InferenceBackend {
+
+/**
+ * @brief Pre-processed images of one frame, i.e. regions of the frame converted and resized to model input. Cache is
+ * shared by inference elements processing the same frame, so a region converted for one model is copied instead of
+ * being converted once again for another model with the same input size.
+ * Only planar RGBP and RGBP_F32 images without custom (model-proc) pre-processing are cached. Images are keyed by
+ * every input of pre-processing, so elements with different pre-processors or configurations never share an image.
+ * Size and format of the frame are part of the key, so a cache carried to a converted or scaled copy of the frame
+ * never returns images of the original one.
+ */
+class PreProcCache {
+  public:
+    using Ptr = std::shared_ptr<PreProcCache>;
+
+    struct Key {
+        uint32_t src_width = 0; // size and format of the frame
+        uint32_t src_height = 0;
+        int src_format = 0;
+        Rectangle<uint32_t> rect; // region of the frame
+        uint32_t width = 0;       // size and format of pre-processed image
+        uint32_t height = 0;
+        int format = 0;
+        int pre_processor = 0; // ImagePreprocessorType
+        size_t config = 0;     // hash of InputImageLayerDesc: resize, crop, color space, normalization and padding
+
+        bool operator==(const Key &other) const;
+    };
+
+    // Memory budget limits total size of cached images in bytes
+    explicit PreProcCache(size_t budget);
+
+    static bool IsCacheable(const Image &dst);
+    static Key MakeKey(const Image &src, const Image &dst, int pre_processor,
+                       const InputImageLayerDesc::Ptr &pre_proc_info);
+
+    // Budget of cache shared by several elements is the largest budget among them
+    void ExtendBudget(size_t budget);
+
+    // Copies cached image to planes of dst. Returns false if image is not cached.
+    bool Lookup(const Key &key, Image &dst) const;
+
+    // Stores copy of image if it fits into budget. Returns false if image is not stored.
+    bool Store(const Key &key, const Image &image);
+
+    size_t MemoryUsage() const;
+
+  private:
+    struct Entry {
+        Key key;
+        std::vector<uint8_t> data; // planes stored one after another
+    };
+
+    mutable std::mutex _mutex;
+    std::vector<std::shared_ptr<const Entry>> _entries;
+    size_t _budget;
+    size_t _memory_usage = 0;
+};
+
+} // namespace InferenceBackend
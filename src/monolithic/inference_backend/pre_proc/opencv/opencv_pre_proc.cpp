@@ -10,6 +10,7 @@
 #include "opencv_utils.h"
 #include "safe_arithmetic.hpp"
 #include "utils.h"
+#include "yuv_resize.h"
 
 #include <opencv2/opencv.hpp>
 
@@ -216,6 +217,12 @@ void OpenCV_VPP::Convert(const Image &raw_src, Image &dst, const InputImageLayer
             // pre-proc
         }
 
+        // NV12/I420 crop is converted, resized and planarized directly into destination without intermediate images
+        if (make_planar && !needCustomImageConvert(pre_proc_info) && CanResizeYUVToPlanarBGR(src, dst)) {
+            ResizeYUVToPlanarBGR(src, dst);
+            return;
+        }
+
         cv::Mat src_mat_image;
         cv::Mat dst_mat_image;
 
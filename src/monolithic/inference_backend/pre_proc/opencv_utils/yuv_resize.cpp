@@ -0,0 +1,297 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "yuv_resize.h"
+#include "inference_backend/logger.h"
+#include "safe_arithmetic.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YUV_RESIZE_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace InferenceBackend {
+
+namespace Utils {
+
+namespace {
+
+// ITU-R BT.601 coefficients of YUV to RGB conversion in the same fixed-point format as OpenCV uses
+constexpr int YUV_SHIFT = 20;
+constexpr int YUV_ROUND = 1 << (YUV_SHIFT - 1);
+constexpr int YUV_CY = 1220542;
+constexpr int YUV_CUB = 2116026;
+constexpr int YUV_CUG = -409993;
+constexpr int YUV_CVG = -852492;
+constexpr int YUV_CVR = 1673527;
+
+// Bilinear interpolation coefficients in the same fixed-point format as cv::resize uses for 8-bit images
+constexpr int RESIZE_COEF_BITS = 11;
+constexpr int RESIZE_COEF_SCALE = 1 << RESIZE_COEF_BITS;
+constexpr int RESIZE_SHIFT = 2 * RESIZE_COEF_BITS;
+constexpr int RESIZE_ROUND = 1 << (RESIZE_SHIFT - 1);
+
+// Converted row is read by 4-byte loads starting at the last pixel
+constexpr size_t ROW_PADDING = 4;
+
+inline uint8_t saturateToByte(int value) {
+    return static_cast<uint8_t>(std::min(std::max(value, 0), 255));
+}
+
+inline int16_t resizeCoefficient(float value) {
+    return static_cast<int16_t>(std::lrint(value * RESIZE_COEF_SCALE));
+}
+
+// Chroma of pixel x is u[(x / 2) * uv_step] and v[(x / 2) * uv_step]
+void convertRowScalar(const uint8_t *y, const uint8_t *u, const uint8_t *v, int uv_step, int begin, int end,
+                      uint8_t *b, uint8_t *g, uint8_t *r) {
+    for (int x = begin; x < end; x++) {
+        const int c = (x / 2) * uv_step;
+        const int uu = u[c] - 128;
+        const int vv = v[c] - 128;
+        const int yy = std::max(0, y[x] - 16) * YUV_CY;
+        b[x] = saturateToByte((yy + YUV_ROUND + YUV_CUB * uu) >> YUV_SHIFT);
+        g[x] = saturateToByte((yy + YUV_ROUND + YUV_CVG * vv + YUV_CUG * uu) >> YUV_SHIFT);
+        r[x] = saturateToByte((yy + YUV_ROUND + YUV_CVR * vv) >> YUV_SHIFT);
+    }
+}
+
+void horizontalScalar(const uint8_t *src, const int32_t *xofs, const int16_t *alpha, int begin, int end,
+                      int32_t *dst) {
+    for (int x = begin; x < end; x++)
+        dst[x] = src[xofs[x]] * alpha[2 * x] + src[xofs[x] + 1] * alpha[2 * x + 1];
+}
+
+void verticalScalar(const int32_t *row0, const int32_t *row1, int32_t beta0, int32_t beta1, int begin, int end,
+                    uint8_t *dst) {
+    for (int x = begin; x < end; x++)
+        dst[x] = saturateToByte((row0[x] * beta0 + row1[x] * beta1 + RESIZE_ROUND) >> RESIZE_SHIFT);
+}
+
+void convertRowDefault(const uint8_t *y, const uint8_t *u, const uint8_t *v, int uv_step, int width, uint8_t *b,
+                       uint8_t *g, uint8_t *r) {
+    convertRowScalar(y, u, v, uv_step, 0, width, b, g, r);
+}
+
+void horizontalDefault(const uint8_t *src, const int32_t *xofs, const int16_t *alpha, int width, int32_t *dst) {
+    horizontalScalar(src, xofs, alpha, 0, width, dst);
+}
+
+void verticalDefault(const int32_t *row0, const int32_t *row1, int32_t beta0, int32_t beta1, int width,
+                     uint8_t *dst) {
+    verticalScalar(row0, row1, beta0, beta1, 0, width, dst);
+}
+
+#ifdef YUV_RESIZE_X86_KERNELS
+
+// Saturates 8 int32 values to bytes and stores them
+__attribute__((target("avx2"))) inline void storeBytesAvx2(__m256i value, uint8_t *dst) {
+    const __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_packus_epi16(words, words));
+}
+
+__attribute__((target("avx2"))) void convertRowAvx2(const uint8_t *y, const uint8_t *u, const uint8_t *v, int uv_step,
+                                                    int width, uint8_t *b, uint8_t *g, uint8_t *r) {
+    const __m256i c16 = _mm256_set1_epi32(16);
+    const __m256i cy = _mm256_set1_epi32(YUV_CY);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m128i c128 = _mm_set1_epi32(128);
+    const __m128i round = _mm_set1_epi32(YUV_ROUND);
+    // every chroma sample covers two neighbour pixels
+    const __m256i duplicate = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        __m256i yy = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + x)));
+        yy = _mm256_mullo_epi32(_mm256_max_epi32(_mm256_sub_epi32(yy, c16), zero), cy);
+
+        const int c = (x / 2) * uv_step;
+        const __m128i uu = _mm_sub_epi32(_mm_setr_epi32(u[c], u[c + uv_step], u[c + 2 * uv_step], u[c + 3 * uv_step]),
+                                         c128);
+        const __m128i vv = _mm_sub_epi32(_mm_setr_epi32(v[c], v[c + uv_step], v[c + 2 * uv_step], v[c + 3 * uv_step]),
+                                         c128);
+        const __m128i buv = _mm_add_epi32(round, _mm_mullo_epi32(uu, _mm_set1_epi32(YUV_CUB)));
+        const __m128i guv = _mm_add_epi32(_mm_add_epi32(round, _mm_mullo_epi32(vv, _mm_set1_epi32(YUV_CVG))),
+                                          _mm_mullo_epi32(uu, _mm_set1_epi32(YUV_CUG)));
+        const __m128i ruv = _mm_add_epi32(round, _mm_mullo_epi32(vv, _mm_set1_epi32(YUV_CVR)));
+
+        const __m256i bb = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(buv), duplicate);
+        const __m256i gg = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(guv), duplicate);
+        const __m256i rr = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(ruv), duplicate);
+
+        storeBytesAvx2(_mm256_srai_epi32(_mm256_add_epi32(yy, bb), YUV_SHIFT), b + x);
+        storeBytesAvx2(_mm256_srai_epi32(_mm256_add_epi32(yy, gg), YUV_SHIFT), g + x);
+        storeBytesAvx2(_mm256_srai_epi32(_mm256_add_epi32(yy, rr), YUV_SHIFT), r + x);
+    }
+    convertRowScalar(y, u, v, uv_step, x, width, b, g, r);
+}
+
+// Pixels src[xofs] and src[xofs + 1] are gathered by one 4-byte load, packed into 16-bit pair and multiplied by pair
+// of coefficients at once
+__attribute__((target("avx2"))) void horizontalAvx2(const uint8_t *src, const int32_t *xofs, const int16_t *alpha,
+                                                    int width, int32_t *dst) {
+    const __m256i low_byte = _mm256_set1_epi32(0xFF);
+    const __m256i second_byte = _mm256_set1_epi32(0xFF00);
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m256i offsets = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(xofs + x));
+        const __m256i pixels = _mm256_i32gather_epi32(reinterpret_cast<const int *>(src), offsets, 1);
+        const __m256i pairs = _mm256_or_si256(_mm256_and_si256(pixels, low_byte),
+                                              _mm256_slli_epi32(_mm256_and_si256(pixels, second_byte), 8));
+        const __m256i coefficients = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(alpha + 2 * x));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x), _mm256_madd_epi16(pairs, coefficients));
+    }
+    horizontalScalar(src, xofs, alpha, x, width, dst);
+}
+
+__attribute__((target("avx2"))) void verticalAvx2(const int32_t *row0, const int32_t *row1, int32_t beta0,
+                                                  int32_t beta1, int width, uint8_t *dst) {
+    const __m256i b0 = _mm256_set1_epi32(beta0);
+    const __m256i b1 = _mm256_set1_epi32(beta1);
+    const __m256i round = _mm256_set1_epi32(RESIZE_ROUND);
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m256i s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0 + x));
+        const __m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1 + x));
+        const __m256i sum = _mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(s0, b0), _mm256_mullo_epi32(s1, b1)),
+                                             round);
+        storeBytesAvx2(_mm256_srai_epi32(sum, RESIZE_SHIFT), dst + x);
+    }
+    verticalScalar(row0, row1, beta0, beta1, x, width, dst);
+}
+
+#endif // YUV_RESIZE_X86_KERNELS
+
+struct Kernels {
+    decltype(&convertRowDefault) convert_row = convertRowDefault;
+    decltype(&horizontalDefault) horizontal = horizontalDefault;
+    decltype(&verticalDefault) vertical = verticalDefault;
+
+    Kernels() {
+#ifdef YUV_RESIZE_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            convert_row = convertRowAvx2;
+            horizontal = horizontalAvx2;
+            vertical = verticalAvx2;
+        }
+#endif
+    }
+};
+
+const Kernels &kernels() {
+    static const Kernels instance;
+    return instance;
+}
+
+// Source position and coefficients of every destination coordinate, computed as cv::resize(INTER_LINEAR) does.
+// Columns outside of source image get the border column with zero second coefficient, while rows are left as is and
+// clamped when read.
+void computeOffsets(int src_size, int dst_size, bool zero_borders, std::vector<int32_t> &offsets,
+                    std::vector<int16_t> &coefficients) {
+    const double scale = 1. / (static_cast<double>(dst_size) / src_size);
+    offsets.resize(dst_size);
+    coefficients.resize(2 * static_cast<size_t>(dst_size));
+    for (int d = 0; d < dst_size; d++) {
+        float f = static_cast<float>((d + 0.5) * scale - 0.5);
+        int s = static_cast<int>(std::floor(f));
+        f -= s;
+        if (zero_borders && s < 0) {
+            f = 0.f;
+            s = 0;
+        }
+        if (zero_borders && s >= src_size - 1) {
+            f = 0.f;
+            s = src_size - 1;
+        }
+        offsets[d] = s;
+        coefficients[2 * d] = resizeCoefficient(1.f - f);
+        coefficients[2 * d + 1] = resizeCoefficient(f);
+    }
+}
+
+} // namespace
+
+bool CanResizeYUVToPlanarBGR(const Image &src, const Image &dst) {
+    return (src.format == FOURCC_NV12 || src.format == FOURCC_I420) && dst.format == FOURCC_RGBP && src.width >= 2 &&
+           src.height >= 2 && dst.width && dst.height;
+}
+
+void ResizeYUVToPlanarBGR(const Image &src, Image &dst) {
+    ITT_TASK(__FUNCTION__);
+    if (!CanResizeYUVToPlanarBGR(src, dst))
+        throw std::invalid_argument("Unsupported image formats for fused YUV to planar BGR resize");
+
+    // as in CreateMat, odd row or column of source image is dropped
+    const int src_width = safe_convert<int>(src.width & ~1u);
+    const int src_height = safe_convert<int>(src.height & ~1u);
+    const int dst_width = safe_convert<int>(dst.width);
+    const int dst_height = safe_convert<int>(dst.height);
+
+    std::vector<int32_t> xofs, yofs;
+    std::vector<int16_t> alpha, beta;
+    computeOffsets(src_width, dst_width, true, xofs, alpha);
+    computeOffsets(src_height, dst_height, false, yofs, beta);
+
+    const bool is_nv12 = src.format == FOURCC_NV12;
+    const int uv_step = is_nv12 ? 2 : 1;
+    const Kernels &k = kernels();
+
+    // Source rows converted to B, G, R and resampled horizontally. Two rows are kept, so upscaling converts every
+    // source row once and downscaling converts only two rows per destination row.
+    const size_t row_size = static_cast<size_t>(src_width) + ROW_PADDING;
+    std::vector<uint8_t> converted(3 * row_size, 0);
+    std::vector<int32_t> resampled(6 * static_cast<size_t>(dst_width));
+    int32_t *rows[2] = {resampled.data(), resampled.data() + 3 * static_cast<size_t>(dst_width)};
+    int row_index[2] = {-1, -1};
+
+    auto prepare_row = [&](int sy, int32_t *row) {
+        const uint8_t *y = src.planes[0] + static_cast<size_t>(sy) * src.stride[0];
+        const uint8_t *u = src.planes[1] + static_cast<size_t>(sy / 2) * src.stride[1];
+        const uint8_t *v = is_nv12 ? u + 1 : src.planes[2] + static_cast<size_t>(sy / 2) * src.stride[2];
+        uint8_t *b = converted.data();
+        k.convert_row(y, u, v, uv_step, src_width, b, b + row_size, b + 2 * row_size);
+        for (int c = 0; c < 3; c++)
+            k.horizontal(b + c * row_size, xofs.data(), alpha.data(), dst_width, row + c * dst_width);
+    };
+
+    for (int dy = 0; dy < dst_height; dy++) {
+        const int sy0 = std::min(std::max(yofs[dy], 0), src_height - 1);
+        const int sy1 = std::min(std::max(yofs[dy] + 1, 0), src_height - 1);
+        if (row_index[0] != sy0) {
+            if (row_index[1] == sy0) {
+                std::swap(rows[0], rows[1]);
+                std::swap(row_index[0], row_index[1]);
+            } else {
+                prepare_row(sy0, rows[0]);
+                row_index[0] = sy0;
+            }
+        }
+        if (row_index[1] != sy1) {
+            prepare_row(sy1, rows[1]);
+            row_index[1] = sy1;
+        }
+
+        // planes of destination tensor are dense, as in MatToMultiPlaneImage
+        const size_t dst_offset = static_cast<size_t>(dy) * dst_width;
+        for (int c = 0; c < 3; c++)
+            k.vertical(rows[0] + c * dst_width, rows[1] + c * dst_width, beta[2 * dy], beta[2 * dy + 1], dst_width,
+                       dst.planes[c] + dst_offset);
+    }
+}
+
+} // namespace Utils
+
+} // namespace InferenceBackend
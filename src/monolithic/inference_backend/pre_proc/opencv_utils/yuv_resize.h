@@ -0,0 +1,29 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include "inference_backend/image.h"
+
+namespace InferenceBackend {
+
+namespace Utils {
+
+// Checks if ResizeYUVToPlanarBGR supports conversion of src to dst: NV12 or I420 image to RGBP
+bool CanResizeYUVToPlanarBGR(const Image &src, const Image &dst);
+
+/**
+ * @brief Converts NV12 or I420 image to BGR and resizes it to dst size with bilinear interpolation in one pass, writing
+ * B, G and R channels into dst planes. Only source rows used for interpolation are converted and no intermediate image
+ * of source size is created, so cost depends on dst size rather than on size of source (crop) rectangle.
+ * Result follows fixed-point arithmetic of cv::cvtColor(COLOR_YUV2BGR_NV12/I420) and cv::resize(INTER_LINEAR) and
+ * differs from their sequence at most by 1 in pixels where optimized OpenCV implementation rounds differently.
+ */
+void ResizeYUVToPlanarBGR(const Image &src, Image &dst);
+
+} // namespace Utils
+
+} // namespace InferenceBackend
@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "inference_backend/pre_proc_cache.h"
+
+#include "safe_arithmetic.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace InferenceBackend {
+
+namespace {
+
+constexpr size_t PLANES_NUMBER = 3;
+
+// Planes of model input tensor are dense, see fill_image in OpenVINO backend
+size_t PlaneSize(const Image &image) {
+    const size_t element_size = image.format == FOURCC_RGBP_F32 ? sizeof(float) : sizeof(uint8_t);
+    return safe_mul(safe_mul(static_cast<size_t>(image.width), static_cast<size_t>(image.height)), element_size);
+}
+
+void HashCombine(size_t &seed, size_t value) {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+void HashCombine(size_t &seed, double value) {
+    HashCombine(seed, std::hash<double>()(value));
+}
+
+void HashCombine(size_t &seed, const std::vector<double> &values) {
+    HashCombine(seed, values.size());
+    for (double value : values)
+        HashCombine(seed, value);
+}
+
+size_t HashConfig(const InputImageLayerDesc::Ptr &desc) {
+    if (!desc)
+        return 0;
+    size_t seed = 0;
+    HashCombine(seed, static_cast<size_t>(desc->getResizeType()));
+    HashCombine(seed, static_cast<size_t>(desc->getCropType()));
+    HashCombine(seed, static_cast<size_t>(desc->getTargetColorSpace()));
+
+    const auto &range_norm = desc->getRangeNormalization();
+    HashCombine(seed, static_cast<size_t>(range_norm.isDefined()));
+    if (range_norm.isDefined()) {
+        HashCombine(seed, range_norm.min);
+        HashCombine(seed, range_norm.max);
+    }
+    const auto &distrib_norm = desc->getDistribNormalization();
+    HashCombine(seed, static_cast<size_t>(distrib_norm.isDefined()));
+    if (distrib_norm.isDefined()) {
+        HashCombine(seed, distrib_norm.mean);
+        HashCombine(seed, distrib_norm.std);
+    }
+    const auto &padding = desc->getPadding();
+    HashCombine(seed, static_cast<size_t>(padding.isDefined()));
+    if (padding.isDefined()) {
+        HashCombine(seed, padding.stride_x);
+        HashCombine(seed, padding.stride_y);
+        HashCombine(seed, padding.fill_value);
+    }
+    // zero is reserved for no configuration
+    return seed ? seed : 1;
+}
+
+} // namespace
+
+bool PreProcCache::Key::operator==(const Key &other) const {
+    return src_width == other.src_width && src_height == other.src_height && src_format == other.src_format &&
+           rect.x == other.rect.x && rect.y == other.rect.y && rect.width == other.rect.width &&
+           rect.height == other.rect.height && width == other.width && height == other.height &&
+           format == other.format && pre_processor == other.pre_processor && config == other.config;
+}
+
+PreProcCache::PreProcCache(size_t budget) : _budget(budget) {
+}
+
+bool PreProcCache::IsCacheable(const Image &dst) {
+    return dst.format == FOURCC_RGBP || dst.format == FOURCC_RGBP_F32;
+}
+
+PreProcCache::Key PreProcCache::MakeKey(const Image &src, const Image &dst, int pre_processor,
+                                        const InputImageLayerDesc::Ptr &pre_proc_info) {
+    Key key;
+    key.src_width = src.width;
+    key.src_height = src.height;
+    key.src_format = src.format;
+    // region is either set explicitly or covers the whole frame
+    key.rect = (src.rect.width && src.rect.height) ? src.rect : Rectangle<uint32_t>(0, 0, src.width, src.height);
+    key.width = dst.width;
+    key.height = dst.height;
+    key.format = dst.format;
+    key.pre_processor = pre_processor;
+    key.config = HashConfig(pre_proc_info);
+    return key;
+}
+
+void PreProcCache::ExtendBudget(size_t budget) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _budget = std::max(_budget, budget);
+}
+
+bool PreProcCache::Lookup(const Key &key, Image &dst) const {
+    std::shared_ptr<const Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = std::find_if(_entries.begin(), _entries.end(),
+                               [&key](const std::shared_ptr<const Entry> &e) { return e->key == key; });
+        if (it == _entries.end())
+            return false;
+        entry = *it;
+    }
+
+    // entries are immutable, so copying is done without lock
+    const size_t plane_size = PlaneSize(dst);
+    if (entry->data.size() != plane_size * PLANES_NUMBER)
+        return false;
+    for (size_t i = 0; i < PLANES_NUMBER; i++)
+        std::memcpy(dst.planes[i], entry->data.data() + i * plane_size, plane_size);
+    return true;
+}
+
+bool PreProcCache::Store(const Key &key, const Image &image) {
+    if (!IsCacheable(image))
+        return false;
+
+    const size_t plane_size = PlaneSize(image);
+    const size_t size = plane_size * PLANES_NUMBER;
+    {
+        // check budget before copying image
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_memory_usage + size > _budget)
+            return false;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->key = key;
+    entry->data.resize(size);
+    for (size_t i = 0; i < PLANES_NUMBER; i++)
+        std::memcpy(entry->data.data() + i * plane_size, image.planes[i], plane_size);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    // another element may have stored the same region or used the budget meanwhile
+    if (_memory_usage + size > _budget ||
+        std::any_of(_entries.begin(), _entries.end(),
+                    [&key](const std::shared_ptr<const Entry> &e) { return e->key == key; }))
+        return false;
+    _entries.push_back(std::move(entry));
+    _memory_usage += size;
+    return true;
+}
+
+size_t PreProcCache::MemoryUsage() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _memory_usage;
+}
+
+} // namespace InferenceBackend
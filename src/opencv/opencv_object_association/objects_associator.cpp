@@ -7,6 +7,7 @@
 #include "objects_associator.h"
 
 #include "hungarian_wrap.h"
+#include "sparse_assignment.h"
 
 namespace vas {
 namespace ot {
@@ -14,9 +15,10 @@ namespace ot {
 const float kAssociationCostThreshold = 1.0f;
 
 ObjectsAssociator::ObjectsAssociator(bool tracking_per_class, float kRgbHistDistScale, float kNormCenterDistScale,
-                                     float kNormShapeDistScale)
+                                     float kNormShapeDistScale, bool dense_association)
     : tracking_per_class_(tracking_per_class), kRgbHistDistScale_(kRgbHistDistScale),
-      kNormCenterDistScale_(kNormCenterDistScale), kNormShapeDistScale_(kNormShapeDistScale) {
+      kNormCenterDistScale_(kNormCenterDistScale), kNormShapeDistScale_(kNormShapeDistScale),
+      dense_association_(dense_association) {
 }
 
 ObjectsAssociator::~ObjectsAssociator() {
@@ -25,6 +27,14 @@ ObjectsAssociator::~ObjectsAssociator() {
 std::pair<std::vector<bool>, std::vector<int32_t>>
 ObjectsAssociator::Associate(const std::vector<Detection> &detections,
                              const std::vector<std::shared_ptr<Tracklet>> &tracklets) {
+    if (dense_association_)
+        return AssociateDense(detections, tracklets);
+    return AssociateSparse(detections, tracklets);
+}
+
+std::pair<std::vector<bool>, std::vector<int32_t>>
+ObjectsAssociator::AssociateDense(const std::vector<Detection> &detections,
+                                  const std::vector<std::shared_ptr<Tracklet>> &tracklets) {
     std::vector<std::vector<float>> d2t_rgb_dist_table;
 
     if (!detections[0].feature.empty()) {
@@ -115,6 +125,62 @@ ObjectsAssociator::Associate(const std::vector<Detection> &detections,
     return std::make_pair(d_is_associated, t_associated_d_index);
 }
 
+std::pair<std::vector<bool>, std::vector<int32_t>>
+ObjectsAssociator::AssociateSparse(const std::vector<Detection> &detections,
+                                   const std::vector<std::shared_ptr<Tracklet>> &tracklets) {
+    const size_t n_detections = detections.size();
+    const size_t n_tracklets = tracklets.size();
+
+    if (n_detections == 0 || n_tracklets == 0)
+        return std::make_pair(std::vector<bool>(n_detections, false), std::vector<int32_t>(n_tracklets, -1));
+
+    std::vector<assignment::Box> d_boxes(n_detections), t_boxes(n_tracklets);
+    std::vector<float> t_log_term(n_tracklets), t_norm_center_dist_scale(n_tracklets),
+        t_norm_shape_dist_scale(n_tracklets);
+    for (size_t t = 0; t < n_tracklets; ++t) {
+        const auto &tracklet = tracklets[t];
+        const cv::Rect2f &rect = tracklet->trajectory.back();
+
+        float const_ratio = 0.95f;
+        t_norm_center_dist_scale[t] =
+            (1.0 - const_ratio) * kNormCenterDistScale_ * tracklet->association_delta_t / 0.033f +
+            const_ratio * kNormCenterDistScale_; // adaptive to delta_t
+        t_norm_shape_dist_scale[t] =
+            (1.0 - const_ratio) * kNormShapeDistScale_ * tracklet->association_delta_t / 0.033f +
+            const_ratio * kNormShapeDistScale_; // adaptive to delta_t
+        t_log_term[t] = logf(kRgbHistDistScale_ * t_norm_center_dist_scale[t] * t_norm_shape_dist_scale[t]);
+        t_boxes[t] = {rect.x, rect.y, rect.width, rect.height};
+    }
+    for (size_t d = 0; d < n_detections; ++d) {
+        const cv::Rect2f &rect = detections[d].rect;
+        d_boxes[d] = {rect.x, rect.y, rect.width, rect.height};
+    }
+
+    const bool use_feature = !detections[0].feature.empty();
+
+    const assignment::SparseCostMatrix d2t_costs = assignment::gatedCosts(
+        d_boxes, t_boxes, t_log_term, t_norm_center_dist_scale, kAssociationCostThreshold, [&](size_t d, size_t t) {
+            if (tracking_per_class_ && (detections[d].class_label != tracklets[t]->label))
+                return kAssociationCostThreshold;
+
+            const cv::Rect2f &rect = detections[d].rect;
+            const cv::Rect2f &t_rect = tracklets[t]->trajectory.back();
+            float cost = t_log_term[t] + NormalizedCenterDistance(rect, t_rect) / t_norm_center_dist_scale[t] +
+                         NormalizedShapeDistance(rect, t_rect) / t_norm_shape_dist_scale[t];
+            // Feature distance is non-negative, so it is computed only for pairs which may still be associated
+            if (cost >= kAssociationCostThreshold)
+                return cost;
+            if (use_feature)
+                cost += RgbDistance(detections[d].feature, *tracklets[t]) / kRgbHistDistScale_;
+            return cost;
+        });
+
+    // Unassigned detection costs kAssociationCostThreshold, the same as its dummy column in dense cost table
+    const std::vector<int32_t> d_associated_t_index = assignment::solve(d2t_costs, kAssociationCostThreshold, true);
+
+    return assignment::toAssociation(d_associated_t_index, n_tracklets);
+}
+
 static float ComputeSimilarity(const cv::Mat &hist1, const cv::Mat &hist2) {
     // PROF_START(PROF_COMPONENTS_OT_SHORTTERM_HIST_SIMILARITY);
     // Bhattacharyya coeff (w/o weights)
@@ -154,18 +220,22 @@ ObjectsAssociator::ComputeRgbDistance(const std::vector<Detection> &detections,
             if (tracking_per_class_ && (detections[d].class_label != tracklets[t]->label))
                 continue;
 
-            // Find best match in rgb feature history
-            float min_dist = 1000.0f;
-            for (const auto &t_feature : *(tracklets[t]->GetRgbFeatures())) {
-                min_dist = std::min(min_dist, 1.0f - ComputeSimilarity(d_feature, t_feature));
-            }
-            d2t_rgb_dist_table[d][t] = min_dist;
+            d2t_rgb_dist_table[d][t] = RgbDistance(d_feature, *tracklets[t]);
         }
     }
 
     return d2t_rgb_dist_table;
 }
 
+float ObjectsAssociator::RgbDistance(const cv::Mat &detection_feature, Tracklet &tracklet) {
+    // Find best match in rgb feature history
+    float min_dist = 1000.0f;
+    for (const auto &t_feature : *(tracklet.GetRgbFeatures())) {
+        min_dist = std::min(min_dist, 1.0f - ComputeSimilarity(detection_feature, t_feature));
+    }
+    return min_dist;
+}
+
 float ObjectsAssociator::NormalizedCenterDistance(const cv::Rect2f &r1, const cv::Rect2f &r2) {
     float normalizer = std::min(0.5f * (r1.width + r1.height), 0.5f * (r2.width + r2.height));
 
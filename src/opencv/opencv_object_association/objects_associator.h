@@ -16,8 +16,12 @@ namespace ot {
 
 class ObjectsAssociator {
   public:
+    // Dense association solves full detection-tracklet cost table with Hungarian algorithm, otherwise only pairs of
+    // nearby detections and tracklets are scored and the sparse cost table is solved by shortest augmenting path
+    // algorithm. Both give the same association up to ties.
     explicit ObjectsAssociator(bool tracking_per_class, float kRgbHistDistScale = 0.25f,
-                               float kNormCenterDistScale = 0.5f, float kNormShapeDistScale = 0.75f);
+                               float kNormCenterDistScale = 0.5f, float kNormShapeDistScale = 0.75f,
+                               bool dense_association = false);
     virtual ~ObjectsAssociator();
     ObjectsAssociator() = delete;
 
@@ -26,9 +30,15 @@ class ObjectsAssociator {
     Associate(const std::vector<Detection> &detections, const std::vector<std::shared_ptr<Tracklet>> &tracklets);
 
   private:
+    std::pair<std::vector<bool>, std::vector<int32_t>>
+    AssociateDense(const std::vector<Detection> &detections, const std::vector<std::shared_ptr<Tracklet>> &tracklets);
+    std::pair<std::vector<bool>, std::vector<int32_t>>
+    AssociateSparse(const std::vector<Detection> &detections, const std::vector<std::shared_ptr<Tracklet>> &tracklets);
+
     std::vector<std::vector<float>> ComputeRgbDistance(const std::vector<Detection> &detections,
                                                        const std::vector<std::shared_ptr<Tracklet>> &tracklets);
 
+    static float RgbDistance(const cv::Mat &detection_feature, Tracklet &tracklet);
     static float NormalizedCenterDistance(const cv::Rect2f &r1, const cv::Rect2f &r2);
     static float NormalizedShapeDistance(const cv::Rect2f &r1, const cv::Rect2f &r2);
 
@@ -37,6 +47,7 @@ class ObjectsAssociator {
     float kRgbHistDistScale_;
     float kNormCenterDistScale_;
     float kNormShapeDistScale_;
+    bool dense_association_;
 };
 
 }; // namespace ot
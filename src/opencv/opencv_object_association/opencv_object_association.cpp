@@ -20,6 +20,7 @@ static constexpr auto adjust_objects = "adjust-objects";
 static constexpr auto tracking_per_class = "tracking-per-class";
 static constexpr auto spatial_feature_distance = "spatial-feature-distance";
 static constexpr auto spatial_feature_metadata_name = "spatial-feature-metadata-name";
+static constexpr auto association_solver = "association-solver";
 
 static constexpr auto shape_feature_weight = "shape-feature-weight";
 static constexpr auto trajectory_feature_weight = "trajectory-feature-weight";
@@ -37,6 +38,11 @@ static ParamDescVector params_desc = {
      "Method to calculate distance between two spatial features",
      "bhattacharyya",
      {"none", "cosine", "bhattacharyya"}},
+    {param::association_solver,
+     "Algorithm to associate objects with detections: 'sparse' scores only nearby pairs, 'hungarian' solves full cost "
+     "table",
+     "sparse",
+     {"sparse", "hungarian"}},
     // object tracker tuning parameters
     {param::shape_feature_weight, "Weighting factor for shape-based feature", 0.75, 0.0, 1.0},
     {param::trajectory_feature_weight, "Weighting factor for trajectory-based feature", 0.5, 0.0, 1.0},
@@ -53,6 +59,7 @@ class ObjectAssociationOpenCV : public BaseTransformInplace {
 
         _ot_params.generate_objects = params->get<bool>(param::generate_objects, true);
         _ot_params.tracking_per_class = params->get<bool>(param::tracking_per_class, true);
+        _ot_params.dense_association = params->get<std::string>(param::association_solver) == "hungarian";
         _ot_params.kRgbHistDistScale = params->get<double>(param::spatial_feature_weight);
         _ot_params.kNormCenterDistScale = params->get<double>(param::trajectory_feature_weight);
         _ot_params.kNormShapeDistScale = params->get<double>(param::shape_feature_weight);
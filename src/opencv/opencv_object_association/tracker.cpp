@@ -14,7 +14,8 @@ namespace ot {
 Tracker::Tracker(vas::ot::Tracker::InitParameters init_param)
     : next_id_(1), frame_count_(0), min_region_ratio_in_boundary_(init_param.min_region_ratio_in_boundary),
       associator_(ObjectsAssociator(init_param.tracking_per_class, init_param.kRgbHistDistScale,
-                                    init_param.kNormCenterDistScale, init_param.kNormShapeDistScale)),
+                                    init_param.kNormCenterDistScale, init_param.kNormShapeDistScale,
+                                    init_param.dense_association)),
       generate_objects(init_param.generate_objects), image_sz(0, 0) {
     if (generate_objects) {
         kMaxAssociationFailCount = 20;
@@ -26,6 +26,7 @@ class Tracker {
       public:
         bool generate_objects; // short-term if true, zero-term if false
         bool tracking_per_class;
+        bool dense_association; // solve association with Hungarian algorithm on dense cost table
 
         float kRgbHistDistScale;
         float kNormCenterDistScale;
@@ -122,8 +122,7 @@ class TensorPostProcHumanPose : public BaseTransformInplace {
 
         // find peaks in heat_maps
         std::vector<std::vector<Peak>> peaks_from_heat_map(heat_maps.size());
-        FindPeaksBody find_peaks_body(heat_maps, dflt::min_peaks_distance, peaks_from_heat_map);
-        cv::parallel_for_(cv::Range(0, static_cast<int>(heat_maps.size())), find_peaks_body);
+        FindAllPeaks(heat_maps, dflt::min_peaks_distance, peaks_from_heat_map);
         int peaks_before = 0;
         for (size_t heatmap_id = 1; heatmap_id < heat_maps.size(); heatmap_id++) {
             peaks_before += static_cast<int>(peaks_from_heat_map[heatmap_id - 1].size());
@@ -10,9 +10,12 @@
 #include "dlstreamer/image_metadata.h"
 #include "dlstreamer/memory_mapper_factory.h"
 #include "dlstreamer/openvino/context.h"
+#include "dlstreamer/openvino/model_cache.h"
+#include "dlstreamer/utils.h"
 #include "dlstreamer/vaapi/context.h"
 
 #include <logger.h>
+#include <mutex>
 #include <openvino/openvino.hpp>
 #include <openvino/runtime/intel_gpu/properties.hpp>
 
@@ -66,7 +69,7 @@ class OpenVinoTensorInference : public BaseTransform {
     void read_ir_model() {
         // read model
         auto path = _params->get<std::string>(param::model);
-        _model = _core.read_model(path);
+        _model = OpenVINOModelCache::instance().clone_model(path);
         // set batch size
         int batch_size = _params->get<int>(param::batch_size);
         if (batch_size > 1)
@@ -92,8 +95,10 @@ class OpenVinoTensorInference : public BaseTransform {
     }
 
     bool init_once() override {
-        if (is_preprocessing_required())
+        if (is_preprocessing_required()) {
             configure_model_preprocessing();
+            _model_preprocessed = true;
+        }
 
         load_network();
 
@@ -139,11 +144,12 @@ class OpenVinoTensorInference : public BaseTransform {
         };
     }
 
+    // May be called concurrently by streams sharing the instance (ELEMENT_FLAG_CONCURRENT). Every call takes its own
+    // infer request from the output pool, only input mapping and submission are serialized.
     FramePtr process(FramePtr src) override {
         DLS_CHECK(init());
         // ITT_TASK(__FUNCTION__);
         FramePtr dst = create_output();
-        auto src_openvino = _input_mapper->map(src, AccessMode::Read);
         auto dst_openvino = ptr_cast<OpenVINOFrame>(dst);
 
         // FIXME: Since we are reusing inference requests we have to make sure that the inference is actually completed.
@@ -152,12 +158,16 @@ class OpenVinoTensorInference : public BaseTransform {
         // For example, fakesink after inference.
         dst_openvino->wait();
 
-        dst_openvino->set_input({src_openvino.begin(), src_openvino.end()});
+        {
+            std::lock_guard<std::mutex> lock(_submit_mutex);
+            auto src_openvino = _input_mapper->map(src, AccessMode::Read);
+            dst_openvino->set_input({src_openvino.begin(), src_openvino.end()});
 
-        // capture input tensors until infer_request.wait() completed
-        dst_openvino->set_parent(src_openvino);
+            // capture input tensors until infer_request.wait() completed
+            dst_openvino->set_parent(src_openvino);
 
-        dst_openvino->start();
+            dst_openvino->start();
+        }
 
         ModelInfoMetadata model_info(dst->metadata().add(ModelInfoMetadata::name));
         model_info.set_model_name(_model->get_friendly_name());
@@ -170,10 +180,12 @@ class OpenVinoTensorInference : public BaseTransform {
     }
 
   protected:
-    ov::Core _core;
+    ov::Core _core = OpenVINOModelCache::instance().core();
     std::string _device;
     std::shared_ptr<ov::Model> _model;
+    bool _model_preprocessed = false;
     ov::CompiledModel _compiled_model;
+    std::shared_ptr<const void> _compiled_model_reference; // keeps _compiled_model shared with other elements
 
     FrameInfo _model_input_info;
     FrameInfo _model_output_info;
@@ -182,6 +194,7 @@ class OpenVinoTensorInference : public BaseTransform {
     DictionaryCPtr _params;
     MemoryMapperPtr _input_mapper;
     OpenVINOContextPtr _openvino_context;
+    std::mutex _submit_mutex;
 
     bool is_device_gpu() const {
         return _device.find("GPU") != std::string::npos;
@@ -241,14 +254,28 @@ class OpenVinoTensorInference : public BaseTransform {
             std::string config = _params->get<std::string>(param::config);
             auto ov_params = string_to_openvino_map(config);
             adjust_ie_config(ov_params);
-            if (_openvino_context) {
-                _compiled_model = _core.compile_model(_model, *_openvino_context, ov_params);
-            } else {
-                _compiled_model = _core.compile_model(_model, _device, ov_params);
-            }
+            auto path = _params->get<std::string>(param::model);
+            auto &cache = OpenVINOModelCache::instance();
+            OpenVINOModelCache::CompileResult result =
+                _openvino_context ? cache.compile_model(_model, path, model_variant(), *_openvino_context, ov_params)
+                                  : cache.compile_model(_model, path, model_variant(), _device, ov_params);
+            _compiled_model = result.compiled_model;
+            _compiled_model_reference = result.reference;
+            if (!result.blob_error.empty())
+                GVA_WARNING("Model cache directory is not used: %s", result.blob_error.c_str());
+            GVA_INFO("Model %s loaded to device %s in %lld ms (%s)", path.c_str(), _device.c_str(),
+                     static_cast<long long>(result.duration.count()), OpenVINOModelCache::source_name(result.source));
         }
     }
 
+    // Batch size and pre-processing are the only changes applied to model after reading
+    std::string model_variant() const {
+        std::string variant = "batch=" + std::to_string(_params->get<int>(param::batch_size));
+        if (_model_preprocessed)
+            variant += ";input=" + frame_info_to_string(_input_info);
+        return variant;
+    }
+
     FrameInfoVector info_variations(const FrameInfo &info, std::vector<MemoryType> memory_types,
                                     std::vector<DataType> data_types) {
         FrameInfoVector infos;
@@ -359,7 +386,7 @@ ElementDesc openvino_tensor_inference = {
     .input_info = {{MediaType::Tensors, MemoryType::OpenCL}, {MediaType::Tensors, MemoryType::CPU}},
     .output_info = {{MediaType::Tensors, MemoryType::OpenVINO}},
     .create = create_element<OpenVinoTensorInference>,
-    .flags = ELEMENT_FLAG_SHARABLE};
+    .flags = ELEMENT_FLAG_SHARABLE | ELEMENT_FLAG_CONCURRENT};
 }
 
 extern "C" {
@@ -370,7 +397,7 @@ ElementDesc openvino_video_inference = {.name = "openvino_video_inference",
                                         .input_info = {{ImageFormat::NV12, MemoryType::VAAPI}},
                                         .output_info = {{MediaType::Tensors, MemoryType::OpenVINO}},
                                         .create = create_element<OpenVinoVideoInference>,
-                                        .flags = ELEMENT_FLAG_SHARABLE};
+                                        .flags = ELEMENT_FLAG_SHARABLE | ELEMENT_FLAG_CONCURRENT};
 }
 
 } // namespace dlstreamer
@@ -0,0 +1,175 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "bitmask.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BITMASK_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace bitmask {
+
+namespace {
+
+using PackRowFunction = void (*)(const float *src, size_t width, float threshold, uint8_t *dst);
+using BlendFunction = void (*)(uint8_t *dst, const uint8_t *mask, const uint8_t *color, size_t size);
+
+void packRowScalar(const float *src, size_t width, float threshold, uint8_t *dst) {
+    std::memset(dst, 0, rowStride(width));
+    for (size_t x = 0; x < width; x++) {
+        if (src[x] > threshold)
+            dst[x / 8] |= static_cast<uint8_t>(1u << (x % 8));
+    }
+}
+
+// Rounds like _mm256_avg_epu8, so result doesn't depend on the kernel
+void blendScalar(uint8_t *dst, const uint8_t *mask, const uint8_t *color, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (mask[i])
+            dst[i] = static_cast<uint8_t>((dst[i] + color[i] + 1) >> 1);
+    }
+}
+
+#ifdef BITMASK_X86_KERNELS
+
+__attribute__((target("avx2"))) void packRowAvx2(const float *src, size_t width, float threshold, uint8_t *dst) {
+    const __m256 threshold_v = _mm256_set1_ps(threshold);
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m256 gt = _mm256_cmp_ps(_mm256_loadu_ps(src + x), threshold_v, _CMP_GT_OQ);
+        dst[x / 8] = static_cast<uint8_t>(_mm256_movemask_ps(gt));
+    }
+    if (x < width)
+        packRowScalar(src + x, width - x, threshold, dst + x / 8);
+}
+
+__attribute__((target("avx2"))) void blendAvx2(uint8_t *dst, const uint8_t *mask, const uint8_t *color, size_t size) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        const __m256i average =
+            _mm256_avg_epu8(pixels, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(color + i)));
+        const __m256i select = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mask + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_blendv_epi8(pixels, average, select));
+    }
+    blendScalar(dst + i, mask + i, color + i, size - i);
+}
+
+#endif // BITMASK_X86_KERNELS
+
+bool hasAvx2() {
+#ifdef BITMASK_X86_KERNELS
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+PackRowFunction selectPackRowFunction() {
+#ifdef BITMASK_X86_KERNELS
+    if (hasAvx2())
+        return packRowAvx2;
+#endif
+    return packRowScalar;
+}
+
+BlendFunction selectBlendFunction() {
+#ifdef BITMASK_X86_KERNELS
+    if (hasAvx2())
+        return blendAvx2;
+#endif
+    return blendScalar;
+}
+
+} // namespace
+
+void pack(const float *src, size_t width, size_t height, float threshold, uint8_t *dst) {
+    static const PackRowFunction pack_row = selectPackRowFunction();
+    const size_t stride = rowStride(width);
+    for (size_t y = 0; y < height; y++)
+        pack_row(src + y * width, width, threshold, dst + y * stride);
+}
+
+std::vector<uint8_t> pack(const float *src, size_t width, size_t height, float threshold) {
+    std::vector<uint8_t> bits(packedSize(width, height));
+    pack(src, width, height, threshold, bits.data());
+    return bits;
+}
+
+void unpack(const uint8_t *bits, size_t width, size_t height, uint8_t *dst, uint8_t value) {
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++)
+            dst[y * width + x] = test(bits, width, x, y) ? value : 0;
+    }
+}
+
+ScaledMask::ScaledMask(const uint8_t *bits, int width, int height, int dst_width, int dst_height)
+    : _bits(bits), _width(width), _height(height), _x_taps(taps(width + 2, dst_width)),
+      _y_taps(taps(height + 2, dst_height)) {
+}
+
+ScaledMask::ScaledMask(const float *values, int width, int height, int dst_width, int dst_height)
+    : _values(values), _width(width), _height(height), _x_taps(taps(width + 2, dst_width)),
+      _y_taps(taps(height + 2, dst_height)) {
+}
+
+// Pixel centers are aligned as in cv::resize with INTER_LINEAR
+std::vector<ScaledMask::Tap> ScaledMask::taps(int src_size, int dst_size) {
+    std::vector<Tap> result(std::max(dst_size, 0));
+    const float scale = static_cast<float>(src_size) / std::max(dst_size, 1);
+    for (int i = 0; i < dst_size; i++) {
+        const float position = (i + 0.5f) * scale - 0.5f;
+        int index = static_cast<int>(std::floor(position));
+        float weight = position - index;
+        if (index < 0) {
+            index = 0;
+            weight = 0.0f;
+        } else if (index >= src_size - 1) {
+            index = src_size - 1;
+            weight = 0.0f;
+        }
+        result[i] = {index, weight};
+    }
+    return result;
+}
+
+float ScaledMask::value(int x, int y) const {
+    // Shift from bordered coordinates, border pixels are zero
+    x--;
+    y--;
+    if (x < 0 || y < 0 || x >= _width || y >= _height)
+        return 0.0f;
+    if (_values)
+        return _values[y * _width + x];
+    return test(_bits, _width, x, y) ? 1.0f : 0.0f;
+}
+
+void ScaledMask::row(int y, int x_begin, int x_end, int channels, uint8_t *dst) const {
+    const Tap &y_tap = _y_taps[y];
+    for (int x = x_begin; x < x_end; x++) {
+        const Tap &x_tap = _x_taps[x];
+        const float top = (1.0f - x_tap.weight) * value(x_tap.index, y_tap.index) +
+                          x_tap.weight * value(x_tap.index + 1, y_tap.index);
+        const float bottom = (1.0f - x_tap.weight) * value(x_tap.index, y_tap.index + 1) +
+                             x_tap.weight * value(x_tap.index + 1, y_tap.index + 1);
+        const float interpolated = (1.0f - y_tap.weight) * top + y_tap.weight * bottom;
+        std::memset(dst, interpolated > 0.5f ? 0xFF : 0, channels);
+        dst += channels;
+    }
+}
+
+void blend(uint8_t *dst, const uint8_t *mask, const uint8_t *color, size_t size) {
+    static const BlendFunction blend_function = selectBlendFunction();
+    blend_function(dst, mask, color, size);
+}
+
+} // namespace bitmask
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Binary masks packed one bit per pixel. Rows are stored top to bottom and each row starts at a byte boundary, pixel x
+ * of a row is bit (x % 8) of byte (x / 8).
+ */
+namespace bitmask {
+
+inline size_t rowStride(size_t width) {
+    return (width + 7) / 8;
+}
+
+inline size_t packedSize(size_t width, size_t height) {
+    return rowStride(width) * height;
+}
+
+inline bool test(const uint8_t *bits, size_t width, size_t x, size_t y) {
+    return (bits[y * rowStride(width) + x / 8] >> (x % 8)) & 1;
+}
+
+// Sets bits of pixels with value greater than threshold. 'dst' must hold packedSize(width, height) bytes
+void pack(const float *src, size_t width, size_t height, float threshold, uint8_t *dst);
+
+std::vector<uint8_t> pack(const float *src, size_t width, size_t height, float threshold);
+
+// Writes 'value' for set bits and 0 for others, one byte per pixel
+void unpack(const uint8_t *bits, size_t width, size_t height, uint8_t *dst, uint8_t value = 1);
+
+/**
+ * Mask surrounded by one-pixel border of zeros and scaled to 'dst_width x dst_height' (border included) with bilinear
+ * interpolation, followed by 0.5 threshold. Rows are computed on demand, so only the visible part of a mask scaled to
+ * object size is ever materialized.
+ * Float masks are interpolated from their values, as cv::resize followed by cv::threshold would do. Packed masks are
+ * interpolated from 0/1 bits, already thresholded at model resolution, so edges of a mask scaled up follow the model
+ * pixel grid more closely than edges of the float mask it was packed from.
+ */
+class ScaledMask {
+  public:
+    ScaledMask(const uint8_t *bits, int width, int height, int dst_width, int dst_height);
+    ScaledMask(const float *values, int width, int height, int dst_width, int dst_height);
+
+    // Writes 'channels' bytes per pixel for x in [x_begin, x_end) of scaled row 'y': 0xFF inside mask, 0 outside
+    void row(int y, int x_begin, int x_end, int channels, uint8_t *dst) const;
+
+  private:
+    // Bilinear tap in bordered source coordinates
+    struct Tap {
+        int index;
+        float weight; // of (index + 1)
+    };
+
+    static std::vector<Tap> taps(int src_size, int dst_size);
+    float value(int x, int y) const;
+
+    const uint8_t *_bits = nullptr;
+    const float *_values = nullptr;
+    int _width;
+    int _height;
+    std::vector<Tap> _x_taps;
+    std::vector<Tap> _y_taps;
+};
+
+// Averages 'size' bytes of 'dst' with 'color' where 'mask' is 0xFF, 'color' holds one value per byte of 'dst'
+void blend(uint8_t *dst, const uint8_t *mask, const uint8_t *color, size_t size);
+
+} // namespace bitmask
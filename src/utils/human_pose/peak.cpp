@@ -6,13 +6,79 @@
 
 #include "peak.h"
 
+#include "dlstreamer/base/thread_pool.h"
+
 #include <algorithm>
 #include <iostream>
 #include <utility>
 #include <vector>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PEAK_X86_KERNELS
+#include <immintrin.h>
+#endif
+
 using namespace std;
 
+namespace {
+
+constexpr float peak_threshold = 0.1f;
+constexpr size_t limbs_number = 17;
+
+// Shared by all element instances, peak search and limb scoring run on it instead of OpenCV's global pool
+dlstreamer::ThreadPool &poseThreadPool() {
+    static dlstreamer::ThreadPool pool;
+    return pool;
+}
+
+// Appends pixels of a row greater than all four neighbours. Rows have one-pixel border on both sides
+using FindRowPeaksFunction = void (*)(const float *top, const float *row, const float *bottom, int width, int y,
+                                      std::vector<cv::Point> &peaks);
+
+void findRowPeaksScalar(const float *top, const float *row, const float *bottom, int begin, int width, int y,
+                        std::vector<cv::Point> &peaks) {
+    for (int x = begin; x < width; x++) {
+        const float val = row[x];
+        if (val > row[x - 1] && val > row[x + 1] && val > top[x] && val > bottom[x])
+            peaks.emplace_back(x, y);
+    }
+}
+
+void findRowPeaksScalar(const float *top, const float *row, const float *bottom, int width, int y,
+                        std::vector<cv::Point> &peaks) {
+    findRowPeaksScalar(top, row, bottom, 0, width, y, peaks);
+}
+
+#ifdef PEAK_X86_KERNELS
+
+__attribute__((target("avx2"))) void findRowPeaksAvx2(const float *top, const float *row, const float *bottom,
+                                                      int width, int y, std::vector<cv::Point> &peaks) {
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m256 val = _mm256_loadu_ps(row + x);
+        __m256 mask = _mm256_and_ps(_mm256_cmp_ps(val, _mm256_loadu_ps(row + x - 1), _CMP_GT_OQ),
+                                    _mm256_cmp_ps(val, _mm256_loadu_ps(row + x + 1), _CMP_GT_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(val, _mm256_loadu_ps(top + x), _CMP_GT_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(val, _mm256_loadu_ps(bottom + x), _CMP_GT_OQ));
+        for (unsigned bits = _mm256_movemask_ps(mask); bits; bits &= bits - 1)
+            peaks.emplace_back(x + __builtin_ctz(bits), y);
+    }
+    findRowPeaksScalar(top, row, bottom, x, width, y, peaks);
+}
+
+#endif // PEAK_X86_KERNELS
+
+FindRowPeaksFunction selectFindRowPeaksFunction() {
+#ifdef PEAK_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return findRowPeaksAvx2;
+#endif
+    return findRowPeaksScalar;
+}
+
+} // namespace
+
 Peak::Peak(const int id, const cv::Point2f &pos, const float score) : id(id), pos(pos), score(score) {
 }
 
@@ -35,44 +101,60 @@ void FindPeaksBody::operator()(const cv::Range &range) const {
     }
 }
 
+void FindAllPeaks(const std::vector<cv::Mat> &heat_maps, float min_peaks_distance,
+                  std::vector<std::vector<Peak>> &all_peaks) {
+    FindPeaksBody find_peaks_body(heat_maps, min_peaks_distance, all_peaks);
+    poseThreadPool().parallel_for(heat_maps.size(), [&](size_t i) {
+        const int heat_map_id = static_cast<int>(i);
+        find_peaks_body(cv::Range(heat_map_id, heat_map_id + 1));
+    });
+}
+
 std::vector<TwoJointsConnection> ComputeLineIntegralAndWeightedBipartiteGraph(
     const std::vector<Peak> &candidate_a, const std::vector<Peak> &candidate_b, const float mid_points_score_threshold,
     const std::pair<cv::Mat, cv::Mat> &score_mid, const std::vector<cv::Mat> &pafs,
     const float found_mid_points_ratio_threshold) {
     std::vector<TwoJointsConnection> temp_joint_connections;
+    const cv::Mat &paf_x = score_mid.first;
+    const cv::Mat &paf_y = score_mid.second;
+    const int height_n = pafs[0].rows / 2;
+    const int mid_num = 10;
+    const float score_threshold = -100.0f;
+    // p_count / mid_num below is integer division: for ratio thresholds in [0, 1) only pairs with all points above
+    // the score threshold pass, so sampling stops at the first point below it
+    const bool all_points_required = found_mid_points_ratio_threshold >= 0.0f;
     for (size_t i = 0; i < candidate_a.size(); ++i) {
+        const cv::Point2f &pos_a = candidate_a[i].pos;
         for (size_t j = 0; j < candidate_b.size(); ++j) {
+            const cv::Point2f &pos_b = candidate_b[j].pos;
             // building vectors
-            cv::Point2f pt = candidate_a[i].pos * 0.5 + candidate_b[j].pos * 0.5;
+            cv::Point2f pt = pos_a * 0.5 + pos_b * 0.5;
             cv::Point mid = cv::Point(cvRound(pt.x), cvRound(pt.y));
-            cv::Point2f vec = candidate_b[j].pos - candidate_a[i].pos;
+            cv::Point2f vec = pos_b - pos_a;
             double norm_vec = cv::norm(vec);
             if (norm_vec == 0) {
                 continue;
             }
             vec /= norm_vec;
             // sampling
-            float score = vec.x * score_mid.first.at<float>(mid) + vec.y * score_mid.second.at<float>(mid);
-            int height_n = pafs[0].rows / 2;
+            float score = vec.x * paf_x.ptr<float>(mid.y)[mid.x] + vec.y * paf_y.ptr<float>(mid.y)[mid.x];
             float suc_ratio = 0.0f;
             float mid_score = 0.0f;
-            const int mid_num = 10;
-            const float score_threshold = -100.0f;
             if (score > score_threshold) {
                 float p_sum = 0;
                 int p_count = 0;
-                cv::Size2f step((candidate_b[j].pos.x - candidate_a[i].pos.x) / (mid_num - 1),
-                                (candidate_b[j].pos.y - candidate_a[i].pos.y) / (mid_num - 1));
+                cv::Size2f step((pos_b.x - pos_a.x) / (mid_num - 1), (pos_b.y - pos_a.y) / (mid_num - 1));
                 // evaluating on the fields
                 for (int n = 0; n < mid_num; n++) {
-                    cv::Point mid_point(cvRound(candidate_a[i].pos.x + n * step.width),
-                                        cvRound(candidate_a[i].pos.y + n * step.height));
-                    cv::Point2f pred(score_mid.first.at<float>(mid_point), score_mid.second.at<float>(mid_point));
+                    const int x = cvRound(pos_a.x + n * step.width);
+                    const int y = cvRound(pos_a.y + n * step.height);
                     // integral step
-                    score = vec.x * pred.x + vec.y * pred.y;
+                    score = vec.x * paf_x.ptr<float>(y)[x] + vec.y * paf_y.ptr<float>(y)[x];
                     if (score > mid_points_score_threshold) {
                         p_sum += score;
                         p_count++;
+                    } else if (all_points_required) {
+                        break;
                     }
                 }
                 suc_ratio = static_cast<float>(p_count / mid_num);
@@ -166,47 +248,26 @@ void FindPeaksBody::runNms(std::vector<cv::Point> &peaks, std::vector<std::vecto
 
 void FindPeaksBody::findPeaks(const std::vector<cv::Mat> &heat_maps, const float min_peaks_distance,
                               std::vector<std::vector<Peak>> &all_peaks, int heat_map_id) const {
-    const float threshold = 0.1f;
-    std::vector<cv::Point> peaks;
+    static const FindRowPeaksFunction find_row_peaks = selectFindRowPeaksFunction();
     const cv::Mat &heat_map = heat_maps[heat_map_id];
-    const float *heat_map_data = heat_map.ptr<float>();
-    size_t heat_map_step = heat_map.step1();
-    for (int y = -1; y < heat_map.rows + 1; y++) {
-        for (int x = -1; x < heat_map.cols + 1; x++) {
-            float val = 0;
-            if (x >= 0 && y >= 0 && x < heat_map.cols && y < heat_map.rows) {
-                val = heat_map_data[y * heat_map_step + x];
-                val = val >= threshold ? val : 0;
-            }
+    const int width = heat_map.cols;
+    const int padded_width = width + 2;
 
-            float left_val = 0;
-            if (y >= 0 && x < (heat_map.cols - 1) && y < heat_map.rows) {
-                left_val = heat_map_data[y * heat_map_step + x + 1];
-                left_val = left_val >= threshold ? left_val : 0;
-            }
-
-            float right_val = 0;
-            if (x > 0 && y >= 0 && y < heat_map.rows) {
-                right_val = heat_map_data[y * heat_map_step + x - 1];
-                right_val = right_val >= threshold ? right_val : 0;
-            }
-
-            float top_val = 0;
-            if (x >= 0 && x < heat_map.cols && y < (heat_map.rows - 1)) {
-                top_val = heat_map_data[(y + 1) * heat_map_step + x];
-                top_val = top_val >= threshold ? top_val : 0;
-            }
-
-            float bottom_val = 0;
-            if (x >= 0 && y > 0 && x < heat_map.cols) {
-                bottom_val = heat_map_data[(y - 1) * heat_map_step + x];
-                bottom_val = bottom_val >= threshold ? bottom_val : 0;
-            }
+    // Values below threshold are zeroed and the map gets one-pixel border of zeros, so every pixel has four
+    // neighbours and only values above threshold can be peaks
+    static thread_local std::vector<float> padded;
+    padded.assign(static_cast<size_t>(padded_width) * (heat_map.rows + 2), 0.0f);
+    for (int y = 0; y < heat_map.rows; y++) {
+        const float *src = heat_map.ptr<float>(y);
+        float *dst = &padded[(y + 1) * padded_width + 1];
+        for (int x = 0; x < width; x++)
+            dst[x] = src[x] >= peak_threshold ? src[x] : 0.0f;
+    }
 
-            if ((val > left_val) && (val > right_val) && (val > top_val) && (val > bottom_val)) {
-                peaks.push_back(cv::Point(x, y));
-            }
-        }
+    std::vector<cv::Point> peaks;
+    for (int y = 0; y < heat_map.rows; y++) {
+        const float *row = &padded[(y + 1) * padded_width + 1];
+        find_row_peaks(row - padded_width, row, row + padded_width, width, y, peaks);
     }
     runNms(peaks, all_peaks, heat_map_id, min_peaks_distance, heat_map);
 }
@@ -270,10 +331,24 @@ HumanPoses GroupPeaksToPoses(const std::vector<std::vector<Peak>> &all_peaks, co
     for (const auto &peaks : all_peaks) {
         candidates.insert(candidates.end(), peaks.begin(), peaks.end());
     }
-    std::vector<HumanPoseByPeaksIndices> pose_by_peak_indices_set;
-    for (size_t k = 0; k < 17; k++) {
-        std::vector<TwoJointsConnection> connections;
+    // Connections of a limb type depend only on peaks and PAFs, so they are found in parallel and merged in order
+    std::vector<std::vector<TwoJointsConnection>> limb_connections(limbs_number);
+    poseThreadPool().parallel_for(limbs_number, [&](size_t k) {
+        const std::vector<Peak> &candidate_a = all_peaks[limb_ids_heatmap[k].first];
+        const std::vector<Peak> &candidate_b = all_peaks[limb_ids_heatmap[k].second];
+        if (candidate_a.empty() || candidate_b.empty()) {
+            return;
+        }
         std::pair<cv::Mat, cv::Mat> score_mid = {pafs[limb_ids_paf[k].first], pafs[limb_ids_paf[k].second]};
+        std::vector<TwoJointsConnection> temp_joint_connections = ComputeLineIntegralAndWeightedBipartiteGraph(
+            candidate_a, candidate_b, mid_points_score_threshold, score_mid, pafs, found_mid_points_ratio_threshold);
+        if (!temp_joint_connections.empty()) {
+            AssignmentAlgoritm(temp_joint_connections, limb_connections[k], candidate_a, candidate_b);
+        }
+    });
+
+    std::vector<HumanPoseByPeaksIndices> pose_by_peak_indices_set;
+    for (size_t k = 0; k < limbs_number; k++) {
         const int idx_joint_a = limb_ids_heatmap[k].first;
         const int idx_joint_b = limb_ids_heatmap[k].second;
         const std::vector<Peak> &candidate_b = all_peaks[idx_joint_b]; // vector limbs, witch connect with
@@ -292,11 +367,7 @@ HumanPoses GroupPeaksToPoses(const std::vector<std::vector<Peak>> &all_peaks, co
             FillingSubSetForExistPeak(n_joints_a, keypoints_number, candidate_a, idx_joint_a, pose_by_peak_indices_set);
             continue;
         }
-        std::vector<TwoJointsConnection> temp_joint_connections = ComputeLineIntegralAndWeightedBipartiteGraph(
-            candidate_a, candidate_b, mid_points_score_threshold, score_mid, pafs, found_mid_points_ratio_threshold);
-        if (!temp_joint_connections.empty()) {
-            AssignmentAlgoritm(temp_joint_connections, connections, candidate_a, candidate_b);
-        }
+        const std::vector<TwoJointsConnection> &connections = limb_connections[k];
         if (connections.empty()) {
             continue;
         }
@@ -66,6 +66,10 @@ std::vector<TwoJointsConnection> ComputeLineIntegralAndWeightedBipartiteGraph(
     const std::pair<cv::Mat, cv::Mat> &score_mid, const std::vector<cv::Mat> &pafs,
     const float found_mid_points_ratio_threshold);
 
+// Finds peaks of all heat maps in parallel, peak ids are local to each heat map
+void FindAllPeaks(const std::vector<cv::Mat> &heat_maps, float min_peaks_distance,
+                  std::vector<std::vector<Peak>> &all_peaks);
+
 class FindPeaksBody : public cv::ParallelLoopBody {
   public:
     FindPeaksBody(const std::vector<cv::Mat> &heat_maps, float min_peaks_distance,
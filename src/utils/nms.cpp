@@ -0,0 +1,302 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "nms.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NMS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace nms {
+
+namespace {
+
+// Below this number of candidates the plain O(N^2) loop with vectorized IoU is faster than building the grid
+constexpr size_t GRID_MIN_CANDIDATES = 2048;
+// Average number of candidates per grid cell
+constexpr size_t GRID_CELL_OCCUPANCY = 8;
+
+// Candidates sorted by score, area is precomputed
+struct SortedBoxes {
+    std::vector<float> x_min;
+    std::vector<float> y_min;
+    std::vector<float> x_max;
+    std::vector<float> y_max;
+    std::vector<float> area;
+    std::vector<int32_t> label_id;
+    std::vector<size_t> index; // index in input Boxes
+};
+
+using SuppressFunction = void (*)(const SortedBoxes &boxes, size_t i, size_t begin, size_t end, float iou_threshold,
+                                  bool class_aware, uint8_t *suppressed);
+
+// IoU > threshold is checked as intersection > threshold * union to avoid division
+inline bool overlaps(const SortedBoxes &b, size_t i, size_t j, float iou_threshold, bool class_aware) {
+    if (class_aware && b.label_id[i] != b.label_id[j])
+        return false;
+    const float inter_width = std::min(b.x_max[i], b.x_max[j]) - std::max(b.x_min[i], b.x_min[j]);
+    const float inter_height = std::min(b.y_max[i], b.y_max[j]) - std::max(b.y_min[i], b.y_min[j]);
+    if (inter_width <= 0.f || inter_height <= 0.f)
+        return false;
+    const float inter_area = inter_width * inter_height;
+    const float union_area = b.area[i] + b.area[j] - inter_area;
+    return inter_area > iou_threshold * union_area;
+}
+
+void suppressScalar(const SortedBoxes &boxes, size_t i, size_t begin, size_t end, float iou_threshold,
+                    bool class_aware, uint8_t *suppressed) {
+    for (size_t j = begin; j < end; j++) {
+        if (!suppressed[j] && overlaps(boxes, i, j, iou_threshold, class_aware))
+            suppressed[j] = 1;
+    }
+}
+
+#ifdef NMS_X86_KERNELS
+
+__attribute__((target("avx2"))) void suppressAvx2(const SortedBoxes &b, size_t i, size_t begin, size_t end,
+                                                  float iou_threshold, bool class_aware, uint8_t *suppressed) {
+    const __m256 x_min = _mm256_set1_ps(b.x_min[i]);
+    const __m256 y_min = _mm256_set1_ps(b.y_min[i]);
+    const __m256 x_max = _mm256_set1_ps(b.x_max[i]);
+    const __m256 y_max = _mm256_set1_ps(b.y_max[i]);
+    const __m256 area = _mm256_set1_ps(b.area[i]);
+    const __m256 threshold = _mm256_set1_ps(iou_threshold);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256i label_id = _mm256_set1_epi32(b.label_id[i]);
+
+    size_t j = begin;
+    for (; j + 8 <= end; j += 8) {
+        const __m256 inter_width = _mm256_sub_ps(_mm256_min_ps(x_max, _mm256_loadu_ps(&b.x_max[j])),
+                                                 _mm256_max_ps(x_min, _mm256_loadu_ps(&b.x_min[j])));
+        const __m256 inter_height = _mm256_sub_ps(_mm256_min_ps(y_max, _mm256_loadu_ps(&b.y_max[j])),
+                                                  _mm256_max_ps(y_min, _mm256_loadu_ps(&b.y_min[j])));
+        const __m256 inter_area = _mm256_mul_ps(inter_width, inter_height);
+        const __m256 union_area = _mm256_sub_ps(_mm256_add_ps(area, _mm256_loadu_ps(&b.area[j])), inter_area);
+
+        __m256 mask = _mm256_and_ps(_mm256_cmp_ps(inter_width, zero, _CMP_GT_OQ),
+                                    _mm256_cmp_ps(inter_height, zero, _CMP_GT_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(inter_area, _mm256_mul_ps(threshold, union_area), _CMP_GT_OQ));
+        if (class_aware) {
+            const __m256i labels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&b.label_id[j]));
+            mask = _mm256_and_ps(mask, _mm256_castsi256_ps(_mm256_cmpeq_epi32(label_id, labels)));
+        }
+
+        for (unsigned bits = _mm256_movemask_ps(mask); bits; bits &= bits - 1)
+            suppressed[j + __builtin_ctz(bits)] = 1;
+    }
+    suppressScalar(b, i, j, end, iou_threshold, class_aware, suppressed);
+}
+
+// GCC reports false positive on _mm512_undefined_ps() used inside of min/max intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+__attribute__((target("avx512f"))) void suppressAvx512(const SortedBoxes &b, size_t i, size_t begin, size_t end,
+                                                       float iou_threshold, bool class_aware, uint8_t *suppressed) {
+    const __m512 x_min = _mm512_set1_ps(b.x_min[i]);
+    const __m512 y_min = _mm512_set1_ps(b.y_min[i]);
+    const __m512 x_max = _mm512_set1_ps(b.x_max[i]);
+    const __m512 y_max = _mm512_set1_ps(b.y_max[i]);
+    const __m512 area = _mm512_set1_ps(b.area[i]);
+    const __m512 threshold = _mm512_set1_ps(iou_threshold);
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512i label_id = _mm512_set1_epi32(b.label_id[i]);
+
+    size_t j = begin;
+    for (; j + 16 <= end; j += 16) {
+        const __m512 inter_width = _mm512_sub_ps(_mm512_min_ps(x_max, _mm512_loadu_ps(&b.x_max[j])),
+                                                 _mm512_max_ps(x_min, _mm512_loadu_ps(&b.x_min[j])));
+        const __m512 inter_height = _mm512_sub_ps(_mm512_min_ps(y_max, _mm512_loadu_ps(&b.y_max[j])),
+                                                  _mm512_max_ps(y_min, _mm512_loadu_ps(&b.y_min[j])));
+        const __m512 inter_area = _mm512_mul_ps(inter_width, inter_height);
+        const __m512 union_area = _mm512_sub_ps(_mm512_add_ps(area, _mm512_loadu_ps(&b.area[j])), inter_area);
+
+        __mmask16 mask = _mm512_cmp_ps_mask(inter_width, zero, _CMP_GT_OQ);
+        mask &= _mm512_cmp_ps_mask(inter_height, zero, _CMP_GT_OQ);
+        mask &= _mm512_cmp_ps_mask(inter_area, _mm512_mul_ps(threshold, union_area), _CMP_GT_OQ);
+        if (class_aware)
+            mask &= _mm512_cmpeq_epi32_mask(label_id, _mm512_loadu_si512(&b.label_id[j]));
+
+        for (unsigned bits = mask; bits; bits &= bits - 1)
+            suppressed[j + __builtin_ctz(bits)] = 1;
+    }
+    suppressScalar(b, i, j, end, iou_threshold, class_aware, suppressed);
+}
+#pragma GCC diagnostic pop
+
+#endif // NMS_X86_KERNELS
+
+SuppressFunction selectSuppressFunction() {
+#ifdef NMS_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return suppressAvx512;
+    if (__builtin_cpu_supports("avx2"))
+        return suppressAvx2;
+#endif
+    return suppressScalar;
+}
+
+SortedBoxes sortByScore(const Boxes &boxes, size_t top_k) {
+    std::vector<size_t> order(boxes.size());
+    std::iota(order.begin(), order.end(), 0);
+    auto by_score = [&](size_t l, size_t r) { return boxes.score[l] > boxes.score[r]; };
+    if (top_k && order.size() > top_k) {
+        std::partial_sort(order.begin(), order.begin() + top_k, order.end(), by_score);
+        order.resize(top_k);
+    } else {
+        std::sort(order.begin(), order.end(), by_score);
+    }
+
+    SortedBoxes sorted;
+    const size_t size = order.size();
+    sorted.x_min.resize(size);
+    sorted.y_min.resize(size);
+    sorted.x_max.resize(size);
+    sorted.y_max.resize(size);
+    sorted.area.resize(size);
+    sorted.label_id.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        const size_t k = order[i];
+        sorted.x_min[i] = boxes.x_min[k];
+        sorted.y_min[i] = boxes.y_min[k];
+        sorted.x_max[i] = boxes.x_max[k];
+        sorted.y_max[i] = boxes.y_max[k];
+        sorted.area[i] = (boxes.x_max[k] - boxes.x_min[k]) * (boxes.y_max[k] - boxes.y_min[k]);
+        sorted.label_id[i] = boxes.label_id[k];
+    }
+    sorted.index = std::move(order);
+    return sorted;
+}
+
+// Every kept box is compared against all remaining boxes with lower score
+std::vector<size_t> runDense(const SortedBoxes &boxes, const Options &options) {
+    static const SuppressFunction suppress = selectSuppressFunction();
+    const bool class_aware = options.method == Method::CLASS_AWARE;
+    const size_t size = boxes.index.size();
+
+    std::vector<size_t> kept;
+    std::vector<uint8_t> suppressed(size, 0);
+    for (size_t i = 0; i < size; i++) {
+        if (suppressed[i])
+            continue;
+        kept.push_back(boxes.index[i]);
+        suppress(boxes, i, i + 1, size, options.iou_threshold, class_aware, suppressed.data());
+    }
+    return kept;
+}
+
+// Boxes are binned into uniform grid, each box is registered in every cell it covers. Intersecting boxes always share
+// at least one cell, so comparing a kept box only with boxes from its cells gives exactly the same result as
+// runDense while skipping far-away candidates.
+std::vector<size_t> runGrid(const SortedBoxes &boxes, const Options &options) {
+    const bool class_aware = options.method == Method::CLASS_AWARE;
+    const size_t size = boxes.index.size();
+
+    const float left = *std::min_element(boxes.x_min.begin(), boxes.x_min.end());
+    const float top = *std::min_element(boxes.y_min.begin(), boxes.y_min.end());
+    const float right = *std::max_element(boxes.x_max.begin(), boxes.x_max.end());
+    const float bottom = *std::max_element(boxes.y_max.begin(), boxes.y_max.end());
+    if (!(right > left) || !(bottom > top))
+        return runDense(boxes, options);
+
+    const size_t grid_size = std::max<size_t>(1, std::sqrt(static_cast<double>(size / GRID_CELL_OCCUPANCY)));
+    const float cell_width = (right - left) / grid_size;
+    const float cell_height = (bottom - top) / grid_size;
+    auto cell_x = [&](float x) {
+        return std::min(grid_size - 1, static_cast<size_t>(std::max(0.f, (x - left) / cell_width)));
+    };
+    auto cell_y = [&](float y) {
+        return std::min(grid_size - 1, static_cast<size_t>(std::max(0.f, (y - top) / cell_height)));
+    };
+    auto for_each_cell = [&](size_t i, auto &&func) {
+        const size_t x_end = cell_x(boxes.x_max[i]), y_end = cell_y(boxes.y_max[i]);
+        for (size_t y = cell_y(boxes.y_min[i]); y <= y_end; y++)
+            for (size_t x = cell_x(boxes.x_min[i]); x <= x_end; x++)
+                func(y * grid_size + x);
+    };
+
+    // Cells in CSR layout, boxes in each cell are ordered by score since they are added in sorted order
+    std::vector<uint32_t> cell_offsets(grid_size * grid_size + 1, 0);
+    for (size_t i = 0; i < size; i++)
+        for_each_cell(i, [&](size_t cell) { cell_offsets[cell + 1]++; });
+    std::partial_sum(cell_offsets.begin(), cell_offsets.end(), cell_offsets.begin());
+    std::vector<uint32_t> cell_boxes(cell_offsets.back());
+    std::vector<uint32_t> cell_fill(cell_offsets.begin(), cell_offsets.end() - 1);
+    for (size_t i = 0; i < size; i++)
+        for_each_cell(i, [&](size_t cell) { cell_boxes[cell_fill[cell]++] = static_cast<uint32_t>(i); });
+
+    std::vector<size_t> kept;
+    std::vector<uint8_t> suppressed(size, 0);
+    for (size_t i = 0; i < size; i++) {
+        if (suppressed[i])
+            continue;
+        kept.push_back(boxes.index[i]);
+        for_each_cell(i, [&](size_t cell) {
+            const auto cell_end = cell_boxes.begin() + cell_offsets[cell + 1];
+            for (auto it = std::upper_bound(cell_boxes.begin() + cell_offsets[cell], cell_end, i); it != cell_end;
+                 ++it) {
+                if (!suppressed[*it] && overlaps(boxes, i, *it, options.iou_threshold, class_aware))
+                    suppressed[*it] = 1;
+            }
+        });
+    }
+    return kept;
+}
+
+} // namespace
+
+Method methodFromString(const std::string &name) {
+    if (name == "greedy")
+        return Method::GREEDY;
+    if (name == "class-aware" || name == "class_aware")
+        return Method::CLASS_AWARE;
+    throw std::invalid_argument("Unknown NMS method '" + name + "', supported methods: greedy, class-aware");
+}
+
+void Boxes::reserve(size_t size) {
+    x_min.reserve(size);
+    y_min.reserve(size);
+    x_max.reserve(size);
+    y_max.reserve(size);
+    score.reserve(size);
+    label_id.reserve(size);
+}
+
+void Boxes::clear() {
+    x_min.clear();
+    y_min.clear();
+    x_max.clear();
+    y_max.clear();
+    score.clear();
+    label_id.clear();
+}
+
+void Boxes::add(float x_min, float y_min, float x_max, float y_max, float score, int32_t label_id) {
+    this->x_min.push_back(x_min);
+    this->y_min.push_back(y_min);
+    this->x_max.push_back(x_max);
+    this->y_max.push_back(y_max);
+    this->score.push_back(score);
+    this->label_id.push_back(label_id);
+}
+
+std::vector<size_t> run(const Boxes &boxes, const Options &options) {
+    if (boxes.size() == 0)
+        return {};
+
+    const SortedBoxes sorted = sortByScore(boxes, options.top_k);
+    if (sorted.index.size() >= GRID_MIN_CANDIDATES)
+        return runGrid(sorted, options);
+    return runDense(sorted, options);
+}
+
+} // namespace nms
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nms {
+
+enum class Method {
+    GREEDY,     // every kept box suppresses overlapping boxes regardless of their class
+    CLASS_AWARE // kept box suppresses overlapping boxes of the same class only (batched NMS)
+};
+
+// Accepts "greedy" and "class-aware" (or "class_aware"), throws std::invalid_argument otherwise
+Method methodFromString(const std::string &name);
+
+struct Options {
+    Method method = Method::GREEDY;
+    float iou_threshold = 0.5f;
+    // Only top_k candidates with the highest scores take part in NMS, 0 means no limit
+    size_t top_k = 0;
+};
+
+// Candidates in structure-of-arrays layout, so IoU of one box against many is computed over contiguous memory
+class Boxes {
+  public:
+    void reserve(size_t size);
+    void clear();
+    void add(float x_min, float y_min, float x_max, float y_max, float score, int32_t label_id = 0);
+
+    size_t size() const {
+        return score.size();
+    }
+
+    std::vector<float> x_min;
+    std::vector<float> y_min;
+    std::vector<float> x_max;
+    std::vector<float> y_max;
+    std::vector<float> score;
+    std::vector<int32_t> label_id;
+};
+
+// Returns indices of boxes kept after suppression, sorted by score in descending order.
+// Box is suppressed if its IoU with a kept box of higher score is greater than iou_threshold.
+std::vector<size_t> run(const Boxes &boxes, const Options &options);
+
+} // namespace nms
@@ -0,0 +1,416 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "sparse_assignment.h"
+
+#include <dlstreamer/base/thread_pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+namespace assignment {
+
+namespace {
+
+// Grid with more cells gives little benefit while its construction time and memory grow
+constexpr size_t MAX_GRID_CELLS = 1 << 16;
+
+// Waking threads costs more than solving a few small components
+constexpr size_t MIN_ENTRIES_PER_THREAD = 4096;
+
+// Center distance bound of gatedCosts() is slightly widened to be robust against rounding
+constexpr float GATE_MARGIN = 1.001f;
+
+dlstreamer::ThreadPool &solverThreadPool() {
+    static dlstreamer::ThreadPool pool;
+    return pool;
+}
+
+// Clamps floating-point cell coordinate into [0, count), NaN goes to 0
+size_t clampCell(double value, size_t count) {
+    if (!(value > 0.0))
+        return 0;
+    if (value >= static_cast<double>(count - 1))
+        return count - 1;
+    return static_cast<size_t>(value);
+}
+
+struct Component {
+    std::vector<uint32_t> rows;
+    std::vector<int32_t> cols; // global indices of real columns, local index is position in this list
+    size_t entries = 0;
+};
+
+class DisjointSets {
+  public:
+    explicit DisjointSets(size_t size) : _parent(size) {
+        std::iota(_parent.begin(), _parent.end(), 0);
+    }
+
+    uint32_t find(uint32_t x) {
+        while (_parent[x] != x) {
+            _parent[x] = _parent[_parent[x]];
+            x = _parent[x];
+        }
+        return x;
+    }
+
+    void unite(uint32_t a, uint32_t b) {
+        a = find(a);
+        b = find(b);
+        if (a != b)
+            _parent[std::max(a, b)] = std::min(a, b);
+    }
+
+  private:
+    std::vector<uint32_t> _parent;
+};
+
+// Shortest augmenting path algorithm (Jonker-Volgenant) on one component. Column k + i is the private "unassigned"
+// column of local row i, so every row always has a feasible assignment. Dual variables keep reduced costs of all
+// edges non-negative, which lets Dijkstra search on sparse adjacency find every augmenting path.
+class ComponentSolver {
+  public:
+    ComponentSolver(const SparseCostMatrix &costs, const std::vector<uint32_t> &col_local, float unassigned_cost)
+        : _costs(costs), _col_local(col_local), _unassigned_cost(unassigned_cost) {
+    }
+
+    void solve(const Component &component, std::vector<int32_t> &result) {
+        const size_t m = component.rows.size();
+        const size_t k = component.cols.size();
+        const size_t n = k + m;
+
+        _v.assign(n, 0.0);
+        _dist.assign(n, 0.0);
+        _pred.assign(n, 0);
+        _pred_cost.assign(n, 0.0);
+        _col_row.assign(n, -1);
+        _state.assign(n, UNSEEN);
+        _row_col.assign(m, -1);
+        _row_cost.assign(m, 0.0);
+
+        for (size_t i = 0; i < m; i++)
+            augment(component, static_cast<uint32_t>(i), k);
+
+        for (size_t i = 0; i < m; i++) {
+            const int32_t j = _row_col[i];
+            result[component.rows[i]] = j < static_cast<int32_t>(k) ? component.cols[j] : -1;
+        }
+    }
+
+  private:
+    enum State : uint8_t { UNSEEN, REACHED, SCANNED };
+
+    using HeapItem = std::pair<double, uint32_t>;
+
+    template <typename F>
+    void forEachEdge(const Component &component, uint32_t local_row, size_t k, F &&f) const {
+        const size_t row = component.rows[local_row];
+        for (size_t e = _costs.rowBegin(row); e < _costs.rowBegin(row + 1); e++) {
+            if (_costs.cost(e) < _unassigned_cost)
+                f(_col_local[_costs.col(e)], static_cast<double>(_costs.cost(e)));
+        }
+        f(static_cast<uint32_t>(k + local_row), static_cast<double>(_unassigned_cost));
+    }
+
+    void relax(uint32_t col, double dist, uint32_t row, double cost) {
+        if (_state[col] == SCANNED || (_state[col] == REACHED && dist >= _dist[col]))
+            return;
+        if (_state[col] == UNSEEN)
+            _touched.push_back(col);
+        _state[col] = REACHED;
+        _dist[col] = dist;
+        _pred[col] = row;
+        _pred_cost[col] = cost;
+        _heap.push({dist, col});
+    }
+
+    void augment(const Component &component, uint32_t start_row, size_t k) {
+        _touched.clear();
+        _scanned.clear();
+        _heap = {};
+
+        forEachEdge(component, start_row, k,
+                    [&](uint32_t col, double cost) { relax(col, cost - _v[col], start_row, cost); });
+
+        uint32_t free_col = 0;
+        double shortest = 0.0;
+        while (true) {
+            // the private column of start_row is always reachable, so heap can not run empty before a free column
+            const HeapItem item = _heap.top();
+            _heap.pop();
+            const uint32_t col = item.second;
+            if (_state[col] == SCANNED || item.first > _dist[col])
+                continue;
+            _state[col] = SCANNED;
+            if (_col_row[col] < 0) {
+                free_col = col;
+                shortest = item.first;
+                break;
+            }
+            _scanned.push_back(col);
+
+            const uint32_t row = static_cast<uint32_t>(_col_row[col]);
+            const double row_dual = _row_cost[row] - _v[col];
+            forEachEdge(component, row, k, [&](uint32_t next, double cost) {
+                relax(next, item.first + cost - _v[next] - row_dual, row, cost);
+            });
+        }
+
+        // dual update keeps reduced costs non-negative and makes edges of the shortest path tight
+        for (uint32_t col : _scanned)
+            _v[col] += _dist[col] - shortest;
+
+        for (uint32_t col = free_col;;) {
+            const uint32_t row = _pred[col];
+            const int32_t previous = _row_col[row];
+            _row_col[row] = static_cast<int32_t>(col);
+            _row_cost[row] = _pred_cost[col];
+            _col_row[col] = static_cast<int32_t>(row);
+            if (row == start_row)
+                break;
+            col = static_cast<uint32_t>(previous);
+        }
+
+        for (uint32_t col : _touched)
+            _state[col] = UNSEEN;
+    }
+
+    const SparseCostMatrix &_costs;
+    const std::vector<uint32_t> &_col_local;
+    const float _unassigned_cost;
+
+    std::vector<double> _v; // column duals
+    std::vector<double> _dist;
+    std::vector<uint32_t> _pred;    // row from which column was reached
+    std::vector<double> _pred_cost; // cost of edge from _pred
+    std::vector<int32_t> _col_row;
+    std::vector<State> _state;
+    std::vector<int32_t> _row_col;
+    std::vector<double> _row_cost; // cost of assigned edge
+    std::vector<uint32_t> _touched;
+    std::vector<uint32_t> _scanned;
+    std::priority_queue<HeapItem, std::vector<HeapItem>, std::greater<HeapItem>> _heap;
+};
+
+} // namespace
+
+SpatialGrid::SpatialGrid(const std::vector<float> &x, const std::vector<float> &y, float cell_size) : _x(x), _y(y) {
+    if (x.size() != y.size())
+        throw std::invalid_argument("SpatialGrid: coordinate arrays have different size");
+    if (x.empty())
+        return;
+
+    _x_min = *std::min_element(x.begin(), x.end());
+    _y_min = *std::min_element(y.begin(), y.end());
+    const float width = *std::max_element(x.begin(), x.end()) - _x_min;
+    const float height = *std::max_element(y.begin(), y.end()) - _y_min;
+
+    _cell_size = std::isfinite(cell_size) && cell_size > 0.f ? cell_size : 1.f;
+    const float min_cell_size = std::sqrt(width * height / MAX_GRID_CELLS);
+    _cell_size = std::max({_cell_size, min_cell_size, width / MAX_GRID_CELLS, height / MAX_GRID_CELLS});
+    _cols = clampCell(width / _cell_size, MAX_GRID_CELLS) + 1;
+    _rows = clampCell(height / _cell_size, MAX_GRID_CELLS) + 1;
+
+    // counting sort of points by cell
+    std::vector<uint32_t> point_cell(x.size());
+    _cell_begin.assign(_cols * _rows + 1, 0);
+    for (size_t i = 0; i < x.size(); i++) {
+        const size_t cx = clampCell((x[i] - _x_min) / _cell_size, _cols);
+        const size_t cy = clampCell((y[i] - _y_min) / _cell_size, _rows);
+        point_cell[i] = static_cast<uint32_t>(cy * _cols + cx);
+        _cell_begin[point_cell[i] + 1]++;
+    }
+    std::partial_sum(_cell_begin.begin(), _cell_begin.end(), _cell_begin.begin());
+    _points.resize(x.size());
+    std::vector<uint32_t> fill(_cell_begin.begin(), _cell_begin.end() - 1);
+    for (size_t i = 0; i < x.size(); i++)
+        _points[fill[point_cell[i]]++] = static_cast<uint32_t>(i);
+}
+
+void SpatialGrid::query(float x, float y, float radius, std::vector<size_t> &indices) const {
+    if (_points.empty() || !(radius >= 0.f))
+        return;
+
+    const size_t first = indices.size();
+    const size_t cx_begin = clampCell((static_cast<double>(x) - radius - _x_min) / _cell_size, _cols);
+    const size_t cx_end = clampCell((static_cast<double>(x) + radius - _x_min) / _cell_size, _cols);
+    const size_t cy_begin = clampCell((static_cast<double>(y) - radius - _y_min) / _cell_size, _rows);
+    const size_t cy_end = clampCell((static_cast<double>(y) + radius - _y_min) / _cell_size, _rows);
+    const double radius2 = static_cast<double>(radius) * radius;
+    for (size_t cy = cy_begin; cy <= cy_end; cy++) {
+        for (size_t cx = cx_begin; cx <= cx_end; cx++) {
+            const size_t cell = cy * _cols + cx;
+            for (size_t p = _cell_begin[cell]; p < _cell_begin[cell + 1]; p++) {
+                const uint32_t i = _points[p];
+                const double dx = static_cast<double>(_x[i]) - x;
+                const double dy = static_cast<double>(_y[i]) - y;
+                if (dx * dx + dy * dy <= radius2)
+                    indices.push_back(i);
+            }
+        }
+    }
+    std::sort(indices.begin() + first, indices.end());
+}
+
+SparseCostMatrix::SparseCostMatrix(size_t cols) {
+    reset(cols);
+}
+
+void SparseCostMatrix::reset(size_t cols) {
+    _cols = cols;
+    _row_begin.assign(1, 0);
+    _col.clear();
+    _cost.clear();
+}
+
+void SparseCostMatrix::add(size_t col, float cost) {
+    if (col >= _cols)
+        throw std::out_of_range("SparseCostMatrix: column index is out of range");
+    _col.push_back(static_cast<uint32_t>(col));
+    _cost.push_back(cost);
+}
+
+void SparseCostMatrix::nextRow() {
+    _row_begin.push_back(_col.size());
+}
+
+SparseCostMatrix gatedCosts(const std::vector<Box> &rows, const std::vector<Box> &cols,
+                            const std::vector<float> &base_cost, const std::vector<float> &center_scale,
+                            float threshold, const PairCost &pair_cost) {
+    if (base_cost.size() != cols.size() || center_scale.size() != cols.size())
+        throw std::invalid_argument("gatedCosts: cost parameters are not given for every column");
+
+    SparseCostMatrix costs(cols.size());
+    if (cols.empty()) {
+        for (size_t r = 0; r < rows.size(); r++)
+            costs.nextRow();
+        return costs;
+    }
+
+    // Smaller half-perimeter is not greater than half-perimeter of row box, so pair cheaper than threshold has centers
+    // within max_gate * half-perimeter of row box
+    std::vector<float> center_x(cols.size()), center_y(cols.size());
+    float max_gate = 0.f;
+    float mean_half_perimeter = 0.f;
+    for (size_t c = 0; c < cols.size(); c++) {
+        const Box &box = cols[c];
+        center_x[c] = box.x + 0.5f * box.width;
+        center_y[c] = box.y + 0.5f * box.height;
+        max_gate = std::max(max_gate, (threshold - base_cost[c]) * center_scale[c]);
+        mean_half_perimeter += 0.5f * (box.width + box.height) / cols.size();
+    }
+    max_gate *= GATE_MARGIN;
+
+    SpatialGrid grid(center_x, center_y, max_gate * mean_half_perimeter);
+    std::vector<size_t> candidates;
+    for (size_t r = 0; r < rows.size(); r++) {
+        const Box &box = rows[r];
+        candidates.clear();
+        grid.query(box.x + 0.5f * box.width, box.y + 0.5f * box.height, max_gate * 0.5f * (box.width + box.height),
+                   candidates);
+        for (size_t c : candidates) {
+            const float cost = pair_cost(r, c);
+            if (cost < threshold)
+                costs.add(c, cost);
+        }
+        costs.nextRow();
+    }
+    return costs;
+}
+
+std::vector<int32_t> solve(const SparseCostMatrix &costs, float unassigned_cost, bool parallel) {
+    const size_t rows = costs.rows();
+    const size_t cols = costs.cols();
+    std::vector<int32_t> result(rows, -1);
+    if (!rows)
+        return result;
+
+    // connected components over rows and columns linked by useful entries
+    DisjointSets sets(rows + cols);
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t e = costs.rowBegin(r); e < costs.rowBegin(r + 1); e++) {
+            if (costs.cost(e) < unassigned_cost)
+                sets.unite(static_cast<uint32_t>(r), static_cast<uint32_t>(rows + costs.col(e)));
+        }
+    }
+
+    std::vector<int32_t> component_of_root(rows + cols, -1);
+    std::vector<Component> components;
+    std::vector<uint32_t> col_local(cols, 0);
+    auto component_of = [&](uint32_t node) -> Component & {
+        const uint32_t root = sets.find(node);
+        if (component_of_root[root] < 0) {
+            component_of_root[root] = static_cast<int32_t>(components.size());
+            components.emplace_back();
+        }
+        return components[component_of_root[root]];
+    };
+    for (size_t r = 0; r < rows; r++) {
+        Component &component = component_of(static_cast<uint32_t>(r));
+        component.rows.push_back(static_cast<uint32_t>(r));
+        component.entries += costs.rowBegin(r + 1) - costs.rowBegin(r) + 1;
+    }
+    for (size_t c = 0; c < cols; c++) {
+        const uint32_t root = sets.find(static_cast<uint32_t>(rows + c));
+        // columns without useful entries are in no component
+        if (component_of_root[root] < 0)
+            continue;
+        Component &component = components[component_of_root[root]];
+        col_local[c] = static_cast<uint32_t>(component.cols.size());
+        component.cols.push_back(static_cast<int32_t>(c));
+    }
+
+    // rows without candidates stay unassigned
+    std::vector<size_t> order;
+    size_t total_entries = 0;
+    for (size_t i = 0; i < components.size(); i++) {
+        if (!components[i].cols.empty()) {
+            order.push_back(i);
+            total_entries += components[i].entries;
+        }
+    }
+    // largest components first, so threads finish at about the same time
+    std::sort(order.begin(), order.end(),
+              [&](size_t a, size_t b) { return components[a].entries > components[b].entries; });
+
+    auto run = [&](std::atomic<size_t> &next) {
+        ComponentSolver solver(costs, col_local, unassigned_cost);
+        for (size_t i = next++; i < order.size(); i = next++)
+            solver.solve(components[order[i]], result);
+    };
+
+    std::atomic<size_t> next{0};
+    const size_t threads = parallel ? std::min({solverThreadPool().num_workers() + 1, order.size(),
+                                                total_entries / MIN_ENTRIES_PER_THREAD + 1})
+                                    : 1;
+    if (threads <= 1)
+        run(next);
+    else
+        solverThreadPool().parallel_for(threads, [&](size_t) { run(next); });
+    return result;
+}
+
+std::pair<std::vector<bool>, std::vector<int32_t>> toAssociation(const std::vector<int32_t> &row_cols, size_t cols) {
+    std::vector<bool> row_is_assigned(row_cols.size(), false);
+    std::vector<int32_t> col_row(cols, -1);
+    for (size_t r = 0; r < row_cols.size(); r++) {
+        const int32_t c = row_cols[r];
+        if (c >= 0) {
+            row_is_assigned[r] = true;
+            col_row[c] = static_cast<int32_t>(r);
+        }
+    }
+    return std::make_pair(row_is_assigned, col_row);
+}
+
+} // namespace assignment
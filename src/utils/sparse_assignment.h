@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Assignment of rows (e.g. detections) to columns (e.g. tracks) when only a small fraction of pairs may be assigned.
+// Candidate pairs are found with SpatialGrid, their costs are kept in SparseCostMatrix and solve() runs Jonker-Volgenant
+// shortest augmenting path algorithm on every connected component of candidate pairs independently.
+namespace assignment {
+
+// Axis-aligned box given by top-left corner and size
+struct Box {
+    float x = 0.f;
+    float y = 0.f;
+    float width = 0.f;
+    float height = 0.f;
+};
+
+// Uniform grid over 2D points, answers which points lie within given distance of a query point
+class SpatialGrid {
+  public:
+    // cell_size should be close to typical query radius, too small cells are enlarged to keep grid size bounded
+    SpatialGrid(const std::vector<float> &x, const std::vector<float> &y, float cell_size);
+
+    // Appends indices of points with distance to (x, y) not greater than radius, in ascending order
+    void query(float x, float y, float radius, std::vector<size_t> &indices) const;
+
+  private:
+    std::vector<float> _x;
+    std::vector<float> _y;
+    float _x_min = 0.f;
+    float _y_min = 0.f;
+    float _cell_size = 1.f;
+    size_t _cols = 0;
+    size_t _rows = 0;
+    std::vector<uint32_t> _cell_begin; // points of cell c are _points[_cell_begin[c], _cell_begin[c + 1])
+    std::vector<uint32_t> _points;
+};
+
+// Costs of candidate pairs in compressed row storage. Rows are filled one after another: add() entries of the current
+// row, then nextRow().
+class SparseCostMatrix {
+  public:
+    explicit SparseCostMatrix(size_t cols = 0);
+
+    void reset(size_t cols);
+    void add(size_t col, float cost);
+    void nextRow();
+
+    size_t rows() const {
+        return _row_begin.size() - 1;
+    }
+    size_t cols() const {
+        return _cols;
+    }
+
+    // entries of row r are [rowBegin(r), rowBegin(r + 1))
+    size_t rowBegin(size_t row) const {
+        return _row_begin[row];
+    }
+    uint32_t col(size_t entry) const {
+        return _col[entry];
+    }
+    float cost(size_t entry) const {
+        return _cost[entry];
+    }
+
+  private:
+    size_t _cols = 0;
+    std::vector<size_t> _row_begin;
+    std::vector<uint32_t> _col;
+    std::vector<float> _cost;
+};
+
+// Cost of (row, col) pair, may be not less than threshold if the pair is not to be associated
+using PairCost = std::function<float(size_t row, size_t col)>;
+
+// Costs of pairs of row and column boxes cheaper than threshold. Cost of every pair must be not less than
+//   base_cost[col] + center distance / (smaller half-perimeter of the two boxes * center_scale[col]),
+// then pairs with centers too far from each other to be cheaper than threshold are skipped without calling pair_cost.
+// Only pairs near row box are looked up in SpatialGrid of column box centers.
+SparseCostMatrix gatedCosts(const std::vector<Box> &rows, const std::vector<Box> &cols,
+                            const std::vector<float> &base_cost, const std::vector<float> &center_scale,
+                            float threshold, const PairCost &pair_cost);
+
+// Finds assignment of rows to columns with minimal total cost, where every row is either assigned to a column of its
+// entries or stays unassigned at unassigned_cost, and every column is assigned to at most one row. Entries with cost
+// not less than unassigned_cost never improve the solution and are ignored.
+// Returns column of every row, -1 for unassigned rows. If parallel is set, large sets of independent components are
+// solved on a thread pool shared by all callers.
+std::vector<int32_t> solve(const SparseCostMatrix &costs, float unassigned_cost, bool parallel = false);
+
+// Converts result of solve() to flags of assigned rows and row of every column (-1 for unassigned columns)
+std::pair<std::vector<bool>, std::vector<int32_t>> toAssociation(const std::vector<int32_t> &row_cols, size_t cols);
+
+} // namespace assignment
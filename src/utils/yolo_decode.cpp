@@ -0,0 +1,284 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "yolo_decode.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YOLO_X86_KERNELS
+#endif
+
+namespace yolo {
+
+namespace {
+
+// Absolute margin in logit space covering rounding of sigmoid implementations in float
+constexpr float LOGIT_MARGIN = 1e-3f;
+
+#ifdef __GNUC__
+
+// Kernels are written once with GCC vector extensions and instantiated for every vector width. Wrappers below compile
+// each instantiation for matching instruction set, so the same source gives SSE, AVX2 and AVX-512 code.
+template <size_t W>
+struct Vec {
+    typedef float F __attribute__((vector_size(W * sizeof(float))));
+    typedef int32_t I __attribute__((vector_size(W * sizeof(int32_t))));
+};
+
+#define YOLO_KERNEL __attribute__((always_inline)) inline
+
+// Unaligned load. Vector is returned via reference, since returning it by value triggers ABI warning for
+// instantiations wider than baseline instruction set allows.
+template <typename V>
+YOLO_KERNEL void load(V &value, const float *ptr) {
+    std::memcpy(&value, ptr, sizeof(value));
+}
+
+template <size_t W>
+YOLO_KERNEL void classMaxPlanarKernel(const float *class_planes, size_t classes_number, size_t plane_stride,
+                                      size_t size, float threshold, std::vector<Proposal> &proposals) {
+    using F = typename Vec<W>::F;
+    using I = typename Vec<W>::I;
+
+    size_t i = 0;
+    for (; i + W <= size; i += W) {
+        F best;
+        load(best, class_planes + i);
+        I best_id = {};
+        for (size_t c = 1; c < classes_number; c++) {
+            F value;
+            load(value, class_planes + c * plane_stride + i);
+            const I greater = value > best;
+            best = (F)(((I)value & greater) | ((I)best & ~greater));
+            best_id = ((I{} + static_cast<int32_t>(c)) & greater) | (best_id & ~greater);
+        }
+        const I passed = best > (F{} + threshold);
+        for (size_t k = 0; k < W; k++) {
+            if (passed[k])
+                proposals.push_back({i + k, static_cast<size_t>(best_id[k]), best[k]});
+        }
+    }
+
+    for (; i < size; i++) {
+        float best = class_planes[i];
+        size_t best_id = 0;
+        for (size_t c = 1; c < classes_number; c++) {
+            const float value = class_planes[c * plane_stride + i];
+            if (value > best) {
+                best = value;
+                best_id = c;
+            }
+        }
+        if (best > threshold)
+            proposals.push_back({i, best_id, best});
+    }
+}
+
+template <size_t W>
+YOLO_KERNEL void selectAtLeastKernel(const float *plane, size_t size, float threshold, std::vector<size_t> &indices) {
+    using F = typename Vec<W>::F;
+    using I = typename Vec<W>::I;
+
+    size_t i = 0;
+    for (; i + W <= size; i += W) {
+        F value;
+        load(value, plane + i);
+        const I passed = value >= (F{} + threshold);
+        // most of blocks are rejected entirely
+        int32_t any = 0;
+        for (size_t k = 0; k < W; k++)
+            any |= passed[k];
+        if (!any)
+            continue;
+        for (size_t k = 0; k < W; k++) {
+            if (passed[k])
+                indices.push_back(i + k);
+        }
+    }
+    for (; i < size; i++) {
+        if (plane[i] >= threshold)
+            indices.push_back(i);
+    }
+}
+
+template <size_t W>
+YOLO_KERNEL Proposal argMaxKernel(const float *scores, size_t size) {
+    using F = typename Vec<W>::F;
+    using I = typename Vec<W>::I;
+
+    size_t i = 0;
+    float best = scores[0];
+    if (size >= W) {
+        F best_vec;
+        load(best_vec, scores);
+        for (i = W; i + W <= size; i += W) {
+            F value;
+            load(value, scores + i);
+            const I greater = value > best_vec;
+            best_vec = (F)(((I)value & greater) | ((I)best_vec & ~greater));
+        }
+        for (size_t k = 0; k < W; k++)
+            best = std::max(best, best_vec[k]);
+    }
+    for (; i < size; i++)
+        best = std::max(best, scores[i]);
+
+    size_t best_id = 0;
+    while (best_id + 1 < size && scores[best_id] != best)
+        best_id++;
+    return {0, best_id, scores[best_id]};
+}
+
+#ifdef YOLO_X86_KERNELS
+
+__attribute__((target("avx512f"))) void classMaxPlanarAvx512(const float *class_planes, size_t classes_number,
+                                                             size_t plane_stride, size_t size, float threshold,
+                                                             std::vector<Proposal> &proposals) {
+    classMaxPlanarKernel<16>(class_planes, classes_number, plane_stride, size, threshold, proposals);
+}
+
+__attribute__((target("avx2"))) void classMaxPlanarAvx2(const float *class_planes, size_t classes_number,
+                                                        size_t plane_stride, size_t size, float threshold,
+                                                        std::vector<Proposal> &proposals) {
+    classMaxPlanarKernel<8>(class_planes, classes_number, plane_stride, size, threshold, proposals);
+}
+
+__attribute__((target("avx512f"))) void selectAtLeastAvx512(const float *plane, size_t size, float threshold,
+                                                            std::vector<size_t> &indices) {
+    selectAtLeastKernel<16>(plane, size, threshold, indices);
+}
+
+__attribute__((target("avx2"))) void selectAtLeastAvx2(const float *plane, size_t size, float threshold,
+                                                       std::vector<size_t> &indices) {
+    selectAtLeastKernel<8>(plane, size, threshold, indices);
+}
+
+// Rows of 80 classes are too short for 512-bit vectors to pay off
+__attribute__((target("avx2"))) Proposal argMaxAvx2(const float *scores, size_t size) {
+    return argMaxKernel<8>(scores, size);
+}
+
+#endif // YOLO_X86_KERNELS
+
+// 128-bit vectors are available on every supported platform (SSE2, NEON)
+void classMaxPlanarDefault(const float *class_planes, size_t classes_number, size_t plane_stride, size_t size,
+                           float threshold, std::vector<Proposal> &proposals) {
+    classMaxPlanarKernel<4>(class_planes, classes_number, plane_stride, size, threshold, proposals);
+}
+
+void selectAtLeastDefault(const float *plane, size_t size, float threshold, std::vector<size_t> &indices) {
+    selectAtLeastKernel<4>(plane, size, threshold, indices);
+}
+
+Proposal argMaxDefault(const float *scores, size_t size) {
+    return argMaxKernel<4>(scores, size);
+}
+
+#else // __GNUC__
+
+void classMaxPlanarDefault(const float *class_planes, size_t classes_number, size_t plane_stride, size_t size,
+                           float threshold, std::vector<Proposal> &proposals) {
+    for (size_t i = 0; i < size; i++) {
+        float best = class_planes[i];
+        size_t best_id = 0;
+        for (size_t c = 1; c < classes_number; c++) {
+            const float value = class_planes[c * plane_stride + i];
+            if (value > best) {
+                best = value;
+                best_id = c;
+            }
+        }
+        if (best > threshold)
+            proposals.push_back({i, best_id, best});
+    }
+}
+
+void selectAtLeastDefault(const float *plane, size_t size, float threshold, std::vector<size_t> &indices) {
+    for (size_t i = 0; i < size; i++) {
+        if (plane[i] >= threshold)
+            indices.push_back(i);
+    }
+}
+
+Proposal argMaxDefault(const float *scores, size_t size) {
+    size_t best_id = 0;
+    for (size_t i = 1; i < size; i++) {
+        if (scores[i] > scores[best_id])
+            best_id = i;
+    }
+    return {0, best_id, scores[best_id]};
+}
+
+#endif // __GNUC__
+
+struct Kernels {
+    decltype(&classMaxPlanarDefault) class_max_planar = classMaxPlanarDefault;
+    decltype(&selectAtLeastDefault) select_at_least = selectAtLeastDefault;
+    decltype(&argMaxDefault) arg_max = argMaxDefault;
+
+    Kernels() {
+#ifdef YOLO_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            class_max_planar = classMaxPlanarAvx2;
+            select_at_least = selectAtLeastAvx2;
+            arg_max = argMaxAvx2;
+        }
+        if (__builtin_cpu_supports("avx512f")) {
+            class_max_planar = classMaxPlanarAvx512;
+            select_at_least = selectAtLeastAvx512;
+        }
+#endif
+    }
+};
+
+const Kernels &kernels() {
+    static const Kernels instance;
+    return instance;
+}
+
+// Largest float not greater than 'threshold': for any float x, x > bound if and only if double(x) > threshold
+float greaterThanBound(double threshold) {
+    float bound = static_cast<float>(threshold);
+    if (static_cast<double>(bound) > threshold)
+        bound = std::nextafter(bound, -std::numeric_limits<float>::infinity());
+    return bound;
+}
+
+} // namespace
+
+void classMaxPlanar(const float *class_planes, size_t classes_number, size_t plane_stride, size_t size,
+                    double threshold, std::vector<Proposal> &proposals) {
+    if (!classes_number)
+        return;
+    kernels().class_max_planar(class_planes, classes_number, plane_stride, size, greaterThanBound(threshold),
+                               proposals);
+}
+
+void selectAtLeast(const float *plane, size_t size, float threshold, std::vector<size_t> &indices) {
+    kernels().select_at_least(plane, size, threshold, indices);
+}
+
+Proposal argMax(const float *scores, size_t size) {
+    if (!size)
+        return {0, 0, 0.f};
+    return kernels().arg_max(scores, size);
+}
+
+float rawThreshold(double threshold, bool sigmoid_activation) {
+    if (!sigmoid_activation)
+        return std::nextafter(static_cast<float>(threshold), -std::numeric_limits<float>::infinity());
+    if (!(threshold > 0.0 && threshold < 1.0))
+        return -std::numeric_limits<float>::infinity();
+    return static_cast<float>(std::log(threshold / (1.0 - threshold))) - LOGIT_MARGIN;
+}
+
+} // namespace yolo
@@ -0,0 +1,42 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Building blocks for decoding of YOLO output tensors. The expensive part of decoding is scanning of class scores and
+// objectness of every proposal while only a handful of them pass confidence threshold, so these functions find
+// survivors with vectorized code and leave box decoding of survivors to the caller.
+namespace yolo {
+
+struct Proposal {
+    size_t index;    // position of proposal in tensor
+    size_t class_id; // class with maximal score, first one if several classes have equal scores
+    float score;     // score of class_id
+};
+
+// Planar layout stores every channel as contiguous plane, e.g. YOLOv8 output [4 + classes, proposals]: score of class c
+// for proposal i is class_planes[c * plane_stride + i]. Computes class with maximal score for proposals [0, size) and
+// appends proposals with maximal score greater than threshold, in ascending order of index. Scores are selected
+// exactly as if they were compared with threshold in double precision.
+void classMaxPlanar(const float *class_planes, size_t classes_number, size_t plane_stride, size_t size,
+                    double threshold, std::vector<Proposal> &proposals);
+
+// Appends indices i in [0, size) with plane[i] >= threshold, in ascending order
+void selectAtLeast(const float *plane, size_t size, float threshold, std::vector<size_t> &indices);
+
+// Finds maximum of contiguous array, e.g. class scores of one row in YOLOv7/YOLOX [proposals, 5 + classes] output.
+// Returns Proposal with index 0.
+Proposal argMax(const float *scores, size_t size);
+
+// Returns lower bound of raw (before sigmoid, if sigmoid_activation is set) value which may pass probability
+// threshold, so that objectness can be compared before activation is computed. Values passing this check must be
+// compared with threshold once again after activation.
+float rawThreshold(double threshold, bool sigmoid_activation);
+
+} // namespace yolo
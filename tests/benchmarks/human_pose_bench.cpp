@@ -0,0 +1,205 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// OpenPose post-processing shared by tensor_postproc_human_pose and gvainference (src/utils/human_pose): peak search
+// and grouping of peaks to poses on upsampled heat maps and PAFs, milliseconds per frame against number of streams
+// decoding frames concurrently on the shared thread pool.
+// Heat maps and PAFs are either synthetic (people with random keypoints) or recorded: raw float32 file with 19 heat
+// maps followed by 38 PAFs of 'width' x 'height' each, as passed to FindAllPeaks after upsampling.
+//
+// Usage: bench_human_pose [iterations] [max_streams] [people] [recorded.bin width height]
+
+#include "peak.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// human-pose-estimation-0001 output 57x32 upsampled 4 times, as tensor_postproc_human_pose does
+constexpr int MAP_WIDTH = 228;
+constexpr int MAP_HEIGHT = 128;
+constexpr size_t KEYPOINTS_NUMBER = 18;
+constexpr size_t HEAT_MAPS_NUMBER = 19;
+constexpr size_t PAFS_NUMBER = 38;
+
+// Parameters of tensor_postproc_human_pose
+constexpr float MIN_PEAKS_DISTANCE = 3.0f;
+constexpr float MID_POINTS_SCORE_THRESHOLD = 0.05f;
+constexpr float FOUND_MID_POINTS_RATIO_THRESHOLD = 0.8f;
+constexpr int MIN_JOINTS_NUMBER = 3;
+constexpr float MIN_SUBSET_SCORE = 0.2f;
+
+// Same limbs as GroupPeaksToPoses
+const std::pair<int, int> LIMB_IDS_HEATMAP[] = {{1, 2}, {1, 5},  {2, 3},   {3, 4},  {5, 6},   {6, 7},
+                                                {1, 8}, {8, 9},  {9, 10},  {1, 11}, {11, 12}, {12, 13},
+                                                {1, 0}, {0, 14}, {14, 16}, {0, 15}, {15, 17}};
+const std::pair<int, int> LIMB_IDS_PAF[] = {{12, 13}, {20, 21}, {14, 15}, {16, 17}, {22, 23}, {24, 25},
+                                            {0, 1},   {2, 3},   {4, 5},   {6, 7},   {8, 9},   {10, 11},
+                                            {28, 29}, {30, 31}, {34, 35}, {32, 33}, {36, 37}};
+
+struct Maps {
+    std::vector<cv::Mat> heat_maps;
+    std::vector<cv::Mat> pafs;
+};
+
+Maps emptyMaps(int width, int height) {
+    Maps maps;
+    for (size_t i = 0; i < HEAT_MAPS_NUMBER; i++)
+        maps.heat_maps.emplace_back(height, width, CV_32F, cv::Scalar(0));
+    for (size_t i = 0; i < PAFS_NUMBER; i++)
+        maps.pafs.emplace_back(height, width, CV_32F, cv::Scalar(0));
+    return maps;
+}
+
+void drawKeypoint(cv::Mat &heat_map, const cv::Point2f &center) {
+    const float sigma = 2.0f;
+    const int radius = 3 * static_cast<int>(sigma);
+    const int x_begin = std::max(0, cvRound(center.x) - radius);
+    const int x_end = std::min(heat_map.cols - 1, cvRound(center.x) + radius);
+    const int y_begin = std::max(0, cvRound(center.y) - radius);
+    const int y_end = std::min(heat_map.rows - 1, cvRound(center.y) + radius);
+    for (int y = y_begin; y <= y_end; y++) {
+        float *row = heat_map.ptr<float>(y);
+        for (int x = x_begin; x <= x_end; x++) {
+            const float dx = x - center.x;
+            const float dy = y - center.y;
+            row[x] = std::max(row[x], std::exp(-(dx * dx + dy * dy) / (2 * sigma * sigma)));
+        }
+    }
+}
+
+// Unit vector of the limb direction in a two pixels wide band along the limb
+void drawLimb(cv::Mat &paf_x, cv::Mat &paf_y, const cv::Point2f &a, const cv::Point2f &b) {
+    const cv::Point2f vec = b - a;
+    const float length = std::sqrt(vec.dot(vec));
+    if (length < 1.0f)
+        return;
+    const cv::Point2f unit = vec / length;
+    for (float t = 0; t <= length; t += 0.5f) {
+        const cv::Point2f point = a + unit * t;
+        for (int dy = -2; dy <= 2; dy++) {
+            for (int dx = -2; dx <= 2; dx++) {
+                const int x = cvRound(point.x) + dx;
+                const int y = cvRound(point.y) + dy;
+                if (x < 0 || y < 0 || x >= paf_x.cols || y >= paf_x.rows)
+                    continue;
+                paf_x.ptr<float>(y)[x] = unit.x;
+                paf_y.ptr<float>(y)[x] = unit.y;
+            }
+        }
+    }
+}
+
+Maps syntheticMaps(int people, std::mt19937 &rng) {
+    Maps maps = emptyMaps(MAP_WIDTH, MAP_HEIGHT);
+    std::uniform_real_distribution<float> center_x(20.f, MAP_WIDTH - 20.f);
+    std::uniform_real_distribution<float> center_y(20.f, MAP_HEIGHT - 20.f);
+    std::uniform_real_distribution<float> offset(-15.f, 15.f);
+    for (int p = 0; p < people; p++) {
+        const cv::Point2f center(center_x(rng), center_y(rng));
+        std::vector<cv::Point2f> keypoints(KEYPOINTS_NUMBER);
+        for (size_t k = 0; k < KEYPOINTS_NUMBER; k++) {
+            keypoints[k] = center + cv::Point2f(offset(rng), offset(rng));
+            drawKeypoint(maps.heat_maps[k], keypoints[k]);
+        }
+        for (size_t l = 0; l < std::size(LIMB_IDS_HEATMAP); l++) {
+            drawLimb(maps.pafs[LIMB_IDS_PAF[l].first], maps.pafs[LIMB_IDS_PAF[l].second],
+                     keypoints[LIMB_IDS_HEATMAP[l].first], keypoints[LIMB_IDS_HEATMAP[l].second]);
+        }
+    }
+    return maps;
+}
+
+bool recordedMaps(const char *path, int width, int height, Maps &maps) {
+    std::ifstream file(path, std::ios::binary);
+    maps = emptyMaps(width, height);
+    for (auto *mats : {&maps.heat_maps, &maps.pafs}) {
+        for (cv::Mat &mat : *mats) {
+            for (int y = 0; y < height; y++)
+                file.read(reinterpret_cast<char *>(mat.ptr<float>(y)), width * sizeof(float));
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+// Same steps as tensor_postproc_human_pose after upsampling
+HumanPoses decode(const Maps &maps) {
+    std::vector<std::vector<Peak>> peaks_from_heat_map(maps.heat_maps.size());
+    FindAllPeaks(maps.heat_maps, MIN_PEAKS_DISTANCE, peaks_from_heat_map);
+    int peaks_before = 0;
+    for (size_t heatmap_id = 1; heatmap_id < maps.heat_maps.size(); heatmap_id++) {
+        peaks_before += static_cast<int>(peaks_from_heat_map[heatmap_id - 1].size());
+        for (auto &peak : peaks_from_heat_map[heatmap_id])
+            peak.id += peaks_before;
+    }
+    return GroupPeaksToPoses(peaks_from_heat_map, maps.pafs, KEYPOINTS_NUMBER, MID_POINTS_SCORE_THRESHOLD,
+                             FOUND_MID_POINTS_RATIO_THRESHOLD, MIN_JOINTS_NUMBER, MIN_SUBSET_SCORE);
+}
+
+// Every stream decodes 'iterations' frames, returns milliseconds per frame as seen by one stream
+double msPerFrame(const Maps &maps, unsigned streams, int iterations) {
+    std::atomic<size_t> poses{0};
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned s = 0; s < streams; s++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < iterations; i++)
+                poses += decode(maps).size();
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    if (!poses)
+        std::printf("no poses found\n");
+    return elapsed.count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 100;
+    const unsigned max_streams = argc > 2 ? std::atoi(argv[2]) : std::max(4u, std::thread::hardware_concurrency());
+    const int people = argc > 3 ? std::atoi(argv[3]) : 20;
+    if (iterations <= 0 || !max_streams || people <= 0 || (argc > 4 && argc != 7)) {
+        std::fprintf(stderr, "Usage: %s [iterations] [max_streams] [people] [recorded.bin width height]\n", argv[0]);
+        return 1;
+    }
+
+    Maps maps;
+    if (argc > 4) {
+        if (!recordedMaps(argv[4], std::atoi(argv[5]), std::atoi(argv[6]), maps)) {
+            std::fprintf(stderr, "Can't read %zu maps of %sx%s floats from %s\n", HEAT_MAPS_NUMBER + PAFS_NUMBER,
+                         argv[5], argv[6], argv[4]);
+            return 1;
+        }
+        std::printf("recorded maps %s: %zu poses\n", argv[4], decode(maps).size());
+    } else {
+        std::mt19937 rng(42);
+        maps = syntheticMaps(people, rng);
+        std::printf("synthetic maps %dx%d with %d people: %zu poses\n", MAP_WIDTH, MAP_HEIGHT, people,
+                    decode(maps).size());
+    }
+
+    std::printf("hardware threads=%u\n", std::thread::hardware_concurrency());
+    std::printf("%8s %14s %14s\n", "streams", "ms per frame", "frames/s");
+    for (unsigned streams = 1; streams <= max_streams; streams *= 2) {
+        const double ms = msPerFrame(maps, streams, iterations);
+        std::printf("%8u %14.3f %14.1f\n", streams, ms, streams * 1000.0 / ms);
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Overhead of latency_tracer percentile histograms:
+// - nanoseconds per record on streaming threads against number of threads, compared with the mutex-protected
+//   avg/min/max update latency_tracer does for every frame anyway,
+// - microseconds per dump of one histogram (snapshot and four percentiles), paid by the dumper thread every interval.
+//
+// Usage: bench_latency_histogram [max_threads] [records_per_thread]
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Same update as ElementStats::cal_log_element_latency without logging
+struct LockedStats {
+    std::mutex mtx;
+    double total = 0;
+    double min = 1e9;
+    double max = 0;
+    uint64_t count = 0;
+
+    void record(uint64_t us) {
+        std::lock_guard<std::mutex> guard(mtx);
+        const double ms = us / 1000.0;
+        total += ms;
+        min = std::min(min, ms);
+        max = std::max(max, ms);
+        count++;
+    }
+};
+
+// Latencies of a few milliseconds with a long tail
+std::vector<uint64_t> makeLatencies(size_t size) {
+    std::mt19937 rng(42);
+    std::lognormal_distribution<double> latency(8.0, 0.7);
+    std::vector<uint64_t> values(size);
+    for (uint64_t &value : values)
+        value = static_cast<uint64_t>(latency(rng));
+    return values;
+}
+
+template <typename Recorder>
+double nsPerRecord(Recorder &recorder, unsigned threads, const std::vector<uint64_t> &latencies) {
+    std::atomic<unsigned> ready{0};
+    std::vector<std::thread> workers;
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&] {
+            ready.fetch_add(1);
+            while (ready.load() < threads)
+                std::this_thread::yield();
+            for (uint64_t us : latencies)
+                recorder.record(us);
+        });
+    }
+    for (auto &worker : workers)
+        worker.join();
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    // every thread records all values, time per record as seen by one streaming thread
+    return elapsed.count() / latencies.size();
+}
+
+double usPerDump(const LatencyHistogram &histogram, int iterations) {
+    double checksum = 0;
+    LatencyHistogram::Snapshot last;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+        const LatencyHistogram::Snapshot interval = snapshot.since(last);
+        for (double p : {50.0, 95.0, 99.0, 99.9})
+            checksum += interval.percentile_ms(p);
+        last = std::move(snapshot);
+    }
+    const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    if (checksum < 0)
+        std::printf("unexpected checksum\n");
+    return elapsed.count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const unsigned max_threads = argc > 1 ? std::atoi(argv[1]) : std::max(4u, std::thread::hardware_concurrency());
+    const int records = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    if (!max_threads || records <= 0) {
+        std::fprintf(stderr, "Usage: %s [max_threads] [records_per_thread]\n", argv[0]);
+        return 1;
+    }
+
+    const std::vector<uint64_t> latencies = makeLatencies(records);
+    std::printf("hardware threads=%u records per thread=%d\n", std::thread::hardware_concurrency(), records);
+    std::printf("%8s %18s %18s\n", "threads", "histogram ns/rec", "avg/min/max ns/rec");
+    LatencyHistogram histogram;
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        LatencyHistogram thread_histogram;
+        LockedStats stats;
+        const double histogram_ns = nsPerRecord(thread_histogram, threads, latencies);
+        const double locked_ns = nsPerRecord(stats, threads, latencies);
+        std::printf("%8u %18.1f %18.1f\n", threads, histogram_ns, locked_ns);
+        if (threads == 1)
+            nsPerRecord(histogram, 1, latencies);
+    }
+
+    const LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+    std::printf("p50=%.3f ms p99=%.3f ms p99.9=%.3f ms\n", snapshot.percentile_ms(50), snapshot.percentile_ms(99),
+                snapshot.percentile_ms(99.9));
+    std::printf("dump of one histogram: %.2f us\n", usPerDump(histogram, 1000));
+    return 0;
+}
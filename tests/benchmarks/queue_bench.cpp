@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Queues of base/blocking_queue.h and base/lock_free_queue.h:
+// - throughput in millions of elements per second against number of producer and consumer threads, consumers take
+//   elements one by one with blocking pop() and in batches with pop_batch(),
+// - wake-up latency, time from push() to return of pop() in a consumer sleeping on empty queue.
+//
+// Usage: bench_queue [max_threads] [elements_per_run] [wake_ups]
+
+#include <dlstreamer/base/blocking_queue.h>
+#include <dlstreamer/base/lock_free_queue.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace dlstreamer;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+constexpr size_t CAPACITY = 1024;
+constexpr size_t BATCH_SIZE = 32;
+
+// Elements are non-zero, blocking pop() returns zero when queue is closed and empty
+template <typename Queue>
+void consume(Queue &queue, bool batch) {
+    if (!batch) {
+        while (queue.pop())
+            ;
+        return;
+    }
+    for (;;) {
+        const std::vector<uint64_t> elements =
+            queue.pop_batch(BATCH_SIZE, clock_type::now() + std::chrono::milliseconds(1));
+        if (elements.empty() && queue.closed() && queue.empty())
+            return;
+    }
+}
+
+template <typename Queue>
+double throughput(unsigned producers, unsigned consumers, uint64_t elements, bool batch) {
+    Queue queue(CAPACITY);
+    std::vector<std::thread> consumer_threads, producer_threads;
+    const auto start = clock_type::now();
+    for (unsigned c = 0; c < consumers; c++)
+        consumer_threads.emplace_back([&] { consume(queue, batch); });
+    for (unsigned p = 0; p < producers; p++) {
+        producer_threads.emplace_back([&, p] {
+            for (uint64_t i = 1 + p; i <= elements; i += producers)
+                queue.push(i);
+        });
+    }
+    for (auto &thread : producer_threads)
+        thread.join();
+    queue.close();
+    for (auto &thread : consumer_threads)
+        thread.join();
+    const std::chrono::duration<double, std::micro> elapsed = clock_type::now() - start;
+    return elements / elapsed.count();
+}
+
+struct Latency {
+    double median_us;
+    double p99_us;
+};
+
+// Producer pushes its timestamp after consumer went to sleep in pop()
+template <typename Queue>
+Latency wakeUpLatency(int wake_ups) {
+    Queue queue(CAPACITY);
+    std::vector<double> latencies;
+    std::thread consumer([&] {
+        while (uint64_t pushed = queue.pop()) {
+            const auto popped = clock_type::now().time_since_epoch();
+            latencies.push_back(std::chrono::duration<double, std::micro>(popped).count() - pushed / 1000.0);
+        }
+    });
+    for (int i = 0; i < wake_ups; i++) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        const auto now = clock_type::now().time_since_epoch();
+        queue.push(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()));
+    }
+    queue.close();
+    consumer.join();
+    std::sort(latencies.begin(), latencies.end());
+    return {latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100]};
+}
+
+template <typename Queue>
+void run(const char *name, unsigned max_threads, uint64_t elements, int wake_ups) {
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        std::printf("%-18s %4ux%-4u %12.2f %12.2f\n", name, threads, threads,
+                    throughput<Queue>(threads, threads, elements, false),
+                    throughput<Queue>(threads, threads, elements, true));
+    }
+    const Latency latency = wakeUpLatency<Queue>(wake_ups);
+    std::printf("%-18s wake-up latency median=%.1f us p99=%.1f us\n", name, latency.median_us, latency.p99_us);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const unsigned max_threads = argc > 1 ? std::atoi(argv[1]) : std::max(4u, std::thread::hardware_concurrency());
+    const long long elements = argc > 2 ? std::atoll(argv[2]) : 2000000;
+    const int wake_ups = argc > 3 ? std::atoi(argv[3]) : 2000;
+    if (!max_threads || elements <= 0 || wake_ups <= 0) {
+        std::fprintf(stderr, "Usage: %s [max_threads] [elements_per_run] [wake_ups]\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("hardware threads=%u elements per run=%lld capacity=%zu\n", std::thread::hardware_concurrency(),
+                elements, CAPACITY);
+    std::printf("%-18s %9s %12s %12s\n", "queue", "prod/cons", "pop Mel/s", "batch Mel/s");
+    run<BlockingQueue<uint64_t>>("BlockingQueue", max_threads, elements, wake_ups);
+    // single producer and single consumer only
+    run<SpscQueue<uint64_t>>("SpscQueue", 1, elements, wake_ups);
+    run<MpmcQueue<uint64_t>>("MpmcQueue", max_threads, elements, wake_ups);
+    return 0;
+}
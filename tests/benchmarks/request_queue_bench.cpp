@@ -0,0 +1,175 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Contention micro-benchmark of the request submission path of OpenVINO backends: requests/second against number of
+// submitter threads. Compares mutex-protected batch filling over a mutex-and-deque free queue (the former SafeQueue)
+// with BatchFillState::Acquire over MpmcQueue, the code OpenVINOImageInference::AcquireBatchSlot runs. Inference
+// completes immediately, so the numbers are the cost of slot claiming and free-request hand-off only.
+//
+// Usage: bench_request_queue [max_threads] [batch_size] [nireq] [milliseconds_per_run]
+
+#include "batch_fill_state.h"
+
+#include <dlstreamer/base/lock_free_queue.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Request {
+    uint32_t index = 0;
+    std::atomic<size_t> filled{0};
+    std::atomic<int64_t> deadline{0};
+};
+
+// Free requests are held by shared_ptr, as BatchRequest of the backend
+using RequestPtr = std::shared_ptr<Request>;
+
+// Mutex taken for every submission, free requests in a mutex-and-deque queue
+class LockedSubmitter {
+  public:
+    LockedSubmitter(uint32_t batch_size, uint32_t nireq) : _batch_size(batch_size), _requests(nireq) {
+        for (uint32_t i = 0; i < nireq; i++) {
+            _requests[i] = std::make_shared<Request>();
+            _requests[i]->index = i;
+            push_free(_requests[i]);
+        }
+    }
+
+    void submit() {
+        RequestPtr complete;
+        {
+            std::lock_guard<std::mutex> lock(_requests_mutex);
+            if (!_current)
+                _current = pop_free();
+            if (++_current_filled == _batch_size) {
+                complete = std::move(_current);
+                _current_filled = 0;
+            }
+        }
+        // inference completes immediately, request goes back to the free queue
+        if (complete)
+            push_free(complete);
+    }
+
+  private:
+    void push_free(RequestPtr request) {
+        {
+            std::lock_guard<std::mutex> lock(_free_mutex);
+            _free.push_back(std::move(request));
+        }
+        _free_cond.notify_one();
+    }
+
+    RequestPtr pop_free() {
+        std::unique_lock<std::mutex> lock(_free_mutex);
+        _free_cond.wait(lock, [this] { return !_free.empty(); });
+        RequestPtr request = std::move(_free.front());
+        _free.pop_front();
+        return request;
+    }
+
+    const uint32_t _batch_size;
+    std::vector<RequestPtr> _requests;
+    std::mutex _requests_mutex;
+    RequestPtr _current;
+    uint32_t _current_filled = 0;
+
+    std::deque<RequestPtr> _free;
+    std::mutex _free_mutex;
+    std::condition_variable _free_cond;
+};
+
+// Slot claiming of OpenVINOImageInference::AcquireBatchSlot, committing as SubmitImage and ReleaseRequest do
+class LockFreeSubmitter {
+  public:
+    LockFreeSubmitter(uint32_t batch_size, uint32_t nireq)
+        : _batch_size(batch_size), _requests(nireq), _free(nireq), _filling(batch_size) {
+        for (uint32_t i = 0; i < nireq; i++) {
+            _requests[i] = std::make_shared<Request>();
+            _requests[i]->index = i;
+            _free.push(_requests[i]);
+        }
+    }
+
+    void submit() {
+        const BatchFillState::Claim claim = _filling.Acquire(_free, [](Request &request) {
+            request.deadline.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                   std::memory_order_relaxed);
+        });
+        const RequestPtr &request = _requests[claim.request];
+        if (request->filled.fetch_add(1, std::memory_order_acq_rel) + 1 == _batch_size) {
+            request->filled.store(0, std::memory_order_relaxed);
+            _free.push(request);
+        }
+    }
+
+  private:
+    const uint32_t _batch_size;
+    std::vector<RequestPtr> _requests;
+    dlstreamer::MpmcQueue<RequestPtr> _free;
+    BatchFillState _filling;
+};
+
+template <typename Submitter>
+double run(unsigned threads, uint32_t batch_size, uint32_t nireq, std::chrono::milliseconds duration) {
+    Submitter submitter(batch_size, nireq);
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> total{0};
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threads; i++) {
+        workers.emplace_back([&] {
+            uint64_t submitted = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                submitter.submit();
+                submitted++;
+            }
+            total.fetch_add(submitted);
+        });
+    }
+    const auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(duration);
+    stop = true;
+    for (auto &worker : workers)
+        worker.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    // threads may stop in the middle of a batch, it is never completed
+    return total.load() / elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const unsigned max_threads = argc > 1 ? std::atoi(argv[1]) : std::max(8u, 2 * std::thread::hardware_concurrency());
+    const uint32_t batch_size = argc > 2 ? std::atoi(argv[2]) : 8;
+    const uint32_t nireq = argc > 3 ? std::atoi(argv[3]) : 4;
+    const std::chrono::milliseconds duration(argc > 4 ? std::atoi(argv[4]) : 500);
+    if (!max_threads || !batch_size || !nireq) {
+        std::fprintf(stderr, "Usage: %s [max_threads] [batch_size] [nireq] [milliseconds_per_run]\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("batch-size=%u nireq=%u hardware threads=%u\n", batch_size, nireq, std::thread::hardware_concurrency());
+    std::printf("%8s %16s %16s %8s\n", "threads", "locked req/s", "lock-free req/s", "speedup");
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        const double locked = run<LockedSubmitter>(threads, batch_size, nireq, duration);
+        const double lock_free = run<LockFreeSubmitter>(threads, batch_size, nireq, duration);
+        std::printf("%8u %16.0f %16.0f %7.2fx\n", threads, locked, lock_free, lock_free / locked);
+    }
+    return 0;
+}
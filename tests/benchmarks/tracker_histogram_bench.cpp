@@ -0,0 +1,182 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Color histogram features of zero-term tracker with the parameters of ZeroTermChistTracker:
+// - spatial RGB histograms of NV12/I420 detections, binned from BGR patch after cv::cvtColor as before and binned from
+//   YUV patch directly (SpatialRgbHistogram::ComputeFromNv12/ComputeFromI420),
+// - detection x tracklet similarity table, pairwise RgbHistogram::ComputeSimilarity as before and
+//   NormalizeForSimilarity + ComputeSimilarityMatrix.
+// Exits with non-zero code if histograms differ or similarities differ by more than float rounding.
+//
+// Usage: bench_tracker_histogram [iterations] [objects_per_frame]
+
+#include "vas/components/ot/mtt/spatial_rgb_histogram.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace vas::ot;
+
+namespace {
+
+constexpr int32_t FRAME_WIDTH = 1920;
+constexpr int32_t FRAME_HEIGHT = 1080;
+constexpr int32_t CANONICAL_PATCH_SIZE = 64;
+constexpr int32_t SPATIAL_BIN_SIZE = 32;
+constexpr int32_t SPATIAL_BIN_STRIDE = 32;
+constexpr int32_t RGB_BIN_SIZE = 32;
+
+// Adds computation of histogram from BGR patch converted from canonical YUV patch, as ComputeFromNv12 and
+// ComputeFromI420 did before
+class BgrPatchHistogram : public SpatialRgbHistogram {
+  public:
+    BgrPatchHistogram()
+        : SpatialRgbHistogram(CANONICAL_PATCH_SIZE, SPATIAL_BIN_SIZE, SPATIAL_BIN_STRIDE, RGB_BIN_SIZE) {
+    }
+
+    void ComputeFromYuvPatch(const YuvImage &image, const cv::Rect &roi, cv::Mat *hist) {
+        cv::Point2f cp(roi.x + roi.width / 2, roi.y + roi.height / 2);
+        hist->create(1, spatial_hist_size_, CV_32F);
+        (*hist) = cv::Scalar(0);
+        float *rgb_hist_ptr = hist->ptr<float>();
+
+        cv::Mat patch;
+        if (image.format_ == YuvImage::FMT_NV12) {
+            YuvImage roi_patch(canonical_patch_size_, canonical_patch_size_, false);
+            image.CropAndResizeNv12(cp, cv::Size2f(roi.width, roi.height), &roi_patch);
+            cv::cvtColor(roi_patch.ToCVMat(), patch, cv::COLOR_YUV2BGR_NV12);
+        } else {
+            YuvImage roi_patch(canonical_patch_size_, canonical_patch_size_, false, YuvImage::FMT_I420);
+            image.CropAndResizeI420(cp, cv::Size2f(roi.width, roi.height), &roi_patch);
+            cv::cvtColor(roi_patch.ToCVMat(), patch, cv::COLOR_YUV2BGR_I420);
+        }
+
+        for (int32_t y_bin = 0; y_bin < spatial_num_bins_; ++y_bin) {
+            int32_t y = y_bin * spatial_bin_stride_;
+            for (int32_t x_bin = 0; x_bin < spatial_num_bins_; ++x_bin) {
+                int32_t x = x_bin * spatial_bin_stride_;
+                AccumulateRgbHistogram(patch(cv::Rect(x, y, spatial_bin_size_, spatial_bin_size_)),
+                                       weight_(cv::Rect(x, y, spatial_bin_size_, spatial_bin_size_)), rgb_hist_ptr);
+                rgb_hist_ptr += rgb_hist_size_;
+            }
+        }
+    }
+};
+
+double measure(int iterations, const std::function<void()> &function) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+        function();
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+void print(const char *name, double before_ms, double after_ms, bool same) {
+    std::printf("%-36s %10.3f %10.3f %8.2fx %s\n", name, before_ms, after_ms, before_ms / after_ms,
+                same ? "same" : "DIFFERENT");
+}
+
+bool compareHistograms(YuvImage::Format format, int iterations, const std::vector<cv::Rect> &rects,
+                       std::mt19937 &rng, std::vector<cv::Mat> &hists) {
+    std::vector<uint8_t> data(FRAME_WIDTH * FRAME_HEIGHT * 3 / 2);
+    std::uniform_int_distribution<int> value(0, 255);
+    for (uint8_t &byte : data)
+        byte = static_cast<uint8_t>(value(rng));
+    const YuvImage frame(FRAME_WIDTH, FRAME_HEIGHT, FRAME_WIDTH, data.data(), format);
+    const bool is_nv12 = format == YuvImage::FMT_NV12;
+
+    BgrPatchHistogram histogram;
+    std::vector<cv::Mat> expected(rects.size());
+    hists.resize(rects.size());
+    const double before_ms = measure(iterations, [&] {
+        for (size_t i = 0; i < rects.size(); i++)
+            histogram.ComputeFromYuvPatch(frame, rects[i], &expected[i]);
+    });
+    const double after_ms = measure(iterations, [&] {
+        for (size_t i = 0; i < rects.size(); i++) {
+            if (is_nv12)
+                histogram.ComputeFromNv12(frame, rects[i], &hists[i]);
+            else
+                histogram.ComputeFromI420(frame, rects[i], &hists[i]);
+        }
+    });
+
+    bool same = true;
+    for (size_t i = 0; i < rects.size(); i++)
+        same &= cv::norm(expected[i], hists[i], cv::NORM_INF) == 0.0;
+    print(is_nv12 ? "NV12 1080p objects histograms" : "I420 1080p objects histograms", before_ms, after_ms, same);
+    return same;
+}
+
+bool compareSimilarity(int iterations, const std::vector<cv::Mat> &detections, const std::vector<cv::Mat> &features) {
+    cv::Mat expected(static_cast<int>(detections.size()), static_cast<int>(features.size()), CV_32F);
+    const double before_ms = measure(iterations, [&] {
+        for (size_t d = 0; d < detections.size(); d++) {
+            for (size_t t = 0; t < features.size(); t++)
+                expected.at<float>(d, t) = RgbHistogram::ComputeSimilarity(detections[d], features[t]);
+        }
+    });
+
+    std::vector<const cv::Mat *> detection_ptrs, feature_ptrs;
+    for (const auto &hist : detections)
+        detection_ptrs.push_back(&hist);
+    for (const auto &hist : features)
+        feature_ptrs.push_back(&hist);
+    cv::Mat similarity;
+    const double after_ms = measure(iterations, [&] {
+        cv::Mat normalized_detections, normalized_features;
+        RgbHistogram::NormalizeForSimilarity(detection_ptrs, &normalized_detections);
+        RgbHistogram::NormalizeForSimilarity(feature_ptrs, &normalized_features);
+        RgbHistogram::ComputeSimilarityMatrix(normalized_detections, normalized_features, &similarity);
+    });
+
+    const double max_difference = cv::norm(expected, similarity, cv::NORM_INF);
+    char name[64];
+    std::snprintf(name, sizeof(name), "similarity %zu x %zu", detections.size(), features.size());
+    print(name, before_ms, after_ms, max_difference < 1e-4);
+    return max_difference < 1e-4;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 20;
+    const int objects = argc > 2 ? std::atoi(argv[2]) : 50;
+    if (iterations <= 0 || objects <= 0) {
+        std::fprintf(stderr, "Usage: %s [iterations] [objects_per_frame]\n", argv[0]);
+        return 1;
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int32_t> size(16, 300);
+    std::vector<cv::Rect> rects;
+    for (int i = 0; i < objects; i++) {
+        const int32_t width = size(rng);
+        const int32_t height = size(rng);
+        std::uniform_int_distribution<int32_t> x(0, FRAME_WIDTH - width);
+        std::uniform_int_distribution<int32_t> y(0, FRAME_HEIGHT - height);
+        rects.emplace_back(x(rng), y(rng), width, height);
+    }
+
+    std::printf("objects per frame: %d, ms per frame\n", objects);
+    std::printf("%-36s %10s %10s %9s\n", "case", "before ms", "after ms", "speedup");
+    bool same = true;
+    std::vector<cv::Mat> nv12_hists, i420_hists;
+    same &= compareHistograms(YuvImage::FMT_NV12, iterations, rects, rng, nv12_hists);
+    same &= compareHistograms(YuvImage::FMT_I420, iterations, rects, rng, i420_hists);
+    // detections of current frame against tracklet features of previous frame, one feature per tracklet
+    same &= compareSimilarity(iterations, nv12_hists, i420_hists);
+    return same ? 0 : 1;
+}
@@ -0,0 +1,235 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Compares yolo_decode kernels with the scalar decoding the YOLO converters used before, on synthetic outputs of
+// canonical 80-class COCO models. Exits with non-zero code if the results differ.
+//
+// Usage: bench_yolo_decode [iterations]
+
+#include "yolo_decode.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t CLASSES = 80;
+constexpr double THRESHOLD = 0.3; // not representable in float, checks rounding of threshold
+
+struct Detection {
+    size_t index;
+    size_t class_id;
+    float score;
+
+    bool operator==(const Detection &other) const {
+        return index == other.index && class_id == other.class_id && score == other.score;
+    }
+    bool operator<(const Detection &other) const {
+        return index < other.index;
+    }
+};
+
+float sigmoid(float x) {
+    return 1.f / (1.f + std::exp(-x));
+}
+
+// Raw logits: values with 'object_rate' probability are confident, the rest are background
+std::vector<float> makeLogits(size_t size, float object_rate, std::mt19937 &rng) {
+    std::normal_distribution<float> background(-6.f, 1.5f);
+    std::normal_distribution<float> object(2.f, 1.f);
+    std::uniform_real_distribution<float> pick(0.f, 1.f);
+    std::vector<float> data(size);
+    for (float &value : data)
+        value = pick(rng) < object_rate ? object(rng) : background(rng);
+    return data;
+}
+
+// YOLOv8 [4 + classes, proposals] with probabilities, as decoded before: transpose, then argmax per proposal
+void yolov8Scalar(const float *data, size_t proposals, std::vector<Detection> &result) {
+    const size_t object_size = 4 + CLASSES;
+    std::vector<float> transposed(object_size * proposals);
+    for (size_t c = 0; c < object_size; c++)
+        for (size_t i = 0; i < proposals; i++)
+            transposed[i * object_size + c] = data[c * proposals + i];
+    for (size_t i = 0; i < proposals; i++) {
+        const float *scores = transposed.data() + i * object_size + 4;
+        const size_t class_id = std::max_element(scores, scores + CLASSES) - scores;
+        const double score = scores[class_id];
+        if (score > THRESHOLD)
+            result.push_back({i, class_id, scores[class_id]});
+    }
+}
+
+void yolov8Vectorized(const float *data, size_t proposals, std::vector<Detection> &result) {
+    std::vector<yolo::Proposal> found;
+    yolo::classMaxPlanar(data + 4 * proposals, CLASSES, proposals, proposals, THRESHOLD, found);
+    for (const auto &proposal : found)
+        result.push_back({proposal.index, proposal.class_id, proposal.score});
+}
+
+// YOLOv3 planar output of one scale [anchors * (5 + classes), side * side] with logits, as decoded before: sigmoid of
+// objectness for every cell
+void yolov3Scalar(const float *data, size_t anchors, size_t side_square, std::vector<Detection> &result) {
+    for (size_t anchor = 0; anchor < anchors; anchor++) {
+        const float *planes = data + anchor * (5 + CLASSES) * side_square;
+        for (size_t i = 0; i < side_square; i++) {
+            const float objectness = sigmoid(planes[4 * side_square + i]);
+            if (objectness < THRESHOLD)
+                continue;
+            size_t class_id = 0;
+            float best = 0.f;
+            for (size_t c = 0; c < CLASSES; c++) {
+                const float value = planes[(5 + c) * side_square + i];
+                if (value > best) {
+                    best = value;
+                    class_id = c;
+                }
+            }
+            const float confidence = objectness * best;
+            if (confidence >= THRESHOLD)
+                result.push_back({anchor * side_square + i, class_id, confidence});
+        }
+    }
+}
+
+void yolov3Vectorized(const float *data, size_t anchors, size_t side_square, std::vector<Detection> &result) {
+    const float objectness_threshold = yolo::rawThreshold(THRESHOLD, true);
+    std::vector<size_t> cells;
+    for (size_t anchor = 0; anchor < anchors; anchor++) {
+        const float *planes = data + anchor * (5 + CLASSES) * side_square;
+        cells.clear();
+        yolo::selectAtLeast(planes + 4 * side_square, side_square, objectness_threshold, cells);
+        for (size_t i : cells) {
+            const float objectness = sigmoid(planes[4 * side_square + i]);
+            if (objectness < THRESHOLD)
+                continue;
+            size_t class_id = 0;
+            float best = 0.f;
+            for (size_t c = 0; c < CLASSES; c++) {
+                const float value = planes[(5 + c) * side_square + i];
+                if (value > best) {
+                    best = value;
+                    class_id = c;
+                }
+            }
+            const float confidence = objectness * best;
+            if (confidence >= THRESHOLD)
+                result.push_back({anchor * side_square + i, class_id, confidence});
+        }
+    }
+}
+
+// YOLOv7/YOLOX rows [proposals, 5 + classes] with probabilities
+template <bool vectorized>
+void yolov7(const float *data, size_t proposals, std::vector<Detection> &result) {
+    for (size_t i = 0; i < proposals; i++) {
+        const float *row = data + i * (5 + CLASSES);
+        float confidence = row[4];
+        if (confidence < THRESHOLD)
+            continue;
+        yolo::Proposal main_class;
+        if (vectorized) {
+            main_class = yolo::argMax(row + 5, CLASSES);
+        } else {
+            main_class = {0, 0, row[5]};
+            for (size_t c = 1; c < CLASSES; c++) {
+                if (row[5 + c] > main_class.score)
+                    main_class = {0, c, row[5 + c]};
+            }
+        }
+        confidence *= main_class.score;
+        if (confidence >= THRESHOLD)
+            result.push_back({i, main_class.class_id, confidence});
+    }
+}
+
+double measure(int iterations, const std::function<void(std::vector<Detection> &)> &decode,
+               std::vector<Detection> &result) {
+    std::vector<Detection> detections;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        detections.clear();
+        decode(detections);
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::sort(detections.begin(), detections.end());
+    result = std::move(detections);
+    return elapsed.count() / iterations;
+}
+
+bool compare(const char *name, int iterations, const std::function<void(std::vector<Detection> &)> &scalar,
+             const std::function<void(std::vector<Detection> &)> &vectorized) {
+    std::vector<Detection> expected, actual;
+    const double scalar_ms = measure(iterations, scalar, expected);
+    const double vectorized_ms = measure(iterations, vectorized, actual);
+    const bool same = expected == actual;
+    std::printf("%-28s %10.3f %12.3f %8.2fx %6zu %s\n", name, scalar_ms, vectorized_ms, scalar_ms / vectorized_ms,
+                actual.size(), same ? "same" : "DIFFERENT");
+    return same;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 100;
+    if (iterations <= 0) {
+        std::fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    std::mt19937 rng(42);
+    auto probabilities = [](std::vector<float> data) {
+        for (float &value : data)
+            value = sigmoid(value);
+        return data;
+    };
+
+    // YOLOv8 640x640: [84, 8400]
+    const size_t v8_proposals = 8400;
+    std::vector<float> v8 = probabilities(makeLogits((4 + CLASSES) * v8_proposals, 0.0002f, rng));
+    // scores right at the threshold must be selected as with comparison in double
+    v8[(4 + 7) * v8_proposals + 100] = static_cast<float>(THRESHOLD);
+    v8[(4 + 9) * v8_proposals + 200] = std::nextafter(static_cast<float>(THRESHOLD), 0.f);
+
+    // YOLOv3 416x416: 3 anchors per scale, 13x13, 26x26 and 52x52 cells
+    const size_t anchors = 3;
+    const size_t sides[] = {13, 26, 52};
+    std::vector<std::vector<float>> v3;
+    for (size_t side : sides)
+        v3.push_back(makeLogits(anchors * (5 + CLASSES) * side * side, 0.003f, rng));
+
+    // YOLOv7 640x640: [25200, 85]
+    const size_t v7_proposals = 25200;
+    const std::vector<float> v7 = probabilities(makeLogits(v7_proposals * (5 + CLASSES), 0.003f, rng));
+
+    std::printf("%-28s %10s %12s %9s %6s\n", "output", "scalar ms", "vectorized ms", "speedup", "found");
+    bool same = true;
+    same &= compare(
+        "yolo_v8 [84, 8400]", iterations,
+        [&](std::vector<Detection> &result) { yolov8Scalar(v8.data(), v8_proposals, result); },
+        [&](std::vector<Detection> &result) { yolov8Vectorized(v8.data(), v8_proposals, result); });
+    same &= compare(
+        "yolo_v3 [255, 13/26/52^2]", iterations,
+        [&](std::vector<Detection> &result) {
+            for (size_t s = 0; s < v3.size(); s++)
+                yolov3Scalar(v3[s].data(), anchors, sides[s] * sides[s], result);
+        },
+        [&](std::vector<Detection> &result) {
+            for (size_t s = 0; s < v3.size(); s++)
+                yolov3Vectorized(v3[s].data(), anchors, sides[s] * sides[s], result);
+        });
+    same &= compare(
+        "yolo_v7 [25200, 85]", iterations,
+        [&](std::vector<Detection> &result) { yolov7<false>(v7.data(), v7_proposals, result); },
+        [&](std::vector<Detection> &result) { yolov7<true>(v7.data(), v7_proposals, result); });
+    return same ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Compares OpenCV pre-processing of NV12/I420 crops (ImageToMat, ResizeMat and MatToMultiPlaneImage as in
+// OpenCV_VPP::Convert) with fused ResizeYUVToPlanarBGR: classification of objects in 1080p frame and full frame
+// detection input.
+//
+// Usage: bench_yuv_resize [iterations] [objects_per_frame]
+
+#include "opencv_utils.h"
+#include "yuv_resize.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace InferenceBackend;
+
+namespace {
+
+constexpr uint32_t FRAME_WIDTH = 1920;
+constexpr uint32_t FRAME_HEIGHT = 1080;
+
+struct Frame {
+    Frame(int format, std::mt19937 &rng) {
+        const bool is_nv12 = format == FOURCC_NV12;
+        const uint32_t planes = is_nv12 ? 2 : 3;
+        image.type = MemoryType::SYSTEM;
+        image.format = format;
+        image.width = FRAME_WIDTH;
+        image.height = FRAME_HEIGHT;
+        data.resize(planes);
+        std::uniform_int_distribution<int> value(0, 255);
+        for (uint32_t i = 0; i < planes; i++) {
+            image.stride[i] = i && !is_nv12 ? FRAME_WIDTH / 2 : FRAME_WIDTH;
+            data[i].resize(image.stride[i] * (i ? FRAME_HEIGHT / 2 : FRAME_HEIGHT));
+            for (uint8_t &byte : data[i])
+                byte = static_cast<uint8_t>(value(rng));
+            image.planes[i] = data[i].data();
+        }
+    }
+
+    // Same plane offsets as ApplyCrop
+    Image crop(const Rectangle<uint32_t> &rect) const {
+        Image dst = image;
+        dst.width = rect.width;
+        dst.height = rect.height;
+        dst.planes[0] = image.planes[0] + rect.y * image.stride[0] + rect.x;
+        if (image.format == FOURCC_NV12) {
+            dst.planes[1] = image.planes[1] + (rect.y / 2) * image.stride[1] + rect.x;
+        } else {
+            dst.planes[1] = image.planes[1] + (rect.y / 2) * image.stride[1] + rect.x / 2;
+            dst.planes[2] = image.planes[2] + (rect.y / 2) * image.stride[2] + rect.x / 2;
+        }
+        return dst;
+    }
+
+    Image image;
+    std::vector<std::vector<uint8_t>> data;
+};
+
+struct Tensor {
+    Tensor(uint32_t width, uint32_t height) : data(3 * width * height) {
+        image.type = MemoryType::SYSTEM;
+        image.format = FOURCC_RGBP;
+        image.width = width;
+        image.height = height;
+        for (uint32_t i = 0; i < 3; i++) {
+            image.planes[i] = data.data() + i * width * height;
+            image.stride[i] = width;
+        }
+    }
+
+    Image image;
+    std::vector<uint8_t> data;
+};
+
+void convertOpenCV(const Image &src, Image &dst) {
+    cv::Mat src_mat;
+    Utils::ImageToMat(src, src_mat);
+    Utils::MatToMultiPlaneImage(Utils::ResizeMat(src_mat, dst.height, dst.width), dst);
+}
+
+void convertFused(const Image &src, Image &dst) {
+    Utils::ResizeYUVToPlanarBGR(src, dst);
+}
+
+double measure(int iterations, const std::function<void()> &function) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+        function();
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+void compare(const char *name, int iterations, const Frame &frame, const std::vector<Rectangle<uint32_t>> &rects,
+             Tensor &tensor) {
+    auto run = [&](void (*convert)(const Image &, Image &)) {
+        return measure(iterations, [&] {
+            for (const auto &rect : rects)
+                convert(frame.crop(rect), tensor.image);
+        });
+    };
+    const double opencv_ms = run(convertOpenCV);
+    const double fused_ms = run(convertFused);
+    std::printf("%-36s %12.3f %10.3f %8.2fx\n", name, opencv_ms, fused_ms, opencv_ms / fused_ms);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 20;
+    const int objects = argc > 2 ? std::atoi(argv[2]) : 50;
+    if (iterations <= 0 || objects <= 0) {
+        std::fprintf(stderr, "Usage: %s [iterations] [objects_per_frame]\n", argv[0]);
+        return 1;
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> size(32, 200);
+    std::vector<Rectangle<uint32_t>> objects_rects;
+    for (int i = 0; i < objects; i++) {
+        const uint32_t width = 2 * size(rng);
+        const uint32_t height = 2 * size(rng);
+        std::uniform_int_distribution<uint32_t> x(0, (FRAME_WIDTH - width) / 2);
+        std::uniform_int_distribution<uint32_t> y(0, (FRAME_HEIGHT - height) / 2);
+        objects_rects.emplace_back(2 * x(rng), 2 * y(rng), width, height);
+    }
+    const std::vector<Rectangle<uint32_t>> full_frame{{0, 0, FRAME_WIDTH, FRAME_HEIGHT}};
+
+    Tensor classification_input(64, 64);
+    Tensor detection_input(416, 416);
+
+    std::printf("objects per frame: %d, ms per frame\n", objects);
+    std::printf("%-36s %12s %10s %9s\n", "case", "OpenCV ms", "fused ms", "speedup");
+    for (int format : {FOURCC_NV12, FOURCC_I420}) {
+        const Frame frame(format, rng);
+        const bool is_nv12 = format == FOURCC_NV12;
+        compare(is_nv12 ? "NV12 1080p objects to 64x64" : "I420 1080p objects to 64x64", iterations, frame,
+                objects_rects, classification_input);
+        compare(is_nv12 ? "NV12 1080p frame to 416x416" : "I420 1080p frame to 416x416", iterations, frame,
+                full_frame, detection_input);
+    }
+    return 0;
+}
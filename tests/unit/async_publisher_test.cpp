@@ -0,0 +1,307 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Checks AsyncPublisher of gvametapublish with two stub sinks: a broker client that publishes JSON array payloads and
+// can be slow, held or disconnected, as MQTT publisher does, and a file sink writing JSON lines records. Covers
+// ordering, batching, overflow policies, failed sends and release of producers blocked on full queue.
+
+#include "async_publisher.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// Payload of several messages, as gvametapublish base publishes batches to brokers
+std::string jsonArray(const std::vector<std::string> &messages) {
+    std::string payload = "[";
+    for (size_t i = 0; i < messages.size(); i++)
+        payload += (i ? "," : "") + messages[i];
+    return payload + "]";
+}
+
+// Broker client: every batch is one payload, publishing waits while the client is held and fails while disconnected
+class StubBroker {
+  public:
+    bool publish(const std::vector<std::string> &batch) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _waiting++;
+        _state_changed.notify_all();
+        _state_changed.wait(lock, [this] { return !_held; });
+        _waiting--;
+        if (!_connected)
+            return false;
+        _payloads.push_back(batch.size() == 1 ? batch.front() : jsonArray(batch));
+        _batch_sizes.push_back(batch.size());
+        for (const auto &message : batch)
+            _messages.push_back(message);
+        return true;
+    }
+
+    void hold(bool held) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _held = held;
+        }
+        _state_changed.notify_all();
+    }
+
+    // Waits until sender thread is held in publish()
+    void wait_until_held() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _state_changed.wait(lock, [this] { return _waiting > 0; });
+    }
+
+    void set_connected(bool connected) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _connected = connected;
+    }
+
+    std::vector<std::string> messages() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _messages;
+    }
+
+    std::vector<size_t> batch_sizes() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _batch_sizes;
+    }
+
+    std::vector<std::string> payloads() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _payloads;
+    }
+
+  private:
+    std::mutex _mutex;
+    std::condition_variable _state_changed;
+    bool _held = false;
+    int _waiting = 0;
+    bool _connected = true;
+    std::vector<std::string> _payloads;
+    std::vector<size_t> _batch_sizes;
+    std::vector<std::string> _messages;
+};
+
+// File sink: records of a batch are written separately, as the file publisher does
+class StubFile {
+  public:
+    explicit StubFile(std::string path) : _path(std::move(path)), _file(std::fopen(_path.c_str(), "w")) {
+    }
+    ~StubFile() {
+        close();
+        std::remove(_path.c_str());
+    }
+
+    bool publish(const std::vector<std::string> &batch) {
+        for (const auto &message : batch) {
+            if (std::fputs(message.c_str(), _file) < 0 || std::fputs("\n", _file) < 0)
+                return false;
+        }
+        return std::fflush(_file) == 0;
+    }
+
+    void close() {
+        if (_file)
+            std::fclose(_file);
+        _file = nullptr;
+    }
+
+    std::vector<std::string> lines() const {
+        std::vector<std::string> result;
+        std::ifstream in(_path);
+        for (std::string line; std::getline(in, line);)
+            result.push_back(line);
+        return result;
+    }
+
+  private:
+    std::string _path;
+    std::FILE *_file;
+};
+
+std::string message(int i) {
+    return "{\"frame\":" + std::to_string(i) + "}";
+}
+
+std::vector<std::string> messages(int first, int last) {
+    std::vector<std::string> result;
+    for (int i = first; i <= last; i++)
+        result.push_back(message(i));
+    return result;
+}
+
+bool report(bool passed, const char *what) {
+    std::printf("%s %s\n", passed ? "PASSED" : "FAILED", what);
+    return passed;
+}
+
+AsyncPublisher::Options options(size_t queue_size, AsyncPublisher::OverflowPolicy policy, size_t batch_size = 1,
+                                std::chrono::milliseconds batch_interval = 0ms) {
+    AsyncPublisher::Options result;
+    result.queue_size = queue_size;
+    result.batch_size = batch_size;
+    result.batch_interval = batch_interval;
+    result.overflow_policy = policy;
+    return result;
+}
+
+bool checkFileOrder() {
+    StubFile file("async_publisher_test.jsonl");
+    AsyncPublisher publisher(options(16, AsyncPublisher::OverflowPolicy::Block, 4),
+                             [&](const std::vector<std::string> &batch) { return file.publish(batch); });
+    bool pushed = true;
+    for (int i = 0; i < 1000; i++)
+        pushed &= publisher.push(message(i));
+    publisher.flush();
+    const bool flushed = file.lines() == messages(0, 999);
+    publisher.stop();
+    file.close();
+    const AsyncPublisher::Stats stats = publisher.stats();
+    return report(pushed && flushed && stats.published == 1000 && stats.dropped == 0,
+                  "file sink gets all records in order after flush()");
+}
+
+bool checkBatching() {
+    StubBroker broker;
+    const size_t batch_size = 8;
+    AsyncPublisher publisher(options(64, AsyncPublisher::OverflowPolicy::Block, batch_size, 50ms),
+                             [&](const std::vector<std::string> &batch) { return broker.publish(batch); });
+    // the first message waits for the batch to fill up, the last batch is partial and published after the interval
+    for (int i = 0; i < 100; i++)
+        publisher.push(message(i));
+    publisher.flush();
+
+    bool batches_fit = true;
+    for (size_t size : broker.batch_sizes())
+        batches_fit &= size >= 1 && size <= batch_size;
+    const std::vector<std::string> payloads = broker.payloads();
+    const bool first_payload_is_array = !payloads.empty() && payloads.front() == jsonArray(messages(0, 7));
+    publisher.stop();
+    return report(batches_fit && first_payload_is_array && broker.messages() == messages(0, 99),
+                  "broker sink gets batches of at most batch-size messages as JSON arrays");
+}
+
+bool checkFailedSends() {
+    StubBroker broker;
+    broker.set_connected(false);
+    AsyncPublisher publisher(options(8, AsyncPublisher::OverflowPolicy::Block),
+                             [&](const std::vector<std::string> &batch) { return broker.publish(batch); });
+    for (int i = 0; i < 5; i++)
+        publisher.push(message(i));
+    publisher.flush();
+    broker.set_connected(true);
+    for (int i = 5; i < 10; i++)
+        publisher.push(message(i));
+    publisher.stop();
+    const AsyncPublisher::Stats stats = publisher.stats();
+    return report(stats.failed_batches == 5 && stats.published == 5 && broker.messages() == messages(5, 9),
+                  "sender keeps draining the queue while broker is disconnected");
+}
+
+// Holds the broker and fills the queue: one message is taken by the sender, 'queue_size' are queued
+void fillHeld(StubBroker &broker, AsyncPublisher &publisher, size_t queue_size) {
+    broker.hold(true);
+    publisher.push(message(0));
+    broker.wait_until_held();
+    for (size_t i = 1; i <= queue_size; i++)
+        publisher.push(message(static_cast<int>(i)));
+}
+
+bool checkDropPolicies() {
+    bool passed = true;
+    for (auto policy : {AsyncPublisher::OverflowPolicy::DropNewest, AsyncPublisher::OverflowPolicy::DropOldest}) {
+        const bool newest = policy == AsyncPublisher::OverflowPolicy::DropNewest;
+        StubBroker broker;
+        AsyncPublisher publisher(options(4, policy),
+                                 [&](const std::vector<std::string> &batch) { return broker.publish(batch); });
+        fillHeld(broker, publisher, 4);
+        bool overflow_pushed = false;
+        for (int i = 5; i < 10; i++)
+            overflow_pushed |= publisher.push(message(i));
+        broker.hold(false);
+        publisher.stop();
+
+        std::vector<std::string> expected = messages(0, 4);
+        if (!newest) {
+            // every new message pushes out the oldest queued one
+            expected = messages(6, 9);
+            expected.insert(expected.begin(), message(0));
+        }
+        const AsyncPublisher::Stats stats = publisher.stats();
+        const bool ok = broker.messages() == expected && stats.dropped == 5 && overflow_pushed == !newest;
+        passed &= report(ok, newest ? "drop-newest drops new messages when queue is full"
+                                    : "drop-oldest drops queued messages when queue is full");
+    }
+    return passed;
+}
+
+// Starts a producer blocked on full queue, returns its result
+std::future<bool> blockedProducer(StubBroker &broker, AsyncPublisher &publisher, size_t queue_size) {
+    fillHeld(broker, publisher, queue_size);
+    auto producer = std::async(std::launch::async, [&] { return publisher.push(message(100)); });
+    return producer;
+}
+
+bool checkBlockReleasedByFlushing() {
+    StubBroker broker;
+    AsyncPublisher publisher(options(2, AsyncPublisher::OverflowPolicy::Block),
+                             [&](const std::vector<std::string> &batch) { return broker.publish(batch); });
+    std::future<bool> producer = blockedProducer(broker, publisher, 2);
+    const bool blocked = producer.wait_for(50ms) == std::future_status::timeout;
+    // flush comes while the broker is still held
+    publisher.set_flushing(true);
+    const bool released = producer.wait_for(1s) == std::future_status::ready && !producer.get();
+    const bool dropped_while_flushing = !publisher.push(message(101));
+    publisher.set_flushing(false);
+    broker.hold(false);
+    publisher.flush();
+    const bool accepted_after_flush = publisher.push(message(102));
+    publisher.stop();
+
+    std::vector<std::string> expected = messages(0, 2);
+    expected.push_back(message(102));
+    return report(blocked && released && dropped_while_flushing && accepted_after_flush &&
+                      broker.messages() == expected,
+                  "set_flushing() releases producer blocked on full queue");
+}
+
+bool checkBlockReleasedByStop() {
+    StubBroker broker;
+    AsyncPublisher publisher(options(2, AsyncPublisher::OverflowPolicy::Block),
+                             [&](const std::vector<std::string> &batch) { return broker.publish(batch); });
+    std::future<bool> producer = blockedProducer(broker, publisher, 2);
+    const bool blocked = producer.wait_for(50ms) == std::future_status::timeout;
+    // stop joins the sender, which is held in the broker until released below
+    auto stopping = std::async(std::launch::async, [&] { publisher.stop(); });
+    const bool released = producer.wait_for(1s) == std::future_status::ready && !producer.get();
+    broker.hold(false);
+    stopping.get();
+    const bool rejected_after_stop = !publisher.push(message(101));
+    return report(blocked && released && rejected_after_stop && broker.messages() == messages(0, 2),
+                  "stop() releases producer blocked on full queue and publishes queued messages");
+}
+
+} // namespace
+
+int main() {
+    bool passed = checkFileOrder();
+    passed &= checkBatching();
+    passed &= checkFailedSends();
+    passed &= checkDropPolicies();
+    passed &= checkBlockReleasedByFlushing();
+    passed &= checkBlockReleasedByStop();
+    return passed ? 0 : 1;
+}
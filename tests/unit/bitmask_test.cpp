@@ -0,0 +1,231 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Checks packed segmentation masks of utils/bitmask.h: pack() and unpack() round trip for row widths handled by vector
+// kernels and by scalar tails, ScaledMask against bilinear scaling of the zero bordered mask as cv::resize does it,
+// for float masks and for packed ones, and blend() against per byte average.
+
+#include "bitmask.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr float THRESHOLD = 0.5f;
+const int WIDTHS[] = {1, 7, 8, 9, 31, 33, 64, 100};
+
+bool report(bool passed, const char *what) {
+    std::printf("%s %s\n", passed ? "PASSED" : "FAILED", what);
+    return passed;
+}
+
+// Random values, some of them exactly at the threshold
+std::vector<float> randomMask(int width, int height, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> value(0.0f, 1.0f);
+    std::vector<float> mask(size_t(width) * height);
+    for (float &v : mask)
+        v = rng() % 8 ? value(rng) : THRESHOLD;
+    return mask;
+}
+
+// Smooth blob, as masks of detected objects are, with values close to 0.5 on its edge only
+std::vector<float> blobMask(int width, int height) {
+    std::vector<float> mask(size_t(width) * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const float dx = (x + 0.5f) / width - 0.5f;
+            const float dy = (y + 0.5f) / height - 0.5f;
+            mask[y * width + x] = std::exp(-8.0f * (dx * dx + dy * dy));
+        }
+    }
+    return mask;
+}
+
+// Bilinear scaling of the mask with one-pixel zero border to 'dst_width x dst_height', pixel centers aligned as in
+// cv::resize with INTER_LINEAR
+std::vector<double> referenceScale(const std::vector<float> &mask, int width, int height, int dst_width,
+                                   int dst_height) {
+    const int src_width = width + 2;
+    const int src_height = height + 2;
+    auto source = [&](int x, int y) -> double {
+        x--;
+        y--;
+        return x < 0 || y < 0 || x >= width || y >= height ? 0.0 : mask[y * width + x];
+    };
+    auto tap = [](int i, int src_size, int dst_size, int &index, double &weight) {
+        const double position = std::clamp((i + 0.5) * src_size / dst_size - 0.5, 0.0, src_size - 1.0);
+        index = std::min(static_cast<int>(position), src_size - 2);
+        weight = position - index;
+    };
+    std::vector<double> result(size_t(dst_width) * dst_height);
+    for (int y = 0; y < dst_height; y++) {
+        int y0;
+        double wy;
+        tap(y, src_height, dst_height, y0, wy);
+        for (int x = 0; x < dst_width; x++) {
+            int x0;
+            double wx;
+            tap(x, src_width, dst_width, x0, wx);
+            const double top = (1 - wx) * source(x0, y0) + wx * source(x0 + 1, y0);
+            const double bottom = (1 - wx) * source(x0, y0 + 1) + wx * source(x0 + 1, y0 + 1);
+            result[y * dst_width + x] = (1 - wy) * top + wy * bottom;
+        }
+    }
+    return result;
+}
+
+// Scaled mask matches thresholded reference, except where rounding can move the value across the threshold
+bool matchesReference(const bitmask::ScaledMask &scaled, const std::vector<double> &reference, int dst_width,
+                      int dst_height) {
+    std::vector<uint8_t> row(dst_width);
+    for (int y = 0; y < dst_height; y++) {
+        scaled.row(y, 0, dst_width, 1, row.data());
+        for (int x = 0; x < dst_width; x++) {
+            const double expected = reference[y * dst_width + x];
+            if (std::abs(expected - THRESHOLD) > 1e-5 && row[x] != (expected > THRESHOLD ? 0xFF : 0))
+                return false;
+        }
+    }
+    return true;
+}
+
+bool checkPackRoundTrip() {
+    std::mt19937 rng(1);
+    bool passed = true;
+    for (int width : WIDTHS) {
+        const int height = 5;
+        const std::vector<float> mask = randomMask(width, height, rng);
+        const std::vector<uint8_t> bits = bitmask::pack(mask.data(), width, height, THRESHOLD);
+        std::vector<uint8_t> unpacked(mask.size());
+        bitmask::unpack(bits.data(), width, height, unpacked.data(), 255);
+
+        passed &= bits.size() == bitmask::packedSize(width, height);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                const bool set = mask[y * width + x] > THRESHOLD;
+                passed &= bitmask::test(bits.data(), width, x, y) == set;
+                passed &= unpacked[y * width + x] == (set ? 255 : 0);
+            }
+            // bits past the row end are zero
+            const uint8_t last = bits[y * bitmask::rowStride(width) + bitmask::rowStride(width) - 1];
+            passed &= width % 8 == 0 || last >> (width % 8) == 0;
+        }
+    }
+    return report(passed, "pack() sets bits above threshold, unpack() restores them, rows start at byte boundary");
+}
+
+bool checkScaledFloat() {
+    bool passed = true;
+    const int width = 28;
+    const int height = 28;
+    const std::vector<float> mask = blobMask(width, height);
+    // up and down scaling, as masks are scaled to boxes of any size
+    for (int dst_size : {7, 30, 45, 200}) {
+        bitmask::ScaledMask scaled(mask.data(), width, height, dst_size, dst_size + 3);
+        passed &= matchesReference(scaled, referenceScale(mask, width, height, dst_size, dst_size + 3), dst_size,
+                                   dst_size + 3);
+    }
+    return report(passed, "ScaledMask interpolates float mask values, then thresholds");
+}
+
+bool checkScaledBits() {
+    bool passed = true;
+    const int width = 28;
+    const int height = 28;
+    const std::vector<float> mask = blobMask(width, height);
+    const std::vector<uint8_t> bits = bitmask::pack(mask.data(), width, height, THRESHOLD);
+    std::vector<float> thresholded(mask.size());
+    for (size_t i = 0; i < mask.size(); i++)
+        thresholded[i] = mask[i] > THRESHOLD ? 1.0f : 0.0f;
+    for (int dst_size : {7, 30, 45, 200}) {
+        bitmask::ScaledMask scaled(bits.data(), width, height, dst_size, dst_size + 3);
+        passed &= matchesReference(scaled, referenceScale(thresholded, width, height, dst_size, dst_size + 3),
+                                   dst_size, dst_size + 3);
+    }
+    return report(passed, "ScaledMask interpolates bits of packed mask, thresholded at model resolution");
+}
+
+bool checkScaledIdentity() {
+    std::mt19937 rng(2);
+    bool passed = true;
+    for (int width : WIDTHS) {
+        const int height = 4;
+        const std::vector<float> mask = randomMask(width, height, rng);
+        const std::vector<uint8_t> bits = bitmask::pack(mask.data(), width, height, THRESHOLD);
+        // border included, so each scaled pixel is one source pixel
+        bitmask::ScaledMask scaled(bits.data(), width, height, width + 2, height + 2);
+        std::vector<uint8_t> row(width + 2);
+        for (int y = 0; y < height + 2; y++) {
+            scaled.row(y, 0, width + 2, 1, row.data());
+            for (int x = 0; x < width + 2; x++) {
+                const bool inside = x > 0 && y > 0 && x <= width && y <= height;
+                const bool set = inside && bitmask::test(bits.data(), width, x - 1, y - 1);
+                passed &= row[x] == (set ? 0xFF : 0);
+            }
+        }
+    }
+    return report(passed, "ScaledMask of mask size plus border reproduces the mask");
+}
+
+bool checkScaledRowRange() {
+    const int width = 28;
+    const int height = 28;
+    const int dst_width = 90;
+    const int dst_height = 60;
+    const int channels = 3;
+    const std::vector<float> mask = blobMask(width, height);
+    bitmask::ScaledMask scaled(mask.data(), width, height, dst_width, dst_height);
+    bool passed = true;
+    std::vector<uint8_t> full(dst_width);
+    // part of the row, as rendered when the box is clipped by frame borders
+    const int x_begin = 17;
+    const int x_end = 61;
+    std::vector<uint8_t> part((x_end - x_begin) * channels);
+    for (int y = 0; y < dst_height; y++) {
+        scaled.row(y, 0, dst_width, 1, full.data());
+        scaled.row(y, x_begin, x_end, channels, part.data());
+        for (int x = x_begin; x < x_end; x++) {
+            for (int c = 0; c < channels; c++)
+                passed &= part[(x - x_begin) * channels + c] == full[x];
+        }
+    }
+    return report(passed, "ScaledMask row range writes the same value for every channel of the pixel");
+}
+
+bool checkBlend() {
+    std::mt19937 rng(3);
+    bool passed = true;
+    // sizes below, at and above vector width, with tails
+    for (size_t size : {1, 31, 32, 33, 64, 100}) {
+        std::vector<uint8_t> dst(size), mask(size), color(size);
+        for (size_t i = 0; i < size; i++) {
+            dst[i] = static_cast<uint8_t>(rng());
+            color[i] = static_cast<uint8_t>(rng());
+            mask[i] = rng() % 2 ? 0xFF : 0;
+        }
+        std::vector<uint8_t> blended = dst;
+        bitmask::blend(blended.data(), mask.data(), color.data(), size);
+        for (size_t i = 0; i < size; i++)
+            passed &= blended[i] == (mask[i] ? (dst[i] + color[i] + 1) / 2 : dst[i]);
+    }
+    return report(passed, "blend() averages color into masked bytes only");
+}
+
+} // namespace
+
+int main() {
+    bool passed = checkPackRoundTrip();
+    passed &= checkScaledFloat();
+    passed &= checkScaledBits();
+    passed &= checkScaledIdentity();
+    passed &= checkScaledRowRange();
+    passed &= checkBlend();
+    return passed ? 0 : 1;
+}
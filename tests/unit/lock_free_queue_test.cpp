@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Checks MpmcQueue of base/lock_free_queue.h: 4 producers and 4 consumers pass every element exactly once through a
+// queue much smaller than the number of elements, close() wakes blocked producers and consumers and lets consumers
+// take the remaining elements, timed pop() and pop_batch() return on deadline.
+
+#include <dlstreamer/base/lock_free_queue.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace dlstreamer;
+using clock = std::chrono::steady_clock;
+
+constexpr int THREADS = 4;
+constexpr int ELEMENTS_PER_PRODUCER = 100000;
+
+bool report(bool passed, const char *what) {
+    std::printf("%s %s\n", passed ? "PASSED" : "FAILED", what);
+    return passed;
+}
+
+bool checkProducersConsumers() {
+    // capacity is rounded up to 8
+    MpmcQueue<int> queue(5);
+    std::vector<std::atomic<int>> received(THREADS * ELEMENTS_PER_PRODUCER);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < THREADS; p++) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < ELEMENTS_PER_PRODUCER; i++)
+                queue.push(p * ELEMENTS_PER_PRODUCER + i + 1);
+        });
+    }
+    for (int c = 0; c < THREADS; c++) {
+        threads.emplace_back([&, c] {
+            // consumers use blocking, timed and batch pop
+            for (;;) {
+                std::vector<int> values;
+                if (c % 2) {
+                    values = queue.pop_batch(3, clock::now() + std::chrono::milliseconds(10));
+                } else if (std::optional<int> value = queue.pop(clock::now() + std::chrono::milliseconds(10))) {
+                    values.push_back(*value);
+                } else if (!queue.closed()) {
+                    continue;
+                }
+                if (values.empty() && queue.closed())
+                    break;
+                for (int value : values)
+                    received[value - 1]++;
+            }
+        });
+    }
+    for (int p = 0; p < THREADS; p++)
+        threads[p].join();
+    queue.close();
+    for (int c = 0; c < THREADS; c++)
+        threads[THREADS + c].join();
+
+    bool passed = queue.capacity() == 8 && queue.empty();
+    for (const auto &count : received)
+        passed &= count == 1;
+    return report(passed, "every element pushed by 4 producers is popped by 4 consumers exactly once");
+}
+
+bool checkCloseWakesProducers() {
+    MpmcQueue<int> queue(2);
+    queue.push(1);
+    queue.push(2);
+    std::atomic<bool> pushed{true};
+    std::thread producer([&] { pushed = queue.push(3); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    producer.join();
+    // remaining elements are still taken after close, then pop() returns default value
+    const int first = queue.pop();
+    const int second = queue.pop();
+    return report(!pushed && !queue.try_push(4) && first == 1 && second == 2 && queue.pop() == 0,
+                  "close() fails blocked push, remaining elements are popped");
+}
+
+bool checkCloseWakesConsumers() {
+    MpmcQueue<int> queue(4);
+    std::atomic<int> woken{0};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < THREADS; c++) {
+        consumers.emplace_back([&] {
+            if (!queue.pop(clock::now() + std::chrono::hours(1)))
+                woken++;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    for (auto &consumer : consumers)
+        consumer.join();
+    return report(woken == THREADS, "close() wakes consumers waiting on empty queue");
+}
+
+bool checkDeadlines() {
+    MpmcQueue<int> queue(4);
+    const auto timeout = std::chrono::milliseconds(20);
+    auto start = clock::now();
+    const bool timed_out = !queue.pop(start + timeout);
+    bool passed = timed_out && clock::now() - start >= timeout;
+
+    queue.push(1);
+    queue.push(2);
+    start = clock::now();
+    const std::vector<int> batch = queue.pop_batch(4, start + timeout);
+    passed &= batch == std::vector<int>({1, 2}) && clock::now() - start >= timeout;
+    return report(passed, "timed pop() and pop_batch() return what is available on deadline");
+}
+
+} // namespace
+
+int main() {
+    bool passed = checkProducersConsumers();
+    passed &= checkCloseWakesProducers();
+    passed &= checkCloseWakesConsumers();
+    passed &= checkDeadlines();
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Checks Pool used for output frames of transform elements: reuse of released objects, get_or_create() waiting on
+// full pool woken by release of a handle, by release of an aliasing pointer owning the handle (as GStreamer memories
+// hold frame tensors) and by notify() for pending objects, and timeout of the wait.
+
+#include "dlstreamer/base/pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <memory>
+
+namespace {
+
+using namespace std::chrono_literals;
+using Object = std::shared_ptr<int>;
+using ObjectPool = dlstreamer::Pool<Object>;
+
+// Object is available if nothing but the pool references it
+ObjectPool makePool(size_t max_pool_size) {
+    return ObjectPool([] { return std::make_shared<int>(0); }, [](Object &object) { return object.use_count() == 1; },
+                      max_pool_size);
+}
+
+bool report(bool passed, const char *what) {
+    std::printf("%s %s\n", passed ? "PASSED" : "FAILED", what);
+    return passed;
+}
+
+bool checkReuse() {
+    ObjectPool pool = makePool(0);
+    int *first = pool.get_or_create().get();
+    Object second = pool.get_or_create();
+    const ObjectPool::Stats stats = pool.stats();
+    return report(second.get() == first && pool.size() == 1 && stats.hits == 1 && stats.allocations == 1,
+                  "released object is reused");
+}
+
+// Starts get_or_create() on full pool, returns pointer of the object it got
+std::future<int *> waitingAcquire(ObjectPool &pool) {
+    return std::async(std::launch::async, [&pool] { return pool.get_or_create().get(); });
+}
+
+bool checkWakeOnRelease() {
+    ObjectPool pool = makePool(1);
+    Object handle = pool.get_or_create();
+    int *object = handle.get();
+    std::future<int *> waiting = waitingAcquire(pool);
+    const bool blocked = waiting.wait_for(50ms) == std::future_status::timeout;
+    handle.reset();
+    const bool woken = waiting.wait_for(1s) == std::future_status::ready && waiting.get() == object;
+    return report(blocked && woken, "release of handle wakes get_or_create() on full pool");
+}
+
+bool checkWakeOnAliasRelease() {
+    ObjectPool pool = makePool(1);
+    Object handle = pool.get_or_create();
+    int *object = handle.get();
+    // aliasing pointer keeps the handle, so the object is released once, when nothing references it
+    std::shared_ptr<int> alias(std::make_shared<Object>(handle), object);
+    handle.reset();
+    std::future<int *> waiting = waitingAcquire(pool);
+    const bool blocked = waiting.wait_for(50ms) == std::future_status::timeout;
+    alias.reset();
+    const bool woken = waiting.wait_for(1s) == std::future_status::ready && waiting.get() == object;
+    return report(blocked && woken, "release of aliasing pointer owning handle wakes get_or_create()");
+}
+
+bool checkWakeOnNotify() {
+    // object referenced through other pointers, as tensors of a frame, stays pending after release of the handle
+    std::atomic<bool> referenced{true};
+    ObjectPool pool([] { return std::make_shared<int>(0); }, [&](Object &) { return !referenced.load(); }, 1);
+    int *object = pool.get_or_create().get();
+    std::future<int *> waiting = waitingAcquire(pool);
+    const bool blocked = waiting.wait_for(50ms) == std::future_status::timeout;
+    referenced = false;
+    pool.notify();
+    const bool woken = waiting.wait_for(1s) == std::future_status::ready && waiting.get() == object;
+    return report(blocked && woken, "notify() wakes get_or_create() to reclaim pending object");
+}
+
+bool checkTimeout() {
+    ObjectPool pool = makePool(1);
+    Object handle = pool.get_or_create();
+    const auto start = std::chrono::steady_clock::now();
+    const Object timed_out = pool.get_or_create(20ms);
+    const bool waited = std::chrono::steady_clock::now() - start >= 20ms;
+    const ObjectPool::Stats stats = pool.stats();
+    return report(!timed_out && waited && stats.waits == 1 && stats.wait_time >= 20ms,
+                  "get_or_create() with timeout returns empty pointer on full pool");
+}
+
+} // namespace
+
+int main() {
+    bool passed = checkReuse();
+    passed &= checkWakeOnRelease();
+    passed &= checkWakeOnAliasRelease();
+    passed &= checkWakeOnNotify();
+    passed &= checkTimeout();
+    return passed ? 0 : 1;
+}
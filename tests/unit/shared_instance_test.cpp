@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Checks SharedInstance as transform elements use it with shared-instance-id: 16 branches starting at once, each with
+// its own element and init function initializing that element, as GstDlsTransform does, all get one instance which is
+// initialized exactly once. Also covers retry after failed init and separate instances for different ids.
+
+#include "shared_instance.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace dlstreamer;
+
+constexpr int BRANCHES = 16;
+
+class CountingElement : public Element {
+  public:
+    bool init() override {
+        // slow init, as model loading is, leaves time for other branches to find the instance
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        init_calls++;
+        return true;
+    }
+
+    ContextPtr get_context(MemoryType) noexcept override {
+        return nullptr;
+    }
+
+    std::atomic<int> init_calls{0};
+};
+
+struct Branch {
+    std::shared_ptr<CountingElement> own = std::make_shared<CountingElement>();
+    ElementPtr shared;
+    bool init_failed = false;
+};
+
+bool report(bool passed, const char *what) {
+    std::printf("%s %s\n", passed ? "PASSED" : "FAILED", what);
+    return passed;
+}
+
+SharedInstance::InstanceId instanceId(const std::string &shared_instance_id) {
+    return {"counting_element", shared_instance_id, BaseDictionary(), FrameInfo(), FrameInfo()};
+}
+
+// Starts all branches at once, 'failing_inits' first init calls throw
+void runBranches(SharedInstance &instances, const SharedInstance::InstanceId &id, std::vector<Branch> &branches,
+                 int failing_inits = 0) {
+    std::atomic<bool> start{false};
+    std::atomic<int> init_calls{0};
+    std::vector<std::thread> threads;
+    for (Branch &branch : branches) {
+        threads.emplace_back([&] {
+            while (!start)
+                std::this_thread::yield();
+            // init function of the branch initializes its own element
+            auto init = [&] {
+                if (init_calls++ < failing_inits)
+                    throw std::runtime_error("init failed");
+                branch.own->init();
+            };
+            try {
+                branch.shared = instances.acquire(id, branch.own, init).element;
+            } catch (const std::runtime_error &) {
+                branch.init_failed = true;
+            }
+        });
+    }
+    start = true;
+    for (auto &thread : threads)
+        thread.join();
+}
+
+// All branches not failed in init got the same element, initialized once, and no other element was initialized
+bool oneInstanceInitializedOnce(const std::vector<Branch> &branches) {
+    ElementPtr shared;
+    int inits = 0;
+    for (const Branch &branch : branches) {
+        inits += branch.own->init_calls;
+        if (branch.init_failed)
+            continue;
+        if (!shared)
+            shared = branch.shared;
+        if (!shared || branch.shared != shared)
+            return false;
+    }
+    return shared && inits == 1 && static_cast<CountingElement &>(*shared).init_calls == 1;
+}
+
+bool checkSharedByBranches() {
+    bool passed = true;
+    SharedInstance instances;
+    // every round is a new pipeline with its own shared-instance-id
+    for (int round = 0; round < 50; round++) {
+        std::vector<Branch> branches(BRANCHES);
+        runBranches(instances, instanceId("inf" + std::to_string(round)), branches);
+        passed &= oneInstanceInitializedOnce(branches);
+    }
+    return report(passed, "16 branches with same id share one instance initialized exactly once");
+}
+
+bool checkRetryAfterFailedInit() {
+    bool passed = true;
+    SharedInstance instances;
+    for (int round = 0; round < 20; round++) {
+        std::vector<Branch> branches(BRANCHES);
+        runBranches(instances, instanceId("inf" + std::to_string(round)), branches, 1);
+        int failed = 0;
+        for (const Branch &branch : branches)
+            failed += branch.init_failed;
+        passed &= failed == 1 && oneInstanceInitializedOnce(branches);
+    }
+    return report(passed, "failed init is reported to its branch only, other branches register and share instance");
+}
+
+bool checkDifferentIds() {
+    SharedInstance instances;
+    std::vector<Branch> first(BRANCHES / 2), second(BRANCHES / 2);
+    std::thread other([&] { runBranches(instances, instanceId("inf1"), second); });
+    runBranches(instances, instanceId("inf0"), first);
+    other.join();
+    return report(oneInstanceInitializedOnce(first) && oneInstanceInitializedOnce(second) &&
+                      first.front().shared != second.front().shared,
+                  "branches with different ids get separate instances");
+}
+
+} // namespace
+
+int main() {
+    bool passed = checkSharedByBranches();
+    passed &= checkRetryAfterFailedInit();
+    passed &= checkDifferentIds();
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Checks sparse assignment used by object association: solve() against brute force search on small random instances,
+// serial and parallel solve() against each other, and gatedCosts() against scoring of all pairs.
+
+#include "sparse_assignment.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr float THRESHOLD = 1.f;
+
+struct Dense {
+    size_t rows = 0;
+    size_t cols = 0;
+    std::vector<float> cost; // infinity for pairs without entry
+};
+
+Dense randomInstance(size_t rows, size_t cols, float density, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    Dense dense{rows, cols, std::vector<float>(rows * cols, std::numeric_limits<float>::infinity())};
+    for (float &cost : dense.cost) {
+        if (unit(rng) < density)
+            cost = 1.5f * unit(rng); // some entries are not cheaper than threshold
+    }
+    return dense;
+}
+
+assignment::SparseCostMatrix toSparse(const Dense &dense) {
+    assignment::SparseCostMatrix sparse(dense.cols);
+    for (size_t r = 0; r < dense.rows; r++) {
+        for (size_t c = 0; c < dense.cols; c++) {
+            if (std::isfinite(dense.cost[r * dense.cols + c]))
+                sparse.add(c, dense.cost[r * dense.cols + c]);
+        }
+        sparse.nextRow();
+    }
+    return sparse;
+}
+
+double totalCost(const Dense &dense, const std::vector<int32_t> &row_cols) {
+    double total = 0.0;
+    for (size_t r = 0; r < dense.rows; r++)
+        total += row_cols[r] < 0 ? THRESHOLD : dense.cost[r * dense.cols + row_cols[r]];
+    return total;
+}
+
+// Minimal total cost over all assignments, every row is either unassigned or takes a free column
+double bruteForce(const Dense &dense) {
+    std::vector<bool> used(dense.cols, false);
+    std::function<double(size_t)> search = [&](size_t r) -> double {
+        if (r == dense.rows)
+            return 0.0;
+        double best = THRESHOLD + search(r + 1);
+        for (size_t c = 0; c < dense.cols; c++) {
+            const float cost = dense.cost[r * dense.cols + c];
+            if (used[c] || !(cost < THRESHOLD))
+                continue;
+            used[c] = true;
+            best = std::min(best, cost + search(r + 1));
+            used[c] = false;
+        }
+        return best;
+    };
+    return search(0);
+}
+
+bool validAssignment(const Dense &dense, const std::vector<int32_t> &row_cols) {
+    std::vector<bool> used(dense.cols, false);
+    for (size_t r = 0; r < dense.rows; r++) {
+        const int32_t c = row_cols[r];
+        if (c < 0)
+            continue;
+        if (static_cast<size_t>(c) >= dense.cols || used[c] || !(dense.cost[r * dense.cols + c] < THRESHOLD))
+            return false;
+        used[c] = true;
+    }
+    return true;
+}
+
+bool checkSolve() {
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<size_t> size(0, 7);
+    for (int i = 0; i < 5000; i++) {
+        const Dense dense = randomInstance(size(rng), size(rng), 0.4f, rng);
+        const std::vector<int32_t> row_cols = assignment::solve(toSparse(dense), THRESHOLD);
+        if (!validAssignment(dense, row_cols) || std::abs(totalCost(dense, row_cols) - bruteForce(dense)) > 1e-4) {
+            std::printf("FAILED solve() of %zux%zu instance %d is not optimal\n", dense.rows, dense.cols, i);
+            return false;
+        }
+    }
+    std::printf("PASSED solve() matches brute force\n");
+    return true;
+}
+
+bool checkParallel() {
+    // many independent components, so parallel solve() really splits the work
+    std::mt19937 rng(2);
+    const Dense dense = randomInstance(3000, 3000, 0.002f, rng);
+    const assignment::SparseCostMatrix sparse = toSparse(dense);
+    const std::vector<int32_t> serial = assignment::solve(sparse, THRESHOLD, false);
+    const std::vector<int32_t> parallel = assignment::solve(sparse, THRESHOLD, true);
+    const bool passed = validAssignment(dense, serial) && serial == parallel;
+    std::printf("%s serial and parallel solve() give the same assignment\n", passed ? "PASSED" : "FAILED");
+    return passed;
+}
+
+float halfPerimeter(const assignment::Box &box) {
+    return 0.5f * (box.width + box.height);
+}
+
+// Cost of the same form as in object association: base + normalized center distance / scale + non-negative term
+bool checkGatedCosts() {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> position(0.f, 1920.f);
+    std::uniform_real_distribution<float> extent(10.f, 200.f);
+    std::uniform_real_distribution<float> base(-2.5f, -0.5f);
+    std::uniform_real_distribution<float> scale(0.4f, 0.6f);
+    auto random_box = [&] { return assignment::Box{position(rng), position(rng), extent(rng), extent(rng)}; };
+
+    std::vector<assignment::Box> rows(500), cols(400);
+    std::generate(rows.begin(), rows.end(), random_box);
+    std::generate(cols.begin(), cols.end(), random_box);
+    std::vector<float> base_cost(cols.size()), center_scale(cols.size());
+    std::generate(base_cost.begin(), base_cost.end(), [&] { return base(rng); });
+    std::generate(center_scale.begin(), center_scale.end(), [&] { return scale(rng); });
+
+    auto pair_cost = [&](size_t r, size_t c) {
+        const assignment::Box &a = rows[r];
+        const assignment::Box &b = cols[c];
+        const float dx = (a.x + 0.5f * a.width) - (b.x + 0.5f * b.width);
+        const float dy = (a.y + 0.5f * a.height) - (b.y + 0.5f * b.height);
+        const float normalizer = std::min(halfPerimeter(a), halfPerimeter(b));
+        return base_cost[c] + std::sqrt(dx * dx + dy * dy) / normalizer / center_scale[c] +
+               std::abs(a.width - b.width) / normalizer;
+    };
+
+    const assignment::SparseCostMatrix gated =
+        assignment::gatedCosts(rows, cols, base_cost, center_scale, THRESHOLD, pair_cost);
+    size_t expected = 0;
+    bool passed = gated.rows() == rows.size();
+    for (size_t r = 0; passed && r < rows.size(); r++) {
+        std::vector<size_t> found;
+        for (size_t e = gated.rowBegin(r); e < gated.rowBegin(r + 1); e++)
+            found.push_back(gated.col(e));
+        for (size_t c = 0; c < cols.size(); c++) {
+            const bool cheap = pair_cost(r, c) < THRESHOLD;
+            expected += cheap;
+            passed &= cheap == std::binary_search(found.begin(), found.end(), c);
+        }
+    }
+    std::printf("%s gatedCosts() keeps all %zu pairs cheaper than threshold\n", passed ? "PASSED" : "FAILED",
+                expected);
+    return passed;
+}
+
+} // namespace
+
+int main() {
+    bool passed = checkSolve();
+    passed &= checkParallel();
+    passed &= checkGatedCosts();
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Checks ThreadPool used by post-processing and object association: every index is processed once, loops started
+// concurrently from several threads (streams) run at the same time and complete independently, exceptions reach the
+// caller and nested loops run serially.
+
+#include "dlstreamer/base/thread_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+bool report(bool passed, const char *what) {
+    std::printf("%s %s\n", passed ? "PASSED" : "FAILED", what);
+    return passed;
+}
+
+bool processedOnce(dlstreamer::ThreadPool &pool, size_t count) {
+    std::vector<std::atomic<int>> visits(count);
+    pool.parallel_for(count, [&](size_t i) { visits[i]++; });
+    for (auto &visit : visits) {
+        if (visit != 1)
+            return false;
+    }
+    return true;
+}
+
+bool checkIndices() {
+    dlstreamer::ThreadPool pool(3);
+    bool passed = true;
+    for (size_t count : {0, 1, 2, 17, 1000})
+        passed &= processedOnce(pool, count);
+    return report(passed, "parallel_for() processes every index once");
+}
+
+bool checkConcurrentCallers() {
+    dlstreamer::ThreadPool pool(3);
+    const int callers = 8;
+    std::vector<std::future<bool>> results;
+    for (int c = 0; c < callers; c++) {
+        results.push_back(std::async(std::launch::async, [&] {
+            bool passed = true;
+            for (int i = 0; i < 200; i++)
+                passed &= processedOnce(pool, 64);
+            return passed;
+        }));
+    }
+    bool passed = true;
+    for (auto &result : results)
+        passed &= result.get();
+    return report(passed, "loops from concurrent callers process every index once");
+}
+
+// Short loop completes while a long loop from other caller is running
+bool checkIndependentLoops() {
+    dlstreamer::ThreadPool pool(2);
+    std::atomic<bool> release{false};
+    std::atomic<int> started{0};
+    auto long_loop = std::async(std::launch::async, [&] {
+        pool.parallel_for(2, [&](size_t) {
+            started++;
+            while (!release)
+                std::this_thread::yield();
+        });
+    });
+    while (started < 2)
+        std::this_thread::yield();
+    auto short_loop = std::async(std::launch::async, [&] { return processedOnce(pool, 16); });
+    const bool completed = short_loop.wait_for(1s) == std::future_status::ready && short_loop.get();
+    release = true;
+    long_loop.get();
+    return report(completed, "loop completes while loop of other caller is running");
+}
+
+bool checkException() {
+    dlstreamer::ThreadPool pool(3);
+    bool thrown = false;
+    try {
+        pool.parallel_for(100, [](size_t i) {
+            if (i == 42)
+                throw std::runtime_error("failed");
+        });
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    return report(thrown && processedOnce(pool, 100), "exception from body is rethrown to caller");
+}
+
+bool checkNested() {
+    dlstreamer::ThreadPool pool(3);
+    std::atomic<size_t> total{0};
+    pool.parallel_for(8, [&](size_t) { pool.parallel_for(8, [&](size_t j) { total += j; }); });
+    return report(total == 8 * 28, "nested parallel_for() runs serially");
+}
+
+} // namespace
+
+int main() {
+    bool passed = checkIndices();
+    passed &= checkConcurrentCallers();
+    passed &= checkIndependentLoops();
+    passed &= checkException();
+    passed &= checkNested();
+    return passed ? 0 : 1;
+}
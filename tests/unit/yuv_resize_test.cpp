@@ -0,0 +1,212 @@
+/*******************************************************************************
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+// Checks that fused NV12/I420 crop, color conversion, resize and planarization (ResizeYUVToPlanarBGR) gives the same
+// tensor as the OpenCV path of OpenCV_VPP::Convert: ImageToMat (cv::cvtColor of the crop), ResizeMat (cv::resize with
+// INTER_LINEAR) and MatToMultiPlaneImage.
+//
+// Result must be identical to cv::cvtColor followed by the reference fixed-point INTER_LINEAR arithmetic of cv::resize.
+// Vectorized vertical pass of cv::resize for 8-bit images truncates intermediate products and may round differently
+// by 1, so the difference to the resize of the linked OpenCV build is only required to be at most 1.
+
+#include "opencv_utils.h"
+#include "yuv_resize.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace InferenceBackend;
+
+namespace {
+
+// NV12 or I420 frame with strides larger than width
+class Frame {
+  public:
+    Frame(int format, uint32_t width, uint32_t height, std::mt19937 &rng) {
+        const uint32_t padding = 64;
+        const bool is_nv12 = format == FOURCC_NV12;
+        const uint32_t planes = is_nv12 ? 2 : 3;
+        const uint32_t chroma_width = is_nv12 ? width : width / 2;
+        _image.type = MemoryType::SYSTEM;
+        _image.format = format;
+        _image.width = width;
+        _image.height = height;
+        _data.resize(planes);
+        std::uniform_int_distribution<int> value(0, 255);
+        for (uint32_t i = 0; i < planes; i++) {
+            _image.stride[i] = (i ? chroma_width : width) + padding;
+            _data[i].resize(_image.stride[i] * (i ? height / 2 : height));
+            for (uint8_t &byte : _data[i])
+                byte = static_cast<uint8_t>(value(rng));
+            _image.planes[i] = _data[i].data();
+        }
+    }
+
+    // Same plane offsets as ApplyCrop, x and y are even
+    Image crop(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const {
+        Image dst = _image;
+        dst.width = width;
+        dst.height = height;
+        dst.planes[0] = _image.planes[0] + y * _image.stride[0] + x;
+        if (_image.format == FOURCC_NV12) {
+            dst.planes[1] = _image.planes[1] + (y / 2) * _image.stride[1] + x;
+        } else {
+            dst.planes[1] = _image.planes[1] + (y / 2) * _image.stride[1] + x / 2;
+            dst.planes[2] = _image.planes[2] + (y / 2) * _image.stride[2] + x / 2;
+        }
+        return dst;
+    }
+
+  private:
+    Image _image;
+    std::vector<std::vector<uint8_t>> _data;
+};
+
+// Dense RGBP tensor as allocated by the inference backend
+struct Tensor {
+    Tensor(uint32_t width, uint32_t height) : data(3 * width * height) {
+        image.type = MemoryType::SYSTEM;
+        image.format = FOURCC_RGBP;
+        image.width = width;
+        image.height = height;
+        for (uint32_t i = 0; i < 3; i++) {
+            image.planes[i] = data.data() + i * width * height;
+            image.stride[i] = width;
+        }
+    }
+
+    Image image;
+    std::vector<uint8_t> data;
+};
+
+// Fixed-point INTER_LINEAR resize of 8-bit images as in the reference (not vectorized) implementation of cv::resize
+cv::Mat referenceResize(const cv::Mat &src, int dst_width, int dst_height) {
+    constexpr int coef_bits = 11;
+    constexpr int coef_scale = 1 << coef_bits;
+    const int channels = src.channels();
+
+    auto coefficients = [](int src_size, int dst_size, bool clamp, std::vector<int> &offsets,
+                           std::vector<short> &weights) {
+        const double scale = 1. / (static_cast<double>(dst_size) / src_size);
+        for (int d = 0; d < dst_size; d++) {
+            float f = static_cast<float>((d + 0.5) * scale - 0.5);
+            int s = cvFloor(f);
+            f -= s;
+            if (clamp && s < 0) {
+                f = 0.f;
+                s = 0;
+            }
+            if (clamp && s >= src_size - 1) {
+                f = 0.f;
+                s = src_size - 1;
+            }
+            offsets.push_back(s);
+            weights.push_back(cv::saturate_cast<short>((1.f - f) * coef_scale));
+            weights.push_back(cv::saturate_cast<short>(f * coef_scale));
+        }
+    };
+    std::vector<int> xofs, yofs;
+    std::vector<short> alpha, beta;
+    coefficients(src.cols, dst_width, true, xofs, alpha);
+    coefficients(src.rows, dst_height, false, yofs, beta);
+
+    // rows outside of image are clamped, columns are clamped by coefficients
+    auto horizontal = [&](int sy, int dx, int c) {
+        const uint8_t *row = src.ptr<uint8_t>(std::min(std::max(sy, 0), src.rows - 1));
+        const int sx = xofs[dx];
+        const int next = std::min(sx + 1, src.cols - 1);
+        return row[sx * channels + c] * alpha[2 * dx] + row[next * channels + c] * alpha[2 * dx + 1];
+    };
+
+    cv::Mat dst(dst_height, dst_width, src.type());
+    for (int dy = 0; dy < dst_height; dy++) {
+        uint8_t *row = dst.ptr<uint8_t>(dy);
+        for (int dx = 0; dx < dst_width; dx++) {
+            for (int c = 0; c < channels; c++) {
+                const int value = horizontal(yofs[dy], dx, c) * beta[2 * dy] +
+                                  horizontal(yofs[dy] + 1, dx, c) * beta[2 * dy + 1] + (1 << (2 * coef_bits - 1));
+                row[dx * channels + c] = cv::saturate_cast<uint8_t>(value >> (2 * coef_bits));
+            }
+        }
+    }
+    return dst;
+}
+
+struct Difference {
+    size_t pixels = 0;
+    int max = 0;
+};
+
+Difference compare(const Tensor &expected, const Tensor &actual) {
+    Difference difference;
+    for (size_t i = 0; i < expected.data.size(); i++) {
+        const int delta = std::abs(expected.data[i] - actual.data[i]);
+        difference.pixels += delta != 0;
+        difference.max = std::max(difference.max, delta);
+    }
+    return difference;
+}
+
+struct Case {
+    uint32_t x, y, width, height;
+    uint32_t dst_width, dst_height;
+};
+
+bool check(const char *format_name, const Frame &frame, const Case &c) {
+    const Image src = frame.crop(c.x, c.y, c.width, c.height);
+
+    Tensor fused(c.dst_width, c.dst_height);
+    Utils::ResizeYUVToPlanarBGR(src, fused.image);
+
+    cv::Mat converted;
+    Utils::ImageToMat(src, converted);
+
+    Tensor reference(c.dst_width, c.dst_height);
+    Utils::MatToMultiPlaneImage(referenceResize(converted, c.dst_width, c.dst_height), reference.image);
+
+    Tensor opencv(c.dst_width, c.dst_height);
+    Utils::MatToMultiPlaneImage(Utils::ResizeMat(converted, c.dst_height, c.dst_width), opencv.image);
+
+    const Difference to_reference = compare(reference, fused);
+    const Difference to_opencv = compare(opencv, fused);
+    const bool passed = to_reference.pixels == 0 && to_opencv.max <= 1;
+    std::printf("%s %s crop %ux%u at (%u, %u) to %ux%u: %zu values differ from reference, %zu (max %d) from "
+                "cv::resize\n",
+                passed ? "PASSED" : "FAILED", format_name, c.width, c.height, c.x, c.y, c.dst_width, c.dst_height,
+                to_reference.pixels, to_opencv.pixels, to_opencv.max);
+    return passed;
+}
+
+} // namespace
+
+int main() {
+    const Case cases[] = {
+        {0, 0, 1920, 1080, 416, 416},    // full frame detection input
+        {0, 0, 1920, 1080, 960, 540},    // exact downscale by 2
+        {640, 360, 300, 200, 64, 64},    // classification of object crop
+        {100, 50, 37, 91, 64, 64},       // odd crop size, last column and row are dropped
+        {1800, 1000, 120, 80, 224, 224}, // upscale at frame border
+        {2, 2, 64, 64, 64, 64},          // same size
+        {0, 0, 2, 2, 17, 9},             // smallest source
+        {512, 256, 250, 250, 31, 250},   // resize along one axis
+    };
+
+    std::mt19937 rng(7);
+    bool passed = true;
+    for (int format : {FOURCC_NV12, FOURCC_I420}) {
+        const char *format_name = format == FOURCC_NV12 ? "NV12" : "I420";
+        const Frame frame(format, 1920, 1080, rng);
+        for (const Case &c : cases)
+            passed &= check(format_name, frame, c);
+    }
+    return passed ? 0 : 1;
+}